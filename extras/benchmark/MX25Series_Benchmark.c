@@ -0,0 +1,444 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+/**
+ * MX25Series_Benchmark measures read, program and erase throughput and latency against the host emulator in
+ * extras/emulator. Throughput and latency are in emulated time, so they reflect the SPI clock, the per call
+ * overhead and the number of platform function calls the library makes, and the host time is reported alongside
+ * for tracking the CPU cost of the hot paths.
+ *
+ * Output is one CSV row (or JSON object with -j) per benchmark.
+ */
+
+#include "MX25Series.h"
+#include "MX25Series_Stripe.h"
+#include "MX25Series_Verify.h"
+#include "MX25Series_Emulator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct
+{
+    MX25Series_Emulator_t emulator;
+    MX25Series_t dev;
+    uint32_t region;        /**! Bytes of flash exercised by each benchmark */
+    uint32_t chunk;         /**! Bytes per read call */
+    bool json;
+    uint32_t random_state;
+    uint8_t *buffer;
+    MX25Series_Emulator_t *members;     /**! Further chips on the bus of emulator, counted while a stripe benchmark runs */
+    uint8_t member_count;
+} MX25Series_Benchmark_t;
+
+typedef struct
+{
+    uint64_t emulated_ns;
+    uint64_t host_ns;
+    uint64_t calls;
+} MX25Series_Benchmark_Mark_t;
+
+static uint64_t MX25Series__benchmark_host_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+static uint64_t MX25Series__benchmark_emulator_calls(MX25Series_Emulator_t *emulator)
+{
+    return (uint64_t)emulator->counters.issue_command + emulator->counters.write +
+           emulator->counters.read + emulator->counters.cs + emulator->counters.transfer;
+}
+
+static uint64_t MX25Series__benchmark_calls(MX25Series_Benchmark_t *bench)
+{
+    uint64_t calls = MX25Series__benchmark_emulator_calls(&bench->emulator);
+
+    for(uint8_t i = 0; i < bench->member_count; i++)
+    {
+        calls += MX25Series__benchmark_emulator_calls(&bench->members[i]);
+    }
+    return calls;
+}
+
+static void MX25Series__benchmark_start(MX25Series_Benchmark_t *bench, MX25Series_Benchmark_Mark_t *mark)
+{
+    mark->calls = MX25Series__benchmark_calls(bench);
+    mark->emulated_ns = MX25Series_emulator_get_time_ns(&bench->emulator);
+    mark->host_ns = MX25Series__benchmark_host_ns();
+}
+
+static uint32_t MX25Series__benchmark_random(MX25Series_Benchmark_t *bench)
+{
+    //xorshift32, the sequence only needs to be repeatable between runs.
+    uint32_t x = bench->random_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    bench->random_state = x;
+    return x;
+}
+
+static void MX25Series__benchmark_report(
+        MX25Series_Benchmark_t *bench,
+        MX25Series_Benchmark_Mark_t *mark,
+        const char *name,
+        const char *mode,
+        uint64_t ops,
+        uint64_t bytes,
+        MX25Series_status_enum_t result)
+{
+    uint64_t host_ns = MX25Series__benchmark_host_ns() - mark->host_ns;
+    uint64_t emulated_ns = MX25Series_emulator_get_time_ns(&bench->emulator) - mark->emulated_ns;
+    uint64_t calls = MX25Series__benchmark_calls(bench) - mark->calls;
+    double seconds = emulated_ns / 1e9;
+    double bytes_per_second = seconds > 0 ? bytes / seconds : 0;
+    double ns_per_op = ops > 0 ? (double)emulated_ns / ops : 0;
+    double calls_per_byte = bytes > 0 ? (double)calls / bytes : 0;
+    bool ok = !MX25Series_HAS_ERROR(result) && bench->emulator.counters.framing_errors == 0;
+
+    for(uint8_t i = 0; i < bench->member_count; i++)
+    {
+        ok &= bench->members[i].counters.framing_errors == 0 && bench->members[i].counters.bus_conflicts == 0;
+    }
+
+    if(bench->json)
+    {
+        printf("{\"benchmark\":\"%s\",\"mode\":\"%s\",\"ops\":%llu,\"bytes\":%llu,\"emulated_ns\":%llu,"
+               "\"bytes_per_second\":%.0f,\"ns_per_op\":%.0f,\"hal_calls\":%llu,\"hal_calls_per_byte\":%.4f,"
+               "\"host_ns\":%llu,\"ok\":%s}\n",
+               name, mode, (unsigned long long)ops, (unsigned long long)bytes, (unsigned long long)emulated_ns,
+               bytes_per_second, ns_per_op, (unsigned long long)calls, calls_per_byte,
+               (unsigned long long)host_ns, ok ? "true" : "false");
+    }
+    else
+    {
+        printf("%s,%s,%llu,%llu,%llu,%.0f,%.0f,%llu,%.4f,%llu,%d\n",
+               name, mode, (unsigned long long)ops, (unsigned long long)bytes, (unsigned long long)emulated_ns,
+               bytes_per_second, ns_per_op, (unsigned long long)calls, calls_per_byte,
+               (unsigned long long)host_ns, ok ? 1 : 0);
+    }
+}
+
+static MX25Series_status_enum_t MX25Series__benchmark_read_call(
+        MX25Series_Benchmark_t *bench,
+        MX25Series_Read_Mode_enum_t mode,
+        uint32_t memory_address)
+{
+    //READ and FAST_READ go through MX25Series_read_stored_data, the historical hot path.
+    switch(mode)
+    {
+        case MX25Series_Read_Mode_READ:
+            return MX25Series_read_stored_data(&bench->dev, false, memory_address, bench->chunk, bench->buffer);
+        case MX25Series_Read_Mode_FAST_READ:
+            return MX25Series_read_stored_data(&bench->dev, true, memory_address, bench->chunk, bench->buffer);
+        default:
+            return MX25Series_read_stored_data_mode(&bench->dev, mode, memory_address, bench->chunk, bench->buffer);
+    }
+}
+
+static void MX25Series__benchmark_read(MX25Series_Benchmark_t *bench, MX25Series_Read_Mode_enum_t mode)
+{
+    MX25Series_Benchmark_Mark_t mark;
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t memory_size = bench->dev.chip_def->memory_size;
+    uint64_t ops = 0;
+
+    MX25Series__benchmark_start(bench, &mark);
+    for(uint32_t offset = 0; offset + bench->chunk <= bench->region; offset += bench->chunk, ops++)
+    {
+        result |= MX25Series__benchmark_read_call(bench, mode, offset);
+    }
+    MX25Series__benchmark_report(bench, &mark, "read_sequential", MX25Series_get_read_mode_string(mode),
+                                 ops, ops * bench->chunk, result);
+
+    result = MX25Series_status_init;
+    bench->random_state = 0x2545F491;
+    MX25Series__benchmark_start(bench, &mark);
+    for(ops = 0; ops < bench->region / bench->chunk; ops++)
+    {
+        result |= MX25Series__benchmark_read_call(bench, mode,
+                                                  MX25Series__benchmark_random(bench) % (memory_size - bench->chunk));
+    }
+    MX25Series__benchmark_report(bench, &mark, "read_random", MX25Series_get_read_mode_string(mode),
+                                 ops, ops * bench->chunk, result);
+}
+
+static void MX25Series__benchmark_program(MX25Series_Benchmark_t *bench, const char *mode)
+{
+    MX25Series_Benchmark_Mark_t mark;
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t page_size = bench->dev.chip_def->page_size;
+    uint64_t ops = 0;
+
+    result = MX25Series_erase_range(&bench->dev, 0, bench->region);
+    for(uint32_t i = 0; i < page_size; i++)
+    {
+        bench->buffer[i] = (uint8_t)MX25Series__benchmark_random(bench);
+    }
+
+    MX25Series__benchmark_start(bench, &mark);
+    for(uint32_t offset = 0; offset < bench->region; offset += page_size, ops++)
+    {
+        result |= MX25Series_set_write_enable(&bench->dev, true);
+        result |= MX25Series_write_stored_data(&bench->dev, offset, page_size, bench->buffer);
+        result |= MX25Series_wait_for_operation(&bench->dev);
+    }
+    MX25Series__benchmark_report(bench, &mark, "program", mode, ops, ops * page_size, result);
+}
+
+static void MX25Series__benchmark_erase(MX25Series_Benchmark_t *bench, MX25Series_Erase_enum_t erase_type, const char *mode)
+{
+    MX25Series_Benchmark_Mark_t mark;
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t size = MX25Series_get_erasure_size(&bench->dev, erase_type);
+    uint64_t ops = 0;
+
+    MX25Series__benchmark_start(bench, &mark);
+    for(uint32_t offset = 0; offset + size <= bench->region; offset += size, ops++)
+    {
+        result |= MX25Series_set_write_enable(&bench->dev, true);
+        result |= MX25Series_erase(&bench->dev, erase_type, offset);
+        result |= MX25Series_wait_for_operation(&bench->dev);
+    }
+    MX25Series__benchmark_report(bench, &mark, "erase", mode, ops, ops * size, result);
+}
+
+static void MX25Series__benchmark_crc(MX25Series_Benchmark_t *bench, MX25Series_CRC_enum_t type, const char *mode)
+{
+    MX25Series_Benchmark_Mark_t mark;
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t *record = malloc(bench->region);
+    uint32_t expected = 0;
+    uint32_t crc = 0;
+
+    if(record == NULL)
+    {
+        return;
+    }
+
+    //The CRC alone, host time only.
+    MX25Series_read_stored_data_mode(&bench->dev, bench->dev.read_mode, 0, bench->region, record);
+    MX25Series__benchmark_start(bench, &mark);
+    expected = MX25Series_crc(type, 0, record, bench->region);
+    MX25Series__benchmark_report(bench, &mark, "crc", mode, 1, bench->region, MX25Series_status_ok);
+
+    //Read the whole record, then a second pass over it.
+    MX25Series__benchmark_start(bench, &mark);
+    result = MX25Series_read_stored_data_mode(&bench->dev, bench->dev.read_mode, 0, bench->region, record);
+    crc = MX25Series_crc(type, 0, record, bench->region);
+    MX25Series__benchmark_report(bench, &mark, "read_crc_two_pass", mode, 1, bench->region,
+                                 crc == expected ? result : MX25Series_status_error_verify);
+
+    //The CRC of each chunk as it arrives.
+    crc = 0;
+    MX25Series__benchmark_start(bench, &mark);
+    result = MX25Series_read_crc(&bench->dev, type, 0, bench->region, record, &crc);
+    MX25Series__benchmark_report(bench, &mark, "read_crc_single_pass", mode, 1, bench->region,
+                                 crc == expected ? result : MX25Series_status_error_verify);
+    free(record);
+}
+
+/**
+ * MX25Series__benchmark_stripe writes the region striped over the benchmark chip and member_count - 1 more on the
+ * same bus. The program time depends on the latency setting, so the mode names it along with the member count.
+ */
+static void MX25Series__benchmark_stripe(MX25Series_Benchmark_t *bench, uint8_t member_count)
+{
+    MX25Series_Benchmark_Mark_t mark;
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Emulator_t emulators[MX25Series_STRIPE_MAX_MEMBERS - 1];
+    MX25Series_t devices[MX25Series_STRIPE_MAX_MEMBERS - 1];
+    MX25Series_t *members[MX25Series_STRIPE_MAX_MEMBERS];
+    MX25Series_Stripe_t stripe;
+    uint32_t page_size = bench->dev.chip_def->page_size;
+    uint64_t ops = 0;
+    uint8_t created;
+    char mode[40];
+
+    members[0] = &bench->dev;
+    for(created = 0; created + 1 < member_count; created++)
+    {
+        if(MX25Series_HAS_ERROR(MX25Series_emulator_init(&emulators[created], bench->emulator.chip_def, NULL)))
+        {
+            break;
+        }
+        MX25Series_emulator_share_bus(&emulators[created], &bench->emulator);
+        emulators[created].call_overhead_ns = bench->emulator.call_overhead_ns;
+        emulators[created].latency_percent = bench->emulator.latency_percent;
+        MX25Series_init(&devices[created], bench->dev.chip_def, created + 1, 0, 0, 0, &emulators[created]);
+        members[created + 1] = &devices[created];
+    }
+
+    if(created + 1 == member_count)
+    {
+        bench->members = emulators;
+        bench->member_count = created;
+        result = MX25Series_stripe_init(&stripe, members, member_count);
+        //Whole volume sectors, one 4 KB sector per member.
+        result |= MX25Series_stripe_erase_range(&stripe, 0, (bench->region + stripe.sector_size - 1) / stripe.sector_size * stripe.sector_size);
+        result |= MX25Series_stripe_wait(&stripe);
+        for(uint32_t i = 0; i < page_size; i++)
+        {
+            bench->buffer[i] = (uint8_t)MX25Series__benchmark_random(bench);
+        }
+
+        MX25Series__benchmark_start(bench, &mark);
+        for(uint32_t offset = 0; offset < bench->region; offset += page_size, ops++)
+        {
+            result |= MX25Series_stripe_write(&stripe, offset, page_size, bench->buffer);
+        }
+        result |= MX25Series_stripe_wait(&stripe);
+        snprintf(mode, sizeof(mode), "%u_members_latency_%u", member_count, bench->emulator.latency_percent);
+        MX25Series__benchmark_report(bench, &mark, "stripe_write", mode, ops, ops * page_size, result);
+        bench->members = NULL;
+        bench->member_count = 0;
+    }
+
+    while(created > 0)
+    {
+        MX25Series_emulator_deinit(&emulators[--created]);
+    }
+}
+
+static void MX25Series__benchmark_usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s [-c spi_clock_hz] [-o call_overhead_ns] [-l latency_percent] [-r region_bytes]\n"
+            "          [-s read_chunk_bytes] [-H] [-j]\n"
+            "  -H  use the high performance chip definition and set CR L/H\n"
+            "  -j  JSON lines instead of CSV\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    MX25Series_Benchmark_t bench;
+    MX25Series_Chip_Info_t *chip_def = &MX25R6435F_Chip_Def_Low_Power;
+    uint32_t spi_clock_hz = MX25Series_EMULATOR_SPI_CLOCK_HZ;
+    uint32_t call_overhead_ns = 0;
+    uint8_t latency_percent = 50;
+    int option;
+
+    memset(&bench, 0, sizeof(bench));
+    bench.region = MX25Series_BLOCK_64K_SIZE * 4;
+    bench.chunk = 256;
+
+    while((option = getopt(argc, argv, "c:o:l:r:s:Hjh")) != -1)
+    {
+        switch(option)
+        {
+            case 'c':
+                spi_clock_hz = strtoul(optarg, NULL, 0);
+                break;
+            case 'o':
+                call_overhead_ns = strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                latency_percent = strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                bench.region = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                bench.chunk = strtoul(optarg, NULL, 0);
+                break;
+            case 'H':
+                chip_def = &MX25R6435F_Chip_Def_High_Performance;
+                break;
+            case 'j':
+                bench.json = true;
+                break;
+            default:
+                MX25Series__benchmark_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    //Whole 64 KB blocks keep every erase type comparable.
+    bench.region -= bench.region % MX25Series_BLOCK_64K_SIZE;
+    if(spi_clock_hz == 0 || bench.region == 0 || bench.chunk == 0 || bench.region > chip_def->memory_size ||
+       bench.chunk >= chip_def->memory_size)
+    {
+        MX25Series__benchmark_usage(argv[0]);
+        return 1;
+    }
+
+    bench.buffer = malloc(bench.chunk > chip_def->page_size ? bench.chunk : chip_def->page_size);
+    if(bench.buffer == NULL ||
+       MX25Series_HAS_ERROR(MX25Series_emulator_init(&bench.emulator, &MX25R6435F_Chip_Def_Low_Power, NULL)))
+    {
+        fprintf(stderr, "Failed to create the emulator.\n");
+        return 1;
+    }
+    bench.emulator.chip_def_high_performance = &MX25R6435F_Chip_Def_High_Performance;
+    bench.emulator.spi_clock_hz = spi_clock_hz;
+    bench.emulator.call_overhead_ns = call_overhead_ns;
+    bench.emulator.latency_percent = latency_percent;
+    bench.random_state = 0x2545F491;
+
+    MX25Series_init(&bench.dev, chip_def, 0, 0, 0, 0, &bench.emulator);
+    MX25Series_set_write_enable(&bench.dev, true);
+    MX25Series_configure_chip(&bench.dev, MX25Series_SR_QE_MASK,
+                              chip_def == &MX25R6435F_Chip_Def_High_Performance ? MX25Series_CR_LH : 0);
+    MX25Series_wait_for_operation(&bench.dev);
+
+    if(!bench.json)
+    {
+        printf("benchmark,mode,ops,bytes,emulated_ns,bytes_per_second,ns_per_op,hal_calls,hal_calls_per_byte,host_ns,ok\n");
+    }
+
+    MX25Series__benchmark_program(&bench, "PP");
+#if defined(MX25Series_ENABLE_MULTI_IO)
+    MX25Series_set_program_mode(&bench.dev, MX25Series_Program_Mode_4PP);
+    MX25Series__benchmark_program(&bench, "4PP");
+    MX25Series_set_program_mode(&bench.dev, MX25Series_Program_Mode_PP);
+#endif
+
+    MX25Series__benchmark_read(&bench, MX25Series_Read_Mode_READ);
+    MX25Series__benchmark_read(&bench, MX25Series_Read_Mode_FAST_READ);
+#if defined(MX25Series_ENABLE_MULTI_IO)
+    MX25Series__benchmark_read(&bench, MX25Series_Read_Mode_DREAD);
+    MX25Series__benchmark_read(&bench, MX25Series_Read_Mode_2READ);
+    MX25Series__benchmark_read(&bench, MX25Series_Read_Mode_QREAD);
+    MX25Series__benchmark_read(&bench, MX25Series_Read_Mode_4READ);
+#endif
+
+    MX25Series__benchmark_crc(&bench, MX25Series_CRC_32, "CRC32");
+    MX25Series__benchmark_crc(&bench, MX25Series_CRC_32C, "CRC32C");
+
+    MX25Series__benchmark_erase(&bench, MX25Series_Erase_Block_4K, "SE");
+    MX25Series__benchmark_erase(&bench, MX25Series_Erase_Block_32K, "BE32K");
+    MX25Series__benchmark_erase(&bench, MX25Series_Erase_Block_64K, "BE64K");
+
+    for(uint8_t members = 1; members <= MX25Series_STRIPE_MAX_MEMBERS; members++)
+    {
+        MX25Series__benchmark_stripe(&bench, members);
+    }
+
+    MX25Series_emulator_deinit(&bench.emulator);
+    free(bench.buffer);
+    return 0;
+}
@@ -0,0 +1,959 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+#include "MX25Series_Emulator.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static MX25Series_Emulator_t* MX25Series__emulator(MX25Series_t *dev)
+{
+    return (MX25Series_Emulator_t*)dev->ctx;
+}
+
+static void MX25Series__emulator_call(MX25Series_Emulator_t *emu)
+{
+    *emu->clock_ns += emu->call_overhead_ns;
+}
+
+static void MX25Series__emulator_clock_bytes(MX25Series_Emulator_t *emu, size_t length, uint8_t lanes)
+{
+    *emu->clock_ns += ((uint64_t)length * 8 / lanes * 1000000000ull) / emu->spi_clock_hz;
+}
+
+static MX25Series_Chip_Info_t* MX25Series__emulator_timing(MX25Series_Emulator_t *emu)
+{
+    if((emu->configuration_register & MX25Series_CR_LH_MASK) != 0 && emu->chip_def_high_performance != NULL)
+    {
+        return emu->chip_def_high_performance;
+    }
+    return emu->chip_def;
+}
+
+static void MX25Series__emulator_set_busy(MX25Series_Emulator_t *emu, uint32_t max_time)
+{
+    emu->status_register |= MX25Series_SR_WIP;
+    emu->busy_command = emu->command;
+    emu->busy_until_ns = *emu->clock_ns + (uint64_t)max_time * 1000ull * emu->latency_percent / 100;
+}
+
+static void MX25Series__emulator_update(MX25Series_Emulator_t *emu)
+{
+    if((emu->status_register & MX25Series_SR_WIP) != 0 && !emu->suspended && *emu->clock_ns >= emu->busy_until_ns)
+    {
+        emu->status_register &= ~(MX25Series_SR_WIP | MX25Series_SR_WEL);
+    }
+}
+
+static bool MX25Series__emulator_quad_enabled(MX25Series_Emulator_t *emu)
+{
+    return (emu->status_register & MX25Series_SR_QE_MASK) != 0;
+}
+
+/**
+ * MX25Series__emulator_expect sets up the address, dummy and data phases of the frame for the command.
+ */
+static bool MX25Series__emulator_expect(MX25Series_Emulator_t *emu, uint8_t command)
+{
+    MX25Series_Chip_Info_t *chip = emu->chip_def;
+    bool dc = (emu->configuration_register & MX25Series_CR_DC_MASK) != 0;
+    uint8_t dummy_cycles = 0;
+
+    emu->expected_address_lanes = 1;
+    emu->expected_data_lanes = 1;
+    emu->address_bytes = 0;
+
+    switch(command)
+    {
+        case MX25Series_Command_READ:
+        case MX25Series_Command_PP:
+        case MX25Series_Command_SE:
+        case MX25Series_Command_BE32K:
+        case MX25Series_Command_BE64K:
+            break;
+        case MX25Series_Command_FAST_READ:
+            dummy_cycles = chip->dummy_cycles.fast_read;
+            break;
+        case MX25Series_Command_RDSFDP:
+            dummy_cycles = 8;
+            break;
+        case MX25Series_Command_DREAD:
+            emu->expected_data_lanes = 2;
+            dummy_cycles = chip->dummy_cycles.dread;
+            break;
+        case MX25Series_Command_2READ:
+            emu->expected_address_lanes = 2;
+            emu->expected_data_lanes = 2;
+            dummy_cycles = dc ? chip->dummy_cycles.dual_io_dc : chip->dummy_cycles.dual_io;
+            break;
+        case MX25Series_Command_QREAD:
+            emu->expected_data_lanes = 4;
+            dummy_cycles = chip->dummy_cycles.qread;
+            if(!MX25Series__emulator_quad_enabled(emu))
+            {
+                return false;
+            }
+            break;
+        case MX25Series_Command_4READ:
+        case MX25Series_Command_4PP:
+            emu->expected_address_lanes = 4;
+            emu->expected_data_lanes = 4;
+            dummy_cycles = command == MX25Series_Command_4PP ? 0 : (dc ? chip->dummy_cycles.quad_io_dc : chip->dummy_cycles.quad_io);
+            if(!MX25Series__emulator_quad_enabled(emu))
+            {
+                return false;
+            }
+            break;
+        default:
+            //Every other command goes straight to its data phase.
+            emu->phase = MX25Series_Emulator_Phase_Data;
+            return true;
+    }
+
+    emu->expected_dummy_bytes = (dummy_cycles * emu->expected_address_lanes) / 8;
+    emu->phase = MX25Series_Emulator_Phase_Address;
+    return true;
+}
+
+static void MX25Series__emulator_write_byte(MX25Series_Emulator_t *emu, uint8_t lanes, uint8_t value)
+{
+    switch(emu->phase)
+    {
+        case MX25Series_Emulator_Phase_Address:
+            if(lanes != emu->expected_address_lanes)
+            {
+                emu->counters.framing_errors++;
+            }
+            emu->address = (emu->address << 8) | value;
+            if(++emu->address_bytes == 3)
+            {
+                emu->phase = emu->expected_dummy_bytes > 0 ? MX25Series_Emulator_Phase_Dummy : MX25Series_Emulator_Phase_Data;
+            }
+            break;
+        case MX25Series_Emulator_Phase_Dummy:
+            if(lanes != emu->expected_address_lanes)
+            {
+                emu->counters.framing_errors++;
+            }
+            if(++emu->dummy_bytes == emu->expected_dummy_bytes)
+            {
+                emu->phase = MX25Series_Emulator_Phase_Data;
+            }
+            break;
+        case MX25Series_Emulator_Phase_Data:
+            switch(emu->command)
+            {
+                case MX25Series_Command_PP:
+                case MX25Series_Command_4PP:
+                {
+                    //PP wraps within the page, the last page_size bytes sent win.
+                    uint32_t page_size = emu->chip_def->page_size;
+                    uint32_t index = (emu->address % page_size + emu->data_count) % page_size;
+                    if(lanes != emu->expected_data_lanes)
+                    {
+                        emu->counters.framing_errors++;
+                    }
+                    emu->page[index] = value;
+                    emu->page_touched[index] = true;
+                    break;
+                }
+                case MX25Series_Command_WRSR:
+                    if(emu->data_count < sizeof(emu->data))
+                    {
+                        emu->data[emu->data_count] = value;
+                    }
+                    break;
+                case MX25Series_Command_READ:
+                case MX25Series_Command_FAST_READ:
+                case MX25Series_Command_DREAD:
+                case MX25Series_Command_2READ:
+                case MX25Series_Command_QREAD:
+                case MX25Series_Command_4READ:
+                case MX25Series_Command_RDSFDP:
+                    emu->counters.framing_errors++;
+                    break;
+                default:
+                    //Dummy bytes of RES, REMS and the like.
+                    break;
+            }
+            emu->data_count++;
+            break;
+        case MX25Series_Emulator_Phase_Idle:
+        case MX25Series_Emulator_Phase_Command:
+        default:
+            emu->counters.framing_errors++;
+            break;
+    }
+}
+
+static uint8_t MX25Series__emulator_read_byte(MX25Series_Emulator_t *emu, uint8_t lanes)
+{
+    uint8_t value = 0xFF;
+    uint32_t index = emu->data_count++;
+
+    if(emu->phase != MX25Series_Emulator_Phase_Data)
+    {
+        emu->counters.framing_errors++;
+        return value;
+    }
+
+    switch(emu->command)
+    {
+        case MX25Series_Command_READ:
+        case MX25Series_Command_FAST_READ:
+        case MX25Series_Command_DREAD:
+        case MX25Series_Command_2READ:
+        case MX25Series_Command_QREAD:
+        case MX25Series_Command_4READ:
+            if(lanes != emu->expected_data_lanes)
+            {
+                emu->counters.framing_errors++;
+            }
+            value = emu->memory[(emu->address + index) % emu->chip_def->memory_size];
+            break;
+        case MX25Series_Command_RDSR:
+            MX25Series__emulator_update(emu);
+            value = emu->status_register;
+            break;
+        case MX25Series_Command_RDCR:
+            value = (index % 2) == 0 ? (emu->configuration_register >> 8) : (emu->configuration_register & 0xFF);
+            break;
+        case MX25Series_Command_RDSCUR:
+            value = emu->security_register;
+            break;
+        case MX25Series_Command_RDID:
+        {
+            uint8_t id[3] = {emu->chip_def->manufacturer_id, emu->chip_def->memory_type, emu->chip_def->memory_density};
+            value = id[index % 3];
+            break;
+        }
+        case MX25Series_Command_REMS:
+            value = (index % 2) == 0 ? emu->chip_def->manufacturer_id : emu->chip_def->memory_density;
+            break;
+        case MX25Series_Command_RES:
+            value = emu->chip_def->memory_density;
+            break;
+        case MX25Series_Command_RDSFDP:
+            if(emu->address + index < emu->sfdp_length)
+            {
+                value = emu->sfdp[emu->address + index];
+            }
+            break;
+        default:
+            break;
+    }
+    return value;
+}
+
+/**
+ * MX25Series__emulator_fails decides whether the program or erase being started fails, once fail_after have
+ * succeeded.
+ */
+static bool MX25Series__emulator_fails(MX25Series_Emulator_t *emu, uint32_t *failures)
+{
+    if(*failures == 0)
+    {
+        return false;
+    }
+    if(emu->fail_after > 0)
+    {
+        emu->fail_after--;
+        return false;
+    }
+    (*failures)--;
+    return true;
+}
+
+/**
+ * MX25Series__emulator_erase_failed sets or clears E_FAIL for the erase being started, a failed erase leaves the
+ * memory untouched unless fail_torn is set.
+ */
+static bool MX25Series__emulator_erase_failed(MX25Series_Emulator_t *emu, uint32_t address, uint32_t block)
+{
+    if(MX25Series__emulator_fails(emu, &emu->fail_erases))
+    {
+        emu->security_register |= MX25Series_SCUR_E_FAIL;
+        if(emu->fail_torn)
+        {
+            memset(emu->memory + address, 0xFF, block / 2);
+        }
+        return true;
+    }
+    emu->security_register &= ~MX25Series_SCUR_E_FAIL;
+    return false;
+}
+
+/**
+ * MX25Series__emulator_execute carries out the frame once CS goes high.
+ */
+static void MX25Series__emulator_execute(MX25Series_Emulator_t *emu)
+{
+    MX25Series_Chip_Info_t *timing = MX25Series__emulator_timing(emu);
+    bool wel = (emu->status_register & MX25Series_SR_WEL) != 0;
+    bool address = emu->address_bytes == 3;
+    uint32_t size = emu->chip_def->memory_size;
+
+    switch(emu->command)
+    {
+        case MX25Series_Command_WREN:
+            emu->status_register |= MX25Series_SR_WEL;
+            break;
+        case MX25Series_Command_WRDI:
+            emu->status_register &= ~MX25Series_SR_WEL;
+            break;
+        case MX25Series_Command_PP:
+        case MX25Series_Command_4PP:
+        {
+            uint32_t page_size = emu->chip_def->page_size;
+            uint32_t page = (emu->address % size) - (emu->address % page_size);
+            if(!wel || !address)
+            {
+                emu->counters.ignored_commands++;
+                break;
+            }
+            uint32_t touched = 0;
+            uint32_t limit = page_size;
+            emu->counters.programs++;
+            MX25Series__emulator_set_busy(emu, timing->timing.tPP);
+            if(MX25Series__emulator_fails(emu, &emu->fail_programs))
+            {
+                //A failed program leaves the page untouched, a torn one programs the first half of its bytes.
+                emu->security_register |= MX25Series_SCUR_P_FAIL;
+                if(!emu->fail_torn)
+                {
+                    break;
+                }
+                for(uint32_t i = 0; i < page_size; i++)
+                {
+                    touched += emu->page_touched[i] ? 1 : 0;
+                }
+                limit = touched / 2;
+            }
+            else
+            {
+                emu->security_register &= ~MX25Series_SCUR_P_FAIL;
+            }
+            //NOR flash only programs bits from 1 to 0.
+            for(uint32_t i = 0, programmed = 0; i < page_size && programmed < limit; i++)
+            {
+                if(emu->page_touched[i])
+                {
+                    emu->memory[page + i] &= emu->page[i];
+                    programmed++;
+                }
+            }
+            break;
+        }
+        case MX25Series_Command_SE:
+        case MX25Series_Command_BE32K:
+        case MX25Series_Command_BE64K:
+        {
+            uint32_t block = emu->command == MX25Series_Command_SE ? MX25Series_SECTOR_SIZE :
+                             emu->command == MX25Series_Command_BE32K ? MX25Series_BLOCK_32K_SIZE : MX25Series_BLOCK_64K_SIZE;
+            uint32_t max_time = emu->command == MX25Series_Command_SE ? timing->timing.tSE :
+                                emu->command == MX25Series_Command_BE32K ? timing->timing.tBE32K : timing->timing.tBE64K;
+            if(!wel || !address)
+            {
+                emu->counters.ignored_commands++;
+                break;
+            }
+            emu->counters.erases++;
+            MX25Series__emulator_set_busy(emu, max_time);
+            if(MX25Series__emulator_erase_failed(emu, (emu->address % size) & ~(block - 1), block))
+            {
+                break;
+            }
+            memset(emu->memory + ((emu->address % size) & ~(block - 1)), 0xFF, block);
+            break;
+        }
+        case MX25Series_Command_CE:
+        case MX25Series_Command_CE_Alternate:
+            if(!wel)
+            {
+                emu->counters.ignored_commands++;
+                break;
+            }
+            emu->counters.erases++;
+            MX25Series__emulator_set_busy(emu, timing->timing.tCE);
+            if(MX25Series__emulator_erase_failed(emu, 0, size))
+            {
+                break;
+            }
+            memset(emu->memory, 0xFF, size);
+            break;
+        case MX25Series_Command_WRSR:
+            if(!wel || emu->data_count == 0)
+            {
+                emu->counters.ignored_commands++;
+                break;
+            }
+            //WIP and WEL are read only.
+            emu->status_register = (emu->status_register & (MX25Series_SR_WIP | MX25Series_SR_WEL)) | (emu->data[0] & 0xFC);
+            if(emu->data_count >= 2)
+            {
+                emu->configuration_register = (emu->configuration_register & 0x00FF) | (emu->data[1] << 8);
+            }
+            if(emu->data_count >= 3)
+            {
+                emu->configuration_register = (emu->configuration_register & 0xFF00) | emu->data[2];
+            }
+            MX25Series__emulator_set_busy(emu, timing->timing.tWSR);
+            break;
+        case MX25Series_Command_WRSCUR:
+            if(!wel)
+            {
+                emu->counters.ignored_commands++;
+                break;
+            }
+            emu->security_register |= MX25Series_SCUR_LDSO;
+            MX25Series__emulator_set_busy(emu, timing->timing.tWSR);
+            break;
+        case MX25Series_Command_PGM_ERS_Suspend:
+        case MX25Series_Command_PGM_ERS_Suspend_Alternate:
+            if((emu->status_register & MX25Series_SR_WIP) == 0 || emu->suspended ||
+               emu->busy_command == MX25Series_Command_CE || emu->busy_command == MX25Series_Command_CE_Alternate ||
+               emu->busy_command == MX25Series_Command_WRSR)
+            {
+                break;
+            }
+            emu->suspended = true;
+            emu->suspended_remaining_ns = emu->busy_until_ns - *emu->clock_ns;
+            emu->status_register &= ~(MX25Series_SR_WIP | MX25Series_SR_WEL);
+            emu->security_register |= (emu->busy_command == MX25Series_Command_PP || emu->busy_command == MX25Series_Command_4PP) ?
+                                      MX25Series_SCUR_PSB : MX25Series_SCUR_ESB;
+            break;
+        case MX25Series_Command_PGM_ERS_Resume:
+        case MX25Series_Command_PGM_ERS_Resume_Alternate:
+            if(!emu->suspended)
+            {
+                break;
+            }
+            emu->suspended = false;
+            emu->busy_until_ns = *emu->clock_ns + emu->suspended_remaining_ns;
+            emu->status_register |= MX25Series_SR_WIP;
+            emu->security_register &= ~(MX25Series_SCUR_PSB | MX25Series_SCUR_ESB);
+            break;
+        case MX25Series_Command_DP:
+            emu->deep_power_down = true;
+            break;
+        case MX25Series_Command_RES:
+            if(emu->deep_power_down)
+            {
+                emu->standby_ns = *emu->clock_ns + (uint64_t)timing->timing.tRES1 * 1000;
+            }
+            emu->deep_power_down = false;
+            break;
+        default:
+            break;
+    }
+}
+
+MX25Series_status_enum_t MX25Series_emulator_init(MX25Series_Emulator_t *emu, MX25Series_Chip_Info_t *chip_def, const char *path)
+{
+    struct stat info;
+    bool fresh = true;
+
+    memset(emu, 0, sizeof(MX25Series_Emulator_t));
+    emu->chip_def = chip_def;
+    emu->fd = -1;
+    emu->clock_ns = &emu->own_clock_ns;
+    emu->bus_owner = &emu->own_bus_owner;
+    emu->spi_clock_hz = MX25Series_EMULATOR_SPI_CLOCK_HZ;
+    emu->latency_percent = 100;
+    emu->sfdp = emu->sfdp_image;
+    emu->sfdp_length = sizeof(emu->sfdp_image);
+
+    if(chip_def == NULL || chip_def->page_size == 0 || chip_def->page_size > sizeof(emu->page))
+    {
+        return MX25Series_status_error_invalid_chip_def;
+    }
+
+    if(path != NULL)
+    {
+        emu->fd = open(path, O_RDWR | O_CREAT, 0644);
+        if(emu->fd < 0)
+        {
+            return MX25Series_status_error;
+        }
+        fresh = fstat(emu->fd, &info) != 0 || info.st_size != (off_t)chip_def->memory_size;
+        if(fresh && ftruncate(emu->fd, chip_def->memory_size) != 0)
+        {
+            close(emu->fd);
+            emu->fd = -1;
+            return MX25Series_status_error;
+        }
+        emu->memory = mmap(NULL, chip_def->memory_size, PROT_READ | PROT_WRITE, MAP_SHARED, emu->fd, 0);
+    }
+    else
+    {
+        emu->memory = mmap(NULL, chip_def->memory_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    if(emu->memory == MAP_FAILED)
+    {
+        emu->memory = NULL;
+        if(emu->fd >= 0)
+        {
+            close(emu->fd);
+            emu->fd = -1;
+        }
+        return MX25Series_status_error;
+    }
+
+    if(fresh)
+    {
+        memset(emu->memory, 0xFF, chip_def->memory_size);
+    }
+    MX25Series_emulator_build_sfdp(chip_def, emu->sfdp_image);
+    return MX25Series_status_ok;
+}
+
+static void MX25Series__emulator_le32(uint8_t *bytes, uint32_t value)
+{
+    bytes[0] = value & 0xFF;
+    bytes[1] = (value >> 8) & 0xFF;
+    bytes[2] = (value >> 16) & 0xFF;
+    bytes[3] = (value >> 24) & 0xFF;
+}
+
+/**
+ * MX25Series__emulator_encode_time picks the smallest unit that fits time into a count_bits wide count, rounding
+ * the count up, and raises *multiplier until 2 * (multiplier + 1) times the encoded time covers max.
+ * Returns (units << count_bits) | (count - 1).
+ */
+static uint32_t MX25Series__emulator_encode_time(
+        uint32_t time,
+        uint32_t max,
+        const uint32_t *units,
+        uint8_t unit_count,
+        uint8_t count_bits,
+        uint8_t *multiplier)
+{
+    uint8_t unit = 0;
+    uint32_t count;
+
+    while(unit + 1 < unit_count && (time + units[unit] - 1) / units[unit] > (1ul << count_bits))
+    {
+        unit++;
+    }
+    count = (time + units[unit] - 1) / units[unit];
+    count = count == 0 ? 1 : (count > (1ul << count_bits) ? (1ul << count_bits) : count);
+
+    //The largest typical time may not be representable, stretch the shared multiplier instead.
+    while(*multiplier < 15 && (uint64_t)count * units[unit] * 2 * (*multiplier + 1) < max)
+    {
+        (*multiplier)++;
+    }
+    return ((uint32_t)unit << count_bits) | (count - 1);
+}
+
+void MX25Series_emulator_build_sfdp(MX25Series_Chip_Info_t *chip_def, uint8_t *sfdp)
+{
+    static const uint32_t erase_units[4] = {1000, 16000, 128000, 1000000};
+    static const uint32_t program_units[2] = {8, 64};
+    static const uint32_t byte_units[2] = {1, 8};
+    static const uint32_t chip_erase_units[4] = {16000, 256000, 4000000, 64000000};
+    static const uint32_t delay_units[4] = {128, 1000, 8000, 64000};
+    uint32_t dwords[16];
+    uint8_t page_bits = 0;
+    uint8_t erase_multiplier = 1;
+    uint8_t program_multiplier = 1;
+
+    while((2ul << page_bits) <= chip_def->page_size)
+    {
+        page_bits++;
+    }
+
+    memset(sfdp, 0xFF, MX25Series_EMULATOR_SFDP_SIZE);
+    memcpy(sfdp, "SFDP", 4);
+    sfdp[4] = 0x06; //JESD216B
+    sfdp[5] = 0x01;
+    sfdp[6] = 0x00; //One parameter header
+    sfdp[8] = 0x00; //BFPT
+    sfdp[9] = 0x06;
+    sfdp[10] = 0x01;
+    sfdp[11] = 16;
+    sfdp[12] = 0x30;
+    sfdp[13] = 0x00;
+    sfdp[14] = 0x00;
+    sfdp[15] = 0xFF;
+
+    //4 KB erase, 3 byte addressing, and the dual/quad fast reads the chip_def has dummy cycles for.
+    dwords[0] = 0xFF800000ul | (MX25Series_Command_SE << 8) | 0x04 | 0x01 |
+                (chip_def->dummy_cycles.dread ? (1ul << 16) : 0) | (chip_def->dummy_cycles.dual_io ? (1ul << 20) : 0) |
+                (chip_def->dummy_cycles.quad_io ? (1ul << 21) : 0) | (chip_def->dummy_cycles.qread ? (1ul << 22) : 0);
+    dwords[1] = chip_def->memory_size * 8 - 1;
+    dwords[2] = (chip_def->dummy_cycles.quad_io & 0x1F) | (MX25Series_Command_4READ << 8) |
+                ((uint32_t)(chip_def->dummy_cycles.qread & 0x1F) << 16) | ((uint32_t)MX25Series_Command_QREAD << 24);
+    dwords[3] = (chip_def->dummy_cycles.dread & 0x1F) | (MX25Series_Command_DREAD << 8) |
+                ((uint32_t)(chip_def->dummy_cycles.dual_io & 0x1F) << 16) | ((uint32_t)MX25Series_Command_2READ << 24);
+    dwords[4] = 0xFFFFFFEEul; //No 2-2-2 or 4-4-4
+    dwords[5] = 0x0000FFFFul;
+    dwords[6] = 0x0000FFFFul;
+    dwords[7] = 12 | (MX25Series_Command_SE << 8) | (15ul << 16) | ((uint32_t)MX25Series_Command_BE32K << 24);
+    dwords[8] = 16 | (MX25Series_Command_BE64K << 8);
+
+    //Maximum = 2 * (multiplier + 1) * typical, a multiplier of 1 unless a typical time does not fit.
+    dwords[9] = (MX25Series__emulator_encode_time(chip_def->timing.tSE / 4, chip_def->timing.tSE, erase_units, 4, 5, &erase_multiplier) << 4) |
+                (MX25Series__emulator_encode_time(chip_def->timing.tBE32K / 4, chip_def->timing.tBE32K, erase_units, 4, 5, &erase_multiplier) << 11) |
+                (MX25Series__emulator_encode_time(chip_def->timing.tBE64K / 4, chip_def->timing.tBE64K, erase_units, 4, 5, &erase_multiplier) << 18);
+    dwords[10] = ((uint32_t)page_bits << 4) |
+                 (MX25Series__emulator_encode_time(chip_def->timing.tPP / 4, chip_def->timing.tPP, program_units, 2, 5, &program_multiplier) << 8) |
+                 (MX25Series__emulator_encode_time(chip_def->timing.tBP / 4, chip_def->timing.tBP, byte_units, 2, 4, &program_multiplier) << 14) |
+                 (MX25Series__emulator_encode_time(chip_def->timing.tBP / 8, 0, byte_units, 2, 4, &program_multiplier) << 19) |
+                 (MX25Series__emulator_encode_time(chip_def->timing.tCE / 4, chip_def->timing.tCE, chip_erase_units, 4, 5, &erase_multiplier) << 24);
+    dwords[9] |= erase_multiplier;
+    dwords[10] |= program_multiplier;
+
+    //Suspend supported, latencies and resume to suspend intervals in 1 us and 64 us units.
+    dwords[11] = (((chip_def->timing.tSUS > 0 ? chip_def->timing.tSUS - 1 : 0) & 0x1F) << 24) | (1ul << 29) |
+                 ((((chip_def->timing.tRS + 63) / 64 - 1) & 0xF) << 20) |
+                 (((chip_def->timing.tSUS > 0 ? chip_def->timing.tSUS - 1 : 0) & 0x1F) << 13) | (1ul << 18) |
+                 ((((chip_def->timing.tRS + 63) / 64 - 1) & 0xF) << 9) | 0x80000000ul * (chip_def->timing.tSUS == 0);
+    //Suspend, resume, program suspend and program resume instructions, high byte first.
+    dwords[12] = ((uint32_t)MX25Series_Command_PGM_ERS_Suspend << 24) | ((uint32_t)MX25Series_Command_PGM_ERS_Resume << 16) |
+                 ((uint32_t)MX25Series_Command_PGM_ERS_Suspend << 8) | MX25Series_Command_PGM_ERS_Resume;
+    //Deep power-down with DP and RES, the exit delay in ns units.
+    dwords[13] = 0xFFFFFFF7ul;
+    if(chip_def->timing.tRES1 != 0)
+    {
+        uint8_t unused = 15;
+
+        dwords[13] = ((uint32_t)MX25Series_Command_DP << 23) | ((uint32_t)MX25Series_Command_RES << 15) |
+                     (MX25Series__emulator_encode_time(chip_def->timing.tRES1 * 1000, 0, delay_units, 4, 5, &unused) << 8) | 0xF7;
+    }
+    dwords[14] = 0xFFFFFFFFul;
+    dwords[15] = 0xFFFFFFFFul;
+
+    for(uint8_t i = 0; i < 16; i++)
+    {
+        MX25Series__emulator_le32(sfdp + 0x30 + 4 * i, dwords[i]);
+    }
+}
+
+void MX25Series_emulator_deinit(MX25Series_Emulator_t *emu)
+{
+    if(emu->memory != NULL)
+    {
+        if(emu->fd >= 0)
+        {
+            msync(emu->memory, emu->chip_def->memory_size, MS_SYNC);
+        }
+        munmap(emu->memory, emu->chip_def->memory_size);
+        emu->memory = NULL;
+    }
+    if(emu->fd >= 0)
+    {
+        close(emu->fd);
+        emu->fd = -1;
+    }
+}
+
+void MX25Series_emulator_reset_counters(MX25Series_Emulator_t *emu)
+{
+    memset(&emu->counters, 0, sizeof(emu->counters));
+}
+
+void MX25Series_emulator_power_cycle(MX25Series_Emulator_t *emu)
+{
+    emu->status_register &= ~(MX25Series_SR_WIP | MX25Series_SR_WEL);
+    emu->configuration_register &= ~MX25Series_CR_LH_MASK;
+    emu->security_register &= ~(MX25Series_SCUR_P_FAIL | MX25Series_SCUR_E_FAIL | MX25Series_SCUR_PSB | MX25Series_SCUR_ESB);
+    emu->suspended = false;
+    emu->deep_power_down = false;
+    emu->standby_ns = 0;
+    emu->busy_until_ns = *emu->clock_ns;
+    emu->phase = MX25Series_Emulator_Phase_Idle;
+    emu->fail_programs = 0;
+    emu->fail_erases = 0;
+    emu->fail_after = 0;
+}
+
+void MX25Series_emulator_share_bus(MX25Series_Emulator_t *emu, MX25Series_Emulator_t *other)
+{
+    emu->clock_ns = other->clock_ns;
+    emu->bus_owner = other->bus_owner;
+}
+
+uint64_t MX25Series_emulator_get_time_ns(MX25Series_Emulator_t *emu)
+{
+    return *emu->clock_ns;
+}
+
+MX25Series_status_enum_t MX25Series___issue_command(MX25Series_t *dev, MX25Series_COMMAND_enum_t command)
+{
+    MX25Series_Emulator_t *emu = MX25Series__emulator(dev);
+    bool accepted = true;
+
+    emu->counters.issue_command++;
+    MX25Series__emulator_call(emu);
+    MX25Series__emulator_clock_bytes(emu, 1, 1);
+
+    if(emu->phase != MX25Series_Emulator_Phase_Command)
+    {
+        emu->counters.framing_errors++;
+    }
+
+    MX25Series__emulator_update(emu);
+    emu->command = command;
+
+    if(emu->deep_power_down)
+    {
+        //Only RES wakes the chip.
+        accepted = command == MX25Series_Command_RES;
+    }
+    else if(*emu->clock_ns < emu->standby_ns)
+    {
+        //Still waking up, tRES1 has not elapsed.
+        accepted = false;
+    }
+    else if((emu->status_register & MX25Series_SR_WIP) != 0)
+    {
+        accepted = command == MX25Series_Command_RDSR || command == MX25Series_Command_RDSCUR ||
+                   command == MX25Series_Command_PGM_ERS_Suspend || command == MX25Series_Command_PGM_ERS_Suspend_Alternate;
+    }
+
+    if(accepted)
+    {
+        accepted = MX25Series__emulator_expect(emu, command);
+    }
+
+    if(!accepted)
+    {
+        emu->counters.ignored_commands++;
+        emu->command = 0;
+        emu->phase = MX25Series_Emulator_Phase_Data;
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series___write(MX25Series_t *dev, size_t length, uint8_t* buffer)
+{
+    MX25Series_Emulator_t *emu = MX25Series__emulator(dev);
+
+    emu->counters.write++;
+    emu->counters.bytes_written += length;
+    MX25Series__emulator_call(emu);
+    MX25Series__emulator_clock_bytes(emu, length, 1);
+    for(size_t i = 0; i < length; i++)
+    {
+        MX25Series__emulator_write_byte(emu, 1, buffer[i]);
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series___read(MX25Series_t *dev, size_t length, uint8_t* buffer)
+{
+    MX25Series_Emulator_t *emu = MX25Series__emulator(dev);
+
+    emu->counters.read++;
+    emu->counters.bytes_read += length;
+    MX25Series__emulator_call(emu);
+    MX25Series__emulator_clock_bytes(emu, length, 1);
+    for(size_t i = 0; i < length; i++)
+    {
+        buffer[i] = MX25Series__emulator_read_byte(emu, 1);
+    }
+    return MX25Series_status_ok;
+}
+
+#if defined(MX25Series_ENABLE_MULTI_IO)
+MX25Series_status_enum_t MX25Series___write_multi_io(MX25Series_t *dev, uint8_t lanes, size_t length, uint8_t* buffer)
+{
+    MX25Series_Emulator_t *emu = MX25Series__emulator(dev);
+
+    emu->counters.write++;
+    emu->counters.bytes_written += length;
+    MX25Series__emulator_call(emu);
+    MX25Series__emulator_clock_bytes(emu, length, lanes);
+    for(size_t i = 0; i < length; i++)
+    {
+        MX25Series__emulator_write_byte(emu, lanes, buffer[i]);
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series___read_multi_io(MX25Series_t *dev, uint8_t lanes, size_t length, uint8_t* buffer)
+{
+    MX25Series_Emulator_t *emu = MX25Series__emulator(dev);
+
+    emu->counters.read++;
+    emu->counters.bytes_read += length;
+    MX25Series__emulator_call(emu);
+    MX25Series__emulator_clock_bytes(emu, length, lanes);
+    for(size_t i = 0; i < length; i++)
+    {
+        buffer[i] = MX25Series__emulator_read_byte(emu, lanes);
+    }
+    return MX25Series_status_ok;
+}
+#endif
+
+#if defined(MX25Series_ENABLE_TRANSFER_HOOK)
+MX25Series_status_enum_t MX25Series___transfer(MX25Series_t *dev, MX25Series_Transaction_t *transaction)
+{
+    MX25Series_Emulator_t *emu = MX25Series__emulator(dev);
+    uint64_t clock_ns;
+
+    //Decode the frame through the per call functions, then charge a single call for the whole chain.
+    emu->counters.transfer++;
+    MX25Series___enable_cs_pin(dev, true);
+    MX25Series___issue_command(dev, (MX25Series_COMMAND_enum_t)transaction->command);
+    for(uint8_t i = 0; i < transaction->address_length; i++)
+    {
+        MX25Series__emulator_write_byte(emu, transaction->address_lanes, transaction->address[i]);
+    }
+    for(uint8_t i = 0; i < transaction->dummy_length; i++)
+    {
+        MX25Series__emulator_write_byte(emu, transaction->address_lanes, dev->transfer_dummy_byte);
+    }
+    MX25Series__emulator_clock_bytes(emu, transaction->address_length + transaction->dummy_length, transaction->address_lanes);
+    for(uint8_t i = 0; i < transaction->segment_count; i++)
+    {
+        MX25Series_Segment_t *segment = &transaction->segments[i];
+        for(size_t j = 0; j < segment->length; j++)
+        {
+            if(segment->direction == MX25Series_Segment_TX)
+            {
+                MX25Series__emulator_write_byte(emu, segment->lanes, segment->buffer[j]);
+            }
+            else
+            {
+                segment->buffer[j] = MX25Series__emulator_read_byte(emu, segment->lanes);
+            }
+        }
+        MX25Series__emulator_clock_bytes(emu, segment->length, segment->lanes);
+        if(segment->direction == MX25Series_Segment_TX)
+        {
+            emu->counters.bytes_written += segment->length;
+        }
+        else
+        {
+            emu->counters.bytes_read += segment->length;
+        }
+    }
+    emu->counters.bytes_written += transaction->address_length + transaction->dummy_length;
+
+    //Undo the overhead charged by the nested calls.
+    clock_ns = *emu->clock_ns;
+    MX25Series___enable_cs_pin(dev, false);
+    *emu->clock_ns = clock_ns - 2 * emu->call_overhead_ns;
+    emu->counters.cs -= 2;
+    emu->counters.issue_command--;
+    return MX25Series_status_ok;
+}
+#endif
+
+void MX25Series___enable_cs_pin(MX25Series_t *dev, bool value)
+{
+    MX25Series_Emulator_t *emu = MX25Series__emulator(dev);
+
+    emu->counters.cs++;
+    MX25Series__emulator_call(emu);
+
+    if(value)
+    {
+        if(emu->phase != MX25Series_Emulator_Phase_Idle)
+        {
+            emu->counters.framing_errors++;
+        }
+        if(*emu->bus_owner != NULL && *emu->bus_owner != emu)
+        {
+            emu->counters.bus_conflicts++;
+        }
+        *emu->bus_owner = emu;
+        emu->phase = MX25Series_Emulator_Phase_Command;
+        emu->command = 0;
+        emu->address = 0;
+        emu->address_bytes = 0;
+        emu->dummy_bytes = 0;
+        emu->data_count = 0;
+        memset(emu->page, 0xFF, sizeof(emu->page));
+        memset(emu->page_touched, 0, sizeof(emu->page_touched));
+        return;
+    }
+
+    if(emu->phase == MX25Series_Emulator_Phase_Idle)
+    {
+        //CS released without being asserted, MX25Series_init does this.
+        return;
+    }
+
+    if(*emu->bus_owner == emu)
+    {
+        *emu->bus_owner = NULL;
+    }
+
+    emu->counters.frames++;
+    if(emu->phase != MX25Series_Emulator_Phase_Command)
+    {
+        MX25Series__emulator_execute(emu);
+    }
+    emu->phase = MX25Series_Emulator_Phase_Idle;
+}
+
+void MX25Series___enable_reset_pin(MX25Series_t *dev, bool value)
+{
+    MX25Series_Emulator_t *emu = MX25Series__emulator(dev);
+
+    MX25Series__emulator_call(emu);
+    if(value)
+    {
+        //Reset abandons any operation in progress and wakes the chip.
+        emu->status_register &= ~(MX25Series_SR_WIP | MX25Series_SR_WEL);
+        emu->security_register &= ~(MX25Series_SCUR_PSB | MX25Series_SCUR_ESB);
+        emu->suspended = false;
+        emu->deep_power_down = false;
+        emu->phase = MX25Series_Emulator_Phase_Idle;
+    }
+}
+
+void MX25Series___enable_write_protect_pin(MX25Series_t *dev, bool value)
+{
+    //WP# is not emulated.
+    (void)value;
+    MX25Series__emulator_call(MX25Series__emulator(dev));
+}
+
+bool MX25Series___test_linker(MX25Series_t *dev)
+{
+    return dev->ctx != NULL;
+}
+
+void MX25Series___delay_micro_second(MX25Series_t *dev, unsigned int us)
+{
+    MX25Series_Emulator_t *emu = MX25Series__emulator(dev);
+
+    emu->counters.delay++;
+    *emu->clock_ns += (uint64_t)us * 1000ull;
+}
+
+uint32_t MX25Series___get_micro_seconds(MX25Series_t *dev)
+{
+    MX25Series_Emulator_t *emu = MX25Series__emulator(dev);
+
+    MX25Series__emulator_call(emu);
+    return (uint32_t)(*emu->clock_ns / 1000ull);
+}
@@ -0,0 +1,175 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+#ifndef FLASH_MX25Series_Emulator_H
+#define FLASH_MX25Series_Emulator_H
+
+#include "MX25Series.h"
+
+// A host side emulation of a MX25-Series chip that implements the platform specific functions of this library,
+// so it can be exercised and benchmarked without hardware. Link this file instead of a platform implementation
+// and pass a MX25Series_Emulator_t as the ctx argument of MX25Series_init.
+//
+// Time is virtual: MX25Series___delay_micro_second advances the clock instead of sleeping, every SPI transfer
+// advances it by the time the bytes take at spi_clock_hz and every platform function call by call_overhead_ns.
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define MX25Series_EMULATOR_SPI_CLOCK_HZ 8000000ul /**! Default SPI clock */
+#define MX25Series_EMULATOR_SFDP_SIZE 0x70          /**! SFDP header, one parameter header and a 16 DWORD BFPT at 0x30 */
+
+typedef enum {
+    MX25Series_Emulator_Phase_Idle = 0,    /**< CS is high */
+    MX25Series_Emulator_Phase_Command,     /**< CS is low, waiting for the command */
+    MX25Series_Emulator_Phase_Address,     /**< Receiving the 24-bit address */
+    MX25Series_Emulator_Phase_Dummy,       /**< Receiving dummy cycles */
+    MX25Series_Emulator_Phase_Data,        /**< Transferring data */
+} MX25Series_Emulator_Phase_enum_t;
+
+typedef struct
+{
+    MX25Series_Chip_Info_t *chip_def;             /**! Geometry, identification and timing while CR L/H is clear */
+    MX25Series_Chip_Info_t *chip_def_high_performance; /**! Timing while CR L/H is set, NULL to use chip_def */
+    uint8_t *memory;                              /**! chip_def->memory_size bytes, mmap'd */
+    int fd;                                       /**! Backing file, -1 for anonymous memory */
+
+    uint64_t own_clock_ns;
+    uint64_t *clock_ns;                           /**! Virtual time, may be shared between emulators on one bus */
+    void *own_bus_owner;
+    void **bus_owner;                             /**! Emulator with CS asserted, shared between emulators on one bus */
+    uint32_t spi_clock_hz;
+    uint32_t call_overhead_ns;                    /**! Cost of every platform function call */
+    uint8_t latency_percent;                      /**! Program/erase time as a percentage of the chip_def maximum */
+    uint32_t fail_programs;                       /**! Number of upcoming programs that fail with P_FAIL set */
+    uint32_t fail_erases;                         /**! Number of upcoming erases that fail with E_FAIL set */
+    uint32_t fail_after;                          /**! Programs and erases that succeed before fail_programs and fail_erases apply */
+    bool fail_torn;                               /**! A failing program or erase does the first half of its work, as one cut short by a power loss */
+
+    //Chip state
+    uint8_t status_register;
+    uint16_t configuration_register;              /**! CR1 in the high byte */
+    uint8_t security_register;
+    const uint8_t *sfdp;                          /**! SFDP area served by RDSFDP, defaults to sfdp_image */
+    size_t sfdp_length;
+    uint8_t sfdp_image[MX25Series_EMULATOR_SFDP_SIZE];
+    bool deep_power_down;
+    uint64_t standby_ns;                          /**! Commands are ignored until this time after RES, tRES1 */
+    bool suspended;
+    uint64_t busy_until_ns;
+    uint64_t suspended_remaining_ns;
+    uint8_t busy_command;
+
+    //Current CS frame
+    MX25Series_Emulator_Phase_enum_t phase;
+    uint8_t command;
+    uint32_t address;
+    uint8_t address_bytes;
+    uint8_t dummy_bytes;
+    uint8_t expected_address_lanes;
+    uint8_t expected_data_lanes;
+    uint8_t expected_dummy_bytes;
+    uint32_t data_count;
+    uint8_t data[4];                              /**! Register bytes of WRSR */
+    uint8_t page[512];                            /**! Page data of PP/4PP */
+    bool page_touched[512];
+
+    struct{
+        uint32_t issue_command;
+        uint32_t write;
+        uint32_t read;
+        uint32_t cs;
+        uint32_t transfer;                        /**! MX25Series___transfer calls, with MX25Series_ENABLE_TRANSFER_HOOK */
+        uint32_t delay;
+        uint32_t frames;
+        uint64_t bytes_written;
+        uint64_t bytes_read;
+        uint32_t programs;
+        uint32_t erases;
+        uint32_t framing_errors;                  /**! Frames with a wrong lane count, dummy count or ordering */
+        uint32_t ignored_commands;                /**! Commands dropped because of WIP, WEL, QE or deep power-down */
+        uint32_t bus_conflicts;                   /**! CS asserted while another emulator on the bus had its CS asserted */
+    }counters;
+} MX25Series_Emulator_t;
+
+/**
+ * MX25Series_emulator_init creates an emulated chip.
+ * @param emu the emulator structure to initialise.
+ * @param chip_def the chip to emulate.
+ * @param path a file to mmap as the memory array, created and erased to 0xFF if it is new or the wrong size,
+ * NULL for anonymous memory.
+ * @return MX25Series_status_error if the memory could not be mapped.
+ */
+MX25Series_status_enum_t MX25Series_emulator_init(MX25Series_Emulator_t *emu, MX25Series_Chip_Info_t *chip_def, const char *path);
+
+/**
+ * MX25Series_emulator_deinit flushes and unmaps the memory array.
+ * @param emu the emulator structure.
+ */
+void MX25Series_emulator_deinit(MX25Series_Emulator_t *emu);
+
+/**
+ * MX25Series_emulator_reset_counters zeroes the platform call and transfer counters.
+ * @param emu the emulator structure.
+ */
+void MX25Series_emulator_reset_counters(MX25Series_Emulator_t *emu);
+
+/**
+ * MX25Series_emulator_power_cycle turns the emulated chip off and on again. The memory array and the non-volatile
+ * register bits are kept, an operation in progress is abandoned and pending failures are cancelled. Together with
+ * fail_after and fail_torn it models a power loss at any program or erase.
+ * @param emu the emulator structure.
+ */
+void MX25Series_emulator_power_cycle(MX25Series_Emulator_t *emu);
+
+/**
+ * MX25Series_emulator_build_sfdp writes a JESD216B SFDP area describing chip_def: density, page size, the
+ * 4K/32K/64K erase types, the read modes with non zero dummy cycles, and typical times of a quarter of the
+ * chip_def maximums.
+ * @param chip_def the chip definition to describe.
+ * @param sfdp MX25Series_EMULATOR_SFDP_SIZE bytes.
+ */
+void MX25Series_emulator_build_sfdp(MX25Series_Chip_Info_t *chip_def, uint8_t *sfdp);
+
+/**
+ * MX25Series_emulator_share_bus puts emu on the same simulated SPI bus as other: one clock, and a bus conflict
+ * is counted whenever both assert CS at once.
+ * @param emu the emulator structure to join the bus.
+ * @param other an emulator already on the bus.
+ */
+void MX25Series_emulator_share_bus(MX25Series_Emulator_t *emu, MX25Series_Emulator_t *other);
+
+/**
+ * MX25Series_emulator_get_time_ns returns the virtual time.
+ * @param emu the emulator structure.
+ * @return nano-seconds since MX25Series_emulator_init.
+ */
+uint64_t MX25Series_emulator_get_time_ns(MX25Series_Emulator_t *emu);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_Emulator_H
@@ -0,0 +1,1797 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+/**
+ * MX25Series_Tests checks the library against the host emulator in extras/emulator. Every test starts from a
+ * freshly erased emulated chip. A failed check prints its line, and the exit status is non zero if any check
+ * failed. Tests can be selected by passing their names.
+ */
+
+#include "MX25Series.h"
+#include "MX25Series_Async.h"
+#include "MX25Series_Bus.h"
+#include "MX25Series_Cache.h"
+#include "MX25Series_FTL.h"
+#include "MX25Series_Image.h"
+#include "MX25Series_Journal.h"
+#include "MX25Series_Log.h"
+#include "MX25Series_Power.h"
+#include "MX25Series_SFDP.h"
+#include "MX25Series_Statistics.h"
+#include "MX25Series_Stripe.h"
+#include "MX25Series_Write_Buffer.h"
+#include "MX25Series_Emulator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+    MX25Series_Emulator_t emulator;
+    MX25Series_t dev;
+    const char *name;
+    uint32_t checks;
+    uint32_t failures;
+} MX25Series_Test_t;
+
+typedef void (*MX25Series_Test_Function_t)(MX25Series_Test_t *test);
+
+#define MX25Series_TEST_CHECK(test, condition) MX25Series__test_check((test), (condition), #condition, __LINE__)
+
+static void MX25Series__test_check(MX25Series_Test_t *test, bool passed, const char *condition, int line)
+{
+    test->checks++;
+    if(!passed)
+    {
+        test->failures++;
+        printf("%s:%d: %s failed\n", test->name, line, condition);
+    }
+}
+
+static bool MX25Series__test_setup(MX25Series_Test_t *test, MX25Series_Chip_Info_t *chip_def)
+{
+    if(MX25Series_HAS_ERROR(MX25Series_emulator_init(&test->emulator, chip_def, NULL)))
+    {
+        return false;
+    }
+    MX25Series_init(&test->dev, chip_def, 0, 0, 0, 0, &test->emulator);
+    return true;
+}
+
+static void MX25Series__test_pattern(uint8_t *buffer, size_t length, uint32_t seed)
+{
+    //xorshift32, any pattern that is not constant will do.
+    uint32_t x = seed | 1;
+
+    for(size_t i = 0; i < length; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buffer[i] = (uint8_t)x;
+    }
+}
+
+/**
+ * MX25Series__test_power_cut makes the program or erase after the next count fail, as if the power was lost, part
+ * way through it if torn is set.
+ */
+static void MX25Series__test_power_cut(MX25Series_Test_t *test, uint32_t count, bool torn)
+{
+    test->emulator.fail_after = count;
+    test->emulator.fail_programs = 1;
+    test->emulator.fail_erases = 1;
+    test->emulator.fail_torn = torn;
+}
+
+/**
+ * MX25Series__test_power_cycle turns the emulated chip off and on, and sets dev up again as a reset would.
+ */
+static void MX25Series__test_power_cycle(MX25Series_Test_t *test)
+{
+    MX25Series_emulator_power_cycle(&test->emulator);
+    MX25Series_init(&test->dev, test->dev.chip_def, 0, 0, 0, 0, &test->emulator);
+}
+
+/**
+ * MX25Series__test_read_mode reads back data written earlier in one read mode.
+ */
+static void MX25Series__test_read_mode(MX25Series_Test_t *test, MX25Series_Read_Mode_enum_t mode, uint8_t *expected, size_t length)
+{
+    uint8_t buffer[1024];
+    uint32_t framing_errors = test->emulator.counters.framing_errors;
+
+    memset(buffer, 0, sizeof(buffer));
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data_mode(&test->dev, mode, 3, length, buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(buffer, expected, length) == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == framing_errors);
+}
+
+static void MX25Series__test_read_modes(MX25Series_Test_t *test)
+{
+    uint8_t pattern[1024];
+    uint8_t buffer[1024];
+
+    MX25Series__test_pattern(pattern, sizeof(pattern), 0x5EED);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&test->dev, 3, sizeof(pattern), pattern) == MX25Series_status_ok);
+
+    MX25Series__test_read_mode(test, MX25Series_Read_Mode_READ, pattern, sizeof(pattern));
+    MX25Series__test_read_mode(test, MX25Series_Read_Mode_FAST_READ, pattern, sizeof(pattern));
+#if defined(MX25Series_ENABLE_MULTI_IO)
+    MX25Series__test_read_mode(test, MX25Series_Read_Mode_DREAD, pattern, sizeof(pattern));
+    MX25Series__test_read_mode(test, MX25Series_Read_Mode_2READ, pattern, sizeof(pattern));
+
+    //QREAD and 4READ are refused without sending a frame while QE is clear, a single lane read still works.
+    MX25Series_TEST_CHECK(test, MX25Series_set_quad_enable(&test->dev, false) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data_mode(&test->dev, MX25Series_Read_Mode_QREAD, 3, sizeof(buffer), buffer) ==
+                                MX25Series_status_error_unsupported);
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data_mode(&test->dev, MX25Series_Read_Mode_4READ, 3, sizeof(buffer), buffer) ==
+                                MX25Series_status_error_unsupported);
+    MX25Series_TEST_CHECK(test, MX25Series_set_read_mode(&test->dev, MX25Series_Read_Mode_QREAD) == MX25Series_status_error_unsupported);
+    MX25Series__test_read_mode(test, MX25Series_Read_Mode_FAST_READ, pattern, sizeof(pattern));
+
+    MX25Series_TEST_CHECK(test, MX25Series_set_quad_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series__test_read_mode(test, MX25Series_Read_Mode_QREAD, pattern, sizeof(pattern));
+    MX25Series__test_read_mode(test, MX25Series_Read_Mode_4READ, pattern, sizeof(pattern));
+
+    //DC selects the longer dummy cycle counts of 2READ and 4READ.
+    MX25Series_TEST_CHECK(test, MX25Series_set_write_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_configure_chip(&test->dev, MX25Series_SR_QE_MASK, MX25Series_CR_DC_MASK) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_wait_for_operation(&test->dev) == MX25Series_status_ok);
+    MX25Series__test_read_mode(test, MX25Series_Read_Mode_2READ, pattern, sizeof(pattern));
+    MX25Series__test_read_mode(test, MX25Series_Read_Mode_4READ, pattern, sizeof(pattern));
+#else
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data_mode(&test->dev, MX25Series_Read_Mode_DREAD, 3, sizeof(buffer), buffer) ==
+                                MX25Series_status_error_unsupported);
+#endif
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+/**
+ * MX25Series__test_program writes pattern at memory_address with mode and returns the emulated time it took.
+ */
+static uint64_t MX25Series__test_program(MX25Series_Test_t *test, MX25Series_Program_Mode_enum_t mode, uint32_t memory_address,
+                                         uint8_t *pattern, size_t length)
+{
+    uint64_t start;
+
+    MX25Series_TEST_CHECK(test, MX25Series_set_program_mode(&test->dev, mode) == MX25Series_status_ok);
+    start = MX25Series_emulator_get_time_ns(&test->emulator);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&test->dev, memory_address, length, pattern) == MX25Series_status_ok);
+    return MX25Series_emulator_get_time_ns(&test->emulator) - start;
+}
+
+static void MX25Series__test_program_modes(MX25Series_Test_t *test)
+{
+    uint8_t pattern[1024];
+    uint8_t single[1024];
+    uint8_t quad[1024];
+    uint64_t single_ns;
+    uint64_t quad_ns;
+
+    //An unaligned start so both commands wrap pages the same way.
+    MX25Series__test_pattern(pattern, sizeof(pattern), 0x4AA);
+    single_ns = MX25Series__test_program(test, MX25Series_Program_Mode_PP, 0x1010, pattern, sizeof(pattern));
+    MX25Series_TEST_CHECK(test, MX25Series_set_quad_enable(&test->dev, true) == MX25Series_status_ok);
+    quad_ns = MX25Series__test_program(test, MX25Series_Program_Mode_4PP, 0x2010, pattern, sizeof(pattern));
+
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data(&test->dev, true, 0x1010, sizeof(single), single) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data(&test->dev, true, 0x2010, sizeof(quad), quad) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(single, pattern, sizeof(pattern)) == 0);
+    MX25Series_TEST_CHECK(test, memcmp(quad, single, sizeof(single)) == 0);
+#if defined(MX25Series_ENABLE_MULTI_IO)
+    //4PP sends the address and data on four lanes, so it must have been quicker.
+    MX25Series_TEST_CHECK(test, quad_ns < single_ns);
+#else
+    (void)single_ns;
+    (void)quad_ns;
+#endif
+
+    //With QE clear the emulator ignores 4PP, so the data only arrives if PP was used instead.
+    MX25Series_TEST_CHECK(test, MX25Series_set_quad_enable(&test->dev, false) == MX25Series_status_ok);
+    MX25Series__test_program(test, MX25Series_Program_Mode_4PP, 0x3010, pattern, sizeof(pattern));
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data(&test->dev, true, 0x3010, sizeof(quad), quad) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(quad, pattern, sizeof(pattern)) == 0);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+/**
+ * MX25Series__test_cache_list returns the list of the resident line holding tag, -1 if there is none.
+ */
+static int MX25Series__test_cache_list(MX25Series_Cache_t *cache, uint32_t tag)
+{
+    for(size_t i = 0; i < cache->line_count; i++)
+    {
+        if(cache->lines[i].tag == tag)
+        {
+            return cache->lines[i].list;
+        }
+    }
+    return -1;
+}
+
+static void MX25Series__test_cache(MX25Series_Test_t *test)
+{
+    static uint8_t pattern[0x5000];
+    static uint8_t data[4 * 256];
+    static uint8_t sequential[3 * 256];
+    MX25Series_Cache_Line_t lines[4];
+    MX25Series_Cache_Line_t ghosts[4];
+    MX25Series_Cache_t cache;
+    uint8_t buffer[256];
+    uint8_t update[16];
+
+    MX25Series__test_pattern(pattern, sizeof(pattern), 0x71);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&test->dev, 0, sizeof(pattern), pattern) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_cache_init(&cache, &test->dev, MX25Series_Cache_Policy_LRU, 256, 4, lines, NULL, data) ==
+                                MX25Series_status_ok);
+    cache.prefetch = false;
+
+    //A miss loads the line, the next read of it is a hit.
+    MX25Series_TEST_CHECK(test, MX25Series_cache_read(&cache, 0x110, 16, buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_cache_read(&cache, 0x100, 256, buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(buffer, pattern + 0x100, 256) == 0);
+    MX25Series_TEST_CHECK(test, cache.stats.misses == 1 && cache.stats.hits == 1);
+
+    //Writing through the device drops the line, the next read sees the new data.
+    for(size_t i = 0; i < sizeof(update); i++)
+    {
+        update[i] = pattern[0x110 + i] & 0x0F;
+    }
+    memcpy(pattern + 0x110, update, sizeof(update));
+    MX25Series_TEST_CHECK(test, MX25Series_set_write_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data(&test->dev, 0x110, sizeof(update), update) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_wait_for_operation(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, cache.stats.invalidations == 1);
+    MX25Series_TEST_CHECK(test, MX25Series_cache_read(&cache, 0x100, 256, buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(buffer, pattern + 0x100, 256) == 0);
+    MX25Series_TEST_CHECK(test, cache.stats.misses == 2);
+
+    //So does an erase of the sector holding it.
+    memset(pattern, 0xFF, MX25Series_SECTOR_SIZE);
+    MX25Series_TEST_CHECK(test, MX25Series_set_write_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_erase(&test->dev, MX25Series_Erase_Block_4K, 0) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_wait_for_operation(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, cache.stats.invalidations == 2);
+    MX25Series_TEST_CHECK(test, MX25Series_cache_read(&cache, 0x100, 256, buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(buffer, pattern + 0x100, 256) == 0);
+    MX25Series_TEST_CHECK(test, cache.stats.misses == 3);
+
+    //Once four lines are in use a fifth evicts the least recently used one.
+    MX25Series_cache_invalidate(&cache, 0, test->dev.chip_def->memory_size);
+    MX25Series_cache_reset_stats(&cache);
+    for(uint32_t memory_address = 0x1000; memory_address <= 0x1800; memory_address += 0x200)
+    {
+        MX25Series_TEST_CHECK(test, MX25Series_cache_read(&cache, memory_address, 256, buffer) == MX25Series_status_ok);
+        MX25Series_TEST_CHECK(test, memcmp(buffer, pattern + memory_address, 256) == 0);
+    }
+    MX25Series_TEST_CHECK(test, cache.stats.misses == 5 && cache.stats.evictions == 1);
+    MX25Series_TEST_CHECK(test, MX25Series__test_cache_list(&cache, 0x1000) == -1);
+    MX25Series_TEST_CHECK(test, MX25Series__test_cache_list(&cache, 0x1200) != -1);
+
+    //From the second line of a sequential read on, the following line is brought in ahead of time.
+    cache.prefetch = true;
+    MX25Series_cache_reset_stats(&cache);
+    MX25Series_TEST_CHECK(test, MX25Series_cache_read(&cache, 0x4000, sizeof(sequential), sequential) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(sequential, pattern + 0x4000, sizeof(sequential)) == 0);
+    MX25Series_TEST_CHECK(test, cache.stats.prefetches == 2);
+    MX25Series_TEST_CHECK(test, cache.stats.misses == 2 && cache.stats.hits == 1);
+    MX25Series_TEST_CHECK(test, MX25Series__test_cache_list(&cache, 0x4300) != -1);
+    MX25Series_cache_deinit(&cache);
+    MX25Series_TEST_CHECK(test, test->dev.cache == NULL);
+
+    //ARC: a line read twice is frequent, the next new line evicts the oldest line seen once into the ghosts, and
+    //reading that one again brings it back as frequent.
+    MX25Series_TEST_CHECK(test, MX25Series_cache_init(&cache, &test->dev, MX25Series_Cache_Policy_ARC, 256, 4, lines, ghosts, data) ==
+                                MX25Series_status_ok);
+    cache.prefetch = false;
+    for(uint32_t memory_address = 0x1000; memory_address <= 0x1600; memory_address += 0x200)
+    {
+        MX25Series_TEST_CHECK(test, MX25Series_cache_read(&cache, memory_address, 256, buffer) == MX25Series_status_ok);
+        if(memory_address == 0x1000)
+        {
+            MX25Series_TEST_CHECK(test, MX25Series_cache_read(&cache, memory_address, 256, buffer) == MX25Series_status_ok);
+        }
+    }
+    MX25Series_TEST_CHECK(test, MX25Series__test_cache_list(&cache, 0x1000) == MX25Series_Cache_List_T2);
+    MX25Series_TEST_CHECK(test, MX25Series__test_cache_list(&cache, 0x1200) == MX25Series_Cache_List_T1);
+    MX25Series_TEST_CHECK(test, MX25Series_cache_read(&cache, 0x1800, 256, buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series__test_cache_list(&cache, 0x1200) == -1);
+    MX25Series_TEST_CHECK(test, cache.stats.evictions == 1);
+    MX25Series_TEST_CHECK(test, MX25Series_cache_read(&cache, 0x1200, 256, buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(buffer, pattern + 0x1200, 256) == 0);
+    MX25Series_TEST_CHECK(test, MX25Series__test_cache_list(&cache, 0x1200) == MX25Series_Cache_List_T2);
+    MX25Series_TEST_CHECK(test, cache.target_t1 == 1);
+    MX25Series_TEST_CHECK(test, cache.stats.misses == 6 && cache.stats.hits == 1 && cache.stats.evictions == 2);
+    MX25Series_cache_deinit(&cache);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+static void MX25Series__test_write_buffer(MX25Series_Test_t *test)
+{
+    static uint8_t pattern[0x400];
+    static uint8_t expected[0x400];
+    static uint8_t data[2 * 256];
+    MX25Series_Write_Buffer_Page_t pages[2];
+    MX25Series_Write_Buffer_t buffer;
+    uint8_t read[0x400];
+    uint32_t programs = test->emulator.counters.programs;
+
+    MX25Series__test_pattern(pattern, sizeof(pattern), 0x81);
+    memset(expected, 0xFF, sizeof(expected));
+    //The deadline is well past the time a Page Program takes, so evicting a page does not age the others out.
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_init(&buffer, &test->dev, pages, 2, data, 50000) == MX25Series_status_ok);
+
+    //A partial page stays buffered, reads see it before the chip does.
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_write(&buffer, 0x10, 100, pattern + 0x10) == MX25Series_status_ok);
+    memcpy(expected + 0x10, pattern + 0x10, 100);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.programs == programs);
+    MX25Series_TEST_CHECK(test, test->emulator.memory[0x10] == 0xFF);
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data(&test->dev, true, 0, 0x100, read) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(read, expected, 0x100) == 0);
+
+    //Completing the page programs it in one Page Program.
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_write(&buffer, 0, 0x10, pattern) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_write(&buffer, 0x74, 0x8C, pattern + 0x74) == MX25Series_status_ok);
+    memcpy(expected, pattern, 0x100);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.programs == programs + 1);
+    MX25Series_TEST_CHECK(test, buffer.stats.flushes == 1 && buffer.stats.writes == 3);
+    MX25Series_TEST_CHECK(test, memcmp(test->emulator.memory, expected, 0x100) == 0);
+
+    //A third page evicts the one that has waited the longest.
+    for(uint32_t memory_address = 0x100; memory_address < 0x400; memory_address += 0x100)
+    {
+        MX25Series_TEST_CHECK(test, MX25Series_write_buffer_write(&buffer, memory_address + 8, 16, pattern + memory_address + 8) == MX25Series_status_ok);
+        memcpy(expected + memory_address + 8, pattern + memory_address + 8, 16);
+        MX25Series___delay_micro_second(&test->dev, 10);
+    }
+    MX25Series_TEST_CHECK(test, buffer.stats.flushes == 2);
+    MX25Series_TEST_CHECK(test, memcmp(test->emulator.memory + 0x100, expected + 0x100, 0x100) == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.memory[0x208] == 0xFF && test->emulator.memory[0x308] == 0xFF);
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data_mode(&test->dev, test->dev.read_mode, 0, sizeof(read), read) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(read, expected, sizeof(read)) == 0);
+
+    //The rest go out once they pass the deadline.
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_poll(&buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, buffer.stats.flushes == 2);
+    MX25Series___delay_micro_second(&test->dev, 50000);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_poll(&buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, buffer.stats.flushes == 4);
+    MX25Series_TEST_CHECK(test, memcmp(test->emulator.memory, expected, sizeof(expected)) == 0);
+
+    //An erase drops the buffered data of its sector, nothing is left to program.
+    programs = test->emulator.counters.programs;
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_write(&buffer, 0x1010, 16, pattern) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_set_write_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_erase(&test->dev, MX25Series_Erase_Block_4K, 0x1000) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_wait_for_operation(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data(&test->dev, true, 0x1000, 0x100, read) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, read[0x10] == 0xFF && read[0x1F] == 0xFF);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_deinit(&buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.programs == programs);
+    MX25Series_TEST_CHECK(test, test->dev.write_buffer == NULL);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+static void MX25Series__test_power(MX25Series_Test_t *test)
+{
+    static uint8_t pattern[0x8000];
+    MX25Series_Power_t power;
+    uint16_t configuration_register = 0;
+    uint32_t program_time, erase_time;
+
+    //The emulator times operations from the table of the mode CR L/H selects.
+    test->emulator.chip_def_high_performance = &MX25R6435F_Chip_Def_High_Performance;
+    MX25Series_TEST_CHECK(test, MX25Series_power_init(&power, &test->dev, &MX25R6435F_Chip_Def_Low_Power,
+                                                      &MX25R6435F_Chip_Def_High_Performance, MX25Series_Power_Policy_Bulk) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, !power.high && test->dev.chip_def == &MX25R6435F_Chip_Def_Low_Power);
+
+    //A Page Program is no faster in high performance, however much is written.
+    MX25Series__test_pattern(pattern, sizeof(pattern), 0x93);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&test->dev, 0x20000, sizeof(pattern), pattern) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, !power.high && power.switches == 0);
+    MX25Series_TEST_CHECK(test, memcmp(test->emulator.memory + 0x20000, pattern, sizeof(pattern)) == 0);
+
+    //Nor is a Sector Erase, and a short range is below the threshold anyway.
+    MX25Series_TEST_CHECK(test, MX25Series_erase_range(&test->dev, 0x40000, 0x1000) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, !power.high && power.switches == 0);
+    program_time = test->dev.observed_time[MX25Series_Operation_Program];
+    erase_time = test->dev.observed_time[MX25Series_Operation_Erase_4K];
+    MX25Series_TEST_CHECK(test, program_time != 0 && erase_time != 0);
+
+    //A bulk erase switches first, and the times learnt in low power are put aside.
+    MX25Series_TEST_CHECK(test, MX25Series_erase_range(&test->dev, 0x50000, 0x8000) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, power.high && power.switches == 1);
+    MX25Series_TEST_CHECK(test, test->dev.chip_def == &MX25R6435F_Chip_Def_High_Performance);
+    MX25Series_TEST_CHECK(test, MX25Series_read_configuration_register(&test->dev, &configuration_register) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, (configuration_register & MX25Series_CR_LH_MASK) != 0);
+    MX25Series_TEST_CHECK(test, power.observed_time[MX25Series_Operation_Program] == program_time);
+    MX25Series_TEST_CHECK(test, power.observed_time[MX25Series_Operation_Erase_4K] == erase_time);
+    MX25Series_TEST_CHECK(test, test->dev.observed_time[MX25Series_Operation_Program] == 0);
+    MX25Series_TEST_CHECK(test, test->dev.observed_time[MX25Series_Operation_Erase_32K] != 0);
+    MX25Series_TEST_CHECK(test, test->emulator.memory[0x50000] == 0xFF && test->emulator.memory[0x57FFF] == 0xFF);
+
+    //Back to low power once idle for idle_time after the erase, not after the request for it.
+    MX25Series_TEST_CHECK(test, MX25Series_power_tick(&power) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, power.high);
+    MX25Series___delay_micro_second(&test->dev, power.idle_time / 2);
+    MX25Series_TEST_CHECK(test, MX25Series_power_tick(&power) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, power.high);
+    MX25Series___delay_micro_second(&test->dev, power.idle_time / 2);
+    MX25Series_TEST_CHECK(test, MX25Series_power_tick(&power) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, !power.high && power.switches == 2);
+    MX25Series_TEST_CHECK(test, test->dev.chip_def == &MX25R6435F_Chip_Def_Low_Power);
+    MX25Series_TEST_CHECK(test, MX25Series_read_configuration_register(&test->dev, &configuration_register) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, (configuration_register & MX25Series_CR_LH_MASK) == 0);
+    MX25Series_TEST_CHECK(test, test->dev.observed_time[MX25Series_Operation_Program] == program_time);
+    MX25Series_TEST_CHECK(test, test->dev.observed_time[MX25Series_Operation_Erase_4K] == erase_time);
+    MX25Series_TEST_CHECK(test, power.observed_time[MX25Series_Operation_Erase_32K] != 0);
+
+    MX25Series_power_deinit(&power);
+    MX25Series_TEST_CHECK(test, test->dev.power == NULL);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+static void MX25Series__test_deep_power_down(MX25Series_Test_t *test)
+{
+    uint8_t pattern[0x100];
+    uint8_t read[0x100];
+    uint32_t tRES1 = test->dev.chip_def->timing.tRES1;
+    uint32_t programs, wake_latency;
+
+    MX25Series__test_pattern(pattern, sizeof(pattern), 0xA5);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&test->dev, 0x3000, sizeof(pattern), pattern) == MX25Series_status_ok);
+
+    //A read straight after DP wakes the chip first, the chip ignores nothing.
+    MX25Series_TEST_CHECK(test, MX25Series_enter_deep_power_down(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->dev.deep_power_down.active && test->emulator.deep_power_down);
+    MX25Series_TEST_CHECK(test, test->dev.deep_power_down.count == 1);
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data(&test->dev, true, 0x3000, sizeof(read), read) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(read, pattern, sizeof(read)) == 0);
+    MX25Series_TEST_CHECK(test, !test->dev.deep_power_down.active && !test->emulator.deep_power_down);
+    MX25Series_TEST_CHECK(test, test->dev.deep_power_down.wakes == 1);
+    MX25Series_TEST_CHECK(test, test->dev.deep_power_down.wake_latency >= tRES1);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+
+    //Auto sleep only once no frame has been sent for idle_time.
+    MX25Series_set_auto_sleep(&test->dev, 1000);
+    MX25Series_TEST_CHECK(test, MX25Series_sleep_tick(&test->dev) == MX25Series_status_ok);
+    MX25Series___delay_micro_second(&test->dev, 600);
+    MX25Series_TEST_CHECK(test, MX25Series_sleep_tick(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, !test->dev.deep_power_down.active);
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data(&test->dev, true, 0x3000, sizeof(read), read) == MX25Series_status_ok);
+    MX25Series___delay_micro_second(&test->dev, 600);
+    MX25Series_TEST_CHECK(test, MX25Series_sleep_tick(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, !test->dev.deep_power_down.active && test->dev.deep_power_down.count == 1);
+    MX25Series___delay_micro_second(&test->dev, 400);
+    MX25Series_TEST_CHECK(test, MX25Series_sleep_tick(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->dev.deep_power_down.active && test->emulator.deep_power_down);
+    MX25Series_TEST_CHECK(test, test->dev.deep_power_down.count == 2);
+
+    //Asleep, another tick does nothing and a program wakes the chip like a read.
+    programs = test->emulator.counters.programs;
+    wake_latency = test->dev.deep_power_down.wake_latency;
+    MX25Series_TEST_CHECK(test, MX25Series_sleep_tick(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->dev.deep_power_down.count == 2);
+    MX25Series___delay_micro_second(&test->dev, 5000);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&test->dev, 0x4000, sizeof(pattern), pattern) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.programs == programs + 1);
+    MX25Series_TEST_CHECK(test, memcmp(test->emulator.memory + 0x4000, pattern, sizeof(pattern)) == 0);
+    MX25Series_TEST_CHECK(test, test->dev.deep_power_down.wakes == 2);
+    MX25Series_TEST_CHECK(test, test->dev.deep_power_down.wake_latency >= wake_latency + tRES1);
+    MX25Series_TEST_CHECK(test, test->dev.deep_power_down.time_asleep >= 5000);
+
+    MX25Series_set_auto_sleep(&test->dev, 0);
+    MX25Series___delay_micro_second(&test->dev, 2000);
+    MX25Series_TEST_CHECK(test, MX25Series_sleep_tick(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, !test->dev.deep_power_down.active);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+static void MX25Series__test_suspend(MX25Series_Test_t *test)
+{
+    uint8_t pattern[256];
+    uint8_t buffer[256];
+    uint32_t frames;
+
+    MX25Series__test_pattern(pattern, sizeof(pattern), 0x5005);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&test->dev, 0, sizeof(pattern), pattern) == MX25Series_status_ok);
+
+    //An erase suspended part way through, a read elsewhere, then resumed.
+    MX25Series_TEST_CHECK(test, MX25Series_set_write_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_erase(&test->dev, MX25Series_Erase_Block_4K, 0x1000) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_suspend(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->dev.suspend.active);
+    MX25Series_TEST_CHECK(test, test->dev.busy_operation == MX25Series_Operation_Erase_4K);
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data(&test->dev, true, 0, sizeof(buffer), buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(buffer, pattern, sizeof(pattern)) == 0);
+    MX25Series_TEST_CHECK(test, MX25Series_resume(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_wait_for_operation(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->dev.suspend.count == 1);
+
+    //A program that finished before the suspend is completed, not suspended, and there is nothing to resume.
+    MX25Series_TEST_CHECK(test, MX25Series_set_write_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data(&test->dev, 0x2000, sizeof(pattern), pattern) == MX25Series_status_ok);
+    MX25Series___delay_micro_second(&test->dev, test->dev.chip_def->timing.tPP);
+    MX25Series_TEST_CHECK(test, MX25Series_suspend(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, !test->dev.suspend.active);
+    MX25Series_TEST_CHECK(test, test->dev.suspend.count == 1);
+    MX25Series_TEST_CHECK(test, test->dev.busy_operation == MX25Series_Operation_None);
+    MX25Series_TEST_CHECK(test, test->dev.observed_time[MX25Series_Operation_Program] != 0);
+    frames = test->emulator.counters.frames;
+    MX25Series_TEST_CHECK(test, MX25Series_resume(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.frames == frames);
+
+    //A preempting read suspends an erase for its duration and resumes it afterwards.
+    MX25Series_TEST_CHECK(test, MX25Series_set_write_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_erase(&test->dev, MX25Series_Erase_Block_4K, 0x4000) == MX25Series_status_ok);
+    memset(buffer, 0, sizeof(buffer));
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data_preempt(&test->dev, MX25Series_Read_Mode_FAST_READ, 0, sizeof(buffer), buffer) ==
+                                MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(buffer, pattern, sizeof(pattern)) == 0);
+    MX25Series_TEST_CHECK(test, test->dev.suspend.count == 2);
+    MX25Series_TEST_CHECK(test, !test->dev.suspend.active);
+    MX25Series_TEST_CHECK(test, MX25Series_wait_for_operation(&test->dev) == MX25Series_status_ok);
+
+    //A failed program is reported by the suspend that finds it finished.
+    test->emulator.fail_programs = 1;
+    MX25Series_TEST_CHECK(test, MX25Series_set_write_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data(&test->dev, 0x3000, sizeof(pattern), pattern) == MX25Series_status_ok);
+    MX25Series___delay_micro_second(&test->dev, test->dev.chip_def->timing.tPP);
+    MX25Series_TEST_CHECK(test, MX25Series_suspend(&test->dev) == MX25Series_status_error_program);
+    MX25Series_TEST_CHECK(test, !test->dev.suspend.active);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+/**
+ * MX25Series__test_sfdp_time checks a maximum time decoded from SFDP, which is rounded up to the units SFDP counts in.
+ */
+static void MX25Series__test_sfdp_time(MX25Series_Test_t *test, uint32_t decoded, uint32_t expected, uint32_t tolerance)
+{
+    MX25Series_TEST_CHECK(test, decoded >= expected);
+    MX25Series_TEST_CHECK(test, decoded <= expected + tolerance);
+}
+
+static void MX25Series__test_sfdp(MX25Series_Test_t *test)
+{
+    MX25Series_Chip_Info_t *expected = &MX25R6435F_Chip_Def_Low_Power;
+    MX25Series_Chip_Info_t chip_def;
+    MX25Series_Chip_Info_t discovered;
+    uint8_t sfdp[MX25Series_EMULATOR_SFDP_SIZE];
+
+    MX25Series_emulator_build_sfdp(expected, sfdp);
+    memset(&chip_def, 0, sizeof(chip_def));
+    MX25Series_TEST_CHECK(test, MX25Series_sfdp_parse_buffer(sfdp, sizeof(sfdp), &chip_def) == MX25Series_status_ok);
+
+    MX25Series_TEST_CHECK(test, chip_def.memory_size == expected->memory_size);
+    MX25Series_TEST_CHECK(test, chip_def.page_size == expected->page_size);
+    MX25Series_TEST_CHECK(test, chip_def.erase_types == expected->erase_types);
+    MX25Series_TEST_CHECK(test, chip_def.dummy_cycles.fast_read == expected->dummy_cycles.fast_read);
+    MX25Series_TEST_CHECK(test, chip_def.dummy_cycles.dread == expected->dummy_cycles.dread);
+    MX25Series_TEST_CHECK(test, chip_def.dummy_cycles.qread == expected->dummy_cycles.qread);
+    MX25Series_TEST_CHECK(test, chip_def.dummy_cycles.dual_io == expected->dummy_cycles.dual_io);
+    MX25Series_TEST_CHECK(test, chip_def.dummy_cycles.quad_io == expected->dummy_cycles.quad_io);
+
+    //SFDP counts in coarse units, so the maximums come back rounded up.
+    MX25Series__test_sfdp_time(test, chip_def.timing.tPP, expected->timing.tPP, expected->timing.tPP / 4);
+    MX25Series__test_sfdp_time(test, chip_def.timing.tSE, expected->timing.tSE, expected->timing.tSE / 4);
+    MX25Series__test_sfdp_time(test, chip_def.timing.tBE32K, expected->timing.tBE32K, expected->timing.tBE32K / 4);
+    MX25Series__test_sfdp_time(test, chip_def.timing.tBE64K, expected->timing.tBE64K, expected->timing.tBE64K / 4);
+    MX25Series_TEST_CHECK(test, chip_def.typical.tPP != 0 && chip_def.typical.tPP < chip_def.timing.tPP);
+    MX25Series_TEST_CHECK(test, chip_def.typical.tSE != 0 && chip_def.typical.tSE < chip_def.timing.tSE);
+    MX25Series_TEST_CHECK(test, chip_def.timing.tSUS == expected->timing.tSUS);
+    MX25Series__test_sfdp_time(test, chip_def.timing.tRS, expected->timing.tRS, 63);
+    MX25Series__test_sfdp_time(test, chip_def.timing.tRES1, expected->timing.tRES1, 7);
+    MX25Series_TEST_CHECK(test, chip_def.timing.tWSR != 0);
+
+    //Discovery reads the same image from the emulated chip, keeping the template's other fields.
+    discovered = *expected;
+    discovered.timing.tRES1 = 0;
+    MX25Series_TEST_CHECK(test, MX25Series_sfdp_discover(&test->dev, &discovered) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->dev.chip_def == &discovered);
+    MX25Series_TEST_CHECK(test, discovered.manufacturer_id == expected->manufacturer_id);
+    MX25Series_TEST_CHECK(test, discovered.memory_density == expected->memory_density);
+    MX25Series_TEST_CHECK(test, discovered.timing.tWSR == expected->timing.tWSR);
+    MX25Series_TEST_CHECK(test, discovered.timing.tSE == chip_def.timing.tSE);
+    MX25Series_TEST_CHECK(test, discovered.timing.tRES1 == chip_def.timing.tRES1);
+
+    //Discovery picks the fastest read mode the chip has, the quad modes only once QE is set.
+#if defined(MX25Series_ENABLE_MULTI_IO)
+    MX25Series_TEST_CHECK(test, test->dev.read_mode == MX25Series_Read_Mode_2READ);
+    MX25Series_TEST_CHECK(test, MX25Series_set_quad_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_sfdp_discover(&test->dev, &discovered) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->dev.read_mode == MX25Series_Read_Mode_4READ);
+
+    //A chip without 4READ reads with QREAD, and without either with 2READ.
+    chip_def = *expected;
+    chip_def.dummy_cycles.quad_io = 0;
+    MX25Series_emulator_build_sfdp(&chip_def, sfdp);
+    test->emulator.sfdp = sfdp;
+    MX25Series_TEST_CHECK(test, MX25Series_sfdp_discover(&test->dev, &discovered) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->dev.read_mode == MX25Series_Read_Mode_QREAD);
+    chip_def.dummy_cycles.qread = 0;
+    MX25Series_emulator_build_sfdp(&chip_def, sfdp);
+    MX25Series_TEST_CHECK(test, MX25Series_sfdp_discover(&test->dev, &discovered) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->dev.read_mode == MX25Series_Read_Mode_2READ);
+    test->emulator.sfdp = test->emulator.sfdp_image;
+    MX25Series_emulator_build_sfdp(expected, sfdp);
+#else
+    MX25Series_TEST_CHECK(test, test->dev.read_mode == MX25Series_Read_Mode_FAST_READ);
+    MX25Series_TEST_CHECK(test, MX25Series_set_quad_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_sfdp_discover(&test->dev, &discovered) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->dev.read_mode == MX25Series_Read_Mode_FAST_READ);
+#endif
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+
+    //A BFPT shorter than the nine DWORDs of JESD216, a missing signature and a truncated image are rejected.
+    sfdp[8 + 3] = 8;
+    MX25Series_TEST_CHECK(test, MX25Series_sfdp_parse_buffer(sfdp, sizeof(sfdp), &chip_def) == MX25Series_status_error_unsupported);
+    sfdp[8 + 3] = MX25Series_SFDP_BFPT_DWORDS;
+    MX25Series_TEST_CHECK(test, MX25Series_sfdp_parse_buffer(sfdp, sizeof(sfdp), &chip_def) == MX25Series_status_ok);
+    sfdp[0] = 'X';
+    MX25Series_TEST_CHECK(test, MX25Series_sfdp_parse_buffer(sfdp, sizeof(sfdp), &chip_def) == MX25Series_status_error_unsupported);
+    MX25Series_TEST_CHECK(test, MX25Series_sfdp_parse_buffer(sfdp, 4, &chip_def) != MX25Series_status_ok);
+}
+
+static uint32_t MX25Series__test_async_completions;
+
+static void MX25Series__test_async_completed(MX25Series_t *dev, MX25Series_Async_Request_t *request, MX25Series_status_enum_t status)
+{
+    (void)dev;
+    (void)status;
+    *(uint32_t *)request->user = ++MX25Series__test_async_completions;
+}
+
+static void MX25Series__test_async(MX25Series_Test_t *test)
+{
+    static uint8_t pattern[3 * 1024];
+    static uint8_t reads[4][1024];
+    MX25Series_Async_t async;
+    MX25Series_Async_Request_t *queue[3];
+    MX25Series_Async_Request_t requests[4];
+    uint32_t completed[4];
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+
+    MX25Series__test_async_completions = 0;
+    MX25Series__test_pattern(pattern, sizeof(pattern), 0xA5C);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&test->dev, 0, sizeof(pattern), pattern) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_async_init(&async, &test->dev, queue, 3) == MX25Series_status_ok);
+
+    //Several laps of the ring, filling it each time, the requests complete in the order they were submitted.
+    for(uint32_t round = 0; round < 5; round++)
+    {
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            memset(reads[i], 0, sizeof(reads[i]));
+            MX25Series_TEST_CHECK(test, MX25Series_async_read(&test->dev, &requests[i], MX25Series_Read_Mode_FAST_READ, ((round + i) % 3) * 1024,
+                                                              1024, reads[i], MX25Series__test_async_completed, &completed[i]) ==
+                                        MX25Series_status_ok);
+        }
+        MX25Series_TEST_CHECK(test, MX25Series_async_read(&test->dev, &requests[3], MX25Series_Read_Mode_FAST_READ, 0, 1024, reads[3],
+                                                          MX25Series__test_async_completed, &completed[3]) == MX25Series_status_error_busy);
+        MX25Series_TEST_CHECK(test, !MX25Series_async_is_idle(&test->dev));
+        while(!MX25Series_async_is_idle(&test->dev))
+        {
+            result |= MX25Series_async_tick(&test->dev);
+        }
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            MX25Series_TEST_CHECK(test, completed[i] == round * 3 + i + 1);
+            MX25Series_TEST_CHECK(test, memcmp(reads[i], pattern + ((round + i) % 3) * 1024, 1024) == 0);
+        }
+    }
+    MX25Series_TEST_CHECK(test, result == MX25Series_status_ok);
+
+    //The tick that starts the oldest request frees its entry for another.
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        MX25Series_TEST_CHECK(test, MX25Series_async_read(&test->dev, &requests[i], MX25Series_Read_Mode_FAST_READ, i * 1024, 1024, reads[i],
+                                                          MX25Series__test_async_completed, &completed[i]) == MX25Series_status_ok);
+    }
+    MX25Series_TEST_CHECK(test, MX25Series_async_tick(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_async_read(&test->dev, &requests[3], MX25Series_Read_Mode_FAST_READ, 0, 1024, reads[3],
+                                                      MX25Series__test_async_completed, &completed[3]) == MX25Series_status_ok);
+    while(!MX25Series_async_is_idle(&test->dev))
+    {
+        result |= MX25Series_async_tick(&test->dev);
+    }
+    MX25Series_TEST_CHECK(test, result == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, completed[3] == MX25Series__test_async_completions);
+    MX25Series_TEST_CHECK(test, memcmp(reads[3], pattern, 1024) == 0);
+
+    MX25Series_async_deinit(&async);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+}
+
+static void MX25Series__test_bus_completed(MX25Series_t *dev, MX25Series_Async_Request_t *request, MX25Series_status_enum_t status)
+{
+    MX25Series_Emulator_t *emulator = (MX25Series_Emulator_t *)dev->ctx;
+
+    (void)status;
+    *(uint64_t *)request->user = MX25Series_emulator_get_time_ns(emulator);
+}
+
+static void MX25Series__test_shared_bus(MX25Series_Test_t *test)
+{
+    static MX25Series_Emulator_t emulators[2];
+    static uint8_t pattern[4096];
+    static uint8_t reads[4][1024];
+    static uint8_t buffer[4096];
+    MX25Series_t devices[2];
+    MX25Series_Async_t async[2];
+    MX25Series_Async_Request_t *queues[2][4];
+    MX25Series_Async_Request_t requests[2][4];
+    uint64_t completed[2][4];
+    MX25Series_Bus_t bus;
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint64_t erase_done;
+
+    memset(completed, 0, sizeof(completed));
+    MX25Series__test_pattern(pattern, sizeof(pattern), 0xB05);
+    MX25Series_TEST_CHECK(test, MX25Series_bus_init(&bus, NULL, NULL, NULL) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_bus_attach(&bus, &test->dev) == MX25Series_status_ok);
+    for(uint8_t i = 0; i < 2; i++)
+    {
+        MX25Series_TEST_CHECK(test, MX25Series_emulator_init(&emulators[i], test->dev.chip_def, NULL) == MX25Series_status_ok);
+        MX25Series_emulator_share_bus(&emulators[i], &test->emulator);
+        MX25Series_init(&devices[i], test->dev.chip_def, i + 1, 0, 0, 0, &emulators[i]);
+        MX25Series_TEST_CHECK(test, MX25Series_async_init(&async[i], &devices[i], queues[i], 4) == MX25Series_status_ok);
+        MX25Series_TEST_CHECK(test, MX25Series_bus_attach(&bus, &devices[i]) == MX25Series_status_ok);
+    }
+
+    //The first device queues reads, the second an erase and a write, then test->dev erases 64 KB synchronously.
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&devices[0], 0, sizeof(pattern), pattern) == MX25Series_status_ok);
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        MX25Series_TEST_CHECK(test, MX25Series_async_read(&devices[0], &requests[0][i], MX25Series_Read_Mode_FAST_READ, i * 1024, 1024,
+                                                          reads[i], MX25Series__test_bus_completed, &completed[0][i]) == MX25Series_status_ok);
+    }
+    MX25Series_TEST_CHECK(test, MX25Series_async_erase(&devices[1], &requests[1][0], 0, sizeof(pattern),
+                                                       MX25Series__test_bus_completed, &completed[1][0]) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_async_write(&devices[1], &requests[1][1], 0, sizeof(pattern), pattern,
+                                                       MX25Series__test_bus_completed, &completed[1][1]) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_erase_range(&test->dev, 0x10000, 0x10000) == MX25Series_status_ok);
+    erase_done = MX25Series_emulator_get_time_ns(&test->emulator);
+
+    //The reads were served from the erase's WIP wait, without a MX25Series_bus_tick from here.
+    MX25Series_TEST_CHECK(test, MX25Series_async_is_idle(&devices[0]));
+    MX25Series_TEST_CHECK(test, completed[0][3] != 0 && completed[0][3] < erase_done);
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        MX25Series_TEST_CHECK(test, requests[0][i].status == MX25Series_status_ok);
+        MX25Series_TEST_CHECK(test, memcmp(reads[i], pattern + i * 1024, 1024) == 0);
+    }
+
+    while(!MX25Series_async_is_idle(&devices[1]))
+    {
+        result |= MX25Series_bus_tick(&bus);
+        MX25Series___delay_micro_second(&test->dev, 10);
+    }
+    MX25Series_TEST_CHECK(test, result == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, requests[1][0].status == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, requests[1][1].status == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data(&devices[1], true, 0, sizeof(buffer), buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(buffer, pattern, sizeof(pattern)) == 0);
+
+    //Without a lock, a second device is turned away while the bus is owned.
+    MX25Series_TEST_CHECK(test, MX25Series_bus_acquire(&bus, &devices[0]) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_bus_acquire(&bus, &devices[1]) == MX25Series_status_error_busy);
+    MX25Series_bus_release(&bus, &devices[0]);
+    MX25Series_TEST_CHECK(test, MX25Series_bus_acquire(&bus, &devices[1]) == MX25Series_status_ok);
+    MX25Series_bus_release(&bus, &devices[1]);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.bus_conflicts == 0);
+    for(uint8_t i = 0; i < 2; i++)
+    {
+        MX25Series_TEST_CHECK(test, emulators[i].counters.bus_conflicts == 0);
+        MX25Series_TEST_CHECK(test, emulators[i].counters.framing_errors == 0);
+        MX25Series_TEST_CHECK(test, emulators[i].counters.ignored_commands == 0);
+        MX25Series_async_deinit(&async[i]);
+        MX25Series_bus_detach(&devices[i]);
+        MX25Series_emulator_deinit(&emulators[i]);
+    }
+    MX25Series_bus_detach(&test->dev);
+}
+
+static void MX25Series__test_stripe(MX25Series_Test_t *test)
+{
+    static MX25Series_Emulator_t emulators[MX25Series_STRIPE_MAX_MEMBERS - 1];
+    static uint8_t pattern[3 * 4096 + 123];
+    static uint8_t buffer[sizeof(pattern)];
+    MX25Series_t devices[MX25Series_STRIPE_MAX_MEMBERS - 1];
+    MX25Series_t *members[MX25Series_STRIPE_MAX_MEMBERS];
+    MX25Series_Stripe_t stripe;
+    uint32_t page_size = test->dev.chip_def->page_size;
+
+    members[0] = &test->dev;
+    for(uint8_t i = 0; i + 1 < MX25Series_STRIPE_MAX_MEMBERS; i++)
+    {
+        MX25Series_TEST_CHECK(test, MX25Series_emulator_init(&emulators[i], test->dev.chip_def, NULL) == MX25Series_status_ok);
+        MX25Series_emulator_share_bus(&emulators[i], &test->emulator);
+        MX25Series_init(&devices[i], test->dev.chip_def, i + 1, 0, 0, 0, &emulators[i]);
+        members[i + 1] = &devices[i];
+    }
+
+    for(uint8_t count = 1; count <= MX25Series_STRIPE_MAX_MEMBERS; count++)
+    {
+        //Unaligned at both ends, so the first and last pages are partial.
+        uint32_t memory_address = 2 * count * MX25Series_SECTOR_SIZE + 100;
+
+        MX25Series__test_pattern(pattern, sizeof(pattern), 0x51 + 2 * count);
+        MX25Series_TEST_CHECK(test, MX25Series_stripe_init(&stripe, members, count) == MX25Series_status_ok);
+        MX25Series_TEST_CHECK(test, stripe.sector_size == count * MX25Series_SECTOR_SIZE);
+        MX25Series_TEST_CHECK(test, MX25Series_stripe_erase_range(&stripe, 2 * stripe.sector_size, 2 * stripe.sector_size) == MX25Series_status_ok);
+        MX25Series_TEST_CHECK(test, MX25Series_stripe_write(&stripe, memory_address, sizeof(pattern), pattern) == MX25Series_status_ok);
+        MX25Series_TEST_CHECK(test, MX25Series_stripe_wait(&stripe) == MX25Series_status_ok);
+
+        memset(buffer, 0, sizeof(buffer));
+        MX25Series_TEST_CHECK(test, MX25Series_stripe_read(&stripe, memory_address, sizeof(buffer), buffer) == MX25Series_status_ok);
+        MX25Series_TEST_CHECK(test, memcmp(buffer, pattern, sizeof(pattern)) == 0);
+
+        //Volume page n is page n / count of member n % count.
+        for(uint32_t page = memory_address / page_size + 1; page < (memory_address + sizeof(pattern)) / page_size; page++)
+        {
+            MX25Series_Emulator_t *emulator = (MX25Series_Emulator_t *)members[page % count]->ctx;
+
+            MX25Series_TEST_CHECK(test, memcmp(emulator->memory + (page / count) * page_size,
+                                               pattern + page * page_size - memory_address, page_size) == 0);
+        }
+    }
+
+    //A stripe needs one to MX25Series_STRIPE_MAX_MEMBERS members.
+    MX25Series_TEST_CHECK(test, MX25Series_stripe_init(&stripe, members, 0) == MX25Series_status_error_invalid_argument);
+    MX25Series_TEST_CHECK(test, MX25Series_stripe_init(&stripe, members, MX25Series_STRIPE_MAX_MEMBERS + 1) ==
+                                MX25Series_status_error_invalid_argument);
+    MX25Series_TEST_CHECK(test, MX25Series_stripe_erase_range(&stripe, 0, MX25Series_SECTOR_SIZE) == MX25Series_status_error_invalid_argument);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.bus_conflicts == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+    for(uint8_t i = 0; i + 1 < MX25Series_STRIPE_MAX_MEMBERS; i++)
+    {
+        MX25Series_TEST_CHECK(test, emulators[i].counters.bus_conflicts == 0);
+        MX25Series_TEST_CHECK(test, emulators[i].counters.framing_errors == 0);
+        MX25Series_TEST_CHECK(test, emulators[i].counters.ignored_commands == 0);
+        MX25Series_emulator_deinit(&emulators[i]);
+    }
+}
+
+/**
+ * MX25Series__test_update applies an update to the flash and to reference, then compares all of reference with
+ * the flash, returning the programs and erases the emulator saw.
+ */
+static void MX25Series__test_erase_plan(MX25Series_Test_t *test)
+{
+    MX25Series_Erase_Step_t steps[20];
+    size_t step_count = 0;
+    uint32_t total_time = 0;
+    uint32_t erases;
+    bool all_64K = true;
+    MX25Series_Chip_Info_t *chip_def = test->dev.chip_def;
+
+    //An aligned 1 MB is sixteen 64 KB Block Erases.
+    MX25Series_TEST_CHECK(test, MX25Series_plan_erase_range(&test->dev, 0x100000, 0x100000, steps, 20, &step_count, &total_time) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, step_count == 16);
+    MX25Series_TEST_CHECK(test, total_time == 16 * chip_def->timing.tBE64K);
+    for(size_t i = 0; i < 16; i++)
+    {
+        all_64K &= steps[i].erase_type == MX25Series_Erase_Block_64K && steps[i].memory_address == 0x100000 + i * 0x10000;
+    }
+    MX25Series_TEST_CHECK(test, all_64K);
+
+    //An unaligned head and tail are made up with Sector Erases around the 64 KB block.
+    MX25Series_TEST_CHECK(test, MX25Series_plan_erase_range(&test->dev, 0xE000, 0x14000, steps, 20, &step_count, &total_time) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, step_count == 5);
+    MX25Series_TEST_CHECK(test, steps[0].erase_type == MX25Series_Erase_Block_4K && steps[0].memory_address == 0xE000);
+    MX25Series_TEST_CHECK(test, steps[1].erase_type == MX25Series_Erase_Block_4K && steps[1].memory_address == 0xF000);
+    MX25Series_TEST_CHECK(test, steps[2].erase_type == MX25Series_Erase_Block_64K && steps[2].memory_address == 0x10000);
+    MX25Series_TEST_CHECK(test, steps[3].erase_type == MX25Series_Erase_Block_4K && steps[3].memory_address == 0x20000);
+    MX25Series_TEST_CHECK(test, steps[4].erase_type == MX25Series_Erase_Block_4K && steps[4].memory_address == 0x21000);
+    MX25Series_TEST_CHECK(test, total_time == 4 * chip_def->timing.tSE + chip_def->timing.tBE64K);
+
+    //Erasing the plan sends exactly its steps.
+    erases = test->emulator.counters.erases;
+    MX25Series_TEST_CHECK(test, MX25Series_erase_range(&test->dev, 0xE000, 0x14000) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.erases == erases + 5);
+
+    //The whole chip is a single Chip Erase, the blocks would take longer.
+    MX25Series_TEST_CHECK(test, MX25Series_plan_erase_range(&test->dev, 0, chip_def->memory_size, steps, 20, &step_count, &total_time) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, step_count == 1);
+    MX25Series_TEST_CHECK(test, steps[0].erase_type == MX25Series_Erase_Chip && steps[0].memory_address == 0);
+    MX25Series_TEST_CHECK(test, total_time == chip_def->timing.tCE);
+
+    //The count is the whole plan even when steps is too short for it.
+    MX25Series_TEST_CHECK(test, MX25Series_plan_erase_range(&test->dev, 0x100000, 0x100000, steps, 2, &step_count, NULL) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, step_count == 16);
+    MX25Series_TEST_CHECK(test, MX25Series_plan_erase_range(&test->dev, 0x100000, 0x100000, NULL, 0, &step_count, NULL) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, step_count == 16);
+
+    MX25Series_TEST_CHECK(test, MX25Series_plan_erase_range(&test->dev, 0x800, 0x1000, NULL, 0, NULL, NULL) == MX25Series_status_error_invalid_argument);
+    MX25Series_TEST_CHECK(test, MX25Series_plan_erase_range(&test->dev, 0, 0x1800, NULL, 0, NULL, NULL) == MX25Series_status_error_invalid_argument);
+    MX25Series_TEST_CHECK(test, MX25Series_plan_erase_range(&test->dev, chip_def->memory_size - 0x1000, 0x2000, NULL, 0, NULL, NULL) == MX25Series_status_error_invalid_argument);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+static void MX25Series__test_update(MX25Series_Test_t *test, uint8_t *reference, size_t reference_length, uint32_t memory_address,
+                                    size_t length, uint8_t *data, MX25Series_Update_Report_t *report, uint32_t *programs, uint32_t *erases)
+{
+    static uint8_t sector_buffer[MX25Series_SECTOR_SIZE];
+    static uint8_t buffer[0x3000];
+    uint32_t programs_before = test->emulator.counters.programs;
+    uint32_t erases_before = test->emulator.counters.erases;
+
+    memcpy(reference + memory_address, data, length);
+    MX25Series_TEST_CHECK(test, MX25Series_update_range(&test->dev, memory_address, length, data, sector_buffer, report) ==
+                                MX25Series_status_ok);
+    *programs = test->emulator.counters.programs - programs_before;
+    *erases = test->emulator.counters.erases - erases_before;
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data(&test->dev, true, 0, reference_length, buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(buffer, reference, reference_length) == 0);
+    MX25Series_TEST_CHECK(test, *programs == report->pages_programmed);
+    MX25Series_TEST_CHECK(test, *erases == report->sectors_erased);
+}
+
+static void MX25Series__test_update_range(MX25Series_Test_t *test)
+{
+    static uint8_t reference[0x3000];
+    static uint8_t data[0x1000];
+    MX25Series_Update_Report_t report;
+    uint32_t page_size = test->dev.chip_def->page_size;
+    uint32_t programs;
+    uint32_t erases;
+    size_t byte = 0;
+
+    memset(reference, 0xFF, sizeof(reference));
+
+    //Blank flash only needs programming, a page at a time from mid page.
+    MX25Series__test_pattern(data, sizeof(data), 0x0BD);
+    MX25Series__test_update(test, reference, sizeof(reference), 0x80, 0xE00, data, &report, &programs, &erases);
+    MX25Series_TEST_CHECK(test, erases == 0);
+    MX25Series_TEST_CHECK(test, programs == 15);
+    MX25Series_TEST_CHECK(test, report.bytes_programmed == 0xE00);
+
+    //Rewriting the same data does nothing.
+    MX25Series__test_update(test, reference, sizeof(reference), 0x80, 0xE00, data, &report, &programs, &erases);
+    MX25Series_TEST_CHECK(test, erases == 0 && programs == 0);
+    MX25Series_TEST_CHECK(test, report.pages_skipped == 15);
+    MX25Series_TEST_CHECK(test, report.sectors_skipped == 1);
+
+    //Clearing bits in one page programs only that page, only the changed bytes.
+    data[3 * page_size + 10] &= 0x0F;
+    data[3 * page_size + 20] &= 0x0F;
+    MX25Series__test_update(test, reference, sizeof(reference), 0x80, 0xE00, data, &report, &programs, &erases);
+    MX25Series_TEST_CHECK(test, erases == 0 && programs == 1);
+    MX25Series_TEST_CHECK(test, report.bytes_programmed == 11);
+
+    //Setting a bit erases the sector and programs back every page that is not blank.
+    while(data[byte] == 0xFF)
+    {
+        byte++;
+    }
+    data[byte] = 0xFF;
+    MX25Series__test_update(test, reference, sizeof(reference), 0x80, 0xE00, data, &report, &programs, &erases);
+    MX25Series_TEST_CHECK(test, erases == 1);
+    MX25Series_TEST_CHECK(test, programs == 15);
+
+    //Across a sector boundary into blank flash, then over it again with bits to set in both sectors.
+    MX25Series__test_pattern(data, sizeof(data), 0xC05);
+    MX25Series__test_update(test, reference, sizeof(reference), 0xF00, 0x200, data, &report, &programs, &erases);
+    MX25Series_TEST_CHECK(test, erases == 0 && programs == 2);
+    MX25Series_TEST_CHECK(test, report.sectors_skipped == 2);
+    for(size_t i = 0; i < 0x200; i++)
+    {
+        data[i] = ~data[i];
+    }
+    MX25Series__test_update(test, reference, sizeof(reference), 0xF00, 0x200, data, &report, &programs, &erases);
+    MX25Series_TEST_CHECK(test, erases == 2);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+/**
+ * MX25Series__test_log_record fills buffer with record id, which starts with the id.
+ */
+static size_t MX25Series__test_log_record(uint32_t id, uint8_t *buffer)
+{
+    size_t length = 4 + ((id * 2654435761ul) >> 20) % 297;
+
+    for(size_t i = 0; i < length; i++)
+    {
+        buffer[i] = (uint8_t)(id * 31 + i);
+    }
+    memcpy(buffer, &id, sizeof(id));
+    return length;
+}
+
+/**
+ * MX25Series__test_log_mount mounts the writer's region afresh and walks it, every record must be there in order up
+ * to last_id, apart from the skipped torn ones.
+ */
+static void MX25Series__test_log_mount(MX25Series_Test_t *test, MX25Series_Log_t *writer, uint32_t last_id, uint32_t skipped)
+{
+    static uint8_t page_buffer[256];
+    static uint8_t record[MX25Series_LOG_MAX_RECORD];
+    static uint8_t expected[MX25Series_LOG_MAX_RECORD];
+    MX25Series_Log_t log;
+    MX25Series_Log_Iterator_t iterator;
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint32_t id = 0;
+    bool matched = true;
+    size_t length = 0;
+
+    MX25Series_TEST_CHECK(test, MX25Series_log_init(&log, &test->dev, writer->base, writer->sector_count * MX25Series_SECTOR_SIZE,
+                                                    page_buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_log_mount(&log) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, log.empty == writer->empty);
+    MX25Series_TEST_CHECK(test, log.head == writer->head);
+    MX25Series_TEST_CHECK(test, log.head_sequence == writer->head_sequence);
+    MX25Series_TEST_CHECK(test, log.tail_sequence == writer->tail_sequence);
+
+    MX25Series_log_begin(&log, &iterator);
+    for(;;)
+    {
+        uint32_t record_id;
+
+        result |= MX25Series_log_next(&log, &iterator, record, sizeof(record), &length);
+        if(MX25Series_HAS_ERROR(result) || length == 0)
+        {
+            break;
+        }
+        memcpy(&record_id, record, sizeof(record_id));
+        //Reclaiming only drops the oldest records, after the first the ids run on apart from skipped torn records.
+        matched &= id == 0 || record_id == id + 1 || (skipped != 0 && record_id > id);
+        matched &= MX25Series__test_log_record(record_id, expected) == length && memcmp(record, expected, length) == 0;
+        id = record_id;
+    }
+    MX25Series_TEST_CHECK(test, result == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, matched);
+    MX25Series_TEST_CHECK(test, id == last_id);
+    MX25Series_TEST_CHECK(test, iterator.skipped == skipped);
+}
+
+static void MX25Series__test_log(MX25Series_Test_t *test)
+{
+    static const struct
+    {
+        uint32_t base;
+        uint32_t sectors;
+    } regions[] = {{0x3000, 3}, {0x20000, 5}, {0x30000, 40}, {0x61000, 37}};
+    static uint8_t page_buffer[256];
+    uint8_t record[MX25Series_LOG_MAX_RECORD];
+    MX25Series_Log_t log;
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint32_t id = 0;
+    size_t length;
+
+    //Several laps of each region, mounting afresh after every round.
+    for(size_t region = 0; region < sizeof(regions) / sizeof(regions[0]); region++)
+    {
+        MX25Series_TEST_CHECK(test, MX25Series_log_init(&log, &test->dev, regions[region].base, regions[region].sectors * MX25Series_SECTOR_SIZE,
+                                                        page_buffer) == MX25Series_status_ok);
+        MX25Series_TEST_CHECK(test, MX25Series_log_format(&log) == MX25Series_status_ok);
+        MX25Series__test_log_mount(test, &log, 0, 0);
+
+        id = 0;
+        for(uint32_t round = 0; round < 4 * regions[region].sectors; round++)
+        {
+            for(uint32_t count = 20 + (round * 137) % 100; count > 0; count--)
+            {
+                id++;
+                length = MX25Series__test_log_record(id, record);
+                result |= MX25Series_log_append(&log, record, length);
+            }
+            result |= MX25Series_log_flush(&log);
+            MX25Series__test_log_mount(test, &log, id, 0);
+        }
+        MX25Series_TEST_CHECK(test, result == MX25Series_status_ok);
+        //The region must have wrapped several times.
+        MX25Series_TEST_CHECK(test, log.tail_sequence > 2 * regions[region].sectors);
+    }
+
+    //A record torn by a power loss, programmed only in part, is skipped and the log carries on after it.
+    id++;
+    length = MX25Series__test_log_record(id, record);
+    MX25Series_TEST_CHECK(test, MX25Series_log_append(&log, record, length) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_log_flush(&log) == MX25Series_status_ok);
+    memset(test->emulator.memory + log.head - length / 2, 0xFF, length / 2);
+    MX25Series__test_log_mount(test, &log, id - 1, 1);
+    id++;
+    length = MX25Series__test_log_record(id, record);
+    MX25Series_TEST_CHECK(test, MX25Series_log_append(&log, record, length) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_log_flush(&log) == MX25Series_status_ok);
+    MX25Series__test_log_mount(test, &log, id, 1);
+
+    MX25Series_TEST_CHECK(test, MX25Series_log_init(&log, &test->dev, 0x1000, 0x2000, page_buffer) == MX25Series_status_error_invalid_argument);
+    MX25Series_TEST_CHECK(test, MX25Series_log_init(&log, &test->dev, 0x1001, 0x8000, page_buffer) == MX25Series_status_error_invalid_argument);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+#define MX25Series_TEST_JOURNAL_BASE 0x40000
+#define MX25Series_TEST_JOURNAL_LENGTH 0x4000
+#define MX25Series_TEST_JOURNAL_END (MX25Series_TEST_JOURNAL_BASE + MX25Series_TEST_JOURNAL_LENGTH)
+
+/**
+ * MX25Series__test_journal_matches compares the sectors the journal test writes, ranges and neighbours, with image.
+ */
+static bool MX25Series__test_journal_matches(MX25Series_Test_t *test, const uint8_t *image)
+{
+    return memcmp(test->emulator.memory + 0x10000, image + 0x10000, 0x1000) == 0 &&
+           memcmp(test->emulator.memory + 0x21000, image + 0x21000, 0x2000) == 0;
+}
+
+static MX25Series_status_enum_t MX25Series__test_journal_mount(MX25Series_Test_t *test, MX25Series_Journal_t *journal, uint8_t *page_buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    result = MX25Series_journal_init(journal, &test->dev, MX25Series_TEST_JOURNAL_BASE, MX25Series_TEST_JOURNAL_LENGTH, page_buffer);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    return MX25Series_journal_mount(journal);
+}
+
+/**
+ * MX25Series__test_journal_cuts runs the transaction once to count its programs and erases, then again from the same
+ * start with the power lost before each of them in turn, and again during every replay until one completes. Each
+ * time the ranges and their neighbours must end up as they were before or after the transaction, and stay that way.
+ * Returns the programs and erases of the uninterrupted transaction.
+ */
+static void MX25Series__test_journal_cuts(MX25Series_Test_t *test, const MX25Series_Journal_Range_t *ranges, uint8_t count, bool torn,
+                                          uint32_t *outcomes, uint32_t *programs, uint32_t *erases)
+{
+    static uint8_t before[MX25Series_TEST_JOURNAL_END];
+    static uint8_t after[MX25Series_TEST_JOURNAL_END];
+    static uint8_t page_buffer[256];
+    MX25Series_Journal_t journal;
+    uint32_t operations;
+    uint32_t retries = 0;
+    bool replayed = false;
+
+    memcpy(before, test->emulator.memory, sizeof(before));
+    MX25Series_TEST_CHECK(test, MX25Series__test_journal_mount(test, &journal, page_buffer) == MX25Series_status_ok);
+    *programs = test->emulator.counters.programs;
+    *erases = test->emulator.counters.erases;
+    MX25Series_TEST_CHECK(test, MX25Series_journal_write(&journal, ranges, count) == MX25Series_status_ok);
+    *programs = test->emulator.counters.programs - *programs;
+    *erases = test->emulator.counters.erases - *erases;
+    operations = *programs + *erases;
+    memcpy(after, test->emulator.memory, sizeof(after));
+    for(uint8_t i = 0; i < count; i++)
+    {
+        MX25Series_TEST_CHECK(test, memcmp(test->emulator.memory + ranges[i].memory_address, ranges[i].buffer, ranges[i].length) == 0);
+    }
+
+    for(uint32_t cut = 0; cut < operations; cut++)
+    {
+        MX25Series_status_enum_t result = MX25Series_status_init;
+        uint32_t operations_after;
+        bool completed;
+
+        memcpy(test->emulator.memory, before, sizeof(before));
+        MX25Series__test_power_cycle(test);
+        MX25Series_TEST_CHECK(test, MX25Series__test_journal_mount(test, &journal, page_buffer) == MX25Series_status_ok);
+        MX25Series__test_power_cut(test, cut, torn);
+        MX25Series_TEST_CHECK(test, MX25Series_HAS_ERROR(MX25Series_journal_write(&journal, ranges, count)));
+
+        //The power fails again during each replay, a little later every time.
+        for(uint32_t retry = 0; retry <= operations; retry++)
+        {
+            MX25Series__test_power_cycle(test);
+            MX25Series__test_power_cut(test, retry, torn);
+            result = MX25Series__test_journal_mount(test, &journal, page_buffer);
+            replayed |= journal.replayed_sectors != 0;
+            if(!MX25Series_HAS_ERROR(result))
+            {
+                break;
+            }
+            retries++;
+        }
+        MX25Series__test_power_cycle(test);
+        MX25Series_TEST_CHECK(test, result == MX25Series_status_ok);
+
+        completed = MX25Series__test_journal_matches(test, after);
+        MX25Series_TEST_CHECK(test, completed || MX25Series__test_journal_matches(test, before));
+        outcomes[completed ? 1 : 0]++;
+
+        //A later mount has nothing left to program or erase.
+        operations_after = test->emulator.counters.programs + test->emulator.counters.erases;
+        MX25Series_TEST_CHECK(test, MX25Series__test_journal_mount(test, &journal, page_buffer) == MX25Series_status_ok);
+        MX25Series_TEST_CHECK(test, test->emulator.counters.programs + test->emulator.counters.erases == operations_after);
+        MX25Series_TEST_CHECK(test, MX25Series__test_journal_matches(test, completed ? after : before));
+    }
+    MX25Series_TEST_CHECK(test, replayed);
+    MX25Series_TEST_CHECK(test, retries != 0);
+
+    //Carry on from the completed transaction.
+    memcpy(test->emulator.memory, after, sizeof(after));
+    MX25Series__test_power_cycle(test);
+}
+
+static void MX25Series__test_journal(MX25Series_Test_t *test)
+{
+    static uint8_t background[0x3000];
+    static uint8_t page_buffer[256];
+    static uint8_t first[300];
+    static uint8_t second[256];
+    uint8_t small[16];
+    //One range within a sector, the other across a sector boundary.
+    MX25Series_Journal_Range_t ranges[2] = {{0x10100, sizeof(first), first}, {0x21F80, sizeof(second), second}};
+    MX25Series_Journal_Range_t range = {0x10100, sizeof(small), small};
+    MX25Series_Journal_t journal;
+    uint32_t outcomes[2] = {0, 0};
+    uint32_t programs;
+    uint32_t erases;
+
+    //Neighbouring data around both ranges, then a first transaction over it.
+    MX25Series__test_pattern(background, sizeof(background), 0x10A);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&test->dev, 0x10000, 0x1000, background) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&test->dev, 0x21000, 0x2000, background + 0x1000) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_journal_init(&journal, &test->dev, MX25Series_TEST_JOURNAL_BASE, MX25Series_TEST_JOURNAL_LENGTH,
+                                                        page_buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_journal_format(&journal) == MX25Series_status_ok);
+    MX25Series__test_pattern(first, sizeof(first), 0x11);
+    MX25Series__test_pattern(second, sizeof(second), 0x21);
+    MX25Series_TEST_CHECK(test, MX25Series_journal_write(&journal, ranges, 2) == MX25Series_status_ok);
+
+    //New data with bits to set in three sectors, the power lost cleanly and then part way through an operation.
+    MX25Series__test_pattern(first, sizeof(first), 0x13);
+    MX25Series__test_pattern(second, sizeof(second), 0x23);
+    MX25Series__test_journal_cuts(test, ranges, 2, false, outcomes, &programs, &erases);
+    MX25Series_TEST_CHECK(test, erases == 6);
+    MX25Series__test_pattern(first, sizeof(first), 0x15);
+    MX25Series__test_pattern(second, sizeof(second), 0x25);
+    MX25Series__test_journal_cuts(test, ranges, 2, true, outcomes, &programs, &erases);
+
+    //Only clearing bits needs no erase, the record and the range each take one Page Program.
+    for(size_t i = 0; i < sizeof(small); i++)
+    {
+        small[i] = first[i] & 0x5A;
+    }
+    MX25Series__test_journal_cuts(test, &range, 1, true, outcomes, &programs, &erases);
+    MX25Series_TEST_CHECK(test, programs == 2);
+    MX25Series_TEST_CHECK(test, erases == 0);
+
+    //Torn records were dropped and complete ones replayed.
+    MX25Series_TEST_CHECK(test, outcomes[0] != 0);
+    MX25Series_TEST_CHECK(test, outcomes[1] != 0);
+
+    //Overlapping ranges and ranges inside the journal region are refused.
+    ranges[1].memory_address = 0x10200;
+    MX25Series_TEST_CHECK(test, MX25Series_journal_write(&journal, ranges, 2) == MX25Series_status_error_invalid_argument);
+    range.memory_address = MX25Series_TEST_JOURNAL_BASE + 0x1000;
+    MX25Series_TEST_CHECK(test, MX25Series_journal_write(&journal, &range, 1) == MX25Series_status_error_invalid_argument);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+#define MX25Series_TEST_FTL_BASE 0x80000
+#define MX25Series_TEST_FTL_LENGTH 0x10000 /**! Two checkpoint copies and 14 physical sectors */
+#define MX25Series_TEST_FTL_LOGICAL 4
+
+/**
+ * @brief An FTL, its RAM and the contents its logical sectors should read back.
+ */
+typedef struct
+{
+    MX25Series_FTL_t ftl;
+    uint16_t map[MX25Series_TEST_FTL_LOGICAL];
+    uint8_t used[MX25Series_FTL_BITMAP_SIZE(MX25Series_TEST_FTL_LENGTH / MX25Series_SECTOR_SIZE)];
+    uint8_t dirty[MX25Series_FTL_BITMAP_SIZE(MX25Series_TEST_FTL_LENGTH / MX25Series_SECTOR_SIZE)];
+    uint8_t page_buffer[256];
+    uint8_t expected[MX25Series_TEST_FTL_LOGICAL][MX25Series_FTL_SECTOR_SIZE];
+} MX25Series_Test_FTL_t;
+
+static MX25Series_status_enum_t MX25Series__test_ftl_mount(MX25Series_Test_t *test, MX25Series_Test_FTL_t *state)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    result = MX25Series_ftl_init(&state->ftl, &test->dev, MX25Series_TEST_FTL_BASE, MX25Series_TEST_FTL_LENGTH,
+                                 MX25Series_TEST_FTL_LOGICAL, state->map, state->used, state->dirty, state->page_buffer);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    return MX25Series_ftl_mount(&state->ftl);
+}
+
+/**
+ * MX25Series__test_ftl_matches reads every logical sector back and compares it with the expected contents.
+ */
+static bool MX25Series__test_ftl_matches(MX25Series_Test_FTL_t *state)
+{
+    static uint8_t buffer[MX25Series_FTL_SECTOR_SIZE];
+
+    for(uint16_t logical = 0; logical < MX25Series_TEST_FTL_LOGICAL; logical++)
+    {
+        if(MX25Series_HAS_ERROR(MX25Series_ftl_read(&state->ftl, logical, 0, sizeof(buffer), buffer)) ||
+           memcmp(buffer, state->expected[logical], sizeof(buffer)) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint16_t MX25Series__test_ftl_dirty(MX25Series_Test_FTL_t *state)
+{
+    uint16_t dirty = 0;
+
+    for(uint16_t physical = 0; physical < state->ftl.physical_count; physical++)
+    {
+        dirty += (state->dirty[physical / 8] >> (physical % 8)) & 1;
+    }
+    return dirty;
+}
+
+static void MX25Series__test_ftl(MX25Series_Test_t *test)
+{
+    static MX25Series_Test_FTL_t state;
+    static uint8_t snapshot[MX25Series_TEST_FTL_LENGTH];
+    static uint8_t update[MX25Series_FTL_SECTOR_SIZE];
+    uint16_t map[MX25Series_TEST_FTL_LOGICAL];
+    uint8_t used[sizeof(state.used)];
+    uint32_t operations;
+    uint32_t erases;
+    uint32_t highest = 0;
+    uint32_t erase_count = 0;
+    uint32_t writes = 0;
+    uint16_t dirty;
+    uint16_t previous;
+
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_init(&state.ftl, &test->dev, MX25Series_TEST_FTL_BASE, MX25Series_TEST_FTL_LENGTH,
+                                                    MX25Series_TEST_FTL_LOGICAL, state.map, state.used, state.dirty,
+                                                    state.page_buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_format(&state.ftl) == MX25Series_status_ok);
+    memset(state.expected, 0xFF, sizeof(state.expected));
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_matches(&state));
+
+    //Every logical sector written whole, then one of them in part.
+    for(uint16_t logical = 0; logical < MX25Series_TEST_FTL_LOGICAL; logical++)
+    {
+        MX25Series__test_pattern(state.expected[logical], MX25Series_FTL_SECTOR_SIZE, 0x31 + 2 * logical);
+        MX25Series_TEST_CHECK(test, MX25Series_ftl_write(&state.ftl, logical, 0, MX25Series_FTL_SECTOR_SIZE,
+                                                         state.expected[logical]) == MX25Series_status_ok);
+    }
+    MX25Series__test_pattern(state.expected[1] + 1000, 300, 0x41);
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_write(&state.ftl, 1, 1000, 300, state.expected[1] + 1000) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_matches(&state));
+
+    //The format's checkpoint went stale with the first write, so the mount scans, and a checkpoint mount agrees with it.
+    MX25Series__test_power_cycle(test);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_mount(test, &state) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, !state.ftl.mounted_from_checkpoint);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_matches(&state));
+    memcpy(map, state.map, sizeof(map));
+    memcpy(used, state.used, sizeof(used));
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_checkpoint(&state.ftl) == MX25Series_status_ok);
+    MX25Series__test_power_cycle(test);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_mount(test, &state) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, state.ftl.mounted_from_checkpoint);
+    MX25Series_TEST_CHECK(test, memcmp(map, state.map, sizeof(map)) == 0);
+    MX25Series_TEST_CHECK(test, memcmp(used, state.used, sizeof(used)) == 0);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_matches(&state));
+
+    //A write after the checkpoint marks it stale, the next mount must not trust it.
+    MX25Series__test_pattern(state.expected[3], MX25Series_FTL_SECTOR_SIZE, 0x43);
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_write(&state.ftl, 3, 0, MX25Series_FTL_SECTOR_SIZE, state.expected[3]) == MX25Series_status_ok);
+    MX25Series__test_power_cycle(test);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_mount(test, &state) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, !state.ftl.mounted_from_checkpoint);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_matches(&state));
+
+    //The power lost before each program and erase of a write from a checkpoint, the last cut lands on the commit flag.
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_checkpoint(&state.ftl) == MX25Series_status_ok);
+    memcpy(snapshot, test->emulator.memory + MX25Series_TEST_FTL_BASE, sizeof(snapshot));
+    MX25Series__test_pattern(update, sizeof(update), 0x45);
+    operations = test->emulator.counters.programs + test->emulator.counters.erases;
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_write(&state.ftl, 2, 0, sizeof(update), update) == MX25Series_status_ok);
+    operations = test->emulator.counters.programs + test->emulator.counters.erases - operations;
+    for(uint32_t cut = 0; cut < operations; cut++)
+    {
+        memcpy(test->emulator.memory + MX25Series_TEST_FTL_BASE, snapshot, sizeof(snapshot));
+        MX25Series__test_power_cycle(test);
+        MX25Series_TEST_CHECK(test, MX25Series__test_ftl_mount(test, &state) == MX25Series_status_ok);
+        MX25Series__test_power_cut(test, cut, (cut & 1) != 0);
+        MX25Series_TEST_CHECK(test, MX25Series_HAS_ERROR(MX25Series_ftl_write(&state.ftl, 2, 0, sizeof(update), update)));
+
+        MX25Series__test_power_cycle(test);
+        MX25Series_TEST_CHECK(test, MX25Series__test_ftl_mount(test, &state) == MX25Series_status_ok);
+        MX25Series_TEST_CHECK(test, MX25Series__test_ftl_matches(&state));
+    }
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_write(&state.ftl, 2, 0, sizeof(update), update) == MX25Series_status_ok);
+    memcpy(state.expected[2], update, sizeof(update));
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_matches(&state));
+
+    //Collection erases at most the sectors asked for, and nothing once every replaced sector is clean.
+    dirty = MX25Series__test_ftl_dirty(&state);
+    MX25Series_TEST_CHECK(test, dirty > 1);
+    erases = test->emulator.counters.erases;
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_collect(&state.ftl, 1) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.erases == erases + 1);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_dirty(&state) == dirty - 1);
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_collect(&state.ftl, 0xFFFF) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.erases == erases + dirty);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_dirty(&state) == 0);
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_collect(&state.ftl, 0xFFFF) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.erases == erases + dirty);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_matches(&state));
+
+    //Rewriting one logical sector wears the free sectors until the cold data is moved onto a worn one.
+    while(state.ftl.wear.relocations == 0 && writes < (MX25Series_FTL_WEAR_THRESHOLD + 2) * (uint32_t)state.ftl.physical_count)
+    {
+        MX25Series__test_pattern(state.expected[0], MX25Series_FTL_SECTOR_SIZE, 0x101 + 2 * writes);
+        if(MX25Series_HAS_ERROR(MX25Series_ftl_write(&state.ftl, 0, 0, MX25Series_FTL_SECTOR_SIZE, state.expected[0])))
+        {
+            break;
+        }
+        writes++;
+    }
+    MX25Series_TEST_CHECK(test, state.ftl.wear.relocations != 0);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_matches(&state));
+    MX25Series__test_power_cycle(test);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_mount(test, &state) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_matches(&state));
+
+    //The power lost between erasing a sector and recording its count, the count must carry on from the most worn.
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_collect(&state.ftl, 0xFFFF) == MX25Series_status_ok);
+    previous = state.map[0];
+    MX25Series__test_pattern(state.expected[0], MX25Series_FTL_SECTOR_SIZE, 0x47);
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_write(&state.ftl, 0, 0, MX25Series_FTL_SECTOR_SIZE, state.expected[0]) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_dirty(&state) == 1);
+    for(uint16_t physical = 0; physical < state.ftl.physical_count; physical++)
+    {
+        MX25Series_TEST_CHECK(test, MX25Series_ftl_read_erase_count(&state.ftl, physical, &erase_count) == MX25Series_status_ok);
+        if(physical != previous && erase_count > highest)
+        {
+            highest = erase_count;
+        }
+    }
+    MX25Series_TEST_CHECK(test, highest > MX25Series_FTL_WEAR_THRESHOLD);
+    MX25Series__test_power_cut(test, 1, false);
+    MX25Series_TEST_CHECK(test, MX25Series_HAS_ERROR(MX25Series_ftl_collect(&state.ftl, 1)));
+    MX25Series__test_power_cycle(test);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_mount(test, &state) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_collect(&state.ftl, 0xFFFF) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_ftl_read_erase_count(&state.ftl, previous, &erase_count) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, erase_count == highest + 1);
+    MX25Series_TEST_CHECK(test, MX25Series__test_ftl_matches(&state));
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+#define MX25Series_TEST_IMAGE_LENGTH (300ul * 1024 + 123) /**! Not a whole number of pages or sectors */
+#define MX25Series_TEST_IMAGE_BASE 0x10000
+#define MX25Series_TEST_IMAGE_PACKET 128                  /**! Bytes received at a time */
+#define MX25Series_TEST_IMAGE_INTERVAL 5000               /**! Micro-seconds between packets, 25 KB/s */
+
+/**
+ * MX25Series__test_image_receive feeds image to MX25Series_image_write as a radio would, ticking between packets,
+ * and returns the emulated time the last byte arrived.
+ */
+static uint64_t MX25Series__test_image_receive(MX25Series_Test_t *test, MX25Series_Image_t *image, const uint8_t *data, size_t length)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint64_t next = MX25Series_emulator_get_time_ns(&test->emulator);
+
+    for(size_t received = 0; received < length;)
+    {
+        size_t packet = length - received < MX25Series_TEST_IMAGE_PACKET ? length - received : MX25Series_TEST_IMAGE_PACKET;
+        size_t accepted = 0;
+
+        if(MX25Series_emulator_get_time_ns(&test->emulator) < next)
+        {
+            result |= MX25Series_image_tick(image);
+            MX25Series___delay_micro_second(&test->dev, 20);
+            continue;
+        }
+
+        //A full ring takes less than the whole packet, the rest is offered again.
+        for(size_t sent = 0; sent < packet; sent += accepted)
+        {
+            result |= MX25Series_image_write(image, data + received + sent, packet - sent, &accepted);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return 0;
+            }
+            if(sent + accepted < packet)
+            {
+                MX25Series___delay_micro_second(&test->dev, 20);
+            }
+        }
+        received += packet;
+        next += MX25Series_TEST_IMAGE_INTERVAL * 1000ull;
+    }
+    return MX25Series_emulator_get_time_ns(&test->emulator);
+}
+
+static void MX25Series__test_image(MX25Series_Test_t *test)
+{
+    static uint8_t data[MX25Series_TEST_IMAGE_LENGTH];
+    uint8_t ring[8 * 256];
+    MX25Series_Image_t image;
+    uint64_t start;
+    uint64_t last_byte;
+    uint64_t serial_ns;
+    uint32_t crc = 0;
+    size_t accepted;
+
+    MX25Series__test_pattern(data, sizeof(data), 0x1A6E);
+    test->emulator.latency_percent = 25;
+
+    //Old contents everywhere, so every sector must be erased, and the flash time of doing it all serially.
+    memset(test->emulator.memory + MX25Series_TEST_IMAGE_BASE, 0, 0x50000);
+    start = MX25Series_emulator_get_time_ns(&test->emulator);
+    MX25Series_TEST_CHECK(test, MX25Series_erase_range(&test->dev, MX25Series_TEST_IMAGE_BASE, 0x4C000) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&test->dev, MX25Series_TEST_IMAGE_BASE, sizeof(data), data) ==
+                                MX25Series_status_ok);
+    serial_ns = MX25Series_emulator_get_time_ns(&test->emulator) - start;
+    memset(test->emulator.memory + MX25Series_TEST_IMAGE_BASE, 0, 0x50000);
+
+    start = MX25Series_emulator_get_time_ns(&test->emulator);
+    MX25Series_TEST_CHECK(test, MX25Series_image_begin(&image, &test->dev, MX25Series_TEST_IMAGE_BASE, sizeof(data), ring, sizeof(ring),
+                                                       MX25Series_CRC_32) == MX25Series_status_ok);
+    last_byte = MX25Series__test_image_receive(test, &image, data, sizeof(data));
+    MX25Series_TEST_CHECK(test, last_byte != 0);
+    MX25Series_TEST_CHECK(test, MX25Series_image_finish(&image, &crc) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, crc == MX25Series_crc(MX25Series_CRC_32, 0, data, sizeof(data)));
+    MX25Series_TEST_CHECK(test, memcmp(test->emulator.memory + MX25Series_TEST_IMAGE_BASE, data, sizeof(data)) == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.memory[MX25Series_TEST_IMAGE_BASE + sizeof(data)] == 0xFF);
+
+    //The erases and programs overlapped reception, leaving well under the serial flash time once the last byte arrived.
+    MX25Series_TEST_CHECK(test, serial_ns > (last_byte - start) / 2);
+    MX25Series_TEST_CHECK(test, MX25Series_emulator_get_time_ns(&test->emulator) - last_byte < serial_ns / 10);
+
+    //An image corrupted after programming fails its CRC.
+    MX25Series_TEST_CHECK(test, MX25Series_image_begin(&image, &test->dev, MX25Series_TEST_IMAGE_BASE, 1000, ring, sizeof(ring),
+                                                       MX25Series_CRC_32C) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series__test_image_receive(test, &image, data, 1000) != 0);
+    while(image.programmed < 1000 && !MX25Series_HAS_ERROR(MX25Series_image_tick(&image)))
+    {
+        MX25Series___delay_micro_second(&test->dev, 20);
+    }
+    test->emulator.memory[MX25Series_TEST_IMAGE_BASE + 500] ^= 0x10;
+    MX25Series_TEST_CHECK(test, MX25Series_image_finish(&image, &crc) == MX25Series_status_error_verify);
+
+    //Too much data, too little data, bad regions and rings, and a failed program.
+    MX25Series_TEST_CHECK(test, MX25Series_image_begin(&image, &test->dev, MX25Series_TEST_IMAGE_BASE, 1000, ring, sizeof(ring),
+                                                       MX25Series_CRC_32C) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_image_write(&image, data, 1001, &accepted) == MX25Series_status_error_invalid_argument);
+    MX25Series_TEST_CHECK(test, MX25Series_image_finish(&image, NULL) == MX25Series_status_error_invalid_argument);
+    MX25Series_TEST_CHECK(test, MX25Series_image_begin(&image, &test->dev, MX25Series_TEST_IMAGE_BASE + 0x100, 10, ring, sizeof(ring),
+                                                       MX25Series_CRC_32) == MX25Series_status_error_invalid_argument);
+    MX25Series_TEST_CHECK(test, MX25Series_image_begin(&image, &test->dev, 0, 10, ring, 256, MX25Series_CRC_32) ==
+                                MX25Series_status_error_invalid_argument);
+    MX25Series_TEST_CHECK(test, MX25Series_image_begin(&image, &test->dev, MX25Series_TEST_IMAGE_BASE, 1000, ring, sizeof(ring),
+                                                       MX25Series_CRC_32C) == MX25Series_status_ok);
+    test->emulator.fail_programs = 1;
+    MX25Series_image_write(&image, data, 1000, &accepted);
+    MX25Series_TEST_CHECK(test, MX25Series_image_finish(&image, NULL) == MX25Series_status_error_program);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+static void MX25Series__test_check_modes(MX25Series_Test_t *test)
+{
+    static uint8_t page_data[256];
+    MX25Series_Write_Buffer_Page_t page;
+    MX25Series_Write_Buffer_t buffer;
+    uint8_t zeros[14];
+    uint8_t read[14];
+    uint8_t pattern[1024];
+
+    memset(zeros, 0, sizeof(zeros));
+    MX25Series__test_pattern(pattern, sizeof(pattern), 0xC4EC);
+
+    MX25Series_TEST_CHECK(test, MX25Series_set_check_mode(&test->dev, MX25Series_Check_Full, 0) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data_paged(&test->dev, 0x1000, sizeof(pattern), pattern) == MX25Series_status_ok);
+
+    //A flush over part of a programmed page sends 0xFF for the bytes it did not touch, which must pass the read back.
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_init(&buffer, &test->dev, &page, 1, page_data, 0) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_write(&buffer, 4, 6, zeros) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_flush(&buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_write(&buffer, 0, 4, zeros) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_write(&buffer, 10, 4, zeros) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_flush(&buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_deinit(&buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data(&test->dev, true, 0, sizeof(read), read) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(read, zeros, sizeof(zeros)) == 0);
+
+    //The same over the start of the programmed pattern, sampling every page.
+    MX25Series_TEST_CHECK(test, MX25Series_set_check_mode(&test->dev, MX25Series_Check_Sampled, 1) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_init(&buffer, &test->dev, &page, 1, page_data, 0) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_write(&buffer, 0x1000 + 8, 6, zeros) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_flush(&buffer) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_buffer_deinit(&buffer) == MX25Series_status_ok);
+    memset(pattern + 8, 0, 6);
+    MX25Series_TEST_CHECK(test, MX25Series_read_stored_data(&test->dev, true, 0x1000, 256, page_data) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(page_data, pattern, 256) == 0);
+
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+
+#if defined(MX25Series_ENABLE_STATISTICS)
+static void MX25Series__test_statistics(MX25Series_Test_t *test)
+{
+    static MX25Series_Statistics_t statistics;
+    static MX25Series_Statistics_Counters_t counters;
+    uint16_t sectors[16];
+    uint16_t copy[20];
+    uint8_t page[256];
+    MX25Series_Statistics_Command_t *command;
+
+    MX25Series_TEST_CHECK(test, MX25Series_statistics_init(&statistics, &test->dev, sectors, 16) == MX25Series_status_ok);
+
+    //A Sector Erase and a 32 KB Block Erase, each counted once per sector they cover.
+    MX25Series_TEST_CHECK(test, MX25Series_set_write_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_erase(&test->dev, MX25Series_Erase_Block_4K, 0x1000) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, sectors[1] == 0);
+    MX25Series_TEST_CHECK(test, MX25Series_wait_for_operation(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_set_write_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_erase(&test->dev, MX25Series_Erase_Block_32K, 0x8000) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_wait_for_operation(&test->dev) == MX25Series_status_ok);
+    for(uint8_t sector = 0; sector < 16; sector++)
+    {
+        MX25Series_TEST_CHECK(test, sectors[sector] == (sector == 1 || sector >= 8 ? 1 : 0));
+    }
+    MX25Series_TEST_CHECK(test, statistics.counters.erase.count == 2);
+    MX25Series_TEST_CHECK(test, statistics.counters.erase.min <= statistics.counters.erase.max);
+    MX25Series_TEST_CHECK(test, MX25Series_statistics_get_percentile(&statistics.counters.erase, 100) == statistics.counters.erase.max);
+
+    //A failed erase still takes time, but leaves the sector counts alone.
+    test->emulator.fail_erases = 1;
+    MX25Series_TEST_CHECK(test, MX25Series_set_write_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_erase(&test->dev, MX25Series_Erase_Block_4K, 0x2000) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_wait_for_operation(&test->dev) == MX25Series_status_error_erase);
+    MX25Series_TEST_CHECK(test, sectors[2] == 0);
+    MX25Series_TEST_CHECK(test, statistics.counters.erase.count == 3);
+
+    //One Page Program, its address and data counted as bytes, and its WIP polls.
+    MX25Series__test_pattern(page, sizeof(page), 0x61);
+    MX25Series_TEST_CHECK(test, MX25Series_set_write_enable(&test->dev, true) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_write_stored_data(&test->dev, 0x1000, sizeof(page), page) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, MX25Series_wait_for_operation(&test->dev) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, statistics.counters.program.count == 1);
+    MX25Series_TEST_CHECK(test, statistics.counters.polling.count == 4);
+    MX25Series_TEST_CHECK(test, statistics.counters.wip_polls >= 4);
+
+    command = MX25Series_statistics_get_command(&statistics, MX25Series_Command_PP);
+    MX25Series_TEST_CHECK(test, command != NULL && command->count == 1 && command->bytes == 3 + sizeof(page));
+    command = MX25Series_statistics_get_command(&statistics, MX25Series_Command_SE);
+    MX25Series_TEST_CHECK(test, command != NULL && command->count == 2 && command->bytes == 2 * 3);
+    command = MX25Series_statistics_get_command(&statistics, MX25Series_Command_BE32K);
+    MX25Series_TEST_CHECK(test, command != NULL && command->count == 1);
+    command = MX25Series_statistics_get_command(&statistics, MX25Series_Command_WREN);
+    MX25Series_TEST_CHECK(test, command != NULL && command->count == 4);
+    command = MX25Series_statistics_get_command(&statistics, MX25Series_Command_RDSR);
+    MX25Series_TEST_CHECK(test, command != NULL && command->count >= statistics.counters.wip_polls);
+    MX25Series_TEST_CHECK(test, MX25Series_statistics_get_command(&statistics, MX25Series_Command_CE) == NULL);
+    MX25Series_TEST_CHECK(test, statistics.counters.untracked_commands == 0);
+
+    //A snapshot pads the sector counts past the end with 0, a reset keeps them unless asked.
+    memset(copy, 0xAA, sizeof(copy));
+    MX25Series_TEST_CHECK(test, MX25Series_statistics_snapshot(&statistics, &counters, copy, 20) == MX25Series_status_ok);
+    MX25Series_TEST_CHECK(test, memcmp(&counters, &statistics.counters, sizeof(counters)) == 0);
+    MX25Series_TEST_CHECK(test, memcmp(copy, sectors, sizeof(sectors)) == 0);
+    MX25Series_TEST_CHECK(test, copy[16] == 0 && copy[19] == 0);
+    MX25Series_statistics_reset(&statistics, false);
+    MX25Series_TEST_CHECK(test, statistics.counters.erase.count == 0);
+    MX25Series_TEST_CHECK(test, MX25Series_statistics_get_command(&statistics, MX25Series_Command_PP) == NULL);
+    MX25Series_TEST_CHECK(test, sectors[1] == 1);
+    MX25Series_statistics_reset(&statistics, true);
+    MX25Series_TEST_CHECK(test, sectors[1] == 0);
+
+    MX25Series_statistics_deinit(&statistics);
+    MX25Series_TEST_CHECK(test, test->dev.statistics == NULL);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.framing_errors == 0);
+    MX25Series_TEST_CHECK(test, test->emulator.counters.ignored_commands == 0);
+}
+#endif
+
+static const struct
+{
+    const char *name;
+    MX25Series_Test_Function_t function;
+} MX25Series__tests[] = {
+        {"read_modes", MX25Series__test_read_modes},
+        {"program_modes", MX25Series__test_program_modes},
+        {"cache", MX25Series__test_cache},
+        {"write_buffer", MX25Series__test_write_buffer},
+        {"power", MX25Series__test_power},
+        {"deep_power_down", MX25Series__test_deep_power_down},
+        {"suspend", MX25Series__test_suspend},
+        {"async", MX25Series__test_async},
+        {"sfdp", MX25Series__test_sfdp},
+        {"shared_bus", MX25Series__test_shared_bus},
+        {"stripe", MX25Series__test_stripe},
+        {"erase_plan", MX25Series__test_erase_plan},
+        {"update_range", MX25Series__test_update_range},
+        {"log", MX25Series__test_log},
+        {"journal", MX25Series__test_journal},
+        {"ftl", MX25Series__test_ftl},
+        {"check_modes", MX25Series__test_check_modes},
+#if defined(MX25Series_ENABLE_STATISTICS)
+        {"statistics", MX25Series__test_statistics},
+#endif
+        {"image", MX25Series__test_image},
+};
+
+int main(int argc, char **argv)
+{
+    static MX25Series_Test_t test;
+    uint32_t failed = 0;
+    uint32_t run = 0;
+
+    for(size_t i = 0; i < sizeof(MX25Series__tests) / sizeof(MX25Series__tests[0]); i++)
+    {
+        bool selected = argc < 2;
+
+        for(int arg = 1; arg < argc; arg++)
+        {
+            selected |= strcmp(argv[arg], MX25Series__tests[i].name) == 0;
+        }
+        if(!selected)
+        {
+            continue;
+        }
+
+        memset(&test, 0, sizeof(test));
+        test.name = MX25Series__tests[i].name;
+        if(!MX25Series__test_setup(&test, &MX25R6435F_Chip_Def_Low_Power))
+        {
+            fprintf(stderr, "Failed to create the emulator.\n");
+            return 1;
+        }
+        MX25Series__tests[i].function(&test);
+        MX25Series_emulator_deinit(&test.emulator);
+
+        printf("%s: %u checks, %u failed\n", test.name, test.checks, test.failures);
+        failed += test.failures != 0;
+        run++;
+    }
+
+    printf("%u of %u tests failed\n", failed, run);
+    return failed != 0;
+}
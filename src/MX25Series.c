@@ -21,6 +21,12 @@
  */
 
 #include "MX25Series.h"
+#include "MX25Series_Cache.h"
+#include "MX25Series_Write_Buffer.h"
+#include "MX25Series_Statistics.h"
+#include "MX25Series_Bus.h"
+#include "MX25Series_Power.h"
+#include "MX25Series_Async.h"
 #include "stdio.h"
 
 MX25Series_Chip_Info_t MX25R6435F_Chip_Def_Low_Power = {
@@ -29,6 +35,7 @@ MX25Series_Chip_Info_t MX25R6435F_Chip_Def_Low_Power = {
         .memory_density=MX25R6435F_MEMORY_DENSITY,
         .memory_size=MX25R6435F_MEMORY_SIZE,
         .page_size=MX25R6435F_PAGE_SIZE,
+        .erase_types=MX25Series_ERASE_TYPE_ALL,
         .timing = {
                 .tBP=MX25R6435F_tBP_LP,
                 .tPP=MX25R6435F_tPP_LP,
@@ -37,8 +44,21 @@ MX25Series_Chip_Info_t MX25R6435F_Chip_Def_Low_Power = {
                 .tBE64K=MX25R6435F_tBE64K_LP,
                 .tCE=MX25R6435F_tCE_LP,
                 .tWSR=MX25R6435F_tW_LP,
+                .tSUS=MX25R6435F_tSUS_LP,
+                .tRS=MX25R6435F_tRS_LP,
+                .tDP=MX25R6435F_tDP_LP,
+                .tRES1=MX25R6435F_tRES1_LP,
                 .tUNKNOWN=MX25Series_tUNKNOWN_TIMING
         },
+        .dummy_cycles = {
+                .fast_read=MX25R6435F_DUMMY_FAST_READ,
+                .dread=MX25R6435F_DUMMY_DREAD,
+                .qread=MX25R6435F_DUMMY_QREAD,
+                .dual_io=MX25R6435F_DUMMY_2READ,
+                .quad_io=MX25R6435F_DUMMY_4READ,
+                .dual_io_dc=MX25R6435F_DUMMY_2READ_DC,
+                .quad_io_dc=MX25R6435F_DUMMY_4READ_DC
+        },
         .name="MX25R6435F"
 };
 
@@ -48,6 +68,7 @@ MX25Series_Chip_Info_t MX25R6435F_Chip_Def_High_Performance = {
         .memory_density=MX25R6435F_MEMORY_DENSITY,
         .memory_size=MX25R6435F_MEMORY_SIZE,
         .page_size=MX25R6435F_PAGE_SIZE,
+        .erase_types=MX25Series_ERASE_TYPE_ALL,
         .timing = {
                 .tBP=MX25R6435F_tBP_HP,
                 .tPP=MX25R6435F_tPP_HP,
@@ -56,12 +77,294 @@ MX25Series_Chip_Info_t MX25R6435F_Chip_Def_High_Performance = {
                 .tBE64K=MX25R6435F_tBE64K_HP,
                 .tCE=MX25R6435F_tCE_HP,
                 .tWSR=MX25R6435F_tW_HP,
+                .tSUS=MX25R6435F_tSUS_HP,
+                .tRS=MX25R6435F_tRS_HP,
+                .tDP=MX25R6435F_tDP_HP,
+                .tRES1=MX25R6435F_tRES1_HP,
                 .tUNKNOWN=MX25Series_tUNKNOWN_TIMING
         },
+        .dummy_cycles = {
+                .fast_read=MX25R6435F_DUMMY_FAST_READ,
+                .dread=MX25R6435F_DUMMY_DREAD,
+                .qread=MX25R6435F_DUMMY_QREAD,
+                .dual_io=MX25R6435F_DUMMY_2READ,
+                .quad_io=MX25R6435F_DUMMY_4READ,
+                .dual_io_dc=MX25R6435F_DUMMY_2READ_DC,
+                .quad_io_dc=MX25R6435F_DUMMY_4READ_DC
+        },
         .name="MX25R6435F"
 };
 
 
+static void MX25Series__set_busy(MX25Series_t *dev, MX25Series_Operation_enum_t operation, uint32_t memory_address, uint32_t length)
+{
+    dev->busy_operation = operation;
+    dev->busy_start = MX25Series___get_micro_seconds(dev);
+    dev->busy_address = memory_address;
+    dev->busy_length = length;
+}
+
+static void MX25Series__record_completion(MX25Series_t *dev, uint32_t elapsed)
+{
+    MX25Series_Operation_enum_t operation = dev->busy_operation;
+
+    if(operation != MX25Series_Operation_None && operation < MX25Series_Operation_Count)
+    {
+        uint32_t previous = dev->observed_time[operation];
+
+        //Exponentially weighted, so a single slow operation does not push every later wait out.
+        dev->observed_time[operation] = previous == 0 ? elapsed : (previous * 3 + elapsed) / 4;
+    }
+    MX25Series_STATISTICS_COMPLETION(dev, operation, elapsed);
+    if(dev->power != NULL)
+    {
+        //The idle time counts from the end of the operation, not from the request that started it.
+        dev->power->last_active = dev->busy_start + elapsed;
+    }
+    dev->busy_operation = MX25Series_Operation_None;
+}
+
+#if !defined(MX25Series_ENABLE_TRANSFER_HOOK)
+static MX25Series_status_enum_t MX25Series__write_lanes(MX25Series_t *dev, uint8_t lanes, size_t length, uint8_t* buffer)
+{
+    if(lanes == 1)
+    {
+        return MX25Series___write(dev, length, buffer);
+    }
+#if defined(MX25Series_ENABLE_MULTI_IO)
+    return MX25Series___write_multi_io(dev, lanes, length, buffer);
+#else
+    return MX25Series_status_error_unsupported;
+#endif
+}
+
+static MX25Series_status_enum_t MX25Series__read_lanes(MX25Series_t *dev, uint8_t lanes, size_t length, uint8_t* buffer)
+{
+    if(lanes == 1)
+    {
+        return MX25Series___read(dev, length, buffer);
+    }
+#if defined(MX25Series_ENABLE_MULTI_IO)
+    return MX25Series___read_multi_io(dev, lanes, length, buffer);
+#else
+    return MX25Series_status_error_unsupported;
+#endif
+}
+#endif
+
+static void MX25Series__transaction(MX25Series_Transaction_t *transaction, MX25Series_COMMAND_enum_t command)
+{
+    memset(transaction, 0, sizeof(MX25Series_Transaction_t));
+    transaction->command = command;
+    transaction->address_lanes = 1;
+}
+
+static void MX25Series__transaction_address(MX25Series_Transaction_t *transaction, uint32_t memory_address, uint8_t lanes)
+{
+    transaction->address_length = sizeof(transaction->address);
+    transaction->address_lanes = lanes;
+    transaction->address[0] = (memory_address & 0xFF0000) >> 16;
+    transaction->address[1] = (memory_address & 0xFF00) >> 8;
+    transaction->address[2] = (memory_address & 0xFF);
+}
+
+static void MX25Series__transaction_segment(
+        MX25Series_Transaction_t *transaction,
+        MX25Series_Segment_Direction_enum_t direction,
+        uint8_t lanes,
+        size_t length,
+        uint8_t* buffer)
+{
+    MX25Series_Segment_t *segment = &transaction->segments[transaction->segment_count++];
+    segment->direction = direction;
+    segment->lanes = lanes;
+    segment->length = length;
+    segment->buffer = buffer;
+}
+
+/**
+ * MX25Series__touch notes the end of a frame for MX25Series_sleep_tick.
+ */
+static void MX25Series__touch(MX25Series_t *dev)
+{
+    if(dev->deep_power_down.idle_time != 0)
+    {
+        dev->deep_power_down.last_access = MX25Series___get_micro_seconds(dev);
+    }
+}
+
+/**
+ * MX25Series__execute carries out a transaction with MX25Series___transfer when MX25Series_ENABLE_TRANSFER_HOOK is
+ * defined, otherwise with the per call platform functions, holding the device's bus for the frame.
+ */
+#if !defined(MX25Series_ENABLE_TRANSFER_HOOK)
+/**
+ * MX25Series__execute_start asserts CS and clocks out the command, address and dummy bytes of a transaction.
+ */
+static MX25Series_status_enum_t MX25Series__execute_start(MX25Series_t *dev, MX25Series_Transaction_t *transaction)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    MX25Series___enable_cs_pin(dev, true);
+
+    //The command is always sent on a single lane.
+    result = MX25Series___issue_command(dev, (MX25Series_COMMAND_enum_t)transaction->command);
+
+    if(transaction->address_length > 0)
+    {
+        result |= MX25Series__write_lanes(dev, transaction->address_lanes, transaction->address_length, transaction->address);
+    }
+
+    if(transaction->dummy_length > 0)
+    {
+        uint8_t dummy[8];
+        uint8_t remaining = transaction->dummy_length;
+
+        memset(dummy, dev->transfer_dummy_byte, sizeof(dummy));
+        while(remaining > 0)
+        {
+            uint8_t chunk = remaining > sizeof(dummy) ? sizeof(dummy) : remaining;
+            result |= MX25Series__write_lanes(dev, transaction->address_lanes, chunk, dummy);
+            remaining -= chunk;
+        }
+    }
+    return result;
+}
+#endif
+
+static MX25Series_status_enum_t MX25Series__execute(MX25Series_t *dev, MX25Series_Transaction_t *transaction)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t i;
+
+    //In deep power-down every command but RES is ignored.
+    result = MX25Series_release_deep_power_down(dev);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    result = MX25Series_bus_acquire(dev->bus, dev);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    MX25Series_STATISTICS_COMMAND(dev, transaction->command);
+    MX25Series_STATISTICS_BYTES(dev, transaction->address_length + transaction->dummy_length);
+    for(i = 0; i < transaction->segment_count; i++)
+    {
+        MX25Series_STATISTICS_BYTES(dev, transaction->segments[i].length);
+    }
+
+#if defined(MX25Series_ENABLE_TRANSFER_HOOK)
+    result = MX25Series___transfer(dev, transaction);
+#else
+    result = MX25Series__execute_start(dev, transaction);
+
+    for(i = 0; i < transaction->segment_count; i++)
+    {
+        MX25Series_Segment_t *segment = &transaction->segments[i];
+        if(segment->direction == MX25Series_Segment_TX)
+        {
+            result |= MX25Series__write_lanes(dev, segment->lanes, segment->length, segment->buffer);
+        }
+        else
+        {
+            result |= MX25Series__read_lanes(dev, segment->lanes, segment->length, segment->buffer);
+        }
+    }
+
+    MX25Series___enable_cs_pin(dev, false);
+#endif
+    MX25Series_bus_release(dev->bus, dev);
+    MX25Series__touch(dev);
+    return result;
+}
+
+/**
+ * MX25Series__get_read_framing works out the address/data lane counts and the number of dummy bytes, clocked on
+ * the address lanes, for the given read mode.
+ */
+static MX25Series_status_enum_t MX25Series__get_read_framing(
+        MX25Series_t *dev,
+        MX25Series_Read_Mode_enum_t mode,
+        uint8_t *address_lanes,
+        uint8_t *data_lanes,
+        uint8_t *dummy_bytes)
+{
+    bool dc = (dev->configuration_register & MX25Series_CR_DC_MASK) != 0;
+    bool quad = false;
+    uint8_t dummy_cycles = 0;
+
+    if(dev->chip_def == NULL)
+    {
+        return MX25Series_status_error_invalid_chip_def;
+    }
+
+    switch(mode)
+    {
+        case MX25Series_Read_Mode_READ:
+            *address_lanes = 1; *data_lanes = 1;
+            break;
+        case MX25Series_Read_Mode_FAST_READ:
+            *address_lanes = 1; *data_lanes = 1;
+            dummy_cycles = dev->chip_def->dummy_cycles.fast_read;
+            break;
+        case MX25Series_Read_Mode_DREAD:
+            *address_lanes = 1; *data_lanes = 2;
+            dummy_cycles = dev->chip_def->dummy_cycles.dread;
+            break;
+        case MX25Series_Read_Mode_2READ:
+            *address_lanes = 2; *data_lanes = 2;
+            dummy_cycles = dc ? dev->chip_def->dummy_cycles.dual_io_dc : dev->chip_def->dummy_cycles.dual_io;
+            break;
+        case MX25Series_Read_Mode_QREAD:
+            *address_lanes = 1; *data_lanes = 4; quad = true;
+            dummy_cycles = dev->chip_def->dummy_cycles.qread;
+            break;
+        case MX25Series_Read_Mode_4READ:
+            *address_lanes = 4; *data_lanes = 4; quad = true;
+            dummy_cycles = dc ? dev->chip_def->dummy_cycles.quad_io_dc : dev->chip_def->dummy_cycles.quad_io;
+            break;
+        default:
+            return MX25Series_status_error_invalid_argument;
+    }
+
+#if !defined(MX25Series_ENABLE_MULTI_IO)
+    if(*data_lanes != 1)
+    {
+        return MX25Series_status_error_unsupported;
+    }
+#endif
+
+    //Every mode other than READ has dummy cycles, zero means the chip does not support the mode.
+    //The dummy cycles are clocked on the address lanes and must make up whole bytes.
+    if((mode != MX25Series_Read_Mode_READ && dummy_cycles == 0) || ((dummy_cycles * *address_lanes) % 8) != 0)
+    {
+        return MX25Series_status_error_unsupported;
+    }
+    *dummy_bytes = (dummy_cycles * *address_lanes) / 8;
+
+    if(quad && (dev->status_register & MX25Series_SR_QE_MASK) == 0)
+    {
+        //The QE bit is non-volatile, it may have been set before dev was initialised.
+        uint8_t status_register = 0;
+        MX25Series_status_enum_t result = MX25Series_read_status_register(dev, &status_register);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        if((status_register & MX25Series_SR_QE_MASK) == 0)
+        {
+            return MX25Series_status_error_unsupported;
+        }
+    }
+
+    return MX25Series_status_ok;
+}
+
+
 MX25Series_status_enum_t MX25Series_init(MX25Series_t *dev, MX25Series_Chip_Info_t *chip_def, uint8_t cs_pin, uint8_t reset_pin, uint8_t wp_pin, uint8_t transfer_dummy_byte, void* ctx)
 {
     memset(dev, 0, sizeof(MX25Series_t));
@@ -71,229 +374,1435 @@ MX25Series_status_enum_t MX25Series_init(MX25Series_t *dev, MX25Series_Chip_Info
     dev->transfer_dummy_byte = transfer_dummy_byte;
     dev->ctx = ctx;
     dev->chip_def = chip_def;
+    dev->read_mode = MX25Series_Read_Mode_FAST_READ;
+    dev->program_mode = MX25Series_Program_Mode_PP;
+    dev->check_mode = MX25Series_Check_Fail_Flags;
+    dev->check_interval = MX25Series_CHECK_INTERVAL;
 
     MX25Series___enable_cs_pin(dev, false);
     MX25Series___enable_reset_pin(dev, false);
     MX25Series___enable_write_protect_pin(dev, false);
 
-    if(dev->chip_def == NULL)
+    if(dev->chip_def == NULL)
+    {
+        return MX25Series_status_error_invalid_chip_def;
+    }
+
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_read_identification(MX25Series_t *dev, int *manufacturer_id, int *memory_type, int *memory_density)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Transaction_t transaction;
+    uint8_t value[3] = {0};
+
+    MX25Series__transaction(&transaction, MX25Series_Command_RDID);
+    MX25Series__transaction_segment(&transaction, MX25Series_Segment_RX, 1, sizeof(value), value);
+    result = MX25Series__execute(dev, &transaction);
+
+    *manufacturer_id = value[0];
+    *memory_type = value[1];
+    *memory_density = value[2];
+
+    if(dev->chip_def == NULL)
+    {
+        return MX25Series_status_error_invalid_chip_def;
+    }
+
+    if(
+            value[0] != dev->chip_def->manufacturer_id &&
+            value[1] != dev->chip_def->memory_type &&
+            value[2] != dev->chip_def->memory_density
+    )
+    {
+        return MX25Series_status_error_incorrect_ids;
+    }
+
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_read_electronic_signature(MX25Series_t *dev, int *electronic_id)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Transaction_t transaction;
+    uint8_t value = 0;
+
+    //RES is followed by three dummy bytes before the Electronic ID.
+    MX25Series__transaction(&transaction, MX25Series_Command_RES);
+    transaction.dummy_length = 3;
+    MX25Series__transaction_segment(&transaction, MX25Series_Segment_RX, 1, sizeof(value), &value);
+    result = MX25Series__execute(dev, &transaction);
+    *electronic_id = value;
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_read_manufacture_and_device_id(MX25Series_t *dev, int *manufacturer_id, int *memory_type)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Transaction_t transaction;
+    uint8_t value[2];
+
+    MX25Series__transaction(&transaction, MX25Series_Command_REMS);
+    MX25Series__transaction_segment(&transaction, MX25Series_Segment_RX, 1, sizeof(value), value);
+    result = MX25Series__execute(dev, &transaction);
+    *manufacturer_id = value[0];
+    *memory_type = value[1];
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_read_status_register(MX25Series_t *dev, uint8_t *status_register)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Transaction_t transaction;
+
+    MX25Series__transaction(&transaction, MX25Series_Command_RDSR);
+    MX25Series__transaction_segment(&transaction, MX25Series_Segment_RX, 1, 1, status_register);
+    result = MX25Series__execute(dev, &transaction);
+    dev->status_register = *status_register;
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_read_configuration_register(MX25Series_t *dev, uint16_t *configuration_register)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Transaction_t transaction;
+    uint8_t value[2] = {0};
+
+    MX25Series__transaction(&transaction, MX25Series_Command_RDCR);
+    MX25Series__transaction_segment(&transaction, MX25Series_Segment_RX, 1, sizeof(value), value);
+    result = MX25Series__execute(dev, &transaction);
+
+    //CR1 is sent first and holds the high byte of the MX25Series_CR_* fields.
+    *configuration_register = (uint16_t)((value[0] << 8) | value[1]);
+    dev->configuration_register = *configuration_register;
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_configure_chip(
+        MX25Series_t *dev,
+        uint8_t status_register,
+        uint16_t configuration_register)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Transaction_t transaction;
+    uint8_t value[3] = {0};
+
+    value[0] = status_register;
+    value[1] = (configuration_register & 0xFF00) >> 8;
+    value[2] = (configuration_register & 0xFF);
+
+    MX25Series__transaction(&transaction, MX25Series_Command_WRSR);
+    MX25Series__transaction_segment(&transaction, MX25Series_Segment_TX, 1, sizeof(value), value);
+    result = MX25Series__execute(dev, &transaction);
+    MX25Series__set_busy(dev, MX25Series_Operation_Write_Status, 0, 0);
+
+    dev->status_register = status_register;
+    dev->configuration_register = configuration_register;
+
+    //Switch to the timing table of the L/H mode just written.
+    MX25Series_power_sync(dev->power, configuration_register);
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_set_quad_enable(MX25Series_t *dev, bool enable)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t status_register = 0;
+    uint16_t configuration_register = 0;
+
+    result = MX25Series_read_status_register(dev, &status_register);
+    result |= MX25Series_read_configuration_register(dev, &configuration_register);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    if(((status_register & MX25Series_SR_QE_MASK) != 0) == enable)
+    {
+        return MX25Series_status_ok;
+    }
+
+    status_register &= ~MX25Series_SR_QE_MASK;
+    status_register |= enable ? MX25Series_SR_QE_QE_ENABLE : MX25Series_SR_QE_QE_DISABLE;
+
+    //WIP and WEL are read only, leave them clear.
+    status_register &= ~(MX25Series_SR_WIP_MASK | MX25Series_SR_WEL_MASK);
+
+    result = MX25Series_set_write_enable(dev, true);
+    result |= MX25Series_configure_chip(dev, status_register, configuration_register);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    result = MX25Series_wait_for_operation(dev);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    result = MX25Series_read_status_register(dev, &status_register);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    if(((status_register & MX25Series_SR_QE_MASK) != 0) != enable)
+    {
+        return MX25Series_status_error_verify;
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_set_write_enable(MX25Series_t *dev, bool enable)
+{
+    MX25Series_Transaction_t transaction;
+
+    MX25Series__transaction(&transaction, enable ? MX25Series_Command_WREN : MX25Series_Command_WRDI);
+    return MX25Series__execute(dev, &transaction);
+}
+
+MX25Series_status_enum_t MX25Series_read_stored_data(
+        MX25Series_t *dev,
+        bool use_fast_mode,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer)
+{
+    return MX25Series_read_stored_data_mode(
+            dev,
+            use_fast_mode ? MX25Series_Read_Mode_FAST_READ : MX25Series_Read_Mode_READ,
+            memory_address,
+            length,
+            buffer);
+}
+
+/**
+ * MX25Series__read_array reads the memory array itself, without the bytes waiting in the write buffer.
+ */
+static MX25Series_status_enum_t MX25Series__read_array(
+        MX25Series_t *dev,
+        MX25Series_Read_Mode_enum_t mode,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Transaction_t transaction;
+    uint8_t address_lanes = 1;
+    uint8_t data_lanes = 1;
+    uint8_t dummy_bytes = 0;
+
+    result = MX25Series__get_read_framing(dev, mode, &address_lanes, &data_lanes, &dummy_bytes);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    //Every mode except READ clocks dummy cycles after the address.
+    MX25Series__transaction(&transaction, (MX25Series_COMMAND_enum_t)mode);
+    MX25Series__transaction_address(&transaction, memory_address, address_lanes);
+    transaction.dummy_length = dummy_bytes;
+    MX25Series__transaction_segment(&transaction, MX25Series_Segment_RX, data_lanes, length, buffer);
+    return MX25Series__execute(dev, &transaction);
+}
+
+MX25Series_status_enum_t MX25Series_read_stored_data_mode(
+        MX25Series_t *dev,
+        MX25Series_Read_Mode_enum_t mode,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    result = MX25Series__read_array(dev, mode, memory_address, length, buffer);
+
+    //Serve bytes still waiting in the write buffer.
+    MX25Series_write_buffer_overlay(dev->write_buffer, memory_address, length, buffer);
+
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_read_stored_data_stream(
+        MX25Series_t *dev,
+        MX25Series_Read_Mode_enum_t mode,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer,
+        size_t chunk,
+        MX25Series_Read_Chunk_Callback_t callback,
+        void *context)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    size_t offset;
+
+    if(chunk == 0 || callback == NULL)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+#if defined(MX25Series_ENABLE_TRANSFER_HOOK)
+    //The hook takes whole frames.
+    for(offset = 0; offset < length; offset += chunk)
+    {
+        size_t step = length - offset < chunk ? length - offset : chunk;
+
+        result = MX25Series_read_stored_data_mode(dev, mode, memory_address + offset, step, buffer + offset);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        callback(context, buffer + offset, step);
+    }
+    return MX25Series_status_ok;
+#else
+    MX25Series_Transaction_t transaction;
+    uint8_t address_lanes = 1;
+    uint8_t data_lanes = 1;
+    uint8_t dummy_bytes = 0;
+
+    result = MX25Series__get_read_framing(dev, mode, &address_lanes, &data_lanes, &dummy_bytes);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    MX25Series__transaction(&transaction, (MX25Series_COMMAND_enum_t)mode);
+    MX25Series__transaction_address(&transaction, memory_address, address_lanes);
+    transaction.dummy_length = dummy_bytes;
+
+    result = MX25Series_release_deep_power_down(dev);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    result = MX25Series_bus_acquire(dev->bus, dev);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    MX25Series_STATISTICS_COMMAND(dev, transaction.command);
+    MX25Series_STATISTICS_BYTES(dev, transaction.address_length + transaction.dummy_length + length);
+
+    result = MX25Series__execute_start(dev, &transaction);
+    for(offset = 0; offset < length && !MX25Series_HAS_ERROR(result); offset += chunk)
+    {
+        size_t step = length - offset < chunk ? length - offset : chunk;
+
+        result |= MX25Series__read_lanes(dev, data_lanes, step, buffer + offset);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            break;
+        }
+        MX25Series_write_buffer_overlay(dev->write_buffer, memory_address + offset, step, buffer + offset);
+        callback(context, buffer + offset, step);
+    }
+    MX25Series___enable_cs_pin(dev, false);
+    MX25Series_bus_release(dev->bus, dev);
+    MX25Series__touch(dev);
+    return result;
+#endif
+}
+
+MX25Series_status_enum_t MX25Series_set_read_mode(MX25Series_t *dev, MX25Series_Read_Mode_enum_t mode)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t address_lanes = 1;
+    uint8_t data_lanes = 1;
+    uint8_t dummy_bytes = 0;
+
+    result = MX25Series__get_read_framing(dev, mode, &address_lanes, &data_lanes, &dummy_bytes);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    dev->read_mode = mode;
+    return MX25Series_status_ok;
+}
+
+const char* MX25Series_get_read_mode_string(MX25Series_Read_Mode_enum_t mode)
+{
+    switch(mode)
+    {
+        case MX25Series_Read_Mode_READ: {return "READ";} break;
+        case MX25Series_Read_Mode_FAST_READ: {return "FAST_READ";} break;
+        case MX25Series_Read_Mode_DREAD: {return "DREAD";} break;
+        case MX25Series_Read_Mode_2READ: {return "2READ";} break;
+        case MX25Series_Read_Mode_QREAD: {return "QREAD";} break;
+        case MX25Series_Read_Mode_4READ: {return "4READ";} break;
+        default: {return "Undefined";}
+    }
+    return "Undefined";
+}
+
+MX25Series_status_enum_t MX25Series_write_stored_data(
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Transaction_t transaction;
+    MX25Series_COMMAND_enum_t command = MX25Series_Command_PP;
+    uint8_t lanes = 1;
+
+#if defined(MX25Series_ENABLE_MULTI_IO)
+    if(dev->program_mode == MX25Series_Program_Mode_4PP && (dev->status_register & MX25Series_SR_QE_MASK) != 0)
+    {
+        command = MX25Series_Command_4PP;
+        lanes = 4;
+    }
+#endif
+
+    //4PP sends the address and the data on all four lanes.
+    MX25Series__transaction(&transaction, command);
+    MX25Series__transaction_address(&transaction, memory_address, lanes);
+    MX25Series__transaction_segment(&transaction, MX25Series_Segment_TX, lanes, length, buffer);
+    result = MX25Series__execute(dev, &transaction);
+    MX25Series__set_busy(dev, MX25Series_Operation_Program, memory_address, length);
+
+    if(dev->cache != NULL && dev->chip_def != NULL && dev->chip_def->page_size != 0)
+    {
+        uint32_t page_offset = memory_address % dev->chip_def->page_size;
+
+        //PP wraps within the page, so a long write can touch any byte of it.
+        if(length > dev->chip_def->page_size - page_offset)
+        {
+            MX25Series_cache_invalidate(dev->cache, memory_address - page_offset, dev->chip_def->page_size);
+        }
+        else
+        {
+            MX25Series_cache_invalidate(dev->cache, memory_address, length);
+        }
+    }
+
+    return result;
+
+}
+
+MX25Series_status_enum_t MX25Series_set_program_mode(MX25Series_t *dev, MX25Series_Program_Mode_enum_t mode)
+{
+    uint8_t status_register = 0;
+
+    switch(mode)
+    {
+        case MX25Series_Program_Mode_PP:
+            dev->program_mode = mode;
+            return MX25Series_status_ok;
+        case MX25Series_Program_Mode_4PP:
+            dev->program_mode = mode;
+            //Refresh the QE bit, 4PP is only used once it is known to be set.
+            return MX25Series_read_status_register(dev, &status_register);
+        default:
+            return MX25Series_status_error_invalid_argument;
+    }
+}
+
+/**
+ * MX25Series__read_back checks a page that has just been programmed against the data sent, when dev->check_mode asks
+ * for it. A program only clears bits, so every bit that was sent as 0 must read back as 0; bits sent as 1, such as
+ * the 0xFF padding of the write buffer, leave whatever was already programmed there.
+ */
+static MX25Series_status_enum_t MX25Series__read_back(MX25Series_t *dev, uint32_t memory_address, size_t length, const uint8_t* data)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t current[MX25Series_CHECK_CHUNK];
+
+    switch(dev->check_mode)
+    {
+        case MX25Series_Check_Sampled:
+            if(++dev->check_count < dev->check_interval)
+            {
+                return MX25Series_status_ok;
+            }
+            dev->check_count = 0;
+            break;
+        case MX25Series_Check_Full:
+            break;
+        default:
+            return MX25Series_status_ok;
+    }
+
+    while(length > 0)
+    {
+        size_t step = length < sizeof(current) ? length : sizeof(current);
+
+        result = MX25Series__read_array(dev, dev->read_mode, memory_address, step, current);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        for(size_t i = 0; i < step; i++)
+        {
+            if((current[i] & ~data[i]) != 0)
+            {
+                return MX25Series_status_error_verify;
+            }
+        }
+
+        memory_address += step;
+        data += step;
+        length -= step;
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_write_stored_data_paged(
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    if(dev->chip_def == NULL || dev->chip_def->page_size == 0)
+    {
+        return MX25Series_status_error_invalid_chip_def;
+    }
+
+    if(memory_address > dev->chip_def->memory_size || length > dev->chip_def->memory_size - memory_address)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    result = MX25Series_power_request(dev->power, MX25Series_Operation_Program, length);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    while(length > 0)
+    {
+        //Never cross a page boundary, PP wraps to the start of the page instead.
+        size_t chunk = dev->chip_def->page_size - (memory_address % dev->chip_def->page_size);
+        if(chunk > length)
+        {
+            chunk = length;
+        }
+
+        result = MX25Series_set_write_enable(dev, true);
+        result |= MX25Series_write_stored_data(dev, memory_address, chunk, buffer);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        result = MX25Series_wait_for_operation(dev);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        result = MX25Series__read_back(dev, memory_address, chunk, buffer);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        memory_address += chunk;
+        buffer += chunk;
+        length -= chunk;
+    }
+
+    return MX25Series_status_ok;
+}
+
+/**
+ * MX25Series__check_fail_flags reads P_FAIL or E_FAIL once operation has finished. WIP clears whether or not the
+ * operation succeeded, so an erase is only counted in the statistics here, once it is known not to have failed.
+ */
+static MX25Series_status_enum_t MX25Series__check_fail_flags(MX25Series_t *dev, MX25Series_Operation_enum_t operation)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t security_register = 0;
+
+    if(operation == MX25Series_Operation_None || operation == MX25Series_Operation_Write_Status ||
+       operation >= MX25Series_Operation_Count)
+    {
+        return MX25Series_status_ok;
+    }
+
+    if(dev->check_mode != MX25Series_Check_None)
+    {
+        result = MX25Series_read_security_register(dev, &security_register);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        if(operation == MX25Series_Operation_Program)
+        {
+            return MX25Series_SCUR_P_FAIL_GET_VALUE(security_register) ? MX25Series_status_error_program : MX25Series_status_ok;
+        }
+        if(MX25Series_SCUR_E_FAIL_GET_VALUE(security_register))
+        {
+            return MX25Series_status_error_erase;
+        }
+    }
+
+    if(operation != MX25Series_Operation_Program)
+    {
+        MX25Series_STATISTICS_ERASE(dev, dev->busy_address, dev->busy_length);
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_wait_for_completion(MX25Series_t *dev, uint32_t max_time)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t status_register = 0;
+    uint32_t start;
+    uint32_t estimate = 0;
+    uint32_t interval;
+    uint32_t interval_cap;
+    uint32_t delay = 0;
+    uint32_t first_poll = 0xFFFFFFFFul;
+
+    //A suspended operation never completes, so let it carry on.
+    if(dev->suspend.active)
+    {
+        result = MX25Series_resume(dev);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+
+    start = dev->busy_operation != MX25Series_Operation_None ? dev->busy_start : MX25Series___get_micro_seconds(dev);
+    estimate = MX25Series_get_operation_typical_time(dev, dev->busy_operation);
+
+    //Poll at 1/16th of the typical time around the typical time, then back off to at most 1/4 of it,
+    //or to 1/64th of the budget while no typical time has been observed.
+    interval = estimate / 16 > MX25Series_WIP_POLL_INTERVAL ? estimate / 16 : MX25Series_WIP_POLL_INTERVAL;
+    interval_cap = estimate != 0 ? estimate / 4 : max_time / 64;
+    if(interval_cap < interval)
+    {
+        interval_cap = interval;
+    }
+
+    for(;;)
+    {
+        uint32_t elapsed;
+
+        result = MX25Series_read_status_register(dev, &status_register);
+        elapsed = MX25Series___get_micro_seconds(dev) - start;
+        MX25Series_STATISTICS_POLL(dev);
+        if(first_poll == 0xFFFFFFFFul)
+        {
+            first_poll = elapsed;
+        }
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        if(!MX25Series_SR_WIP_GET_VALUE(status_register))
+        {
+            MX25Series_Operation_enum_t operation = dev->busy_operation;
+
+            MX25Series_STATISTICS_WAIT(dev, elapsed - first_poll);
+            //The operation finished somewhere in the last delay, take the middle of it.
+            MX25Series__record_completion(dev, elapsed - delay / 2);
+            return MX25Series__check_fail_flags(dev, operation);
+        }
+
+        //The start is rounded down to a micro-second, so a chip taking all of max_time can still be busy at max_time.
+        if(elapsed > max_time)
+        {
+            MX25Series_STATISTICS_WAIT(dev, elapsed - first_poll);
+            return MX25Series_status_error_timeout;
+        }
+
+        if(elapsed + interval < estimate - estimate / 8)
+        {
+            //Sleep through most of the typical time in one go.
+            delay = estimate - estimate / 8 - elapsed;
+        }
+        else
+        {
+            delay = interval;
+            if(elapsed >= estimate)
+            {
+                interval = interval * 2 > interval_cap ? interval_cap : interval * 2;
+            }
+        }
+
+        if(delay > max_time + 1 - elapsed)
+        {
+            delay = max_time + 1 - elapsed;
+        }
+
+        //Other devices on the bus are served while this one is busy.
+        MX25Series_bus_delay(dev, delay);
+    }
+}
+
+MX25Series_status_enum_t MX25Series_wait_for_operation(MX25Series_t *dev)
+{
+    return MX25Series_wait_for_completion(dev, MX25Series_get_operation_max_time(dev, dev->busy_operation));
+}
+
+MX25Series_status_enum_t MX25Series_check_completion(MX25Series_t *dev, bool *busy)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t status_register = 0;
+    uint32_t elapsed;
+
+    if(dev->suspend.active)
+    {
+        *busy = true;
+        return MX25Series_status_ok;
+    }
+
+    result = MX25Series_read_status_register(dev, &status_register);
+    elapsed = MX25Series___get_micro_seconds(dev) - dev->busy_start;
+    MX25Series_STATISTICS_POLL(dev);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    *busy = MX25Series_SR_WIP_GET_VALUE(status_register);
+    if(!*busy)
+    {
+        MX25Series_Operation_enum_t operation = dev->busy_operation;
+
+        if(operation != MX25Series_Operation_None)
+        {
+            MX25Series__record_completion(dev, elapsed);
+        }
+        return MX25Series__check_fail_flags(dev, operation);
+    }
+
+    if(dev->busy_operation != MX25Series_Operation_None && elapsed > MX25Series_get_operation_max_time(dev, dev->busy_operation))
+    {
+        return MX25Series_status_error_timeout;
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_suspend(MX25Series_t *dev)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Transaction_t transaction;
+    uint8_t status_register = 0;
+    uint8_t security_register = 0;
+    uint32_t now;
+    uint32_t start;
+
+    if(dev->suspend.active || dev->busy_operation == MX25Series_Operation_None)
+    {
+        return MX25Series_status_ok;
+    }
+
+    if(dev->busy_operation == MX25Series_Operation_Erase_Chip || dev->busy_operation == MX25Series_Operation_Write_Status)
+    {
+        return MX25Series_status_error_unsupported;
+    }
+
+    //Suspending too soon after a resume starves the operation, wait out the rest of tRS.
+    now = MX25Series___get_micro_seconds(dev);
+    if(dev->suspend.count > 0 && now - dev->suspend.resume_time < dev->chip_def->timing.tRS)
+    {
+        MX25Series___delay_micro_second(dev, dev->chip_def->timing.tRS - (now - dev->suspend.resume_time));
+    }
+
+    MX25Series__transaction(&transaction, MX25Series_Command_PGM_ERS_Suspend);
+    result = MX25Series__execute(dev, &transaction);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    //WIP clears once the chip has suspended, or if the operation finished in the meantime.
+    start = MX25Series___get_micro_seconds(dev);
+    for(;;)
+    {
+        result = MX25Series_read_status_register(dev, &status_register);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        if(!MX25Series_SR_WIP_GET_VALUE(status_register))
+        {
+            break;
+        }
+        if(MX25Series___get_micro_seconds(dev) - start >= dev->chip_def->timing.tSUS)
+        {
+            return MX25Series_status_error_timeout;
+        }
+        MX25Series___delay_micro_second(dev, 1);
+    }
+
+    //ESB/PSB tell a suspended operation apart from one that finished before the suspend took effect.
+    result = MX25Series_read_security_register(dev, &security_register);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    if((security_register & (MX25Series_SCUR_ESB_MASK | MX25Series_SCUR_PSB_MASK)) == 0)
+    {
+        MX25Series_Operation_enum_t operation = dev->busy_operation;
+
+        MX25Series__record_completion(dev, MX25Series___get_micro_seconds(dev) - dev->busy_start);
+        return MX25Series__check_fail_flags(dev, operation);
+    }
+
+    //The operation stopped making progress when the suspend command was sent, not once WIP was seen clear.
+    dev->suspend.active = true;
+    dev->suspend.start = start;
+    dev->suspend.count++;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_resume(MX25Series_t *dev)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Transaction_t transaction;
+    uint32_t now;
+
+    if(!dev->suspend.active)
+    {
+        return MX25Series_status_ok;
+    }
+
+    MX25Series__transaction(&transaction, MX25Series_Command_PGM_ERS_Resume);
+    result = MX25Series__execute(dev, &transaction);
+
+    //Time spent suspended does not count against the operation's budget.
+    now = MX25Series___get_micro_seconds(dev);
+    dev->busy_start += now - dev->suspend.start;
+    dev->suspend.resume_time = now;
+    dev->suspend.active = false;
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_read_stored_data_preempt(
+        MX25Series_t *dev,
+        MX25Series_Read_Mode_enum_t mode,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t start = MX25Series___get_micro_seconds(dev);
+    uint32_t latency;
+    bool busy = false;
+    bool suspended = false;
+
+    if(dev->busy_operation != MX25Series_Operation_None)
+    {
+        result = MX25Series_check_completion(dev, &busy);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+
+    if(busy)
+    {
+        //Data inside the range being programmed or erased is not valid while suspended.
+        bool overlaps = memory_address < dev->busy_address + dev->busy_length &&
+                        dev->busy_address < memory_address + length;
+        bool was_suspended = dev->suspend.active;
+
+        result = overlaps ? MX25Series_status_error_busy : MX25Series_suspend(dev);
+        if(result == MX25Series_status_error_program || result == MX25Series_status_error_erase)
+        {
+            //The operation finished, and failed, before it could be suspended.
+            return result;
+        }
+        if(!MX25Series_HAS_ERROR(result))
+        {
+            //Leave a suspension made by the caller in place, and there is nothing to resume if the operation
+            //finished before it could be suspended.
+            suspended = !was_suspended && dev->suspend.active;
+        }
+        else
+        {
+            result = MX25Series_wait_for_operation(dev);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+        }
+    }
+
+    result = MX25Series_read_stored_data_mode(dev, mode, memory_address, length, buffer);
+
+    if(suspended)
     {
-        return MX25Series_status_error_invalid_chip_def;
+        result |= MX25Series_resume(dev);
     }
 
-    return MX25Series_status_ok;
+    latency = MX25Series___get_micro_seconds(dev) - start;
+    if(latency > dev->suspend.worst_read_latency)
+    {
+        dev->suspend.worst_read_latency = latency;
+    }
+    return result;
 }
 
-MX25Series_status_enum_t MX25Series_read_identification(MX25Series_t *dev, int *manufacturer_id, int *memory_type, int *memory_density)
+MX25Series_status_enum_t MX25Series_enter_deep_power_down(MX25Series_t *dev)
 {
     MX25Series_status_enum_t result = MX25Series_status_init;
-    uint8_t value[3] = {0};
-
-    MX25Series___enable_cs_pin(dev, true);
-    result = MX25Series___issue_command(dev, MX25Series_Command_RDID);
-    result |= MX25Series___read(dev, 3, value);
-    MX25Series___enable_cs_pin(dev, false);
+    MX25Series_Transaction_t transaction;
 
-    *manufacturer_id = value[0];
-    *memory_type = value[1];
-    *memory_density = value[2];
+    if(dev->deep_power_down.active)
+    {
+        return MX25Series_status_ok;
+    }
 
-    if(dev->chip_def == NULL)
+    if(dev->busy_operation != MX25Series_Operation_None || dev->suspend.active)
     {
-        return MX25Series_status_error_invalid_chip_def;
+        return MX25Series_status_error_busy;
     }
 
-    if(
-            value[0] != dev->chip_def->manufacturer_id &&
-            value[1] != dev->chip_def->memory_type &&
-            value[2] != dev->chip_def->memory_density
-    )
+    MX25Series__transaction(&transaction, MX25Series_Command_DP);
+    result = MX25Series__execute(dev, &transaction);
+    if(MX25Series_HAS_ERROR(result))
     {
-        return MX25Series_status_error_incorrect_ids;
+        return result;
     }
 
-    return result;
+    dev->deep_power_down.active = true;
+    dev->deep_power_down.start = MX25Series___get_micro_seconds(dev);
+    dev->deep_power_down.count++;
+    MX25Series___delay_micro_second(dev, dev->chip_def->timing.tDP);
+    return MX25Series_status_ok;
 }
 
-MX25Series_status_enum_t MX25Series_read_electronic_signature(MX25Series_t *dev, int *electronic_id)
+MX25Series_status_enum_t MX25Series_release_deep_power_down(MX25Series_t *dev)
 {
     MX25Series_status_enum_t result = MX25Series_status_init;
-    uint8_t value;
+    MX25Series_Transaction_t transaction;
+    uint32_t start;
 
-    MX25Series___enable_cs_pin(dev, true);
-    result = MX25Series___issue_command(dev, MX25Series_Command_RES);
-    result |= MX25Series___read(dev, sizeof(result), &value);
-    *electronic_id = result;
-    MX25Series___enable_cs_pin(dev, false);
-    return result;
+    if(!dev->deep_power_down.active)
+    {
+        return MX25Series_status_ok;
+    }
+
+    //Cleared first, the RES frame goes through MX25Series__execute too.
+    dev->deep_power_down.active = false;
+    start = MX25Series___get_micro_seconds(dev);
+    MX25Series__transaction(&transaction, MX25Series_Command_RES);
+    result = MX25Series__execute(dev, &transaction);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        dev->deep_power_down.active = true;
+        return result;
+    }
+
+    MX25Series___delay_micro_second(dev, dev->chip_def->timing.tRES1);
+    dev->deep_power_down.wakes++;
+    dev->deep_power_down.wake_latency += MX25Series___get_micro_seconds(dev) - start;
+    dev->deep_power_down.time_asleep += start - dev->deep_power_down.start;
+    return MX25Series_status_ok;
 }
 
-MX25Series_status_enum_t MX25Series_read_manufacture_and_device_id(MX25Series_t *dev, int *manufacturer_id, int *memory_type)
+void MX25Series_set_auto_sleep(MX25Series_t *dev, uint32_t idle_time)
 {
-    MX25Series_status_enum_t result = MX25Series_status_init;
-    uint8_t value[2];
-
-    MX25Series___enable_cs_pin(dev, true);
-    result = MX25Series___issue_command(dev, MX25Series_Command_REMS);
-    result |= MX25Series___read(dev, sizeof(value), (uint8_t *) &value);
-    *manufacturer_id = value[0];
-    *memory_type = value[1];
-    MX25Series___enable_cs_pin(dev, false);
-    return result;
+    dev->deep_power_down.idle_time = idle_time;
+    dev->deep_power_down.last_access = MX25Series___get_micro_seconds(dev);
 }
 
-MX25Series_status_enum_t MX25Series_read_status_register(MX25Series_t *dev, uint8_t *status_register)
+MX25Series_status_enum_t MX25Series_sleep_tick(MX25Series_t *dev)
 {
-    MX25Series_status_enum_t result = MX25Series_status_init;
+    if(dev->deep_power_down.active || dev->deep_power_down.idle_time == 0 ||
+       dev->busy_operation != MX25Series_Operation_None || dev->suspend.active || !MX25Series_async_is_idle(dev))
+    {
+        return MX25Series_status_ok;
+    }
 
-    MX25Series___enable_cs_pin(dev, true);
-    result = MX25Series___issue_command(dev, MX25Series_Command_RDSR);
-    result |= MX25Series___read(dev, 1, status_register);
-    MX25Series___enable_cs_pin(dev, false);
-    return result;
+    if(MX25Series___get_micro_seconds(dev) - dev->deep_power_down.last_access < dev->deep_power_down.idle_time)
+    {
+        return MX25Series_status_ok;
+    }
+    return MX25Series_enter_deep_power_down(dev);
 }
 
-MX25Series_status_enum_t MX25Series_read_configuration_register(MX25Series_t *dev, uint16_t *configuration_register)
+uint32_t MX25Series_get_operation_max_time(MX25Series_t *dev, MX25Series_Operation_enum_t operation)
 {
-    MX25Series_status_enum_t result = MX25Series_status_init;
+    switch(operation)
+    {
+        case MX25Series_Operation_Program:
+            return dev->chip_def->timing.tPP;
+        case MX25Series_Operation_Erase_4K:
+            return dev->chip_def->timing.tSE;
+        case MX25Series_Operation_Erase_32K:
+            return dev->chip_def->timing.tBE32K;
+        case MX25Series_Operation_Erase_64K:
+            return dev->chip_def->timing.tBE64K;
+        case MX25Series_Operation_Erase_Chip:
+            return dev->chip_def->timing.tCE;
+        case MX25Series_Operation_Write_Status:
+            return dev->chip_def->timing.tWSR;
+        case MX25Series_Operation_None:
+        default:
+            return dev->chip_def->timing.tUNKNOWN;
+    }
+}
 
-    MX25Series___enable_cs_pin(dev, true);
-    result = MX25Series___issue_command(dev, MX25Series_Command_RDCR);
-    result |= MX25Series___read(dev, sizeof(*configuration_register), (uint8_t *) configuration_register);
-    MX25Series___enable_cs_pin(dev, false);
-    return result;
+uint32_t MX25Series_get_operation_typical_time(MX25Series_t *dev, MX25Series_Operation_enum_t operation)
+{
+    if(operation >= MX25Series_Operation_Count)
+    {
+        return 0;
+    }
+    if(dev->observed_time[operation] != 0)
+    {
+        return dev->observed_time[operation];
+    }
+
+    switch(operation)
+    {
+        case MX25Series_Operation_Program:
+            return dev->chip_def->typical.tPP;
+        case MX25Series_Operation_Erase_4K:
+            return dev->chip_def->typical.tSE;
+        case MX25Series_Operation_Erase_32K:
+            return dev->chip_def->typical.tBE32K;
+        case MX25Series_Operation_Erase_64K:
+            return dev->chip_def->typical.tBE64K;
+        case MX25Series_Operation_Erase_Chip:
+            return dev->chip_def->typical.tCE;
+        default:
+            return 0;
+    }
 }
 
-MX25Series_status_enum_t MX25Series_configure_chip(
+MX25Series_status_enum_t MX25Series_erase(
         MX25Series_t *dev,
-        uint8_t status_register,
-        uint16_t configuration_register)
+        MX25Series_Erase_enum_t erase_type,
+        uint32_t memory_address)
 {
     MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_COMMAND_enum_t command;
+    MX25Series_Operation_enum_t operation;
+    switch(erase_type)
+    {
+        case MX25Series_Command_SE:
+            operation = MX25Series_Operation_Erase_4K;
+            break;
+        case MX25Series_Command_BE32K:
+            operation = MX25Series_Operation_Erase_32K;
+            break;
+        case MX25Series_Command_BE64K:
+            operation = MX25Series_Operation_Erase_64K;
+            break;
+        case MX25Series_Command_CE:
+            operation = MX25Series_Operation_Erase_Chip;
+            break;
+        default:
+            return result;
+    }
+    command = (MX25Series_COMMAND_enum_t)erase_type;
 
-    MX25Series___enable_cs_pin(dev, true);
-    result = MX25Series___issue_command(dev, MX25Series_Command_WRSR);
-    result |= MX25Series___write(dev, 1, &status_register);
-    result |= MX25Series___write(dev, 2, (uint8_t *) &configuration_register);
-    MX25Series___enable_cs_pin(dev, false);
+    MX25Series_Transaction_t transaction;
+
+    //Send the memory address we wish to erase, except for chip erase.
+    MX25Series__transaction(&transaction, command);
+    if(command != MX25Series_Command_CE) {
+        MX25Series__transaction_address(&transaction, memory_address, 1);
+    }
+    result = MX25Series__execute(dev, &transaction);
+    if(command == MX25Series_Command_CE)
+    {
+        MX25Series__set_busy(dev, operation, 0, dev->chip_def->memory_size);
+    }
+    else
+    {
+        uint32_t size = MX25Series_get_erasure_size(dev, erase_type);
+        MX25Series__set_busy(dev, operation, memory_address - (memory_address % size), size);
+    }
+    MX25Series_cache_invalidate(dev->cache, dev->busy_address, dev->busy_length);
+    MX25Series_write_buffer_discard(dev->write_buffer, dev->busy_address, dev->busy_length);
     return result;
 }
 
-MX25Series_status_enum_t MX25Series_set_write_enable(MX25Series_t *dev, bool enable)
+MX25Series_Erase_enum_t MX25Series_next_erase_step(MX25Series_t *dev, uint32_t memory_address, uint32_t length)
 {
-    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t tSE = dev->chip_def->timing.tSE;
+    uint32_t tBE32K = dev->chip_def->timing.tBE32K;
+    uint32_t tBE64K = dev->chip_def->timing.tBE64K;
+    uint8_t erase_types = dev->chip_def->erase_types != 0 ? dev->chip_def->erase_types : MX25Series_ERASE_TYPE_ALL;
+    bool use_32K;
 
-    MX25Series___enable_cs_pin(dev, true);
-    result = MX25Series___issue_command(dev, enable ? MX25Series_Command_WREN : MX25Series_Command_WRDI);
-    MX25Series___enable_cs_pin(dev, false);
-    return result;
+    if(length == 0 || (memory_address % MX25Series_SECTOR_SIZE) != 0 || (length % MX25Series_SECTOR_SIZE) != 0)
+    {
+        return MX25Series_Erase_Undefined;
+    }
+
+    //Aligned blocks nest, so each fully covered block can be decided on its own.
+    use_32K = (erase_types & MX25Series_ERASE_TYPE_32K) != 0 &&
+              ((erase_types & MX25Series_ERASE_TYPE_4K) == 0 || tBE32K <= 8 * tSE);
+
+    if((erase_types & MX25Series_ERASE_TYPE_64K) != 0 &&
+       (memory_address % MX25Series_BLOCK_64K_SIZE) == 0 && length >= MX25Series_BLOCK_64K_SIZE &&
+       ((erase_types & (MX25Series_ERASE_TYPE_4K | MX25Series_ERASE_TYPE_32K)) == 0 ||
+        tBE64K <= 2 * (use_32K ? tBE32K : 8 * tSE)))
+    {
+        return MX25Series_Erase_Block_64K;
+    }
+
+    if(use_32K && (memory_address % MX25Series_BLOCK_32K_SIZE) == 0 && length >= MX25Series_BLOCK_32K_SIZE)
+    {
+        return MX25Series_Erase_Block_32K;
+    }
+
+    if((erase_types & MX25Series_ERASE_TYPE_4K) == 0)
+    {
+        //Only larger erases exist, the range must cover whole blocks.
+        return MX25Series_Erase_Undefined;
+    }
+    return MX25Series_Erase_Block_4K;
 }
 
-MX25Series_status_enum_t MX25Series_read_stored_data(
+MX25Series_status_enum_t MX25Series_plan_erase_range(
         MX25Series_t *dev,
-        bool use_fast_mode,
         uint32_t memory_address,
-        size_t length,
-        uint8_t* buffer)
+        uint32_t length,
+        MX25Series_Erase_Step_t *steps,
+        size_t max_steps,
+        size_t *step_count,
+        uint32_t *total_time)
 {
-    MX25Series_status_enum_t result = MX25Series_status_init;
-    uint8_t address[3] = {0};
+    size_t count = 0;
+    uint32_t time = 0;
+    uint32_t address = memory_address;
+    uint32_t remaining = length;
 
-    address[0] = (memory_address & 0xFF0000) >> 16;
-    address[1] = (memory_address & 0xFF00) >> 8;
-    address[2] = (memory_address & 0xFF);
-
-    MX25Series___enable_cs_pin(dev, true);
-    
-    //Send the READ Command
-    result = MX25Series___issue_command(dev, use_fast_mode ? MX25Series_Command_FAST_READ : MX25Series_Command_READ);
-
-    //Send the memory address we wish to retrieve
-    result |= MX25Series___write(dev, sizeof(address), address);
+    if(dev->chip_def == NULL)
+    {
+        return MX25Series_status_error_invalid_chip_def;
+    }
 
-    //In fast mode a dummy byte needs to be transferred after the address.
-    if(use_fast_mode)
+    if((memory_address % MX25Series_SECTOR_SIZE) != 0 || (length % MX25Series_SECTOR_SIZE) != 0 ||
+       memory_address > dev->chip_def->memory_size || length > dev->chip_def->memory_size - memory_address)
     {
-        uint8_t dummy = dev->transfer_dummy_byte;
-        MX25Series___write(dev, 1, &dummy);
+        return MX25Series_status_error_invalid_argument;
     }
 
-    //read the data
-    result |= MX25Series___read(dev, length, buffer);
+    while(remaining > 0)
+    {
+        MX25Series_Erase_enum_t erase_type = MX25Series_next_erase_step(dev, address, remaining);
+        uint32_t size = MX25Series_get_erasure_size(dev, erase_type);
+
+        if(erase_type == MX25Series_Erase_Undefined)
+        {
+            //The chip has no erase that fits the rest of the range.
+            return MX25Series_status_error_unsupported;
+        }
+
+        if(steps != NULL && count < max_steps)
+        {
+            steps[count].erase_type = erase_type;
+            steps[count].memory_address = address;
+        }
+        count++;
+        time += MX25Series_get_erasure_max_time(dev, erase_type);
+        address += size;
+        remaining -= size;
+    }
 
-    MX25Series___enable_cs_pin(dev, false);
+    if(length != 0 && length == dev->chip_def->memory_size && dev->chip_def->timing.tCE < time)
+    {
+        count = 1;
+        time = dev->chip_def->timing.tCE;
+        if(steps != NULL && max_steps > 0)
+        {
+            steps[0].erase_type = MX25Series_Erase_Chip;
+            steps[0].memory_address = 0;
+        }
+    }
 
-    return result;
+    if(step_count != NULL)
+    {
+        *step_count = count;
+    }
+    if(total_time != NULL)
+    {
+        *total_time = time;
+    }
+    return MX25Series_status_ok;
 }
 
-MX25Series_status_enum_t MX25Series_write_stored_data(
+MX25Series_status_enum_t MX25Series_erase_range(
         MX25Series_t *dev,
         uint32_t memory_address,
-        size_t length,
-        uint8_t* buffer)
+        uint32_t length)
 {
     MX25Series_status_enum_t result = MX25Series_status_init;
-    uint8_t address[3] = {0};
+    MX25Series_Erase_Step_t step;
+    size_t step_count = 0;
 
-    address[0] = (memory_address & 0xFF0000) >> 16;
-    address[1] = (memory_address & 0xFF00) >> 8;
-    address[2] = (memory_address & 0xFF);
+    result = MX25Series_plan_erase_range(dev, memory_address, length, &step, 1, &step_count, NULL);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
 
-    MX25Series___enable_cs_pin(dev, true);
+    result = MX25Series_power_request(dev->power, length >= MX25Series_BLOCK_64K_SIZE ? MX25Series_Operation_Erase_64K :
+                                                  length >= MX25Series_BLOCK_32K_SIZE ? MX25Series_Operation_Erase_32K :
+                                                  MX25Series_Operation_Erase_4K, length);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    while(length > 0)
+    {
+        MX25Series_Erase_enum_t erase_type = MX25Series_next_erase_step(dev, memory_address, length);
+        uint32_t size = MX25Series_get_erasure_size(dev, erase_type);
+
+        //The plan collapses to a single Chip Erase when that is cheaper.
+        if(step_count == 1 && step.erase_type == MX25Series_Erase_Chip)
+        {
+            erase_type = MX25Series_Erase_Chip;
+            size = length;
+        }
+
+        result = MX25Series_set_write_enable(dev, true);
+        result |= MX25Series_erase(dev, erase_type, memory_address);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
 
-    //Send the PP Command
-    result = MX25Series___issue_command(dev, MX25Series_Command_PP);
-//    result = MX25Series___issue_command(dev, MX25Series_Command_4PP);
+        result = MX25Series_wait_for_operation(dev);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
 
-    //Send the memory address we wish to retrieve
-    result |= MX25Series___write(dev, sizeof(address), address);
+        memory_address += size;
+        length -= size;
+    }
 
-    //write the data
-    result |= MX25Series___write(dev, length, buffer);
+    return MX25Series_status_ok;
+}
 
-    MX25Series___enable_cs_pin(dev, false);
+typedef enum {
+    MX25Series_Update_Same = 0,    /**< The flash already holds the data */
+    MX25Series_Update_Program = 1, /**< Only bits going from 1 to 0, a Page Program is enough */
+    MX25Series_Update_Erase = 2,   /**< A bit goes from 0 to 1, the sector has to be erased */
+} MX25Series_Update_Action_enum_t;
 
-    return result;
+/**
+ * MX25Series__update_action compares the current contents with the new data a word at a time.
+ */
+static MX25Series_Update_Action_enum_t MX25Series__update_action(const uint8_t *current, const uint8_t *data, size_t length)
+{
+    uint32_t differ = 0;
+    uint32_t raise = 0;
+    size_t i = 0;
+
+    for(; i + sizeof(uint32_t) <= length; i += sizeof(uint32_t))
+    {
+        uint32_t current_word;
+        uint32_t data_word;
+
+        //memcpy keeps unaligned buffers safe and compiles to a single load where they are not.
+        memcpy(&current_word, current + i, sizeof(uint32_t));
+        memcpy(&data_word, data + i, sizeof(uint32_t));
+        differ |= current_word ^ data_word;
+        raise |= ~current_word & data_word;
+    }
+    for(; i < length; i++)
+    {
+        differ |= current[i] ^ data[i];
+        raise |= (uint8_t)~current[i] & data[i];
+    }
+
+    if(raise != 0)
+    {
+        return MX25Series_Update_Erase;
+    }
+    return differ != 0 ? MX25Series_Update_Program : MX25Series_Update_Same;
+}
 
+/**
+ * MX25Series__update_page returns the overlap of page with the sector offsets [start, end).
+ */
+static void MX25Series__update_page(uint32_t page, uint32_t page_size, uint32_t start, uint32_t end, uint32_t *first, uint32_t *last)
+{
+    *first = page > start ? page : start;
+    *last = page + page_size < end ? page + page_size : end;
 }
 
-MX25Series_status_enum_t MX25Series_erase(
+MX25Series_status_enum_t MX25Series_update_range(
         MX25Series_t *dev,
-        MX25Series_Erase_enum_t erase_type,
-        uint32_t memory_address)
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer,
+        uint8_t* sector_buffer,
+        MX25Series_Update_Report_t *report)
 {
     MX25Series_status_enum_t result = MX25Series_status_init;
-    MX25Series_COMMAND_enum_t command;
-    switch(erase_type)
+    MX25Series_Update_Report_t counts;
+    uint32_t page_size;
+    uint8_t erase_types;
+
+    memset(&counts, 0, sizeof(MX25Series_Update_Report_t));
+
+    if(dev->chip_def == NULL || dev->chip_def->page_size == 0 || (MX25Series_SECTOR_SIZE % dev->chip_def->page_size) != 0)
     {
-        case MX25Series_Command_SE:
-        case MX25Series_Command_BE32K:
-        case MX25Series_Command_BE64K:
-        case MX25Series_Command_CE:
-            command = (MX25Series_COMMAND_enum_t)erase_type;
-            break;
-        default:
-            return result;
+        return MX25Series_status_error_invalid_chip_def;
     }
 
-    uint8_t address[3] = {0};
-
-    address[0] = (memory_address & 0xFF0000) >> 16;
-    address[1] = (memory_address & 0xFF00) >> 8;
-    address[2] = (memory_address & 0xFF);
+    if(memory_address > dev->chip_def->memory_size || length > dev->chip_def->memory_size - memory_address ||
+       (length > 0 && (buffer == NULL || sector_buffer == NULL)))
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
 
-    MX25Series___enable_cs_pin(dev, true);
+    erase_types = dev->chip_def->erase_types != 0 ? dev->chip_def->erase_types : MX25Series_ERASE_TYPE_ALL;
+    if((erase_types & MX25Series_ERASE_TYPE_4K) == 0)
+    {
+        return MX25Series_status_error_unsupported;
+    }
+    page_size = dev->chip_def->page_size;
 
-    //Send the Erase Command
-    result = MX25Series___issue_command(dev, command);
+    while(length > 0)
+    {
+        uint32_t sector = memory_address - (memory_address % MX25Series_SECTOR_SIZE);
+        uint32_t start = memory_address - sector;
+        uint32_t end = length < MX25Series_SECTOR_SIZE - start ? start + length : MX25Series_SECTOR_SIZE;
+        bool erase = false;
+        uint32_t page;
+
+        result = MX25Series_read_stored_data_mode(dev, dev->read_mode, sector, MX25Series_SECTOR_SIZE, sector_buffer);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        for(page = start - (start % page_size); page < end && !erase; page += page_size)
+        {
+            uint32_t first;
+            uint32_t last;
+
+            MX25Series__update_page(page, page_size, start, end, &first, &last);
+            erase = MX25Series__update_action(sector_buffer + first, buffer + (first - start), last - first) ==
+                    MX25Series_Update_Erase;
+        }
+
+        if(!erase)
+        {
+            counts.sectors_skipped++;
+            for(page = start - (start % page_size); page < end; page += page_size)
+            {
+                uint32_t first;
+                uint32_t last;
+                uint8_t *data;
+
+                MX25Series__update_page(page, page_size, start, end, &first, &last);
+                data = buffer + (first - start);
+                if(MX25Series__update_action(sector_buffer + first, data, last - first) == MX25Series_Update_Same)
+                {
+                    counts.pages_skipped++;
+                    continue;
+                }
+
+                //Only send the bytes from the first to the last that change.
+                while(sector_buffer[first] == *data)
+                {
+                    first++;
+                    data++;
+                }
+                while(sector_buffer[last - 1] == buffer[last - 1 - start])
+                {
+                    last--;
+                }
+
+                result = MX25Series_write_stored_data_paged(dev, sector + first, last - first, data);
+                if(MX25Series_HAS_ERROR(result))
+                {
+                    return result;
+                }
+                counts.pages_programmed++;
+                counts.bytes_programmed += last - first;
+            }
+        }
+        else
+        {
+            memcpy(sector_buffer + start, buffer, end - start);
+
+            result = MX25Series_set_write_enable(dev, true);
+            result |= MX25Series_erase(dev, MX25Series_Erase_Block_4K, sector);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+            result = MX25Series_wait_for_operation(dev);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+            counts.sectors_erased++;
+
+            //Put the rest of the sector back, leaving out the 0xFF bytes at either end of each page.
+            for(page = 0; page < MX25Series_SECTOR_SIZE; page += page_size)
+            {
+                uint32_t first = page;
+                uint32_t last = page + page_size;
+
+                while(first < last && sector_buffer[first] == 0xFF)
+                {
+                    first++;
+                }
+                while(last > first && sector_buffer[last - 1] == 0xFF)
+                {
+                    last--;
+                }
+                if(first == last)
+                {
+                    continue;
+                }
+
+                result = MX25Series_write_stored_data_paged(dev, sector + first, last - first, sector_buffer + first);
+                if(MX25Series_HAS_ERROR(result))
+                {
+                    return result;
+                }
+                counts.pages_programmed++;
+                counts.bytes_programmed += last - first;
+            }
+        }
+
+        memory_address += end - start;
+        buffer += end - start;
+        length -= end - start;
+    }
 
-    //Send the memory address we wish to erase, except for chip erase.
-    if(command != MX25Series_Command_CE) {
-        result |= MX25Series___write(dev, sizeof(address), address);
+    if(report != NULL)
+    {
+        *report = counts;
     }
+    return MX25Series_status_ok;
+}
 
-    MX25Series___enable_cs_pin(dev, false);
-    return result;
+uint32_t MX25Series_get_erasure_size(MX25Series_t *dev, MX25Series_Erase_enum_t erase_type)
+{
+    switch(erase_type)
+    {
+        case MX25Series_Erase_Block_4K:
+            return MX25Series_SECTOR_SIZE;
+        case MX25Series_Erase_Block_32K:
+            return MX25Series_BLOCK_32K_SIZE;
+        case MX25Series_Erase_Block_64K:
+            return MX25Series_BLOCK_64K_SIZE;
+        case MX25Series_Erase_Chip:
+            return dev->chip_def->memory_size;
+        case MX25Series_Erase_Undefined:
+        default:
+            return 0;
+    }
 }
 
 const char* MX25Series_get_erasure_size_string(MX25Series_Erase_enum_t size)
@@ -333,16 +1842,29 @@ uint32_t MX25Series_get_erasure_max_time(MX25Series_t *dev, MX25Series_Erase_enu
     return dev->chip_def->timing.tUNKNOWN;
 }
 
+MX25Series_status_enum_t MX25Series_read_sfdp(MX25Series_t *dev, uint32_t address, size_t length, uint8_t* buffer)
+{
+    MX25Series_Transaction_t transaction;
+
+    //RDSFDP always has 8 dummy cycles after the address.
+    MX25Series__transaction(&transaction, MX25Series_Command_RDSFDP);
+    MX25Series__transaction_address(&transaction, address, 1);
+    transaction.dummy_length = 1;
+    MX25Series__transaction_segment(&transaction, MX25Series_Segment_RX, 1, length, buffer);
+    return MX25Series__execute(dev, &transaction);
+}
+
 MX25Series_status_enum_t MX25Series_read_security_register(
         MX25Series_t *dev,
         uint8_t *security_register)
 {
     MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Transaction_t transaction;
 
-    MX25Series___enable_cs_pin(dev, true);
-    result = MX25Series___issue_command(dev, MX25Series_Command_RDSCUR);
-    result |= MX25Series___read(dev, 1, security_register);
-    MX25Series___enable_cs_pin(dev, false);
+    MX25Series__transaction(&transaction, MX25Series_Command_RDSCUR);
+    MX25Series__transaction_segment(&transaction, MX25Series_Segment_RX, 1, 1, security_register);
+    result = MX25Series__execute(dev, &transaction);
+    dev->security_register = *security_register;
     return result;
 }
 
@@ -351,8 +1873,72 @@ MX25Series_status_enum_t MX25Series_write_security_register(
         uint8_t *security_register)
 {
     MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Transaction_t transaction;
+    uint8_t current = 0;
 
-    return result;
+    //Every other bit is a read only flag.
+    if((*security_register & ~MX25Series_SCUR_LDSO_MASK) != 0)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    result = MX25Series_read_security_register(dev, &current);
+    if(MX25Series_HAS_ERROR(result) || (current & MX25Series_SCUR_LDSO_MASK) == (*security_register & MX25Series_SCUR_LDSO_MASK))
+    {
+        *security_register = current;
+        return result;
+    }
+
+    //LDSO is OTP, once set it can not be cleared.
+    if((*security_register & MX25Series_SCUR_LDSO_MASK) == 0)
+    {
+        *security_register = current;
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    result = MX25Series_set_write_enable(dev, true);
+    MX25Series__transaction(&transaction, MX25Series_Command_WRSCUR);
+    result |= MX25Series__execute(dev, &transaction);
+    MX25Series__set_busy(dev, MX25Series_Operation_Write_Status, 0, 0);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    result = MX25Series_wait_for_operation(dev);
+    result |= MX25Series_read_security_register(dev, security_register);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    if((*security_register & MX25Series_SCUR_LDSO_MASK) == 0)
+    {
+        return MX25Series_status_error_verify;
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_set_check_mode(MX25Series_t *dev, MX25Series_Check_Mode_enum_t mode, uint32_t interval)
+{
+    switch(mode)
+    {
+        case MX25Series_Check_Sampled:
+            if(interval == 0)
+            {
+                return MX25Series_status_error_invalid_argument;
+            }
+            dev->check_interval = interval;
+            //Fall through
+        case MX25Series_Check_None:
+        case MX25Series_Check_Fail_Flags:
+        case MX25Series_Check_Full:
+            dev->check_mode = mode;
+            dev->check_count = 0;
+            return MX25Series_status_ok;
+        default:
+            return MX25Series_status_error_invalid_argument;
+    }
 }
 
 // __attribute__((weak)) MX25Series_status_enum_t MX25Series___issue_command(MX25Series_t *dev, MX25Series_COMMAND_enum_t command)
@@ -398,6 +1984,12 @@ MX25Series_status_enum_t MX25Series_write_security_register(
 //     dev->state = 0xFFFFFFF8;
 // }
 
+// __attribute__((weak)) uint32_t MX25Series___get_micro_seconds(MX25Series_t *dev)
+// {
+//     dev->state = 0xFFFFFFF9;
+//     return 0;
+// }
+
 
 
 
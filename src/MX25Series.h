@@ -49,7 +49,8 @@ typedef enum
     MX25Series_Command_SE = 0x20,
     MX25Series_Command_BE32K = 0x52,
     MX25Series_Command_BE64K = 0xD8,
-    MX25Series_Command_CE = 0x60, // 0x60 Or 0xC7
+    MX25Series_Command_CE = 0x60,
+    MX25Series_Command_CE_Alternate = 0xC7,
     MX25Series_Command_RDSFDP = 0x5A,
 //Register/Setting Commands - Page 18
 
@@ -58,8 +59,10 @@ typedef enum
     MX25Series_Command_RDSR = 0x05,
     MX25Series_Command_RDCR = 0x15,
     MX25Series_Command_WRSR = 0x01,
-    MX25Series_Command_PGM_ERS_Suspend = 0x75, // 0x75 or 0xB0
-    MX25Series_Command_PGM_ERS_Resume = 0x7A,  // 0x7A or 0x30
+    MX25Series_Command_PGM_ERS_Suspend = 0x75,
+    MX25Series_Command_PGM_ERS_Suspend_Alternate = 0xB0,
+    MX25Series_Command_PGM_ERS_Resume = 0x7A,
+    MX25Series_Command_PGM_ERS_Resume_Alternate = 0x30,
     MX25Series_Command_DP = 0xB9,
     MX25Series_Command_SBL = 0xC0,
 
@@ -88,6 +91,12 @@ typedef enum
     MX25Series_status_error_incorrect_ids =    (   0b10000 | MX25Series_status_error),
     MX25Series_status_error_invalid_chip_def = (  0b100000 | MX25Series_status_error),
     MX25Series_status_error_ctx_nullptr =      ( 0b1000000 | MX25Series_status_error),
+    MX25Series_status_error_invalid_argument = (0b10000000 | MX25Series_status_error),
+    MX25Series_status_error_unsupported =    (0b100000000 | MX25Series_status_error),
+    MX25Series_status_error_verify =        (0b1000000000 | MX25Series_status_error),
+    MX25Series_status_error_busy =         (0b10000000000 | MX25Series_status_error),
+    MX25Series_status_error_program =     (0b100000000000 | MX25Series_status_error),
+    MX25Series_status_error_erase =      (0b1000000000000 | MX25Series_status_error),
 
 } MX25Series_status_enum_t;
 
@@ -120,6 +129,114 @@ typedef enum {
     MX25Series_Erase_Block_64K = MX25Series_Command_BE64K,
     MX25Series_Erase_Chip = MX25Series_Command_CE,
 } MX25Series_Erase_enum_t;
+
+#define MX25Series_SECTOR_SIZE      0x1000 /**< 4 KB, Sector Erase (SE) size */
+#define MX25Series_BLOCK_32K_SIZE   0x8000 /**< 32 KB, Block Erase (BE32K) size */
+#define MX25Series_BLOCK_64K_SIZE  0x10000 /**< 64 KB, Block Erase (BE64K) size */
+
+/**
+ * @brief A single erase command of an erase plan, see MX25Series_plan_erase_range.
+ */
+typedef struct {
+    MX25Series_Erase_enum_t erase_type;
+    uint32_t memory_address;
+} MX25Series_Erase_Step_t;
+
+/**
+ * @brief What MX25Series_update_range had to do, and what it avoided.
+ */
+typedef struct {
+    uint32_t sectors_erased;
+    uint32_t sectors_skipped;    /**! Sectors in the range that did not need an erase */
+    uint32_t pages_programmed;   /**! Page Programs issued, including pages restored after an erase */
+    uint32_t pages_skipped;      /**! Pages in the range that already held the data */
+    uint32_t bytes_programmed;
+} MX25Series_Update_Report_t;
+
+#ifndef MX25Series_TRANSACTION_MAX_SEGMENTS
+    #define MX25Series_TRANSACTION_MAX_SEGMENTS 4 /**! Data segments a MX25Series_Transaction_t can carry */
+#endif
+
+typedef enum {
+    MX25Series_Segment_TX = 0, /**< Bytes clocked out to the chip */
+    MX25Series_Segment_RX = 1, /**< Bytes clocked in from the chip */
+} MX25Series_Segment_Direction_enum_t;
+
+/**
+ * @brief A contiguous run of data bytes within a transaction.
+ */
+typedef struct {
+    MX25Series_Segment_Direction_enum_t direction;
+    uint8_t lanes;    /**! Data lines the bytes are clocked on, 1, 2 or 4 */
+    size_t length;
+    uint8_t *buffer;
+} MX25Series_Segment_t;
+
+/**
+ * @brief A complete SPI frame: CS is asserted, the command is clocked out on one lane, followed by the address,
+ * the dummy bytes and then each segment in order, after which CS is released.
+ */
+typedef struct {
+    uint8_t command;
+    uint8_t address_length;   /**! Number of address bytes, 0 or 3 */
+    uint8_t address_lanes;    /**! Data lines the address and dummy bytes are clocked on */
+    uint8_t address[3];       /**! Most significant byte first */
+    uint8_t dummy_length;     /**! Number of transfer_dummy_byte bytes clocked after the address */
+    uint8_t segment_count;
+    MX25Series_Segment_t segments[MX25Series_TRANSACTION_MAX_SEGMENTS];
+} MX25Series_Transaction_t;
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Read commands, named by (command-address-data) lane count.
+ */
+typedef enum {
+    MX25Series_Read_Mode_READ = MX25Series_Command_READ,           /**< 1-1-1, no dummy cycles */
+    MX25Series_Read_Mode_FAST_READ = MX25Series_Command_FAST_READ, /**< 1-1-1 */
+    MX25Series_Read_Mode_DREAD = MX25Series_Command_DREAD,         /**< 1-1-2 */
+    MX25Series_Read_Mode_2READ = MX25Series_Command_2READ,         /**< 1-2-2 */
+    MX25Series_Read_Mode_QREAD = MX25Series_Command_QREAD,         /**< 1-1-4, requires QE */
+    MX25Series_Read_Mode_4READ = MX25Series_Command_4READ,         /**< 1-4-4, requires QE */
+} MX25Series_Read_Mode_enum_t;
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Page Program commands, named by (command-address-data) lane count.
+ */
+typedef enum {
+    MX25Series_Program_Mode_PP = MX25Series_Command_PP,            /**< 1-1-1 */
+    MX25Series_Program_Mode_4PP = MX25Series_Command_4PP,          /**< 1-4-4, falls back to PP while QE is clear */
+} MX25Series_Program_Mode_enum_t;
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief How programs and erases are checked once WIP clears.
+ */
+typedef enum {
+    MX25Series_Check_None = 0,       /**< Trust WIP */
+    MX25Series_Check_Fail_Flags = 1, /**< Read P_FAIL/E_FAIL from the Security Register after every program and erase */
+    MX25Series_Check_Sampled = 2,    /**< As Fail_Flags, and MX25Series_write_stored_data_paged reads back one page in check_interval */
+    MX25Series_Check_Full = 3,       /**< As Fail_Flags, and MX25Series_write_stored_data_paged reads back every page */
+} MX25Series_Check_Mode_enum_t;
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Program/Erase operations tracked while the chip reports WIP.
+ */
+typedef enum {
+    MX25Series_Operation_None = 0,       /**< No tracked operation in progress */
+    MX25Series_Operation_Program,        /**< Page Program */
+    MX25Series_Operation_Erase_4K,       /**< Sector Erase */
+    MX25Series_Operation_Erase_32K,      /**< 32KB Block Erase */
+    MX25Series_Operation_Erase_64K,      /**< 64KB Block Erase */
+    MX25Series_Operation_Erase_Chip,     /**< Chip Erase */
+    MX25Series_Operation_Write_Status,    /**< Write Status Register */
+    MX25Series_Operation_Count,
+} MX25Series_Operation_enum_t;
+
 // ----------------------------------------------------------------------------
 
 typedef enum {
@@ -214,10 +331,47 @@ Low Power mode or High Performance mode. Please check Ordering Information for t
 support. */
 #define MX25Series_CR_LH  (1ul << 1ul)
 
+// Register 'MX25Series.SCUR'.
+#define MX25Series_SCUR_E_FAIL_POSITION  (6ul)
+#define MX25Series_SCUR_E_FAIL_MASK  (0x1ul << 6ul)  /**< [6..6] The Erase Fail (E_FAIL) bit is set when the last erase failed or targeted a protected
+area, and cleared by the next successful erase. */
+#define MX25Series_SCUR_E_FAIL  (1ul << 6ul)
+#define MX25Series_SCUR_E_FAIL_GET_VALUE(REGISTER) (((REGISTER) & MX25Series_SCUR_E_FAIL_MASK) >> MX25Series_SCUR_E_FAIL_POSITION)
+#define MX25Series_SCUR_P_FAIL_POSITION  (5ul)
+#define MX25Series_SCUR_P_FAIL_MASK  (0x1ul << 5ul)  /**< [5..5] The Program Fail (P_FAIL) bit is set when the last program failed or targeted a protected
+area, and cleared by the next successful program. */
+#define MX25Series_SCUR_P_FAIL  (1ul << 5ul)
+#define MX25Series_SCUR_P_FAIL_GET_VALUE(REGISTER) (((REGISTER) & MX25Series_SCUR_P_FAIL_MASK) >> MX25Series_SCUR_P_FAIL_POSITION)
+#define MX25Series_SCUR_ESB_POSITION  (3ul)
+#define MX25Series_SCUR_ESB_MASK  (0x1ul << 3ul)  /**< [3..3] Erase Suspend Bit, set while an erase is suspended */
+#define MX25Series_SCUR_ESB  (1ul << 3ul)
+#define MX25Series_SCUR_PSB_POSITION  (2ul)
+#define MX25Series_SCUR_PSB_MASK  (0x1ul << 2ul)  /**< [2..2] Program Suspend Bit, set while a program is suspended */
+#define MX25Series_SCUR_PSB  (1ul << 2ul)
+#define MX25Series_SCUR_LDSO_POSITION  (1ul)
+#define MX25Series_SCUR_LDSO_MASK  (0x1ul << 1ul)  /**< [1..1] Lock-down Secured OTP, an OTP bit set by WRSCUR that makes the 8K-bit secured OTP
+area read only. */
+#define MX25Series_SCUR_LDSO  (1ul << 1ul)
+#define MX25Series_SCUR_SOTP_POSITION  (0ul)
+#define MX25Series_SCUR_SOTP_MASK  (0x1ul << 0ul)  /**< [0..0] Secured OTP indicator, set when the secured OTP area was locked at the factory */
+#define MX25Series_SCUR_SOTP  (1ul << 0ul)
+
 #ifndef MX25Series_tUNKNOWN_TIMING
     #define MX25Series_tUNKNOWN_TIMING 5000000
 #endif
 
+#ifndef MX25Series_CHECK_INTERVAL
+    #define MX25Series_CHECK_INTERVAL 16 /**! Default pages programmed per page read back by MX25Series_Check_Sampled */
+#endif
+
+#ifndef MX25Series_CHECK_CHUNK
+    #define MX25Series_CHECK_CHUNK 32 /**! Stack bytes used to read back a programmed page */
+#endif
+
+#ifndef MX25Series_WIP_POLL_INTERVAL
+    #define MX25Series_WIP_POLL_INTERVAL 50 /**! Minimum micro-seconds between Status Register polls while WIP is set */
+#endif
+
 // These are the Max values in micro-seconds. From Page 69 of the Datasheet.
 #define MX25R6435F_MANUFACTURER_ID     0xC2
 #define MX25R6435F_MEMORY_TYPE         0x28
@@ -225,6 +379,14 @@ support. */
 #define MX25R6435F_MEMORY_SIZE     0x800000 /**< 8 MB */
 #define MX25R6435F_PAGE_SIZE            256 /**! 256 bytes, Page Size */
 
+#define MX25R6435F_DUMMY_FAST_READ        8 /**! FAST_READ dummy cycles */
+#define MX25R6435F_DUMMY_DREAD            8 /**! DREAD dummy cycles */
+#define MX25R6435F_DUMMY_QREAD            8 /**! QREAD dummy cycles */
+#define MX25R6435F_DUMMY_2READ            4 /**! 2READ dummy cycles, CR DC=0 */
+#define MX25R6435F_DUMMY_4READ            6 /**! 4READ dummy cycles, CR DC=0 */
+#define MX25R6435F_DUMMY_2READ_DC         8 /**! 2READ dummy cycles, CR DC=1 */
+#define MX25R6435F_DUMMY_4READ_DC        10 /**! 4READ dummy cycles, CR DC=1 */
+
 #define MX25R6435F_tBP_LP               100 /**! 100 micro-seconds, Low Power Byte-Program Max Time */
 #define MX25R6435F_tPP_LP             10000 /**! 10 milli-seconds, Low Power Page Program Max Time */
 #define MX25R6435F_tSE_LP            240000 /**! 240 milli-seconds, Low Power Sector Erase Max Time */
@@ -232,6 +394,10 @@ support. */
 #define MX25R6435F_tBE64K_LP        3500000 /**! 3.5 seconds, Low Power 64KB Block Erase Max Time */
 #define MX25R6435F_tCE_LP         240000000 /**! 240 seconds, Low Power Chip Erase Max Time */
 #define MX25R6435F_tW_LP              30000 /**! 20 milli-seconds. Low Power Write Status Register Cycle Time */
+#define MX25R6435F_tSUS_LP               20 /**! 20 micro-seconds, Low Power Program/Erase Suspend Latency Max */
+#define MX25R6435F_tRS_LP               400 /**! 400 micro-seconds, Low Power Resume to next Suspend Min Interval */
+#define MX25R6435F_tDP_LP                10 /**! 10 micro-seconds, Low Power CS# high to Deep Power-down Mode */
+#define MX25R6435F_tRES1_LP              35 /**! 35 micro-seconds, Low Power CS# high to Standby Mode after RES */
 
 #define MX25R6435F_tBP_HP               100 /**! 100 micro-seconds, High Performance Byte-Program Max Time */
 #define MX25R6435F_tPP_HP             10000 /**! 10 milli-seconds, High Performance Page Program Max Time */
@@ -240,8 +406,17 @@ support. */
 #define MX25R6435F_tBE64K_HP        3000000 /**! 3 seconds, High Performance 64KB Block Erase Max Time */
 #define MX25R6435F_tCE_HP         150000000 /**! 150 seconds, High Performance Chip Erase Max Time */
 #define MX25R6435F_tW_HP              20000 /**! 20 milli-seconds. High Performance Write Status Register Cycle Time */
+#define MX25R6435F_tSUS_HP               20 /**! 20 micro-seconds, High Performance Program/Erase Suspend Latency Max */
+#define MX25R6435F_tRS_HP               400 /**! 400 micro-seconds, High Performance Resume to next Suspend Min Interval */
+#define MX25R6435F_tDP_HP                10 /**! 10 micro-seconds, High Performance CS# high to Deep Power-down Mode */
+#define MX25R6435F_tRES1_HP              35 /**! 35 micro-seconds, High Performance CS# high to Standby Mode after RES */
 
 
+#define MX25Series_ERASE_TYPE_4K  0x01 /**! SE is supported */
+#define MX25Series_ERASE_TYPE_32K 0x02 /**! BE32K is supported */
+#define MX25Series_ERASE_TYPE_64K 0x04 /**! BE64K is supported */
+#define MX25Series_ERASE_TYPE_ALL (MX25Series_ERASE_TYPE_4K | MX25Series_ERASE_TYPE_32K | MX25Series_ERASE_TYPE_64K)
+
 typedef struct
 {
     uint8_t manufacturer_id;
@@ -249,6 +424,7 @@ typedef struct
     uint8_t memory_density;
     uint32_t memory_size;
     uint32_t page_size;
+    uint8_t erase_types;   /**! MX25Series_ERASE_TYPE_* flags, 0 is treated as MX25Series_ERASE_TYPE_ALL */
     struct{
         uint32_t tBP;      /**! Byte-Program Max Time */
         uint32_t tPP;      /**! Page Program Max Time */
@@ -257,14 +433,41 @@ typedef struct
         uint32_t tBE64K;   /**! 64KB Block Erase Max Time */
         uint32_t tCE;      /**! Chip Erase Max Time */
         uint32_t tWSR;     /**! Status Register Write Max Time */
+        uint32_t tSUS;     /**! Program/Erase Suspend Latency Max Time */
+        uint32_t tRS;      /**! Resume to next Suspend Min Time, lets the suspended operation make progress */
+        uint32_t tDP;      /**! CS# high to Deep Power-down Mode Max Time */
+        uint32_t tRES1;    /**! CS# high to Standby Mode after RES Max Time, no command is accepted before it */
         uint32_t tUNKNOWN; /**! Unknown Operation Max Time */
     }timing;
+    struct{
+        uint32_t tPP;      /**! Page Program Typical Time, 0 if not known */
+        uint32_t tSE;      /**! Sector Erase Typical Time, 0 if not known */
+        uint32_t tBE32K;   /**! 32KB Block Erase Typical Time, 0 if not known */
+        uint32_t tBE64K;   /**! 64KB Block Erase Typical Time, 0 if not known */
+        uint32_t tCE;      /**! Chip Erase Typical Time, 0 if not known */
+    }typical;
+    struct{
+        uint8_t fast_read;   /**! FAST_READ dummy cycles */
+        uint8_t dread;       /**! DREAD dummy cycles, 0 if not supported */
+        uint8_t qread;       /**! QREAD dummy cycles, 0 if not supported */
+        uint8_t dual_io;     /**! 2READ dummy cycles with CR DC=0, 0 if not supported */
+        uint8_t quad_io;     /**! 4READ dummy cycles with CR DC=0, 0 if not supported */
+        uint8_t dual_io_dc;  /**! 2READ dummy cycles with CR DC=1 */
+        uint8_t quad_io_dc;  /**! 4READ dummy cycles with CR DC=1 */
+    }dummy_cycles;
     char name[20];
 }MX25Series_Chip_Info_t;
 
 extern MX25Series_Chip_Info_t MX25R6435F_Chip_Def_Low_Power;
 extern MX25Series_Chip_Info_t MX25R6435F_Chip_Def_High_Performance;
 
+struct MX25Series_Cache_t;
+struct MX25Series_Write_Buffer_t;
+struct MX25Series_Statistics_t;
+struct MX25Series_Async_t;
+struct MX25Series_Bus_t;
+struct MX25Series_Power_t;
+
 typedef struct
 {
     uint8_t cs_pin;
@@ -274,6 +477,44 @@ typedef struct
     int state;
     MX25Series_Chip_Info_t *chip_def;
     void* ctx;
+    uint8_t status_register;                                    /**! Last value read from or written to the Status Register */
+    uint16_t configuration_register;                            /**! Last value read from or written to the Configuration Register */
+    uint8_t security_register;                                  /**! Last value read from the Security Register */
+    MX25Series_Read_Mode_enum_t read_mode;                      /**! Read mode used by MX25Series_set_read_mode callers */
+    MX25Series_Program_Mode_enum_t program_mode;                /**! Page Program command used by MX25Series_write_stored_data */
+    MX25Series_Operation_enum_t busy_operation;                 /**! The operation last issued, cleared once WIP is seen clear */
+    uint32_t busy_start;                                        /**! MX25Series___get_micro_seconds() when busy_operation was issued */
+    uint32_t observed_time[MX25Series_Operation_Count];         /**! Smoothed observed completion time in micro-seconds, 0 if never observed */
+    uint32_t busy_address;                                      /**! First address affected by busy_operation */
+    uint32_t busy_length;                                       /**! Number of bytes affected by busy_operation */
+    MX25Series_Check_Mode_enum_t check_mode;                    /**! How programs and erases are checked, see MX25Series_set_check_mode */
+    uint32_t check_interval;                                    /**! Pages programmed per page read back by MX25Series_Check_Sampled */
+    uint32_t check_count;                                       /**! Pages programmed since the last read back */
+    struct{
+        bool active;                 /**! busy_operation is suspended */
+        uint32_t start;              /**! When busy_operation was suspended */
+        uint32_t resume_time;        /**! When busy_operation was last resumed */
+        uint32_t count;              /**! Number of suspensions */
+        uint32_t worst_read_latency; /**! Worst latency seen by MX25Series_read_stored_data_preempt in micro-seconds */
+    }suspend;
+    struct{
+        bool active;                 /**! The chip is in deep power-down, the next frame wakes it first */
+        uint32_t idle_time;          /**! Micro-seconds idle before MX25Series_sleep_tick enters deep power-down, 0 to never */
+        uint32_t last_access;        /**! MX25Series___get_micro_seconds() at the end of the last frame */
+        uint32_t start;              /**! When deep power-down was entered */
+        uint32_t count;              /**! Number of times deep power-down was entered */
+        uint32_t wakes;              /**! Number of times the chip was woken */
+        uint32_t wake_latency;       /**! Micro-seconds spent waking the chip, added to the frames that woke it */
+        uint32_t time_asleep;        /**! Micro-seconds spent in deep power-down, up to the last wake */
+    }deep_power_down;
+    struct MX25Series_Cache_t *cache;                           /**! Read cache invalidated by writes and erases, see MX25Series_cache_init */
+    struct MX25Series_Write_Buffer_t *write_buffer;             /**! Unflushed pages served by reads, see MX25Series_write_buffer_init */
+    struct MX25Series_Async_t *async;                           /**! Queued non-blocking operations, see MX25Series_async_init */
+    struct MX25Series_Bus_t *bus;                               /**! SPI bus shared with other devices, see MX25Series_bus_attach */
+    struct MX25Series_Power_t *power;                           /**! L/H mode governor, see MX25Series_power_init */
+#if defined(MX25Series_ENABLE_STATISTICS)
+    struct MX25Series_Statistics_t *statistics;                 /**! Operation counters and latency histograms, see MX25Series_statistics_init */
+#endif
 } MX25Series_t;
 
 /**
@@ -331,16 +572,16 @@ MX25Series_status_enum_t MX25Series_read_manufacture_and_device_id(MX25Series_t
 /**
  * MX25Series_read_configuration_register
  * @param dev the device structure for the MX25Series chip.
- * @param configuration_register see datasheet page 31 for register fields.
+ * @param configuration_register see datasheet page 31 for register fields, the first byte on the wire (CR1) is the high byte.
  * @return a MX25Series_status_enum_t indication success or error codes.
  */
 MX25Series_status_enum_t MX25Series_read_configuration_register(MX25Series_t *dev, uint16_t *configuration_register);
 
 /**
- *
+ * MX25Series_configure_chip issues the WRSR command, WREN must have been issued first.
  * @param dev the device structure for the MX25Series chip.
  * @param status_register the value to write to the status register
- * @param configuration_register the value to write to the configuration register
+ * @param configuration_register the value to write to the configuration register, the high byte is sent first (CR1).
  * @return a MX25Series_status_enum_t indication success or error codes.
  */
 MX25Series_status_enum_t MX25Series_configure_chip(
@@ -348,6 +589,15 @@ MX25Series_status_enum_t MX25Series_configure_chip(
         uint8_t status_register,
         uint16_t configuration_register);
 
+/**
+ * MX25Series_set_quad_enable sets or clears the non-volatile QE bit through MX25Series_configure_chip and
+ * verifies the result. While QE is set the WP# and RESET#/HOLD# pins become IO2 and IO3.
+ * @param dev the device structure for the MX25Series chip.
+ * @param enable true to set QE, false to clear it.
+ * @return MX25Series_status_error_verify if the Status Register does not read back with the requested QE value.
+ */
+MX25Series_status_enum_t MX25Series_set_quad_enable(MX25Series_t *dev, bool enable);
+
 
 /**
  * MX25Series_set_write_enable
@@ -373,8 +623,76 @@ MX25Series_status_enum_t MX25Series_read_stored_data(
         size_t length,
         uint8_t* buffer);
 
+/**
+ * MX25Series_read_stored_data_mode reads data from the flash storage with the specified read command.
+ * The dual and quad modes require MX25Series_ENABLE_MULTI_IO and the platform MX25Series___read_multi_io and
+ * MX25Series___write_multi_io functions, QREAD and 4READ additionally require the QE bit to be set.
+ * The dummy cycles come from chip_def->dummy_cycles and the DC bit of the Configuration Register. For 2READ and
+ * 4READ the first dummy byte carries the performance enhance mode bits, transfer_dummy_byte should be 0x00 or 0xFF.
+ * @param dev the device structure for the MX25Series chip.
+ * @param mode the read command to issue.
+ * @param memory_address the 24-bit memory address to read from.
+ * @param length the number of bytes to read.
+ * @param buffer the buffer in which to store the read data.
+ * @return MX25Series_status_error_unsupported if the mode is not available, otherwise success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_read_stored_data_mode(
+        MX25Series_t *dev,
+        MX25Series_Read_Mode_enum_t mode,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer);
+
+/**
+ * Called by MX25Series_read_stored_data_stream with each chunk as soon as it has been read. CS may still be
+ * asserted, so the callback must not access the chip.
+ */
+typedef void (*MX25Series_Read_Chunk_Callback_t)(void *context, const uint8_t *data, size_t length);
+
+/**
+ * MX25Series_read_stored_data_stream reads like MX25Series_read_stored_data_mode in one frame, but clocks the data
+ * in chunk bytes at a time and hands each chunk to callback straight away, so a checksum can be computed while the
+ * bytes are still in cache instead of in a second pass over the buffer. With MX25Series_ENABLE_TRANSFER_HOOK each
+ * chunk is read in a frame of its own.
+ * @param dev the device structure for the MX25Series chip.
+ * @param mode the read command to issue.
+ * @param memory_address the 24-bit memory address to read from.
+ * @param length the number of bytes to read.
+ * @param buffer the buffer in which to store the read data.
+ * @param chunk the most bytes read before callback is called.
+ * @param callback called with each chunk, in order.
+ * @param context passed to callback untouched.
+ * @return MX25Series_status_error_invalid_argument if chunk is 0 or callback is NULL, otherwise success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_read_stored_data_stream(
+        MX25Series_t *dev,
+        MX25Series_Read_Mode_enum_t mode,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer,
+        size_t chunk,
+        MX25Series_Read_Chunk_Callback_t callback,
+        void *context);
+
+/**
+ * MX25Series_set_read_mode checks that mode is available and stores it in dev->read_mode.
+ * @param dev the device structure for the MX25Series chip.
+ * @param mode the read command to use.
+ * @return MX25Series_status_error_unsupported if the mode is not available, otherwise MX25Series_status_ok.
+ */
+MX25Series_status_enum_t MX25Series_set_read_mode(MX25Series_t *dev, MX25Series_Read_Mode_enum_t mode);
+
+/**
+ * MX25Series_get_read_mode_string converts a MX25Series_Read_Mode_enum_t to a Human Readable String
+ * @param mode the MX25Series_Read_Mode_enum_t to get the string representation of.
+ * @return the string representation of mode
+ */
+const char* MX25Series_get_read_mode_string(MX25Series_Read_Mode_enum_t mode);
+
 /**
  * MX25Series_write_stored_data stores the specified data at the specified address.
+ * The data is sent with dev->program_mode, 4PP is only used when MX25Series_ENABLE_MULTI_IO is defined and the
+ * QE bit is set, otherwise PP is used.
  * @param dev the device structure for the MX25Series chip.
  * @param memory_address
  * @param length
@@ -387,6 +705,152 @@ MX25Series_status_enum_t MX25Series_write_stored_data(
         size_t length,
         uint8_t* buffer);
 
+/**
+ * MX25Series_set_program_mode selects the Page Program command used by MX25Series_write_stored_data.
+ * @param dev the device structure for the MX25Series chip.
+ * @param mode the Page Program command to use.
+ * @return MX25Series_status_error_invalid_argument if mode is unknown, otherwise success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_set_program_mode(MX25Series_t *dev, MX25Series_Program_Mode_enum_t mode);
+
+/**
+ * MX25Series_write_stored_data_paged stores an arbitrary length buffer at the specified address.
+ * The range is split on chip_def->page_size boundaries, each page is programmed with WREN followed by PP and
+ * the chip is polled until WIP clears, within the chip_def->timing.tPP budget, before the next page is sent.
+ * Pages are read back as chosen by dev->check_mode.
+ * @param dev the device structure for the MX25Series chip.
+ * @param memory_address the 24-bit memory address to start writing at.
+ * @param length the number of bytes to write, memory_address + length must not exceed chip_def->memory_size.
+ * @param buffer the data to write.
+ * @return MX25Series_status_error_verify if a page read back differs from buffer, otherwise success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_write_stored_data_paged(
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer);
+
+/**
+ * MX25Series_wait_for_completion polls the status register until the WIP bit clears.
+ * The first poll is delayed until just before the observed completion time of dev->busy_operation, after which
+ * the poll interval starts at MX25Series_WIP_POLL_INTERVAL and doubles on every poll. The time taken is folded
+ * into dev->observed_time so that later waits for the same operation start polling near the real typical time.
+ * Once a program or erase has finished its fail flag is checked, see MX25Series_set_check_mode.
+ * @param dev the device structure for the MX25Series chip.
+ * @param max_time the maximum number of micro-seconds to wait, measured from when the operation was issued.
+ * @return MX25Series_status_ok once WIP has cleared, MX25Series_status_error_timeout if max_time elapsed first,
+ * MX25Series_status_error_program or MX25Series_status_error_erase if the chip reported a failure.
+ */
+MX25Series_status_enum_t MX25Series_wait_for_completion(MX25Series_t *dev, uint32_t max_time);
+
+/**
+ * MX25Series_wait_for_operation waits for dev->busy_operation to complete using the budget from
+ * MX25Series_get_operation_max_time. See MX25Series_wait_for_completion.
+ * @param dev the device structure for the MX25Series chip.
+ * @return MX25Series_status_ok once WIP has cleared, MX25Series_status_error_timeout if the budget elapsed first.
+ */
+MX25Series_status_enum_t MX25Series_wait_for_operation(MX25Series_t *dev);
+
+/**
+ * MX25Series_check_completion polls the status register once without blocking.
+ * When WIP is seen clear the observed completion time is recorded, the fail flag of a program or erase is checked
+ * and dev->busy_operation is cleared.
+ * @param dev the device structure for the MX25Series chip.
+ * @param busy set to true while the chip still reports WIP.
+ * @return MX25Series_status_error_timeout if the chip is still busy past its budget, MX25Series_status_error_program
+ * or MX25Series_status_error_erase if the chip reported a failure, otherwise success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_check_completion(MX25Series_t *dev, bool *busy);
+
+/**
+ * MX25Series_suspend suspends dev->busy_operation with the PGM/ERS Suspend command. The minimum resume to suspend
+ * interval, chip_def->timing.tRS, is honoured by delaying the suspension. Chip Erase and Write Status Register
+ * cannot be suspended. If the operation finished before the suspend took effect, ESB and PSB are clear, and it is
+ * completed instead, leaving dev->suspend.active clear.
+ * @param dev the device structure for the MX25Series chip.
+ * @return MX25Series_status_ok once suspended or completed, or if nothing was in progress,
+ * MX25Series_status_error_unsupported if busy_operation can not be suspended, MX25Series_status_error_timeout if WIP
+ * did not clear within tSUS, MX25Series_status_error_program or MX25Series_status_error_erase if the operation
+ * completed and failed.
+ */
+MX25Series_status_enum_t MX25Series_suspend(MX25Series_t *dev);
+
+/**
+ * MX25Series_resume resumes an operation suspended with MX25Series_suspend, the time spent suspended is not
+ * counted against the operation's budget.
+ * @param dev the device structure for the MX25Series chip.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_resume(MX25Series_t *dev);
+
+/**
+ * MX25Series_read_stored_data_preempt reads data while a program or erase may be in progress. If the read does not
+ * touch the range being programmed or erased the operation is suspended for the duration of the read and then
+ * resumed, otherwise the read waits for the operation to complete. The latency is recorded in
+ * dev->suspend.worst_read_latency.
+ * @param dev the device structure for the MX25Series chip.
+ * @param mode the read command to issue.
+ * @param memory_address the 24-bit memory address to read from.
+ * @param length the number of bytes to read.
+ * @param buffer the buffer in which to store the read data.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_read_stored_data_preempt(
+        MX25Series_t *dev,
+        MX25Series_Read_Mode_enum_t mode,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer);
+
+/**
+ * MX25Series_enter_deep_power_down puts the chip into deep power-down with DP and waits tDP. Every function of this
+ * library wakes the chip again with RES, waiting tRES1, before its first frame.
+ * @param dev the device structure for the MX25Series chip.
+ * @return MX25Series_status_error_busy if an operation is in progress or suspended, the chip ignores DP then.
+ */
+MX25Series_status_enum_t MX25Series_enter_deep_power_down(MX25Series_t *dev);
+
+/**
+ * MX25Series_release_deep_power_down wakes the chip with RES and waits tRES1, counting the wake and its latency in
+ * dev->deep_power_down.
+ * @param dev the device structure for the MX25Series chip.
+ * @return MX25Series_status_ok once the chip accepts commands, or if it was not in deep power-down.
+ */
+MX25Series_status_enum_t MX25Series_release_deep_power_down(MX25Series_t *dev);
+
+/**
+ * MX25Series_set_auto_sleep sets how long the chip must be idle before MX25Series_sleep_tick puts it into deep
+ * power-down. Each wake costs tRES1 on the next access.
+ * @param dev the device structure for the MX25Series chip.
+ * @param idle_time micro-seconds without a frame, 0 to disable.
+ */
+void MX25Series_set_auto_sleep(MX25Series_t *dev, uint32_t idle_time);
+
+/**
+ * MX25Series_sleep_tick enters deep power-down once nothing is in progress or queued and no frame has been sent for
+ * dev->deep_power_down.idle_time. Call it from the main loop.
+ * @param dev the device structure for the MX25Series chip.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_sleep_tick(MX25Series_t *dev);
+
+/**
+ * MX25Series_get_operation_max_time returns the appropriate value from the MX25Series_t.chip_def timing section for the provided operation.
+ * @param dev the device structure for the MX25Series chip.
+ * @param operation the MX25Series_Operation_enum_t to retrieve the timing value of.
+ * @return the maximum number of micro-seconds required for the specified operation.
+ */
+uint32_t MX25Series_get_operation_max_time(MX25Series_t *dev, MX25Series_Operation_enum_t operation);
+
+/**
+ * MX25Series_get_operation_typical_time returns the smoothed observed completion time of the operation, or the
+ * chip_def typical time until the operation has been observed.
+ * @param dev the device structure for the MX25Series chip.
+ * @param operation the MX25Series_Operation_enum_t to retrieve the timing value of.
+ * @return the typical number of micro-seconds taken by the operation, 0 if not known.
+ */
+uint32_t MX25Series_get_operation_typical_time(MX25Series_t *dev, MX25Series_Operation_enum_t operation);
+
 /**
  * MX25Series_erase erases the specified flash area, specified by erase_type ond memory_address
  * @param dev the device structure for the MX25Series chip.
@@ -399,6 +863,82 @@ MX25Series_status_enum_t MX25Series_erase(
         MX25Series_Erase_enum_t erase_type,
         uint32_t memory_address);
 
+/**
+ * MX25Series_next_erase_step selects the erase command to use at memory_address when erasing length bytes.
+ * The largest aligned block that fits is used unless the timing table makes the smaller erases cheaper, for
+ * example with tBE32K larger than eight times tSE. Only the erases in chip_def->erase_types are considered.
+ * @param dev the device structure for the MX25Series chip.
+ * @param memory_address the 4 KB aligned start of the remaining range.
+ * @param length the remaining number of bytes to erase, a multiple of 4 KB.
+ * @return the MX25Series_Erase_enum_t to issue, MX25Series_Erase_Undefined if the arguments are not 4 KB aligned
+ * or no supported erase fits.
+ */
+MX25Series_Erase_enum_t MX25Series_next_erase_step(MX25Series_t *dev, uint32_t memory_address, uint32_t length);
+
+/**
+ * MX25Series_plan_erase_range computes the cheapest mix of 64KB, 32KB and 4KB erases that exactly covers the range,
+ * or a single Chip Erase when the range is the entire chip and tCE is cheaper.
+ * @param dev the device structure for the MX25Series chip.
+ * @param memory_address the 4 KB aligned start address of the range.
+ * @param length the number of bytes to erase, a multiple of 4 KB.
+ * @param steps if not NULL receives up to max_steps erase commands.
+ * @param max_steps the number of entries in steps.
+ * @param step_count if not NULL receives the total number of erase commands in the plan, which may exceed max_steps.
+ * @param total_time if not NULL receives the sum of the maximum times of the plan in micro-seconds.
+ * @return MX25Series_status_error_invalid_argument if the range is not 4 KB aligned or exceeds the chip.
+ */
+MX25Series_status_enum_t MX25Series_plan_erase_range(
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        uint32_t length,
+        MX25Series_Erase_Step_t *steps,
+        size_t max_steps,
+        size_t *step_count,
+        uint32_t *total_time);
+
+/**
+ * MX25Series_erase_range erases the range using the plan from MX25Series_plan_erase_range, issuing WREN before and
+ * waiting for WIP to clear after every erase command.
+ * @param dev the device structure for the MX25Series chip.
+ * @param memory_address the 4 KB aligned start address of the range.
+ * @param length the number of bytes to erase, a multiple of 4 KB.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_erase_range(
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        uint32_t length);
+
+/**
+ * MX25Series_update_range makes the range hold buffer with as few erases and programs as possible. Each 4 KB sector
+ * is read in one frame and compared with the new data a word at a time: pages that already match are skipped,
+ * pages that only clear bits are programmed in place from their first to their last changed byte, and only a
+ * sector with a bit going from 0 to 1 is erased, after which its pages that are not blank are programmed back
+ * with the new data merged in. WREN is issued and WIP waited for around every program and erase.
+ * @param dev the device structure for the MX25Series chip.
+ * @param memory_address the 24-bit memory address to update.
+ * @param length the number of bytes to update.
+ * @param buffer the new data.
+ * @param sector_buffer MX25Series_SECTOR_SIZE bytes of scratch memory for the current sector contents.
+ * @param report filled in with the erases and programs issued and skipped, may be NULL.
+ * @return MX25Series_status_error_unsupported if the chip has no 4 KB Sector Erase.
+ */
+MX25Series_status_enum_t MX25Series_update_range(
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer,
+        uint8_t* sector_buffer,
+        MX25Series_Update_Report_t *report);
+
+/**
+ * MX25Series_get_erasure_size returns the number of bytes erased by erase_type.
+ * @param dev the device structure for the MX25Series chip.
+ * @param erase_type the MX25Series_Erase_enum_t to get the size of.
+ * @return the number of bytes erased, 0 for MX25Series_Erase_Undefined.
+ */
+uint32_t MX25Series_get_erasure_size(MX25Series_t *dev, MX25Series_Erase_enum_t erase_type);
+
 /**
  * MX25Series_get_erasure_size_string converts a MX25Series_Erase_enum_t to a Human Readable String
  * @param size the MX25Series_Erase_enum_t to get the string representation of.
@@ -414,14 +954,50 @@ const char* MX25Series_get_erasure_size_string(MX25Series_Erase_enum_t size);
  */
 uint32_t MX25Series_get_erasure_max_time(MX25Series_t *dev, MX25Series_Erase_enum_t erase_type);
 
+/**
+ * MX25Series_read_sfdp reads from the Serial Flash Discoverable Parameter area with RDSFDP, which works before
+ * dev->chip_def is known. See MX25Series_sfdp_discover.
+ * @param dev the device structure for the MX25Series chip.
+ * @param address the byte offset into the SFDP area.
+ * @param length the number of bytes to read.
+ * @param buffer where to store the data.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_read_sfdp(MX25Series_t *dev, uint32_t address, size_t length, uint8_t* buffer);
+
+/**
+ * MX25Series_read_security_register reads the Security Register with RDSCUR, see the MX25Series_SCUR_* masks.
+ * @param dev the device structure for the MX25Series chip.
+ * @param security_register where to store the register, also kept in dev->security_register.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
 MX25Series_status_enum_t MX25Series_read_security_register(
         MX25Series_t *dev,
         uint8_t *security_register);
 
+/**
+ * MX25Series_write_security_register sets LDSO with WRSCUR, which permanently locks the secured OTP area. LDSO is
+ * the only writable bit and can never be cleared again.
+ * @param dev the device structure for the MX25Series chip.
+ * @param security_register the requested register value, updated with the value read back.
+ * @return MX25Series_status_error_invalid_argument if a bit other than LDSO is requested,
+ * MX25Series_status_error_verify if LDSO does not read back set.
+ */
 MX25Series_status_enum_t MX25Series_write_security_register(
         MX25Series_t *dev,
         uint8_t *security_register);
 
+/**
+ * MX25Series_set_check_mode chooses how programs and erases are checked. MX25Series_Check_Fail_Flags, the default,
+ * costs one RDSCUR frame per operation. Reading pages back also catches bits that P_FAIL does not report, at the
+ * cost of reading every checked page.
+ * @param dev the device structure for the MX25Series chip.
+ * @param mode the MX25Series_Check_Mode_enum_t to use.
+ * @param interval pages programmed per page read back by MX25Series_Check_Sampled, ignored by the other modes.
+ * @return MX25Series_status_error_invalid_argument for an unknown mode or a zero interval.
+ */
+MX25Series_status_enum_t MX25Series_set_check_mode(MX25Series_t *dev, MX25Series_Check_Mode_enum_t mode, uint32_t interval);
+
 // These function implement the platform specific functionality required by this library.
 // __attribute__((weak)) implementations of these functions are provided so that this
 // library can compile. Any program making use of this library must provide implementations
@@ -453,6 +1029,43 @@ MX25Series_status_enum_t MX25Series___read(MX25Series_t *dev, size_t length, uin
  */
 MX25Series_status_enum_t MX25Series___write(MX25Series_t *dev, size_t length, uint8_t* buffer);
 
+#if defined(MX25Series_ENABLE_MULTI_IO)
+/**
+ * MX25Series___read_multi_io reads length bytes from the relevant SPI bus into buffer using lanes data lines.
+ * Only required when MX25Series_ENABLE_MULTI_IO is defined.
+ * @param dev the device structure for the MX25Series chip.
+ * @param lanes the number of data lines to clock the bytes in on, 1, 2 or 4.
+ * @param length the size of the provided buffer
+ * @param buffer the buffer to read bytes into
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series___read_multi_io(MX25Series_t *dev, uint8_t lanes, size_t length, uint8_t* buffer);
+
+/**
+ * MX25Series___write_multi_io writes length bytes from buffer to the relevant SPI bus using lanes data lines.
+ * Only required when MX25Series_ENABLE_MULTI_IO is defined.
+ * @param dev the device structure for the MX25Series chip.
+ * @param lanes the number of data lines to clock the bytes out on, 1, 2 or 4.
+ * @param length the size of the provided buffer
+ * @param buffer the data to write to the relevant SPI bus
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series___write_multi_io(MX25Series_t *dev, uint8_t lanes, size_t length, uint8_t* buffer);
+#endif
+
+#if defined(MX25Series_ENABLE_TRANSFER_HOOK)
+/**
+ * MX25Series___transfer clocks out a whole SPI frame: asserts CS, sends the command, address, dummy bytes and
+ * segments in order and releases CS, ideally as a single DMA chain.
+ * Only required when MX25Series_ENABLE_TRANSFER_HOOK is defined, otherwise every transaction is carried out with
+ * MX25Series___enable_cs_pin, MX25Series___issue_command, MX25Series___write and MX25Series___read.
+ * @param dev the device structure for the MX25Series chip.
+ * @param transaction the frame to transfer, RX segment buffers are filled in.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series___transfer(MX25Series_t *dev, MX25Series_Transaction_t *transaction);
+#endif
+
 /**
  * MX25Series___enable_cs_pin asserts the active low CS pin
  * @param dev the device structure for the MX25Series chip.
@@ -483,6 +1096,20 @@ void                    MX25Series___enable_write_protect_pin(MX25Series_t *dev,
  */
 bool                    MX25Series___test_linker(MX25Series_t *dev);
 
+/**
+ * MX25Series___delay_micro_second blocks for at least us micro-seconds.
+ * @param dev the device structure for the MX25Series chip.
+ * @param us the number of micro-seconds to delay for.
+ */
+void                    MX25Series___delay_micro_second(MX25Series_t *dev, unsigned int us);
+
+/**
+ * MX25Series___get_micro_seconds returns a free running micro-second counter, it is expected to wrap.
+ * @param dev the device structure for the MX25Series chip.
+ * @return the current time in micro-seconds.
+ */
+uint32_t                MX25Series___get_micro_seconds(MX25Series_t *dev);
+
 #if defined(__cplusplus)
 }
 #endif
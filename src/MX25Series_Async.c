@@ -0,0 +1,410 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+#include "MX25Series_Async.h"
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+    #include <stdatomic.h>
+    //Keeps the compiler from moving the request's stores past the tail that publishes it.
+    #define MX25Series__async_barrier() atomic_signal_fence(memory_order_seq_cst)
+#else
+    #define MX25Series__async_barrier()
+#endif
+
+/**
+ * MX25Series__async_queued counts the requests waiting behind the current one. head and tail run over twice the
+ * capacity so a full ring can be told from an empty one without a shared count.
+ */
+static size_t MX25Series__async_queued(MX25Series_Async_t *async)
+{
+    size_t head = async->head;
+    size_t tail = async->tail;
+
+    return (tail + 2 * async->capacity - head) % (2 * async->capacity);
+}
+
+static MX25Series_status_enum_t MX25Series__async_check(MX25Series_t *dev, MX25Series_Async_Request_t *request)
+{
+    if(dev->chip_def == NULL || dev->chip_def->page_size == 0)
+    {
+        return MX25Series_status_error_invalid_chip_def;
+    }
+
+    if(request->memory_address > dev->chip_def->memory_size ||
+       request->length > dev->chip_def->memory_size - request->memory_address ||
+       (request->operation != MX25Series_Async_Erase && request->length > 0 && request->buffer == NULL))
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    switch(request->operation)
+    {
+        case MX25Series_Async_Read:
+        case MX25Series_Async_Write:
+            return MX25Series_status_ok;
+        case MX25Series_Async_Erase:
+            if((request->memory_address % MX25Series_SECTOR_SIZE) != 0 || (request->length % MX25Series_SECTOR_SIZE) != 0)
+            {
+                return MX25Series_status_error_invalid_argument;
+            }
+            return MX25Series_status_ok;
+        default:
+            return MX25Series_status_error_invalid_argument;
+    }
+}
+
+static void MX25Series__async_complete(MX25Series_t *dev, MX25Series_Async_t *async, MX25Series_status_enum_t status)
+{
+    MX25Series_Async_Request_t *request = async->current;
+
+    async->current = NULL;
+    async->state = MX25Series_Async_State_Start;
+    request->status = status;
+    if(request->callback != NULL)
+    {
+        request->callback(dev, request, status);
+    }
+}
+
+/**
+ * MX25Series__async_start sends the next frame of the current request.
+ */
+static MX25Series_status_enum_t MX25Series__async_start(MX25Series_t *dev, MX25Series_Async_t *async)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Async_Request_t *request = async->current;
+    uint32_t memory_address = request->memory_address + request->progress;
+    size_t remaining = request->length - request->progress;
+
+    switch(request->operation)
+    {
+        case MX25Series_Async_Read:
+            request->step = remaining > MX25Series_ASYNC_READ_CHUNK ? MX25Series_ASYNC_READ_CHUNK : remaining;
+            result = MX25Series_read_stored_data_mode(dev, request->read_mode, memory_address, request->step,
+                                                      request->buffer + request->progress);
+            if(!MX25Series_HAS_ERROR(result))
+            {
+                request->progress += request->step;
+            }
+            return result;
+
+        case MX25Series_Async_Write:
+            //Never cross a page boundary, PP wraps to the start of the page instead.
+            request->step = dev->chip_def->page_size - (memory_address % dev->chip_def->page_size);
+            if(request->step > remaining)
+            {
+                request->step = remaining;
+            }
+            result = MX25Series_set_write_enable(dev, true);
+            result |= MX25Series_write_stored_data(dev, memory_address, request->step, request->buffer + request->progress);
+            break;
+
+        case MX25Series_Async_Erase:
+        {
+            MX25Series_Erase_enum_t erase_type = MX25Series_next_erase_step(dev, memory_address, remaining);
+            if(erase_type == MX25Series_Erase_Undefined)
+            {
+                return MX25Series_status_error_invalid_argument;
+            }
+            request->step = MX25Series_get_erasure_size(dev, erase_type);
+            result = MX25Series_set_write_enable(dev, true);
+            result |= MX25Series_erase(dev, erase_type, memory_address);
+            break;
+        }
+
+        default:
+            return MX25Series_status_error_invalid_argument;
+    }
+
+    if(!MX25Series_HAS_ERROR(result))
+    {
+        async->state = MX25Series_Async_State_Busy;
+        async->last_poll = dev->busy_start;
+    }
+    return result;
+}
+
+/**
+ * MX25Series__async_poll_due decides whether the operation could plausibly have finished.
+ */
+static bool MX25Series__async_poll_due(MX25Series_t *dev, MX25Series_Async_t *async, uint32_t now)
+{
+    uint32_t estimate = MX25Series_get_operation_typical_time(dev, dev->busy_operation);
+
+    //Leave the bus alone for most of the typical time, then poll no faster than MX25Series_WIP_POLL_INTERVAL.
+    return now - dev->busy_start >= estimate - estimate / 8 && now - async->last_poll >= MX25Series_WIP_POLL_INTERVAL;
+}
+
+/**
+ * MX25Series__async_poll reads the Status Register once the operation could plausibly have finished.
+ */
+static MX25Series_status_enum_t MX25Series__async_poll(MX25Series_t *dev, MX25Series_Async_t *async, bool *busy)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t now = MX25Series___get_micro_seconds(dev);
+
+    *busy = true;
+
+    if(!MX25Series__async_poll_due(dev, async, now))
+    {
+        return MX25Series_status_ok;
+    }
+
+    async->last_poll = now;
+    result = MX25Series_check_completion(dev, busy);
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_async_init(
+        MX25Series_Async_t *async,
+        MX25Series_t *dev,
+        MX25Series_Async_Request_t **queue,
+        size_t capacity)
+{
+    memset(async, 0, sizeof(MX25Series_Async_t));
+
+    if(queue == NULL || capacity == 0)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    async->dev = dev;
+    async->queue = queue;
+    async->capacity = capacity;
+    dev->async = async;
+    return MX25Series_status_ok;
+}
+
+void MX25Series_async_deinit(MX25Series_Async_t *async)
+{
+    if(async->dev != NULL && async->dev->async == async)
+    {
+        async->dev->async = NULL;
+    }
+    async->dev = NULL;
+    async->current = NULL;
+    async->head = async->tail;
+}
+
+MX25Series_status_enum_t MX25Series_async_submit(MX25Series_t *dev, MX25Series_Async_Request_t *request)
+{
+    MX25Series_Async_t *async = dev->async;
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    if(async == NULL || request == NULL)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    result = MX25Series__async_check(dev, request);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    if(MX25Series__async_queued(async) == async->capacity)
+    {
+        return MX25Series_status_error_busy;
+    }
+
+    //Only tail is shared with a tick that may interrupt here, and it is written once the entry is complete.
+    request->progress = 0;
+    request->step = 0;
+    request->status = MX25Series_status_not_reported;
+    async->queue[async->tail % async->capacity] = request;
+    MX25Series__async_barrier();
+    async->tail = (async->tail + 1) % (2 * async->capacity);
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_async_read(
+        MX25Series_t *dev,
+        MX25Series_Async_Request_t *request,
+        MX25Series_Read_Mode_enum_t mode,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer,
+        MX25Series_Async_Callback_t callback,
+        void *user)
+{
+    memset(request, 0, sizeof(MX25Series_Async_Request_t));
+    request->operation = MX25Series_Async_Read;
+    request->read_mode = mode;
+    request->memory_address = memory_address;
+    request->length = length;
+    request->buffer = buffer;
+    request->callback = callback;
+    request->user = user;
+    return MX25Series_async_submit(dev, request);
+}
+
+MX25Series_status_enum_t MX25Series_async_write(
+        MX25Series_t *dev,
+        MX25Series_Async_Request_t *request,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer,
+        MX25Series_Async_Callback_t callback,
+        void *user)
+{
+    memset(request, 0, sizeof(MX25Series_Async_Request_t));
+    request->operation = MX25Series_Async_Write;
+    request->memory_address = memory_address;
+    request->length = length;
+    request->buffer = buffer;
+    request->callback = callback;
+    request->user = user;
+    return MX25Series_async_submit(dev, request);
+}
+
+MX25Series_status_enum_t MX25Series_async_erase(
+        MX25Series_t *dev,
+        MX25Series_Async_Request_t *request,
+        uint32_t memory_address,
+        uint32_t length,
+        MX25Series_Async_Callback_t callback,
+        void *user)
+{
+    memset(request, 0, sizeof(MX25Series_Async_Request_t));
+    request->operation = MX25Series_Async_Erase;
+    request->memory_address = memory_address;
+    request->length = length;
+    request->callback = callback;
+    request->user = user;
+    return MX25Series_async_submit(dev, request);
+}
+
+MX25Series_status_enum_t MX25Series_async_tick(MX25Series_t *dev)
+{
+    MX25Series_Async_t *async = dev->async;
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    bool sent = false;
+
+    if(async == NULL || async->running)
+    {
+        return MX25Series_status_ok;
+    }
+    async->running = true;
+
+    for(;;)
+    {
+        MX25Series_Async_Request_t *request;
+
+        if(async->current == NULL)
+        {
+            if(MX25Series__async_queued(async) == 0)
+            {
+                break;
+            }
+            async->current = async->queue[async->head % async->capacity];
+            MX25Series__async_barrier();
+            async->head = (async->head + 1) % (2 * async->capacity);
+            async->state = MX25Series_Async_State_Start;
+        }
+        request = async->current;
+
+        if(async->state == MX25Series_Async_State_Busy)
+        {
+            bool busy = true;
+
+            result = MX25Series__async_poll(dev, async, &busy);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                MX25Series__async_complete(dev, async, result);
+                continue;
+            }
+            if(busy)
+            {
+                break;
+            }
+            request->progress += request->step;
+            async->state = MX25Series_Async_State_Start;
+        }
+
+        if(request->progress >= request->length)
+        {
+            MX25Series__async_complete(dev, async, MX25Series_status_ok);
+            continue;
+        }
+
+        //One data frame per tick.
+        if(sent)
+        {
+            break;
+        }
+        sent = true;
+
+        result = MX25Series__async_start(dev, async);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            MX25Series__async_complete(dev, async, result);
+            continue;
+        }
+        if(request->operation == MX25Series_Async_Read && request->progress >= request->length)
+        {
+            MX25Series__async_complete(dev, async, MX25Series_status_ok);
+            continue;
+        }
+        break;
+    }
+
+    async->running = false;
+    return result;
+}
+
+MX25Series_Async_Frame_enum_t MX25Series_async_next_frame(MX25Series_t *dev)
+{
+    MX25Series_Async_t *async = dev->async;
+    MX25Series_Async_Request_t *request;
+
+    if(async == NULL || async->running)
+    {
+        return MX25Series_Async_Frame_None;
+    }
+
+    if(async->current == NULL)
+    {
+        if(MX25Series__async_queued(async) == 0)
+        {
+            return MX25Series_Async_Frame_None;
+        }
+        request = async->queue[async->head % async->capacity];
+    }
+    else if(async->state == MX25Series_Async_State_Busy)
+    {
+        return MX25Series__async_poll_due(dev, async, MX25Series___get_micro_seconds(dev)) ?
+               MX25Series_Async_Frame_Poll : MX25Series_Async_Frame_None;
+    }
+    else
+    {
+        request = async->current;
+    }
+
+    return request->operation == MX25Series_Async_Read ? MX25Series_Async_Frame_Read : MX25Series_Async_Frame_Program;
+}
+
+bool MX25Series_async_is_idle(MX25Series_t *dev)
+{
+    return dev->async == NULL || (dev->async->current == NULL && MX25Series__async_queued(dev->async) == 0);
+}
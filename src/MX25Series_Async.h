@@ -0,0 +1,216 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+#ifndef FLASH_MX25Series_Async_H
+#define FLASH_MX25Series_Async_H
+
+#include "MX25Series.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#ifndef MX25Series_ASYNC_READ_CHUNK
+    #define MX25Series_ASYNC_READ_CHUNK 256 /**! Most bytes read per MX25Series_async_tick, bounds the time spent in one tick */
+#endif
+
+typedef enum {
+    MX25Series_Async_Read = 0,  /**< Read length bytes with the request's read_mode */
+    MX25Series_Async_Write = 1, /**< Program length bytes, page by page */
+    MX25Series_Async_Erase = 2, /**< Erase a 4 KB aligned range with the largest erases that fit */
+} MX25Series_Async_Operation_enum_t;
+
+typedef enum {
+    MX25Series_Async_State_Start = 0, /**< The next frame of the current request is due */
+    MX25Series_Async_State_Busy = 1,  /**< Waiting for a program or erase to clear WIP */
+} MX25Series_Async_State_enum_t;
+
+typedef enum {
+    MX25Series_Async_Frame_None = 0,    /**< Idle, or waiting for a Status Register poll to fall due */
+    MX25Series_Async_Frame_Poll = 1,    /**< A Status Register poll is due */
+    MX25Series_Async_Frame_Program = 2, /**< A program or erase frame is ready to be sent */
+    MX25Series_Async_Frame_Read = 3,    /**< A read frame is ready to be sent */
+} MX25Series_Async_Frame_enum_t;
+
+struct MX25Series_Async_Request_t;
+
+/**
+ * Called from MX25Series_async_tick once a request has finished, the request may be resubmitted from the callback.
+ */
+typedef void (*MX25Series_Async_Callback_t)(MX25Series_t *dev, struct MX25Series_Async_Request_t *request, MX25Series_status_enum_t status);
+
+/**
+ * @brief A queued operation. The request and its buffer are owned by the caller and must stay valid until the
+ * callback has been called.
+ */
+typedef struct MX25Series_Async_Request_t {
+    MX25Series_Async_Operation_enum_t operation;
+    MX25Series_Read_Mode_enum_t read_mode;  /**! Read command used by MX25Series_Async_Read */
+    uint32_t memory_address;
+    size_t length;
+    uint8_t *buffer;                        /**! Destination of a read, source of a write, unused by an erase */
+    MX25Series_Async_Callback_t callback;   /**! May be NULL */
+    void *user;                             /**! Passed through untouched */
+    size_t progress;                        /**! Bytes completed so far */
+    size_t step;                            /**! Bytes covered by the frame in flight */
+    MX25Series_status_enum_t status;        /**! Result once complete */
+} MX25Series_Async_Request_t;
+
+typedef struct MX25Series_Async_t
+{
+    MX25Series_t *dev;
+    MX25Series_Async_Request_t *volatile *queue; /**! Ring of pending requests, filled by submit and emptied by tick */
+    size_t capacity;
+    volatile size_t head;                   /**! Next request to start, in [0, 2 * capacity), only written by tick */
+    volatile size_t tail;                   /**! Next free entry, in [0, 2 * capacity), only written by submit */
+    MX25Series_Async_Request_t *current;    /**! Request being carried out, NULL when idle */
+    MX25Series_Async_State_enum_t state;
+    uint32_t last_poll;                     /**! MX25Series___get_micro_seconds() of the last Status Register read */
+    volatile bool running;                  /**! Guards against MX25Series_async_tick being re-entered from an interrupt */
+} MX25Series_Async_t;
+
+/**
+ * MX25Series_async_init sets up the submission queue and attaches it to dev.
+ * While requests are outstanding the synchronous functions must not be used on dev.
+ * @param async the async structure to initialise.
+ * @param dev the device structure for the MX25Series chip.
+ * @param queue capacity entries of request storage.
+ * @param capacity the number of requests that can be queued behind the current one.
+ * @return MX25Series_status_error_invalid_argument if the queue is invalid.
+ */
+MX25Series_status_enum_t MX25Series_async_init(
+        MX25Series_Async_t *async,
+        MX25Series_t *dev,
+        MX25Series_Async_Request_t **queue,
+        size_t capacity);
+
+/**
+ * MX25Series_async_deinit detaches the queue from its device, outstanding requests are dropped without callbacks.
+ * @param async the async structure.
+ */
+void MX25Series_async_deinit(MX25Series_Async_t *async);
+
+/**
+ * MX25Series_async_submit queues a request and returns immediately, the work happens in MX25Series_async_tick.
+ * The queue is a single producer, single consumer ring, so submit may be interrupted by a tick, but requests for one
+ * device must all be submitted from one context, which is the tick's if callbacks resubmit.
+ * @param dev the device structure for the MX25Series chip.
+ * @param request the request, its operation, addresses, buffer and callback filled in.
+ * @return MX25Series_status_error_busy if the queue is full, MX25Series_status_error_invalid_argument for a bad request.
+ */
+MX25Series_status_enum_t MX25Series_async_submit(MX25Series_t *dev, MX25Series_Async_Request_t *request);
+
+/**
+ * MX25Series_async_read fills in and submits a read request.
+ * @param dev the device structure for the MX25Series chip.
+ * @param request the request storage.
+ * @param mode the read command to use.
+ * @param memory_address the 24-bit memory address to read from.
+ * @param length the number of bytes to read.
+ * @param buffer where to store the data.
+ * @param callback called once the read has finished, may be NULL.
+ * @param user passed to the callback through request->user.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_async_read(
+        MX25Series_t *dev,
+        MX25Series_Async_Request_t *request,
+        MX25Series_Read_Mode_enum_t mode,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer,
+        MX25Series_Async_Callback_t callback,
+        void *user);
+
+/**
+ * MX25Series_async_write fills in and submits a write request, split on page boundaries like
+ * MX25Series_write_stored_data_paged.
+ * @param dev the device structure for the MX25Series chip.
+ * @param request the request storage.
+ * @param memory_address the 24-bit memory address to write to.
+ * @param length the number of bytes to write.
+ * @param buffer the data to write.
+ * @param callback called once every page has been programmed, may be NULL.
+ * @param user passed to the callback through request->user.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_async_write(
+        MX25Series_t *dev,
+        MX25Series_Async_Request_t *request,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer,
+        MX25Series_Async_Callback_t callback,
+        void *user);
+
+/**
+ * MX25Series_async_erase fills in and submits an erase request, carried out with the steps of
+ * MX25Series_next_erase_step.
+ * @param dev the device structure for the MX25Series chip.
+ * @param request the request storage.
+ * @param memory_address the 4 KB aligned start address of the range.
+ * @param length the number of bytes to erase, a multiple of 4 KB.
+ * @param callback called once the range has been erased, may be NULL.
+ * @param user passed to the callback through request->user.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_async_erase(
+        MX25Series_t *dev,
+        MX25Series_Async_Request_t *request,
+        uint32_t memory_address,
+        uint32_t length,
+        MX25Series_Async_Callback_t callback,
+        void *user);
+
+/**
+ * MX25Series_async_tick advances the current request by at most one data frame and one Status Register poll, and
+ * starts the next queued request as soon as the current one completes, so a read queued behind a program is sent
+ * in the same tick that sees the program finish. Never waits for WIP.
+ * Call it from the main loop, a timer, or a DMA complete interrupt.
+ * @param dev the device structure for the MX25Series chip.
+ * @return the status of the last frame, MX25Series_status_ok when there is nothing to do.
+ */
+MX25Series_status_enum_t MX25Series_async_tick(MX25Series_t *dev);
+
+/**
+ * MX25Series_async_next_frame reports what the next MX25Series_async_tick would send, so a scheduler sharing the
+ * bus between devices can order them.
+ * @param dev the device structure for the MX25Series chip.
+ * @return MX25Series_Async_Frame_None if a tick would not touch the bus.
+ */
+MX25Series_Async_Frame_enum_t MX25Series_async_next_frame(MX25Series_t *dev);
+
+/**
+ * MX25Series_async_is_idle reports whether every submitted request has completed.
+ * @param dev the device structure for the MX25Series chip.
+ * @return true if there is no current or queued request.
+ */
+bool MX25Series_async_is_idle(MX25Series_t *dev);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_Async_H
@@ -0,0 +1,222 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#include "MX25Series_Bus.h"
+#include "MX25Series_Async.h"
+
+/**
+ * MX25Series__bus_schedule ticks every device except skip that has a frame to send, highest priority first.
+ */
+static MX25Series_status_enum_t MX25Series__bus_schedule(MX25Series_Bus_t *bus, MX25Series_t *skip, bool *sent)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    MX25Series_Async_Frame_enum_t frames[MX25Series_BUS_MAX_DEVICES];
+    int priority;
+    uint8_t i;
+
+    *sent = false;
+    if(bus->scheduling || bus->device_count == 0)
+    {
+        return MX25Series_status_ok;
+    }
+    bus->scheduling = true;
+
+    //Decide up front, so a device whose poll finds it done is not served twice in one tick.
+    for(i = 0; i < bus->device_count; i++)
+    {
+        frames[i] = bus->devices[i] == skip ? MX25Series_Async_Frame_None : MX25Series_async_next_frame(bus->devices[i]);
+    }
+
+    for(priority = MX25Series_Async_Frame_Read; priority > MX25Series_Async_Frame_None; priority--)
+    {
+        for(i = 0; i < bus->device_count; i++)
+        {
+            uint8_t index = (bus->next + i) % bus->device_count;
+            MX25Series_status_enum_t status;
+
+            if(frames[index] != (MX25Series_Async_Frame_enum_t)priority)
+            {
+                continue;
+            }
+
+            status = MX25Series_async_tick(bus->devices[index]);
+            *sent = true;
+            if(MX25Series_HAS_ERROR(status) && !MX25Series_HAS_ERROR(result))
+            {
+                result = status;
+            }
+        }
+    }
+
+    bus->next = (bus->next + 1) % bus->device_count;
+    bus->scheduling = false;
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_bus_init(
+        MX25Series_Bus_t *bus,
+        MX25Series_Bus_Lock_t lock,
+        MX25Series_Bus_Unlock_t unlock,
+        void *lock_ctx)
+{
+    memset(bus, 0, sizeof(MX25Series_Bus_t));
+    bus->lock = lock;
+    bus->unlock = unlock;
+    bus->lock_ctx = lock_ctx;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_bus_attach(MX25Series_Bus_t *bus, MX25Series_t *dev)
+{
+    if(dev->bus == bus)
+    {
+        return MX25Series_status_ok;
+    }
+
+    if(bus->device_count == MX25Series_BUS_MAX_DEVICES)
+    {
+        return MX25Series_status_error_busy;
+    }
+
+    if(dev->bus != NULL)
+    {
+        MX25Series_bus_detach(dev);
+    }
+
+    bus->devices[bus->device_count++] = dev;
+    dev->bus = bus;
+    return MX25Series_status_ok;
+}
+
+void MX25Series_bus_detach(MX25Series_t *dev)
+{
+    MX25Series_Bus_t *bus = dev->bus;
+    uint8_t i;
+
+    if(bus == NULL)
+    {
+        return;
+    }
+
+    for(i = 0; i < bus->device_count; i++)
+    {
+        if(bus->devices[i] == dev)
+        {
+            memmove(&bus->devices[i], &bus->devices[i + 1], (bus->device_count - i - 1) * sizeof(MX25Series_t*));
+            bus->device_count--;
+            break;
+        }
+    }
+
+    if(bus->next >= bus->device_count)
+    {
+        bus->next = 0;
+    }
+    if(bus->owner == dev)
+    {
+        MX25Series_bus_release(bus, dev);
+    }
+    dev->bus = NULL;
+}
+
+MX25Series_status_enum_t MX25Series_bus_acquire(MX25Series_Bus_t *bus, MX25Series_t *dev)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    if(bus == NULL)
+    {
+        return MX25Series_status_ok;
+    }
+
+    if(bus->lock != NULL)
+    {
+        result = bus->lock(bus->lock_ctx);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+    else if(bus->owner != NULL && bus->owner != dev)
+    {
+        //Without a lock the only way in is from an interrupt, which must not break into another frame.
+        return MX25Series_status_error_busy;
+    }
+
+    bus->owner = dev;
+    return MX25Series_status_ok;
+}
+
+void MX25Series_bus_release(MX25Series_Bus_t *bus, MX25Series_t *dev)
+{
+    if(bus == NULL || bus->owner != dev)
+    {
+        return;
+    }
+
+    bus->owner = NULL;
+    if(bus->unlock != NULL)
+    {
+        bus->unlock(bus->lock_ctx);
+    }
+}
+
+MX25Series_status_enum_t MX25Series_bus_tick(MX25Series_Bus_t *bus)
+{
+    bool sent = false;
+
+    return MX25Series__bus_schedule(bus, NULL, &sent);
+}
+
+void MX25Series_bus_delay(MX25Series_t *dev, uint32_t us)
+{
+    MX25Series_Bus_t *bus = dev->bus;
+    uint32_t start;
+
+    if(bus == NULL || bus->scheduling || bus->device_count < 2)
+    {
+        MX25Series___delay_micro_second(dev, us);
+        return;
+    }
+
+    start = MX25Series___get_micro_seconds(dev);
+    for(;;)
+    {
+        uint32_t elapsed = MX25Series___get_micro_seconds(dev) - start;
+        bool sent = false;
+
+        if(elapsed >= us)
+        {
+            return;
+        }
+
+        //Errors reach the other devices' callbacks, dev only cares about the time passing.
+        MX25Series__bus_schedule(bus, dev, &sent);
+        if(!sent)
+        {
+            uint32_t step = us - elapsed;
+            MX25Series___delay_micro_second(dev, step > MX25Series_WIP_POLL_INTERVAL ? MX25Series_WIP_POLL_INTERVAL : step);
+        }
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#ifndef FLASH_MX25Series_Bus_H
+#define FLASH_MX25Series_Bus_H
+
+#include "MX25Series.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#ifndef MX25Series_BUS_MAX_DEVICES
+    #define MX25Series_BUS_MAX_DEVICES 4 /**! Most devices that can share one bus */
+#endif
+
+/**
+ * Takes the bus lock, for example an RTOS mutex, before a device asserts CS.
+ * @return MX25Series_status_ok once held, an error to abandon the transaction.
+ */
+typedef MX25Series_status_enum_t (*MX25Series_Bus_Lock_t)(void *lock_ctx);
+
+/**
+ * Releases the bus lock after a device has released CS.
+ */
+typedef void (*MX25Series_Bus_Unlock_t)(void *lock_ctx);
+
+/**
+ * @brief A SPI bus shared by several devices on their own CS lines.
+ * The bus is owned for one transaction at a time, never across a sequence such as WREN and Page Program, so
+ * transactions from different devices interleave. The scheduler runs the devices' MX25Series_Async_t queues and
+ * the time one device spends waiting for WIP is used to serve the others.
+ */
+typedef struct MX25Series_Bus_t
+{
+    MX25Series_t *devices[MX25Series_BUS_MAX_DEVICES];
+    uint8_t device_count;
+    uint8_t next;                   /**! Device served first among equal priorities on the next tick */
+    MX25Series_Bus_Lock_t lock;     /**! NULL when the bus is only used from one context */
+    MX25Series_Bus_Unlock_t unlock;
+    void *lock_ctx;                 /**! Passed to lock and unlock */
+    MX25Series_t *owner;            /**! Device with CS asserted, NULL when the bus is free */
+    bool scheduling;                /**! Guards against the scheduler being re-entered */
+} MX25Series_Bus_t;
+
+/**
+ * MX25Series_bus_init sets up a bus with no devices.
+ * @param bus the bus structure to initialise.
+ * @param lock called before every transaction, may be NULL.
+ * @param unlock called after every transaction, may be NULL.
+ * @param lock_ctx passed to lock and unlock.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_bus_init(
+        MX25Series_Bus_t *bus,
+        MX25Series_Bus_Lock_t lock,
+        MX25Series_Bus_Unlock_t unlock,
+        void *lock_ctx);
+
+/**
+ * MX25Series_bus_attach adds an initialised device to the bus, from then on its transactions take the bus and its
+ * waits serve the other devices.
+ * @param bus the bus structure.
+ * @param dev the device structure for the MX25Series chip.
+ * @return MX25Series_status_error_busy if the bus already has MX25Series_BUS_MAX_DEVICES devices.
+ */
+MX25Series_status_enum_t MX25Series_bus_attach(MX25Series_Bus_t *bus, MX25Series_t *dev);
+
+/**
+ * MX25Series_bus_detach removes a device from its bus.
+ * @param dev the device structure for the MX25Series chip.
+ */
+void MX25Series_bus_detach(MX25Series_t *dev);
+
+/**
+ * MX25Series_bus_acquire takes the bus for one transaction of dev, called by the library around every CS frame.
+ * @param bus the bus structure, NULL for a device with the bus to itself.
+ * @param dev the device structure for the MX25Series chip.
+ * @return MX25Series_status_error_busy if another device owns the bus and there is no lock to wait on, or the
+ * error from the lock.
+ */
+MX25Series_status_enum_t MX25Series_bus_acquire(MX25Series_Bus_t *bus, MX25Series_t *dev);
+
+/**
+ * MX25Series_bus_release gives the bus back after a transaction of dev.
+ * @param bus the bus structure, NULL for a device with the bus to itself.
+ * @param dev the device structure for the MX25Series chip.
+ */
+void MX25Series_bus_release(MX25Series_Bus_t *bus, MX25Series_t *dev);
+
+/**
+ * MX25Series_bus_tick runs one MX25Series_async_tick for every device with a frame to send, reads first, then
+ * program and erase frames, then due Status Register polls, rotating the first device among equals so each
+ * gets its turn. Devices that are waiting for WIP and not yet due a poll are skipped.
+ * @param bus the bus structure.
+ * @return the first error reported by a device, MX25Series_status_ok when there is nothing to do.
+ */
+MX25Series_status_enum_t MX25Series_bus_tick(MX25Series_Bus_t *bus);
+
+/**
+ * MX25Series_bus_delay waits us micro-seconds for dev, running the scheduler for the other devices on its bus
+ * while it waits. Without a bus it is MX25Series___delay_micro_second.
+ * @param dev the device structure for the MX25Series chip.
+ * @param us micro-seconds to wait.
+ */
+void MX25Series_bus_delay(MX25Series_t *dev, uint32_t us);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_Bus_H
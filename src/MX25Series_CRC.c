@@ -0,0 +1,172 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#include "MX25Series_CRC.h"
+
+#if defined(__ARM_FEATURE_CRC32)
+    #include <arm_acle.h>
+    #define MX25Series__CRC32_INSTRUCTIONS
+    #define MX25Series__CRC32C_INSTRUCTIONS
+#elif defined(__SSE4_2__)
+    #include <string.h>
+    #include <nmmintrin.h>
+    #define MX25Series__CRC32C_INSTRUCTIONS
+#endif
+
+#if defined(MX25Series__CRC32_INSTRUCTIONS) && defined(MX25Series__CRC32C_INSTRUCTIONS)
+    //No tables needed.
+#elif defined(MX25Series_ENABLE_CRC_SLICE_BY_8)
+#include "MX25Series_CRC_Tables.h"
+
+/**
+ * MX25Series__crc_update adds data to a reflected CRC eight bytes per step, using the byte order independent form
+ * of slice-by-8.
+ */
+static uint32_t MX25Series__crc_update(const uint32_t tables[8][256], uint32_t crc, const uint8_t *data, size_t length)
+{
+    crc = ~crc;
+    while(length >= 8)
+    {
+        uint32_t low = crc ^ (data[0] | (data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+        uint32_t high = data[4] | (data[5] << 8) | ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24);
+
+        crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^
+              tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24] ^
+              tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^
+              tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+        data += 8;
+        length -= 8;
+    }
+    while(length-- > 0)
+    {
+        crc = (crc >> 8) ^ tables[0][(crc ^ *data++) & 0xFF];
+    }
+    return ~crc;
+}
+
+#define MX25Series__CRC32_TABLE MX25Series__crc32_tables
+#define MX25Series__CRC32C_TABLE MX25Series__crc32c_tables
+
+#else
+
+#if !defined(MX25Series__CRC32_INSTRUCTIONS)
+static const uint32_t MX25Series__crc32_nibbles[16] = {
+    0x00000000ul, 0x1DB71064ul, 0x3B6E20C8ul, 0x26D930ACul, 0x76DC4190ul, 0x6B6B51F4ul, 0x4DB26158ul, 0x5005713Cul,
+    0xEDB88320ul, 0xF00F9344ul, 0xD6D6A3E8ul, 0xCB61B38Cul, 0x9B64C2B0ul, 0x86D3D2D4ul, 0xA00AE278ul, 0xBDBDF21Cul
+};
+#endif
+
+#if !defined(MX25Series__CRC32C_INSTRUCTIONS)
+static const uint32_t MX25Series__crc32c_nibbles[16] = {
+    0x00000000ul, 0x105EC76Ful, 0x20BD8EDEul, 0x30E349B1ul, 0x417B1DBCul, 0x5125DAD3ul, 0x61C69362ul, 0x7198540Dul,
+    0x82F63B78ul, 0x92A8FC17ul, 0xA24BB5A6ul, 0xB21572C9ul, 0xC38D26C4ul, 0xD3D3E1ABul, 0xE330A81Aul, 0xF36E6F75ul
+};
+#endif
+
+/**
+ * MX25Series__crc_update adds data to a reflected CRC a nibble at a time, 64 bytes of table per polynomial.
+ */
+static uint32_t MX25Series__crc_update(const uint32_t nibbles[16], uint32_t crc, const uint8_t *data, size_t length)
+{
+    crc = ~crc;
+    while(length-- > 0)
+    {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ nibbles[crc & 0x0F];
+        crc = (crc >> 4) ^ nibbles[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+#define MX25Series__CRC32_TABLE MX25Series__crc32_nibbles
+#define MX25Series__CRC32C_TABLE MX25Series__crc32c_nibbles
+
+#endif
+
+uint32_t MX25Series_crc32(uint32_t crc, const uint8_t *data, size_t length)
+{
+#if defined(MX25Series__CRC32_INSTRUCTIONS)
+    crc = ~crc;
+    for(; length >= 4; data += 4, length -= 4)
+    {
+        crc = __crc32w(crc, data[0] | (data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+    }
+    while(length-- > 0)
+    {
+        crc = __crc32b(crc, *data++);
+    }
+    return ~crc;
+#else
+    return MX25Series__crc_update(MX25Series__CRC32_TABLE, crc, data, length);
+#endif
+}
+
+uint32_t MX25Series_crc32c(uint32_t crc, const uint8_t *data, size_t length)
+{
+#if defined(__ARM_FEATURE_CRC32)
+    crc = ~crc;
+    for(; length >= 4; data += 4, length -= 4)
+    {
+        crc = __crc32cw(crc, data[0] | (data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+    }
+    while(length-- > 0)
+    {
+        crc = __crc32cb(crc, *data++);
+    }
+    return ~crc;
+#elif defined(__SSE4_2__)
+    crc = ~crc;
+#if defined(__x86_64__)
+    {
+        uint64_t wide = crc;
+        for(; length >= 8; data += 8, length -= 8)
+        {
+            uint64_t word;
+            memcpy(&word, data, sizeof(word));
+            wide = _mm_crc32_u64(wide, word);
+        }
+        crc = (uint32_t)wide;
+    }
+#endif
+    for(; length >= 4; data += 4, length -= 4)
+    {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+    }
+    while(length-- > 0)
+    {
+        crc = _mm_crc32_u8(crc, *data++);
+    }
+    return ~crc;
+#else
+    return MX25Series__crc_update(MX25Series__CRC32C_TABLE, crc, data, length);
+#endif
+}
+
+uint32_t MX25Series_crc(MX25Series_CRC_enum_t type, uint32_t crc, const uint8_t *data, size_t length)
+{
+    return type == MX25Series_CRC_32C ? MX25Series_crc32c(crc, data, length) : MX25Series_crc32(crc, data, length);
+}
@@ -0,0 +1,77 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#ifndef FLASH_MX25Series_CRC_H
+#define FLASH_MX25Series_CRC_H
+
+#include "stdint.h"
+#include "stddef.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+typedef enum {
+    MX25Series_CRC_32 = 0,      /**< IEEE 802.3, reflected polynomial 0xEDB88320 */
+    MX25Series_CRC_32C = 1,     /**< Castagnoli, reflected polynomial 0x82F63B78 */
+} MX25Series_CRC_enum_t;
+
+/**
+ * MX25Series_crc32 computes the CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) of data.
+ * Uses the ARMv8 CRC32 instructions when the compiler targets them, eight bytes per step with
+ * MX25Series_ENABLE_CRC_SLICE_BY_8 (16 KB of tables for both CRCs), and a nibble at a time otherwise.
+ * @param crc 0 to start, or the result of the previous call to continue a CRC over several buffers.
+ * @param data the bytes to add.
+ * @param length the number of bytes.
+ * @return the CRC of everything added so far.
+ */
+uint32_t MX25Series_crc32(uint32_t crc, const uint8_t *data, size_t length);
+
+/**
+ * MX25Series_crc32c computes the CRC-32C (Castagnoli, reflected polynomial 0x82F63B78) of data.
+ * Also uses the SSE4.2 CRC32 instruction when the compiler targets it.
+ * @param crc 0 to start, or the result of the previous call to continue a CRC over several buffers.
+ * @param data the bytes to add.
+ * @param length the number of bytes.
+ * @return the CRC of everything added so far.
+ */
+uint32_t MX25Series_crc32c(uint32_t crc, const uint8_t *data, size_t length);
+
+/**
+ * MX25Series_crc computes either CRC of data.
+ * @param type the CRC to compute.
+ * @param crc 0 to start, or the result of the previous call to continue a CRC over several buffers.
+ * @param data the bytes to add.
+ * @param length the number of bytes.
+ * @return the CRC of everything added so far.
+ */
+uint32_t MX25Series_crc(MX25Series_CRC_enum_t type, uint32_t crc, const uint8_t *data, size_t length);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_CRC_H
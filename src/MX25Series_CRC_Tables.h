@@ -0,0 +1,763 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#ifndef FLASH_MX25Series_CRC_Tables_H
+#define FLASH_MX25Series_CRC_Tables_H
+
+//Slice-by-8 tables used by MX25Series_CRC.c when MX25Series_ENABLE_CRC_SLICE_BY_8 is defined.
+
+#if !defined(MX25Series__CRC32_INSTRUCTIONS)
+/**! CRC-32, reflected polynomial 0xEDB88320, table k advances a byte followed by k zero bytes */
+static const uint32_t MX25Series__crc32_tables[8][256] = {
+    {
+        0x00000000ul, 0x77073096ul, 0xEE0E612Cul, 0x990951BAul, 0x076DC419ul, 0x706AF48Ful,
+        0xE963A535ul, 0x9E6495A3ul, 0x0EDB8832ul, 0x79DCB8A4ul, 0xE0D5E91Eul, 0x97D2D988ul,
+        0x09B64C2Bul, 0x7EB17CBDul, 0xE7B82D07ul, 0x90BF1D91ul, 0x1DB71064ul, 0x6AB020F2ul,
+        0xF3B97148ul, 0x84BE41DEul, 0x1ADAD47Dul, 0x6DDDE4EBul, 0xF4D4B551ul, 0x83D385C7ul,
+        0x136C9856ul, 0x646BA8C0ul, 0xFD62F97Aul, 0x8A65C9ECul, 0x14015C4Ful, 0x63066CD9ul,
+        0xFA0F3D63ul, 0x8D080DF5ul, 0x3B6E20C8ul, 0x4C69105Eul, 0xD56041E4ul, 0xA2677172ul,
+        0x3C03E4D1ul, 0x4B04D447ul, 0xD20D85FDul, 0xA50AB56Bul, 0x35B5A8FAul, 0x42B2986Cul,
+        0xDBBBC9D6ul, 0xACBCF940ul, 0x32D86CE3ul, 0x45DF5C75ul, 0xDCD60DCFul, 0xABD13D59ul,
+        0x26D930ACul, 0x51DE003Aul, 0xC8D75180ul, 0xBFD06116ul, 0x21B4F4B5ul, 0x56B3C423ul,
+        0xCFBA9599ul, 0xB8BDA50Ful, 0x2802B89Eul, 0x5F058808ul, 0xC60CD9B2ul, 0xB10BE924ul,
+        0x2F6F7C87ul, 0x58684C11ul, 0xC1611DABul, 0xB6662D3Dul, 0x76DC4190ul, 0x01DB7106ul,
+        0x98D220BCul, 0xEFD5102Aul, 0x71B18589ul, 0x06B6B51Ful, 0x9FBFE4A5ul, 0xE8B8D433ul,
+        0x7807C9A2ul, 0x0F00F934ul, 0x9609A88Eul, 0xE10E9818ul, 0x7F6A0DBBul, 0x086D3D2Dul,
+        0x91646C97ul, 0xE6635C01ul, 0x6B6B51F4ul, 0x1C6C6162ul, 0x856530D8ul, 0xF262004Eul,
+        0x6C0695EDul, 0x1B01A57Bul, 0x8208F4C1ul, 0xF50FC457ul, 0x65B0D9C6ul, 0x12B7E950ul,
+        0x8BBEB8EAul, 0xFCB9887Cul, 0x62DD1DDFul, 0x15DA2D49ul, 0x8CD37CF3ul, 0xFBD44C65ul,
+        0x4DB26158ul, 0x3AB551CEul, 0xA3BC0074ul, 0xD4BB30E2ul, 0x4ADFA541ul, 0x3DD895D7ul,
+        0xA4D1C46Dul, 0xD3D6F4FBul, 0x4369E96Aul, 0x346ED9FCul, 0xAD678846ul, 0xDA60B8D0ul,
+        0x44042D73ul, 0x33031DE5ul, 0xAA0A4C5Ful, 0xDD0D7CC9ul, 0x5005713Cul, 0x270241AAul,
+        0xBE0B1010ul, 0xC90C2086ul, 0x5768B525ul, 0x206F85B3ul, 0xB966D409ul, 0xCE61E49Ful,
+        0x5EDEF90Eul, 0x29D9C998ul, 0xB0D09822ul, 0xC7D7A8B4ul, 0x59B33D17ul, 0x2EB40D81ul,
+        0xB7BD5C3Bul, 0xC0BA6CADul, 0xEDB88320ul, 0x9ABFB3B6ul, 0x03B6E20Cul, 0x74B1D29Aul,
+        0xEAD54739ul, 0x9DD277AFul, 0x04DB2615ul, 0x73DC1683ul, 0xE3630B12ul, 0x94643B84ul,
+        0x0D6D6A3Eul, 0x7A6A5AA8ul, 0xE40ECF0Bul, 0x9309FF9Dul, 0x0A00AE27ul, 0x7D079EB1ul,
+        0xF00F9344ul, 0x8708A3D2ul, 0x1E01F268ul, 0x6906C2FEul, 0xF762575Dul, 0x806567CBul,
+        0x196C3671ul, 0x6E6B06E7ul, 0xFED41B76ul, 0x89D32BE0ul, 0x10DA7A5Aul, 0x67DD4ACCul,
+        0xF9B9DF6Ful, 0x8EBEEFF9ul, 0x17B7BE43ul, 0x60B08ED5ul, 0xD6D6A3E8ul, 0xA1D1937Eul,
+        0x38D8C2C4ul, 0x4FDFF252ul, 0xD1BB67F1ul, 0xA6BC5767ul, 0x3FB506DDul, 0x48B2364Bul,
+        0xD80D2BDAul, 0xAF0A1B4Cul, 0x36034AF6ul, 0x41047A60ul, 0xDF60EFC3ul, 0xA867DF55ul,
+        0x316E8EEFul, 0x4669BE79ul, 0xCB61B38Cul, 0xBC66831Aul, 0x256FD2A0ul, 0x5268E236ul,
+        0xCC0C7795ul, 0xBB0B4703ul, 0x220216B9ul, 0x5505262Ful, 0xC5BA3BBEul, 0xB2BD0B28ul,
+        0x2BB45A92ul, 0x5CB36A04ul, 0xC2D7FFA7ul, 0xB5D0CF31ul, 0x2CD99E8Bul, 0x5BDEAE1Dul,
+        0x9B64C2B0ul, 0xEC63F226ul, 0x756AA39Cul, 0x026D930Aul, 0x9C0906A9ul, 0xEB0E363Ful,
+        0x72076785ul, 0x05005713ul, 0x95BF4A82ul, 0xE2B87A14ul, 0x7BB12BAEul, 0x0CB61B38ul,
+        0x92D28E9Bul, 0xE5D5BE0Dul, 0x7CDCEFB7ul, 0x0BDBDF21ul, 0x86D3D2D4ul, 0xF1D4E242ul,
+        0x68DDB3F8ul, 0x1FDA836Eul, 0x81BE16CDul, 0xF6B9265Bul, 0x6FB077E1ul, 0x18B74777ul,
+        0x88085AE6ul, 0xFF0F6A70ul, 0x66063BCAul, 0x11010B5Cul, 0x8F659EFFul, 0xF862AE69ul,
+        0x616BFFD3ul, 0x166CCF45ul, 0xA00AE278ul, 0xD70DD2EEul, 0x4E048354ul, 0x3903B3C2ul,
+        0xA7672661ul, 0xD06016F7ul, 0x4969474Dul, 0x3E6E77DBul, 0xAED16A4Aul, 0xD9D65ADCul,
+        0x40DF0B66ul, 0x37D83BF0ul, 0xA9BCAE53ul, 0xDEBB9EC5ul, 0x47B2CF7Ful, 0x30B5FFE9ul,
+        0xBDBDF21Cul, 0xCABAC28Aul, 0x53B39330ul, 0x24B4A3A6ul, 0xBAD03605ul, 0xCDD70693ul,
+        0x54DE5729ul, 0x23D967BFul, 0xB3667A2Eul, 0xC4614AB8ul, 0x5D681B02ul, 0x2A6F2B94ul,
+        0xB40BBE37ul, 0xC30C8EA1ul, 0x5A05DF1Bul, 0x2D02EF8Dul
+    },
+    {
+        0x00000000ul, 0x191B3141ul, 0x32366282ul, 0x2B2D53C3ul, 0x646CC504ul, 0x7D77F445ul,
+        0x565AA786ul, 0x4F4196C7ul, 0xC8D98A08ul, 0xD1C2BB49ul, 0xFAEFE88Aul, 0xE3F4D9CBul,
+        0xACB54F0Cul, 0xB5AE7E4Dul, 0x9E832D8Eul, 0x87981CCFul, 0x4AC21251ul, 0x53D92310ul,
+        0x78F470D3ul, 0x61EF4192ul, 0x2EAED755ul, 0x37B5E614ul, 0x1C98B5D7ul, 0x05838496ul,
+        0x821B9859ul, 0x9B00A918ul, 0xB02DFADBul, 0xA936CB9Aul, 0xE6775D5Dul, 0xFF6C6C1Cul,
+        0xD4413FDFul, 0xCD5A0E9Eul, 0x958424A2ul, 0x8C9F15E3ul, 0xA7B24620ul, 0xBEA97761ul,
+        0xF1E8E1A6ul, 0xE8F3D0E7ul, 0xC3DE8324ul, 0xDAC5B265ul, 0x5D5DAEAAul, 0x44469FEBul,
+        0x6F6BCC28ul, 0x7670FD69ul, 0x39316BAEul, 0x202A5AEFul, 0x0B07092Cul, 0x121C386Dul,
+        0xDF4636F3ul, 0xC65D07B2ul, 0xED705471ul, 0xF46B6530ul, 0xBB2AF3F7ul, 0xA231C2B6ul,
+        0x891C9175ul, 0x9007A034ul, 0x179FBCFBul, 0x0E848DBAul, 0x25A9DE79ul, 0x3CB2EF38ul,
+        0x73F379FFul, 0x6AE848BEul, 0x41C51B7Dul, 0x58DE2A3Cul, 0xF0794F05ul, 0xE9627E44ul,
+        0xC24F2D87ul, 0xDB541CC6ul, 0x94158A01ul, 0x8D0EBB40ul, 0xA623E883ul, 0xBF38D9C2ul,
+        0x38A0C50Dul, 0x21BBF44Cul, 0x0A96A78Ful, 0x138D96CEul, 0x5CCC0009ul, 0x45D73148ul,
+        0x6EFA628Bul, 0x77E153CAul, 0xBABB5D54ul, 0xA3A06C15ul, 0x888D3FD6ul, 0x91960E97ul,
+        0xDED79850ul, 0xC7CCA911ul, 0xECE1FAD2ul, 0xF5FACB93ul, 0x7262D75Cul, 0x6B79E61Dul,
+        0x4054B5DEul, 0x594F849Ful, 0x160E1258ul, 0x0F152319ul, 0x243870DAul, 0x3D23419Bul,
+        0x65FD6BA7ul, 0x7CE65AE6ul, 0x57CB0925ul, 0x4ED03864ul, 0x0191AEA3ul, 0x188A9FE2ul,
+        0x33A7CC21ul, 0x2ABCFD60ul, 0xAD24E1AFul, 0xB43FD0EEul, 0x9F12832Dul, 0x8609B26Cul,
+        0xC94824ABul, 0xD05315EAul, 0xFB7E4629ul, 0xE2657768ul, 0x2F3F79F6ul, 0x362448B7ul,
+        0x1D091B74ul, 0x04122A35ul, 0x4B53BCF2ul, 0x52488DB3ul, 0x7965DE70ul, 0x607EEF31ul,
+        0xE7E6F3FEul, 0xFEFDC2BFul, 0xD5D0917Cul, 0xCCCBA03Dul, 0x838A36FAul, 0x9A9107BBul,
+        0xB1BC5478ul, 0xA8A76539ul, 0x3B83984Bul, 0x2298A90Aul, 0x09B5FAC9ul, 0x10AECB88ul,
+        0x5FEF5D4Ful, 0x46F46C0Eul, 0x6DD93FCDul, 0x74C20E8Cul, 0xF35A1243ul, 0xEA412302ul,
+        0xC16C70C1ul, 0xD8774180ul, 0x9736D747ul, 0x8E2DE606ul, 0xA500B5C5ul, 0xBC1B8484ul,
+        0x71418A1Aul, 0x685ABB5Bul, 0x4377E898ul, 0x5A6CD9D9ul, 0x152D4F1Eul, 0x0C367E5Ful,
+        0x271B2D9Cul, 0x3E001CDDul, 0xB9980012ul, 0xA0833153ul, 0x8BAE6290ul, 0x92B553D1ul,
+        0xDDF4C516ul, 0xC4EFF457ul, 0xEFC2A794ul, 0xF6D996D5ul, 0xAE07BCE9ul, 0xB71C8DA8ul,
+        0x9C31DE6Bul, 0x852AEF2Aul, 0xCA6B79EDul, 0xD37048ACul, 0xF85D1B6Ful, 0xE1462A2Eul,
+        0x66DE36E1ul, 0x7FC507A0ul, 0x54E85463ul, 0x4DF36522ul, 0x02B2F3E5ul, 0x1BA9C2A4ul,
+        0x30849167ul, 0x299FA026ul, 0xE4C5AEB8ul, 0xFDDE9FF9ul, 0xD6F3CC3Aul, 0xCFE8FD7Bul,
+        0x80A96BBCul, 0x99B25AFDul, 0xB29F093Eul, 0xAB84387Ful, 0x2C1C24B0ul, 0x350715F1ul,
+        0x1E2A4632ul, 0x07317773ul, 0x4870E1B4ul, 0x516BD0F5ul, 0x7A468336ul, 0x635DB277ul,
+        0xCBFAD74Eul, 0xD2E1E60Ful, 0xF9CCB5CCul, 0xE0D7848Dul, 0xAF96124Aul, 0xB68D230Bul,
+        0x9DA070C8ul, 0x84BB4189ul, 0x03235D46ul, 0x1A386C07ul, 0x31153FC4ul, 0x280E0E85ul,
+        0x674F9842ul, 0x7E54A903ul, 0x5579FAC0ul, 0x4C62CB81ul, 0x8138C51Ful, 0x9823F45Eul,
+        0xB30EA79Dul, 0xAA1596DCul, 0xE554001Bul, 0xFC4F315Aul, 0xD7626299ul, 0xCE7953D8ul,
+        0x49E14F17ul, 0x50FA7E56ul, 0x7BD72D95ul, 0x62CC1CD4ul, 0x2D8D8A13ul, 0x3496BB52ul,
+        0x1FBBE891ul, 0x06A0D9D0ul, 0x5E7EF3ECul, 0x4765C2ADul, 0x6C48916Eul, 0x7553A02Ful,
+        0x3A1236E8ul, 0x230907A9ul, 0x0824546Aul, 0x113F652Bul, 0x96A779E4ul, 0x8FBC48A5ul,
+        0xA4911B66ul, 0xBD8A2A27ul, 0xF2CBBCE0ul, 0xEBD08DA1ul, 0xC0FDDE62ul, 0xD9E6EF23ul,
+        0x14BCE1BDul, 0x0DA7D0FCul, 0x268A833Ful, 0x3F91B27Eul, 0x70D024B9ul, 0x69CB15F8ul,
+        0x42E6463Bul, 0x5BFD777Aul, 0xDC656BB5ul, 0xC57E5AF4ul, 0xEE530937ul, 0xF7483876ul,
+        0xB809AEB1ul, 0xA1129FF0ul, 0x8A3FCC33ul, 0x9324FD72ul
+    },
+    {
+        0x00000000ul, 0x01C26A37ul, 0x0384D46Eul, 0x0246BE59ul, 0x0709A8DCul, 0x06CBC2EBul,
+        0x048D7CB2ul, 0x054F1685ul, 0x0E1351B8ul, 0x0FD13B8Ful, 0x0D9785D6ul, 0x0C55EFE1ul,
+        0x091AF964ul, 0x08D89353ul, 0x0A9E2D0Aul, 0x0B5C473Dul, 0x1C26A370ul, 0x1DE4C947ul,
+        0x1FA2771Eul, 0x1E601D29ul, 0x1B2F0BACul, 0x1AED619Bul, 0x18ABDFC2ul, 0x1969B5F5ul,
+        0x1235F2C8ul, 0x13F798FFul, 0x11B126A6ul, 0x10734C91ul, 0x153C5A14ul, 0x14FE3023ul,
+        0x16B88E7Aul, 0x177AE44Dul, 0x384D46E0ul, 0x398F2CD7ul, 0x3BC9928Eul, 0x3A0BF8B9ul,
+        0x3F44EE3Cul, 0x3E86840Bul, 0x3CC03A52ul, 0x3D025065ul, 0x365E1758ul, 0x379C7D6Ful,
+        0x35DAC336ul, 0x3418A901ul, 0x3157BF84ul, 0x3095D5B3ul, 0x32D36BEAul, 0x331101DDul,
+        0x246BE590ul, 0x25A98FA7ul, 0x27EF31FEul, 0x262D5BC9ul, 0x23624D4Cul, 0x22A0277Bul,
+        0x20E69922ul, 0x2124F315ul, 0x2A78B428ul, 0x2BBADE1Ful, 0x29FC6046ul, 0x283E0A71ul,
+        0x2D711CF4ul, 0x2CB376C3ul, 0x2EF5C89Aul, 0x2F37A2ADul, 0x709A8DC0ul, 0x7158E7F7ul,
+        0x731E59AEul, 0x72DC3399ul, 0x7793251Cul, 0x76514F2Bul, 0x7417F172ul, 0x75D59B45ul,
+        0x7E89DC78ul, 0x7F4BB64Ful, 0x7D0D0816ul, 0x7CCF6221ul, 0x798074A4ul, 0x78421E93ul,
+        0x7A04A0CAul, 0x7BC6CAFDul, 0x6CBC2EB0ul, 0x6D7E4487ul, 0x6F38FADEul, 0x6EFA90E9ul,
+        0x6BB5866Cul, 0x6A77EC5Bul, 0x68315202ul, 0x69F33835ul, 0x62AF7F08ul, 0x636D153Ful,
+        0x612BAB66ul, 0x60E9C151ul, 0x65A6D7D4ul, 0x6464BDE3ul, 0x662203BAul, 0x67E0698Dul,
+        0x48D7CB20ul, 0x4915A117ul, 0x4B531F4Eul, 0x4A917579ul, 0x4FDE63FCul, 0x4E1C09CBul,
+        0x4C5AB792ul, 0x4D98DDA5ul, 0x46C49A98ul, 0x4706F0AFul, 0x45404EF6ul, 0x448224C1ul,
+        0x41CD3244ul, 0x400F5873ul, 0x4249E62Aul, 0x438B8C1Dul, 0x54F16850ul, 0x55330267ul,
+        0x5775BC3Eul, 0x56B7D609ul, 0x53F8C08Cul, 0x523AAABBul, 0x507C14E2ul, 0x51BE7ED5ul,
+        0x5AE239E8ul, 0x5B2053DFul, 0x5966ED86ul, 0x58A487B1ul, 0x5DEB9134ul, 0x5C29FB03ul,
+        0x5E6F455Aul, 0x5FAD2F6Dul, 0xE1351B80ul, 0xE0F771B7ul, 0xE2B1CFEEul, 0xE373A5D9ul,
+        0xE63CB35Cul, 0xE7FED96Bul, 0xE5B86732ul, 0xE47A0D05ul, 0xEF264A38ul, 0xEEE4200Ful,
+        0xECA29E56ul, 0xED60F461ul, 0xE82FE2E4ul, 0xE9ED88D3ul, 0xEBAB368Aul, 0xEA695CBDul,
+        0xFD13B8F0ul, 0xFCD1D2C7ul, 0xFE976C9Eul, 0xFF5506A9ul, 0xFA1A102Cul, 0xFBD87A1Bul,
+        0xF99EC442ul, 0xF85CAE75ul, 0xF300E948ul, 0xF2C2837Ful, 0xF0843D26ul, 0xF1465711ul,
+        0xF4094194ul, 0xF5CB2BA3ul, 0xF78D95FAul, 0xF64FFFCDul, 0xD9785D60ul, 0xD8BA3757ul,
+        0xDAFC890Eul, 0xDB3EE339ul, 0xDE71F5BCul, 0xDFB39F8Bul, 0xDDF521D2ul, 0xDC374BE5ul,
+        0xD76B0CD8ul, 0xD6A966EFul, 0xD4EFD8B6ul, 0xD52DB281ul, 0xD062A404ul, 0xD1A0CE33ul,
+        0xD3E6706Aul, 0xD2241A5Dul, 0xC55EFE10ul, 0xC49C9427ul, 0xC6DA2A7Eul, 0xC7184049ul,
+        0xC25756CCul, 0xC3953CFBul, 0xC1D382A2ul, 0xC011E895ul, 0xCB4DAFA8ul, 0xCA8FC59Ful,
+        0xC8C97BC6ul, 0xC90B11F1ul, 0xCC440774ul, 0xCD866D43ul, 0xCFC0D31Aul, 0xCE02B92Dul,
+        0x91AF9640ul, 0x906DFC77ul, 0x922B422Eul, 0x93E92819ul, 0x96A63E9Cul, 0x976454ABul,
+        0x9522EAF2ul, 0x94E080C5ul, 0x9FBCC7F8ul, 0x9E7EADCFul, 0x9C381396ul, 0x9DFA79A1ul,
+        0x98B56F24ul, 0x99770513ul, 0x9B31BB4Aul, 0x9AF3D17Dul, 0x8D893530ul, 0x8C4B5F07ul,
+        0x8E0DE15Eul, 0x8FCF8B69ul, 0x8A809DECul, 0x8B42F7DBul, 0x89044982ul, 0x88C623B5ul,
+        0x839A6488ul, 0x82580EBFul, 0x801EB0E6ul, 0x81DCDAD1ul, 0x8493CC54ul, 0x8551A663ul,
+        0x8717183Aul, 0x86D5720Dul, 0xA9E2D0A0ul, 0xA820BA97ul, 0xAA6604CEul, 0xABA46EF9ul,
+        0xAEEB787Cul, 0xAF29124Bul, 0xAD6FAC12ul, 0xACADC625ul, 0xA7F18118ul, 0xA633EB2Ful,
+        0xA4755576ul, 0xA5B73F41ul, 0xA0F829C4ul, 0xA13A43F3ul, 0xA37CFDAAul, 0xA2BE979Dul,
+        0xB5C473D0ul, 0xB40619E7ul, 0xB640A7BEul, 0xB782CD89ul, 0xB2CDDB0Cul, 0xB30FB13Bul,
+        0xB1490F62ul, 0xB08B6555ul, 0xBBD72268ul, 0xBA15485Ful, 0xB853F606ul, 0xB9919C31ul,
+        0xBCDE8AB4ul, 0xBD1CE083ul, 0xBF5A5EDAul, 0xBE9834EDul
+    },
+    {
+        0x00000000ul, 0xB8BC6765ul, 0xAA09C88Bul, 0x12B5AFEEul, 0x8F629757ul, 0x37DEF032ul,
+        0x256B5FDCul, 0x9DD738B9ul, 0xC5B428EFul, 0x7D084F8Aul, 0x6FBDE064ul, 0xD7018701ul,
+        0x4AD6BFB8ul, 0xF26AD8DDul, 0xE0DF7733ul, 0x58631056ul, 0x5019579Ful, 0xE8A530FAul,
+        0xFA109F14ul, 0x42ACF871ul, 0xDF7BC0C8ul, 0x67C7A7ADul, 0x75720843ul, 0xCDCE6F26ul,
+        0x95AD7F70ul, 0x2D111815ul, 0x3FA4B7FBul, 0x8718D09Eul, 0x1ACFE827ul, 0xA2738F42ul,
+        0xB0C620ACul, 0x087A47C9ul, 0xA032AF3Eul, 0x188EC85Bul, 0x0A3B67B5ul, 0xB28700D0ul,
+        0x2F503869ul, 0x97EC5F0Cul, 0x8559F0E2ul, 0x3DE59787ul, 0x658687D1ul, 0xDD3AE0B4ul,
+        0xCF8F4F5Aul, 0x7733283Ful, 0xEAE41086ul, 0x525877E3ul, 0x40EDD80Dul, 0xF851BF68ul,
+        0xF02BF8A1ul, 0x48979FC4ul, 0x5A22302Aul, 0xE29E574Ful, 0x7F496FF6ul, 0xC7F50893ul,
+        0xD540A77Dul, 0x6DFCC018ul, 0x359FD04Eul, 0x8D23B72Bul, 0x9F9618C5ul, 0x272A7FA0ul,
+        0xBAFD4719ul, 0x0241207Cul, 0x10F48F92ul, 0xA848E8F7ul, 0x9B14583Dul, 0x23A83F58ul,
+        0x311D90B6ul, 0x89A1F7D3ul, 0x1476CF6Aul, 0xACCAA80Ful, 0xBE7F07E1ul, 0x06C36084ul,
+        0x5EA070D2ul, 0xE61C17B7ul, 0xF4A9B859ul, 0x4C15DF3Cul, 0xD1C2E785ul, 0x697E80E0ul,
+        0x7BCB2F0Eul, 0xC377486Bul, 0xCB0D0FA2ul, 0x73B168C7ul, 0x6104C729ul, 0xD9B8A04Cul,
+        0x446F98F5ul, 0xFCD3FF90ul, 0xEE66507Eul, 0x56DA371Bul, 0x0EB9274Dul, 0xB6054028ul,
+        0xA4B0EFC6ul, 0x1C0C88A3ul, 0x81DBB01Aul, 0x3967D77Ful, 0x2BD27891ul, 0x936E1FF4ul,
+        0x3B26F703ul, 0x839A9066ul, 0x912F3F88ul, 0x299358EDul, 0xB4446054ul, 0x0CF80731ul,
+        0x1E4DA8DFul, 0xA6F1CFBAul, 0xFE92DFECul, 0x462EB889ul, 0x549B1767ul, 0xEC277002ul,
+        0x71F048BBul, 0xC94C2FDEul, 0xDBF98030ul, 0x6345E755ul, 0x6B3FA09Cul, 0xD383C7F9ul,
+        0xC1366817ul, 0x798A0F72ul, 0xE45D37CBul, 0x5CE150AEul, 0x4E54FF40ul, 0xF6E89825ul,
+        0xAE8B8873ul, 0x1637EF16ul, 0x048240F8ul, 0xBC3E279Dul, 0x21E91F24ul, 0x99557841ul,
+        0x8BE0D7AFul, 0x335CB0CAul, 0xED59B63Bul, 0x55E5D15Eul, 0x47507EB0ul, 0xFFEC19D5ul,
+        0x623B216Cul, 0xDA874609ul, 0xC832E9E7ul, 0x708E8E82ul, 0x28ED9ED4ul, 0x9051F9B1ul,
+        0x82E4565Ful, 0x3A58313Aul, 0xA78F0983ul, 0x1F336EE6ul, 0x0D86C108ul, 0xB53AA66Dul,
+        0xBD40E1A4ul, 0x05FC86C1ul, 0x1749292Ful, 0xAFF54E4Aul, 0x322276F3ul, 0x8A9E1196ul,
+        0x982BBE78ul, 0x2097D91Dul, 0x78F4C94Bul, 0xC048AE2Eul, 0xD2FD01C0ul, 0x6A4166A5ul,
+        0xF7965E1Cul, 0x4F2A3979ul, 0x5D9F9697ul, 0xE523F1F2ul, 0x4D6B1905ul, 0xF5D77E60ul,
+        0xE762D18Eul, 0x5FDEB6EBul, 0xC2098E52ul, 0x7AB5E937ul, 0x680046D9ul, 0xD0BC21BCul,
+        0x88DF31EAul, 0x3063568Ful, 0x22D6F961ul, 0x9A6A9E04ul, 0x07BDA6BDul, 0xBF01C1D8ul,
+        0xADB46E36ul, 0x15080953ul, 0x1D724E9Aul, 0xA5CE29FFul, 0xB77B8611ul, 0x0FC7E174ul,
+        0x9210D9CDul, 0x2AACBEA8ul, 0x38191146ul, 0x80A57623ul, 0xD8C66675ul, 0x607A0110ul,
+        0x72CFAEFEul, 0xCA73C99Bul, 0x57A4F122ul, 0xEF189647ul, 0xFDAD39A9ul, 0x45115ECCul,
+        0x764DEE06ul, 0xCEF18963ul, 0xDC44268Dul, 0x64F841E8ul, 0xF92F7951ul, 0x41931E34ul,
+        0x5326B1DAul, 0xEB9AD6BFul, 0xB3F9C6E9ul, 0x0B45A18Cul, 0x19F00E62ul, 0xA14C6907ul,
+        0x3C9B51BEul, 0x842736DBul, 0x96929935ul, 0x2E2EFE50ul, 0x2654B999ul, 0x9EE8DEFCul,
+        0x8C5D7112ul, 0x34E11677ul, 0xA9362ECEul, 0x118A49ABul, 0x033FE645ul, 0xBB838120ul,
+        0xE3E09176ul, 0x5B5CF613ul, 0x49E959FDul, 0xF1553E98ul, 0x6C820621ul, 0xD43E6144ul,
+        0xC68BCEAAul, 0x7E37A9CFul, 0xD67F4138ul, 0x6EC3265Dul, 0x7C7689B3ul, 0xC4CAEED6ul,
+        0x591DD66Ful, 0xE1A1B10Aul, 0xF3141EE4ul, 0x4BA87981ul, 0x13CB69D7ul, 0xAB770EB2ul,
+        0xB9C2A15Cul, 0x017EC639ul, 0x9CA9FE80ul, 0x241599E5ul, 0x36A0360Bul, 0x8E1C516Eul,
+        0x866616A7ul, 0x3EDA71C2ul, 0x2C6FDE2Cul, 0x94D3B949ul, 0x090481F0ul, 0xB1B8E695ul,
+        0xA30D497Bul, 0x1BB12E1Eul, 0x43D23E48ul, 0xFB6E592Dul, 0xE9DBF6C3ul, 0x516791A6ul,
+        0xCCB0A91Ful, 0x740CCE7Aul, 0x66B96194ul, 0xDE0506F1ul
+    },
+    {
+        0x00000000ul, 0x3D6029B0ul, 0x7AC05360ul, 0x47A07AD0ul, 0xF580A6C0ul, 0xC8E08F70ul,
+        0x8F40F5A0ul, 0xB220DC10ul, 0x30704BC1ul, 0x0D106271ul, 0x4AB018A1ul, 0x77D03111ul,
+        0xC5F0ED01ul, 0xF890C4B1ul, 0xBF30BE61ul, 0x825097D1ul, 0x60E09782ul, 0x5D80BE32ul,
+        0x1A20C4E2ul, 0x2740ED52ul, 0x95603142ul, 0xA80018F2ul, 0xEFA06222ul, 0xD2C04B92ul,
+        0x5090DC43ul, 0x6DF0F5F3ul, 0x2A508F23ul, 0x1730A693ul, 0xA5107A83ul, 0x98705333ul,
+        0xDFD029E3ul, 0xE2B00053ul, 0xC1C12F04ul, 0xFCA106B4ul, 0xBB017C64ul, 0x866155D4ul,
+        0x344189C4ul, 0x0921A074ul, 0x4E81DAA4ul, 0x73E1F314ul, 0xF1B164C5ul, 0xCCD14D75ul,
+        0x8B7137A5ul, 0xB6111E15ul, 0x0431C205ul, 0x3951EBB5ul, 0x7EF19165ul, 0x4391B8D5ul,
+        0xA121B886ul, 0x9C419136ul, 0xDBE1EBE6ul, 0xE681C256ul, 0x54A11E46ul, 0x69C137F6ul,
+        0x2E614D26ul, 0x13016496ul, 0x9151F347ul, 0xAC31DAF7ul, 0xEB91A027ul, 0xD6F18997ul,
+        0x64D15587ul, 0x59B17C37ul, 0x1E1106E7ul, 0x23712F57ul, 0x58F35849ul, 0x659371F9ul,
+        0x22330B29ul, 0x1F532299ul, 0xAD73FE89ul, 0x9013D739ul, 0xD7B3ADE9ul, 0xEAD38459ul,
+        0x68831388ul, 0x55E33A38ul, 0x124340E8ul, 0x2F236958ul, 0x9D03B548ul, 0xA0639CF8ul,
+        0xE7C3E628ul, 0xDAA3CF98ul, 0x3813CFCBul, 0x0573E67Bul, 0x42D39CABul, 0x7FB3B51Bul,
+        0xCD93690Bul, 0xF0F340BBul, 0xB7533A6Bul, 0x8A3313DBul, 0x0863840Aul, 0x3503ADBAul,
+        0x72A3D76Aul, 0x4FC3FEDAul, 0xFDE322CAul, 0xC0830B7Aul, 0x872371AAul, 0xBA43581Aul,
+        0x9932774Dul, 0xA4525EFDul, 0xE3F2242Dul, 0xDE920D9Dul, 0x6CB2D18Dul, 0x51D2F83Dul,
+        0x167282EDul, 0x2B12AB5Dul, 0xA9423C8Cul, 0x9422153Cul, 0xD3826FECul, 0xEEE2465Cul,
+        0x5CC29A4Cul, 0x61A2B3FCul, 0x2602C92Cul, 0x1B62E09Cul, 0xF9D2E0CFul, 0xC4B2C97Ful,
+        0x8312B3AFul, 0xBE729A1Ful, 0x0C52460Ful, 0x31326FBFul, 0x7692156Ful, 0x4BF23CDFul,
+        0xC9A2AB0Eul, 0xF4C282BEul, 0xB362F86Eul, 0x8E02D1DEul, 0x3C220DCEul, 0x0142247Eul,
+        0x46E25EAEul, 0x7B82771Eul, 0xB1E6B092ul, 0x8C869922ul, 0xCB26E3F2ul, 0xF646CA42ul,
+        0x44661652ul, 0x79063FE2ul, 0x3EA64532ul, 0x03C66C82ul, 0x8196FB53ul, 0xBCF6D2E3ul,
+        0xFB56A833ul, 0xC6368183ul, 0x74165D93ul, 0x49767423ul, 0x0ED60EF3ul, 0x33B62743ul,
+        0xD1062710ul, 0xEC660EA0ul, 0xABC67470ul, 0x96A65DC0ul, 0x248681D0ul, 0x19E6A860ul,
+        0x5E46D2B0ul, 0x6326FB00ul, 0xE1766CD1ul, 0xDC164561ul, 0x9BB63FB1ul, 0xA6D61601ul,
+        0x14F6CA11ul, 0x2996E3A1ul, 0x6E369971ul, 0x5356B0C1ul, 0x70279F96ul, 0x4D47B626ul,
+        0x0AE7CCF6ul, 0x3787E546ul, 0x85A73956ul, 0xB8C710E6ul, 0xFF676A36ul, 0xC2074386ul,
+        0x4057D457ul, 0x7D37FDE7ul, 0x3A978737ul, 0x07F7AE87ul, 0xB5D77297ul, 0x88B75B27ul,
+        0xCF1721F7ul, 0xF2770847ul, 0x10C70814ul, 0x2DA721A4ul, 0x6A075B74ul, 0x576772C4ul,
+        0xE547AED4ul, 0xD8278764ul, 0x9F87FDB4ul, 0xA2E7D404ul, 0x20B743D5ul, 0x1DD76A65ul,
+        0x5A7710B5ul, 0x67173905ul, 0xD537E515ul, 0xE857CCA5ul, 0xAFF7B675ul, 0x92979FC5ul,
+        0xE915E8DBul, 0xD475C16Bul, 0x93D5BBBBul, 0xAEB5920Bul, 0x1C954E1Bul, 0x21F567ABul,
+        0x66551D7Bul, 0x5B3534CBul, 0xD965A31Aul, 0xE4058AAAul, 0xA3A5F07Aul, 0x9EC5D9CAul,
+        0x2CE505DAul, 0x11852C6Aul, 0x562556BAul, 0x6B457F0Aul, 0x89F57F59ul, 0xB49556E9ul,
+        0xF3352C39ul, 0xCE550589ul, 0x7C75D999ul, 0x4115F029ul, 0x06B58AF9ul, 0x3BD5A349ul,
+        0xB9853498ul, 0x84E51D28ul, 0xC34567F8ul, 0xFE254E48ul, 0x4C059258ul, 0x7165BBE8ul,
+        0x36C5C138ul, 0x0BA5E888ul, 0x28D4C7DFul, 0x15B4EE6Ful, 0x521494BFul, 0x6F74BD0Ful,
+        0xDD54611Ful, 0xE03448AFul, 0xA794327Ful, 0x9AF41BCFul, 0x18A48C1Eul, 0x25C4A5AEul,
+        0x6264DF7Eul, 0x5F04F6CEul, 0xED242ADEul, 0xD044036Eul, 0x97E479BEul, 0xAA84500Eul,
+        0x4834505Dul, 0x755479EDul, 0x32F4033Dul, 0x0F942A8Dul, 0xBDB4F69Dul, 0x80D4DF2Dul,
+        0xC774A5FDul, 0xFA148C4Dul, 0x78441B9Cul, 0x4524322Cul, 0x028448FCul, 0x3FE4614Cul,
+        0x8DC4BD5Cul, 0xB0A494ECul, 0xF704EE3Cul, 0xCA64C78Cul
+    },
+    {
+        0x00000000ul, 0xCB5CD3A5ul, 0x4DC8A10Bul, 0x869472AEul, 0x9B914216ul, 0x50CD91B3ul,
+        0xD659E31Dul, 0x1D0530B8ul, 0xEC53826Dul, 0x270F51C8ul, 0xA19B2366ul, 0x6AC7F0C3ul,
+        0x77C2C07Bul, 0xBC9E13DEul, 0x3A0A6170ul, 0xF156B2D5ul, 0x03D6029Bul, 0xC88AD13Eul,
+        0x4E1EA390ul, 0x85427035ul, 0x9847408Dul, 0x531B9328ul, 0xD58FE186ul, 0x1ED33223ul,
+        0xEF8580F6ul, 0x24D95353ul, 0xA24D21FDul, 0x6911F258ul, 0x7414C2E0ul, 0xBF481145ul,
+        0x39DC63EBul, 0xF280B04Eul, 0x07AC0536ul, 0xCCF0D693ul, 0x4A64A43Dul, 0x81387798ul,
+        0x9C3D4720ul, 0x57619485ul, 0xD1F5E62Bul, 0x1AA9358Eul, 0xEBFF875Bul, 0x20A354FEul,
+        0xA6372650ul, 0x6D6BF5F5ul, 0x706EC54Dul, 0xBB3216E8ul, 0x3DA66446ul, 0xF6FAB7E3ul,
+        0x047A07ADul, 0xCF26D408ul, 0x49B2A6A6ul, 0x82EE7503ul, 0x9FEB45BBul, 0x54B7961Eul,
+        0xD223E4B0ul, 0x197F3715ul, 0xE82985C0ul, 0x23755665ul, 0xA5E124CBul, 0x6EBDF76Eul,
+        0x73B8C7D6ul, 0xB8E41473ul, 0x3E7066DDul, 0xF52CB578ul, 0x0F580A6Cul, 0xC404D9C9ul,
+        0x4290AB67ul, 0x89CC78C2ul, 0x94C9487Aul, 0x5F959BDFul, 0xD901E971ul, 0x125D3AD4ul,
+        0xE30B8801ul, 0x28575BA4ul, 0xAEC3290Aul, 0x659FFAAFul, 0x789ACA17ul, 0xB3C619B2ul,
+        0x35526B1Cul, 0xFE0EB8B9ul, 0x0C8E08F7ul, 0xC7D2DB52ul, 0x4146A9FCul, 0x8A1A7A59ul,
+        0x971F4AE1ul, 0x5C439944ul, 0xDAD7EBEAul, 0x118B384Ful, 0xE0DD8A9Aul, 0x2B81593Ful,
+        0xAD152B91ul, 0x6649F834ul, 0x7B4CC88Cul, 0xB0101B29ul, 0x36846987ul, 0xFDD8BA22ul,
+        0x08F40F5Aul, 0xC3A8DCFFul, 0x453CAE51ul, 0x8E607DF4ul, 0x93654D4Cul, 0x58399EE9ul,
+        0xDEADEC47ul, 0x15F13FE2ul, 0xE4A78D37ul, 0x2FFB5E92ul, 0xA96F2C3Cul, 0x6233FF99ul,
+        0x7F36CF21ul, 0xB46A1C84ul, 0x32FE6E2Aul, 0xF9A2BD8Ful, 0x0B220DC1ul, 0xC07EDE64ul,
+        0x46EAACCAul, 0x8DB67F6Ful, 0x90B34FD7ul, 0x5BEF9C72ul, 0xDD7BEEDCul, 0x16273D79ul,
+        0xE7718FACul, 0x2C2D5C09ul, 0xAAB92EA7ul, 0x61E5FD02ul, 0x7CE0CDBAul, 0xB7BC1E1Ful,
+        0x31286CB1ul, 0xFA74BF14ul, 0x1EB014D8ul, 0xD5ECC77Dul, 0x5378B5D3ul, 0x98246676ul,
+        0x852156CEul, 0x4E7D856Bul, 0xC8E9F7C5ul, 0x03B52460ul, 0xF2E396B5ul, 0x39BF4510ul,
+        0xBF2B37BEul, 0x7477E41Bul, 0x6972D4A3ul, 0xA22E0706ul, 0x24BA75A8ul, 0xEFE6A60Dul,
+        0x1D661643ul, 0xD63AC5E6ul, 0x50AEB748ul, 0x9BF264EDul, 0x86F75455ul, 0x4DAB87F0ul,
+        0xCB3FF55Eul, 0x006326FBul, 0xF135942Eul, 0x3A69478Bul, 0xBCFD3525ul, 0x77A1E680ul,
+        0x6AA4D638ul, 0xA1F8059Dul, 0x276C7733ul, 0xEC30A496ul, 0x191C11EEul, 0xD240C24Bul,
+        0x54D4B0E5ul, 0x9F886340ul, 0x828D53F8ul, 0x49D1805Dul, 0xCF45F2F3ul, 0x04192156ul,
+        0xF54F9383ul, 0x3E134026ul, 0xB8873288ul, 0x73DBE12Dul, 0x6EDED195ul, 0xA5820230ul,
+        0x2316709Eul, 0xE84AA33Bul, 0x1ACA1375ul, 0xD196C0D0ul, 0x5702B27Eul, 0x9C5E61DBul,
+        0x815B5163ul, 0x4A0782C6ul, 0xCC93F068ul, 0x07CF23CDul, 0xF6999118ul, 0x3DC542BDul,
+        0xBB513013ul, 0x700DE3B6ul, 0x6D08D30Eul, 0xA65400ABul, 0x20C07205ul, 0xEB9CA1A0ul,
+        0x11E81EB4ul, 0xDAB4CD11ul, 0x5C20BFBFul, 0x977C6C1Aul, 0x8A795CA2ul, 0x41258F07ul,
+        0xC7B1FDA9ul, 0x0CED2E0Cul, 0xFDBB9CD9ul, 0x36E74F7Cul, 0xB0733DD2ul, 0x7B2FEE77ul,
+        0x662ADECFul, 0xAD760D6Aul, 0x2BE27FC4ul, 0xE0BEAC61ul, 0x123E1C2Ful, 0xD962CF8Aul,
+        0x5FF6BD24ul, 0x94AA6E81ul, 0x89AF5E39ul, 0x42F38D9Cul, 0xC467FF32ul, 0x0F3B2C97ul,
+        0xFE6D9E42ul, 0x35314DE7ul, 0xB3A53F49ul, 0x78F9ECECul, 0x65FCDC54ul, 0xAEA00FF1ul,
+        0x28347D5Ful, 0xE368AEFAul, 0x16441B82ul, 0xDD18C827ul, 0x5B8CBA89ul, 0x90D0692Cul,
+        0x8DD55994ul, 0x46898A31ul, 0xC01DF89Ful, 0x0B412B3Aul, 0xFA1799EFul, 0x314B4A4Aul,
+        0xB7DF38E4ul, 0x7C83EB41ul, 0x6186DBF9ul, 0xAADA085Cul, 0x2C4E7AF2ul, 0xE712A957ul,
+        0x15921919ul, 0xDECECABCul, 0x585AB812ul, 0x93066BB7ul, 0x8E035B0Ful, 0x455F88AAul,
+        0xC3CBFA04ul, 0x089729A1ul, 0xF9C19B74ul, 0x329D48D1ul, 0xB4093A7Ful, 0x7F55E9DAul,
+        0x6250D962ul, 0xA90C0AC7ul, 0x2F987869ul, 0xE4C4ABCCul
+    },
+    {
+        0x00000000ul, 0xA6770BB4ul, 0x979F1129ul, 0x31E81A9Dul, 0xF44F2413ul, 0x52382FA7ul,
+        0x63D0353Aul, 0xC5A73E8Eul, 0x33EF4E67ul, 0x959845D3ul, 0xA4705F4Eul, 0x020754FAul,
+        0xC7A06A74ul, 0x61D761C0ul, 0x503F7B5Dul, 0xF64870E9ul, 0x67DE9CCEul, 0xC1A9977Aul,
+        0xF0418DE7ul, 0x56368653ul, 0x9391B8DDul, 0x35E6B369ul, 0x040EA9F4ul, 0xA279A240ul,
+        0x5431D2A9ul, 0xF246D91Dul, 0xC3AEC380ul, 0x65D9C834ul, 0xA07EF6BAul, 0x0609FD0Eul,
+        0x37E1E793ul, 0x9196EC27ul, 0xCFBD399Cul, 0x69CA3228ul, 0x582228B5ul, 0xFE552301ul,
+        0x3BF21D8Ful, 0x9D85163Bul, 0xAC6D0CA6ul, 0x0A1A0712ul, 0xFC5277FBul, 0x5A257C4Ful,
+        0x6BCD66D2ul, 0xCDBA6D66ul, 0x081D53E8ul, 0xAE6A585Cul, 0x9F8242C1ul, 0x39F54975ul,
+        0xA863A552ul, 0x0E14AEE6ul, 0x3FFCB47Bul, 0x998BBFCFul, 0x5C2C8141ul, 0xFA5B8AF5ul,
+        0xCBB39068ul, 0x6DC49BDCul, 0x9B8CEB35ul, 0x3DFBE081ul, 0x0C13FA1Cul, 0xAA64F1A8ul,
+        0x6FC3CF26ul, 0xC9B4C492ul, 0xF85CDE0Ful, 0x5E2BD5BBul, 0x440B7579ul, 0xE27C7ECDul,
+        0xD3946450ul, 0x75E36FE4ul, 0xB044516Aul, 0x16335ADEul, 0x27DB4043ul, 0x81AC4BF7ul,
+        0x77E43B1Eul, 0xD19330AAul, 0xE07B2A37ul, 0x460C2183ul, 0x83AB1F0Dul, 0x25DC14B9ul,
+        0x14340E24ul, 0xB2430590ul, 0x23D5E9B7ul, 0x85A2E203ul, 0xB44AF89Eul, 0x123DF32Aul,
+        0xD79ACDA4ul, 0x71EDC610ul, 0x4005DC8Dul, 0xE672D739ul, 0x103AA7D0ul, 0xB64DAC64ul,
+        0x87A5B6F9ul, 0x21D2BD4Dul, 0xE47583C3ul, 0x42028877ul, 0x73EA92EAul, 0xD59D995Eul,
+        0x8BB64CE5ul, 0x2DC14751ul, 0x1C295DCCul, 0xBA5E5678ul, 0x7FF968F6ul, 0xD98E6342ul,
+        0xE86679DFul, 0x4E11726Bul, 0xB8590282ul, 0x1E2E0936ul, 0x2FC613ABul, 0x89B1181Ful,
+        0x4C162691ul, 0xEA612D25ul, 0xDB8937B8ul, 0x7DFE3C0Cul, 0xEC68D02Bul, 0x4A1FDB9Ful,
+        0x7BF7C102ul, 0xDD80CAB6ul, 0x1827F438ul, 0xBE50FF8Cul, 0x8FB8E511ul, 0x29CFEEA5ul,
+        0xDF879E4Cul, 0x79F095F8ul, 0x48188F65ul, 0xEE6F84D1ul, 0x2BC8BA5Ful, 0x8DBFB1EBul,
+        0xBC57AB76ul, 0x1A20A0C2ul, 0x8816EAF2ul, 0x2E61E146ul, 0x1F89FBDBul, 0xB9FEF06Ful,
+        0x7C59CEE1ul, 0xDA2EC555ul, 0xEBC6DFC8ul, 0x4DB1D47Cul, 0xBBF9A495ul, 0x1D8EAF21ul,
+        0x2C66B5BCul, 0x8A11BE08ul, 0x4FB68086ul, 0xE9C18B32ul, 0xD82991AFul, 0x7E5E9A1Bul,
+        0xEFC8763Cul, 0x49BF7D88ul, 0x78576715ul, 0xDE206CA1ul, 0x1B87522Ful, 0xBDF0599Bul,
+        0x8C184306ul, 0x2A6F48B2ul, 0xDC27385Bul, 0x7A5033EFul, 0x4BB82972ul, 0xEDCF22C6ul,
+        0x28681C48ul, 0x8E1F17FCul, 0xBFF70D61ul, 0x198006D5ul, 0x47ABD36Eul, 0xE1DCD8DAul,
+        0xD034C247ul, 0x7643C9F3ul, 0xB3E4F77Dul, 0x1593FCC9ul, 0x247BE654ul, 0x820CEDE0ul,
+        0x74449D09ul, 0xD23396BDul, 0xE3DB8C20ul, 0x45AC8794ul, 0x800BB91Aul, 0x267CB2AEul,
+        0x1794A833ul, 0xB1E3A387ul, 0x20754FA0ul, 0x86024414ul, 0xB7EA5E89ul, 0x119D553Dul,
+        0xD43A6BB3ul, 0x724D6007ul, 0x43A57A9Aul, 0xE5D2712Eul, 0x139A01C7ul, 0xB5ED0A73ul,
+        0x840510EEul, 0x22721B5Aul, 0xE7D525D4ul, 0x41A22E60ul, 0x704A34FDul, 0xD63D3F49ul,
+        0xCC1D9F8Bul, 0x6A6A943Ful, 0x5B828EA2ul, 0xFDF58516ul, 0x3852BB98ul, 0x9E25B02Cul,
+        0xAFCDAAB1ul, 0x09BAA105ul, 0xFFF2D1ECul, 0x5985DA58ul, 0x686DC0C5ul, 0xCE1ACB71ul,
+        0x0BBDF5FFul, 0xADCAFE4Bul, 0x9C22E4D6ul, 0x3A55EF62ul, 0xABC30345ul, 0x0DB408F1ul,
+        0x3C5C126Cul, 0x9A2B19D8ul, 0x5F8C2756ul, 0xF9FB2CE2ul, 0xC813367Ful, 0x6E643DCBul,
+        0x982C4D22ul, 0x3E5B4696ul, 0x0FB35C0Bul, 0xA9C457BFul, 0x6C636931ul, 0xCA146285ul,
+        0xFBFC7818ul, 0x5D8B73ACul, 0x03A0A617ul, 0xA5D7ADA3ul, 0x943FB73Eul, 0x3248BC8Aul,
+        0xF7EF8204ul, 0x519889B0ul, 0x6070932Dul, 0xC6079899ul, 0x304FE870ul, 0x9638E3C4ul,
+        0xA7D0F959ul, 0x01A7F2EDul, 0xC400CC63ul, 0x6277C7D7ul, 0x539FDD4Aul, 0xF5E8D6FEul,
+        0x647E3AD9ul, 0xC209316Dul, 0xF3E12BF0ul, 0x55962044ul, 0x90311ECAul, 0x3646157Eul,
+        0x07AE0FE3ul, 0xA1D90457ul, 0x579174BEul, 0xF1E67F0Aul, 0xC00E6597ul, 0x66796E23ul,
+        0xA3DE50ADul, 0x05A95B19ul, 0x34414184ul, 0x92364A30ul
+    },
+    {
+        0x00000000ul, 0xCCAA009Eul, 0x4225077Dul, 0x8E8F07E3ul, 0x844A0EFAul, 0x48E00E64ul,
+        0xC66F0987ul, 0x0AC50919ul, 0xD3E51BB5ul, 0x1F4F1B2Bul, 0x91C01CC8ul, 0x5D6A1C56ul,
+        0x57AF154Ful, 0x9B0515D1ul, 0x158A1232ul, 0xD92012ACul, 0x7CBB312Bul, 0xB01131B5ul,
+        0x3E9E3656ul, 0xF23436C8ul, 0xF8F13FD1ul, 0x345B3F4Ful, 0xBAD438ACul, 0x767E3832ul,
+        0xAF5E2A9Eul, 0x63F42A00ul, 0xED7B2DE3ul, 0x21D12D7Dul, 0x2B142464ul, 0xE7BE24FAul,
+        0x69312319ul, 0xA59B2387ul, 0xF9766256ul, 0x35DC62C8ul, 0xBB53652Bul, 0x77F965B5ul,
+        0x7D3C6CACul, 0xB1966C32ul, 0x3F196BD1ul, 0xF3B36B4Ful, 0x2A9379E3ul, 0xE639797Dul,
+        0x68B67E9Eul, 0xA41C7E00ul, 0xAED97719ul, 0x62737787ul, 0xECFC7064ul, 0x205670FAul,
+        0x85CD537Dul, 0x496753E3ul, 0xC7E85400ul, 0x0B42549Eul, 0x01875D87ul, 0xCD2D5D19ul,
+        0x43A25AFAul, 0x8F085A64ul, 0x562848C8ul, 0x9A824856ul, 0x140D4FB5ul, 0xD8A74F2Bul,
+        0xD2624632ul, 0x1EC846ACul, 0x9047414Ful, 0x5CED41D1ul, 0x299DC2EDul, 0xE537C273ul,
+        0x6BB8C590ul, 0xA712C50Eul, 0xADD7CC17ul, 0x617DCC89ul, 0xEFF2CB6Aul, 0x2358CBF4ul,
+        0xFA78D958ul, 0x36D2D9C6ul, 0xB85DDE25ul, 0x74F7DEBBul, 0x7E32D7A2ul, 0xB298D73Cul,
+        0x3C17D0DFul, 0xF0BDD041ul, 0x5526F3C6ul, 0x998CF358ul, 0x1703F4BBul, 0xDBA9F425ul,
+        0xD16CFD3Cul, 0x1DC6FDA2ul, 0x9349FA41ul, 0x5FE3FADFul, 0x86C3E873ul, 0x4A69E8EDul,
+        0xC4E6EF0Eul, 0x084CEF90ul, 0x0289E689ul, 0xCE23E617ul, 0x40ACE1F4ul, 0x8C06E16Aul,
+        0xD0EBA0BBul, 0x1C41A025ul, 0x92CEA7C6ul, 0x5E64A758ul, 0x54A1AE41ul, 0x980BAEDFul,
+        0x1684A93Cul, 0xDA2EA9A2ul, 0x030EBB0Eul, 0xCFA4BB90ul, 0x412BBC73ul, 0x8D81BCEDul,
+        0x8744B5F4ul, 0x4BEEB56Aul, 0xC561B289ul, 0x09CBB217ul, 0xAC509190ul, 0x60FA910Eul,
+        0xEE7596EDul, 0x22DF9673ul, 0x281A9F6Aul, 0xE4B09FF4ul, 0x6A3F9817ul, 0xA6959889ul,
+        0x7FB58A25ul, 0xB31F8ABBul, 0x3D908D58ul, 0xF13A8DC6ul, 0xFBFF84DFul, 0x37558441ul,
+        0xB9DA83A2ul, 0x7570833Cul, 0x533B85DAul, 0x9F918544ul, 0x111E82A7ul, 0xDDB48239ul,
+        0xD7718B20ul, 0x1BDB8BBEul, 0x95548C5Dul, 0x59FE8CC3ul, 0x80DE9E6Ful, 0x4C749EF1ul,
+        0xC2FB9912ul, 0x0E51998Cul, 0x04949095ul, 0xC83E900Bul, 0x46B197E8ul, 0x8A1B9776ul,
+        0x2F80B4F1ul, 0xE32AB46Ful, 0x6DA5B38Cul, 0xA10FB312ul, 0xABCABA0Bul, 0x6760BA95ul,
+        0xE9EFBD76ul, 0x2545BDE8ul, 0xFC65AF44ul, 0x30CFAFDAul, 0xBE40A839ul, 0x72EAA8A7ul,
+        0x782FA1BEul, 0xB485A120ul, 0x3A0AA6C3ul, 0xF6A0A65Dul, 0xAA4DE78Cul, 0x66E7E712ul,
+        0xE868E0F1ul, 0x24C2E06Ful, 0x2E07E976ul, 0xE2ADE9E8ul, 0x6C22EE0Bul, 0xA088EE95ul,
+        0x79A8FC39ul, 0xB502FCA7ul, 0x3B8DFB44ul, 0xF727FBDAul, 0xFDE2F2C3ul, 0x3148F25Dul,
+        0xBFC7F5BEul, 0x736DF520ul, 0xD6F6D6A7ul, 0x1A5CD639ul, 0x94D3D1DAul, 0x5879D144ul,
+        0x52BCD85Dul, 0x9E16D8C3ul, 0x1099DF20ul, 0xDC33DFBEul, 0x0513CD12ul, 0xC9B9CD8Cul,
+        0x4736CA6Ful, 0x8B9CCAF1ul, 0x8159C3E8ul, 0x4DF3C376ul, 0xC37CC495ul, 0x0FD6C40Bul,
+        0x7AA64737ul, 0xB60C47A9ul, 0x3883404Aul, 0xF42940D4ul, 0xFEEC49CDul, 0x32464953ul,
+        0xBCC94EB0ul, 0x70634E2Eul, 0xA9435C82ul, 0x65E95C1Cul, 0xEB665BFFul, 0x27CC5B61ul,
+        0x2D095278ul, 0xE1A352E6ul, 0x6F2C5505ul, 0xA386559Bul, 0x061D761Cul, 0xCAB77682ul,
+        0x44387161ul, 0x889271FFul, 0x825778E6ul, 0x4EFD7878ul, 0xC0727F9Bul, 0x0CD87F05ul,
+        0xD5F86DA9ul, 0x19526D37ul, 0x97DD6AD4ul, 0x5B776A4Aul, 0x51B26353ul, 0x9D1863CDul,
+        0x1397642Eul, 0xDF3D64B0ul, 0x83D02561ul, 0x4F7A25FFul, 0xC1F5221Cul, 0x0D5F2282ul,
+        0x079A2B9Bul, 0xCB302B05ul, 0x45BF2CE6ul, 0x89152C78ul, 0x50353ED4ul, 0x9C9F3E4Aul,
+        0x121039A9ul, 0xDEBA3937ul, 0xD47F302Eul, 0x18D530B0ul, 0x965A3753ul, 0x5AF037CDul,
+        0xFF6B144Aul, 0x33C114D4ul, 0xBD4E1337ul, 0x71E413A9ul, 0x7B211AB0ul, 0xB78B1A2Eul,
+        0x39041DCDul, 0xF5AE1D53ul, 0x2C8E0FFFul, 0xE0240F61ul, 0x6EAB0882ul, 0xA201081Cul,
+        0xA8C40105ul, 0x646E019Bul, 0xEAE10678ul, 0x264B06E6ul
+    }
+};
+#endif
+
+#if !defined(MX25Series__CRC32C_INSTRUCTIONS)
+/**! CRC-32C, reflected polynomial 0x82F63B78, table k advances a byte followed by k zero bytes */
+static const uint32_t MX25Series__crc32c_tables[8][256] = {
+    {
+        0x00000000ul, 0xF26B8303ul, 0xE13B70F7ul, 0x1350F3F4ul, 0xC79A971Ful, 0x35F1141Cul,
+        0x26A1E7E8ul, 0xD4CA64EBul, 0x8AD958CFul, 0x78B2DBCCul, 0x6BE22838ul, 0x9989AB3Bul,
+        0x4D43CFD0ul, 0xBF284CD3ul, 0xAC78BF27ul, 0x5E133C24ul, 0x105EC76Ful, 0xE235446Cul,
+        0xF165B798ul, 0x030E349Bul, 0xD7C45070ul, 0x25AFD373ul, 0x36FF2087ul, 0xC494A384ul,
+        0x9A879FA0ul, 0x68EC1CA3ul, 0x7BBCEF57ul, 0x89D76C54ul, 0x5D1D08BFul, 0xAF768BBCul,
+        0xBC267848ul, 0x4E4DFB4Bul, 0x20BD8EDEul, 0xD2D60DDDul, 0xC186FE29ul, 0x33ED7D2Aul,
+        0xE72719C1ul, 0x154C9AC2ul, 0x061C6936ul, 0xF477EA35ul, 0xAA64D611ul, 0x580F5512ul,
+        0x4B5FA6E6ul, 0xB93425E5ul, 0x6DFE410Eul, 0x9F95C20Dul, 0x8CC531F9ul, 0x7EAEB2FAul,
+        0x30E349B1ul, 0xC288CAB2ul, 0xD1D83946ul, 0x23B3BA45ul, 0xF779DEAEul, 0x05125DADul,
+        0x1642AE59ul, 0xE4292D5Aul, 0xBA3A117Eul, 0x4851927Dul, 0x5B016189ul, 0xA96AE28Aul,
+        0x7DA08661ul, 0x8FCB0562ul, 0x9C9BF696ul, 0x6EF07595ul, 0x417B1DBCul, 0xB3109EBFul,
+        0xA0406D4Bul, 0x522BEE48ul, 0x86E18AA3ul, 0x748A09A0ul, 0x67DAFA54ul, 0x95B17957ul,
+        0xCBA24573ul, 0x39C9C670ul, 0x2A993584ul, 0xD8F2B687ul, 0x0C38D26Cul, 0xFE53516Ful,
+        0xED03A29Bul, 0x1F682198ul, 0x5125DAD3ul, 0xA34E59D0ul, 0xB01EAA24ul, 0x42752927ul,
+        0x96BF4DCCul, 0x64D4CECFul, 0x77843D3Bul, 0x85EFBE38ul, 0xDBFC821Cul, 0x2997011Ful,
+        0x3AC7F2EBul, 0xC8AC71E8ul, 0x1C661503ul, 0xEE0D9600ul, 0xFD5D65F4ul, 0x0F36E6F7ul,
+        0x61C69362ul, 0x93AD1061ul, 0x80FDE395ul, 0x72966096ul, 0xA65C047Dul, 0x5437877Eul,
+        0x4767748Aul, 0xB50CF789ul, 0xEB1FCBADul, 0x197448AEul, 0x0A24BB5Aul, 0xF84F3859ul,
+        0x2C855CB2ul, 0xDEEEDFB1ul, 0xCDBE2C45ul, 0x3FD5AF46ul, 0x7198540Dul, 0x83F3D70Eul,
+        0x90A324FAul, 0x62C8A7F9ul, 0xB602C312ul, 0x44694011ul, 0x5739B3E5ul, 0xA55230E6ul,
+        0xFB410CC2ul, 0x092A8FC1ul, 0x1A7A7C35ul, 0xE811FF36ul, 0x3CDB9BDDul, 0xCEB018DEul,
+        0xDDE0EB2Aul, 0x2F8B6829ul, 0x82F63B78ul, 0x709DB87Bul, 0x63CD4B8Ful, 0x91A6C88Cul,
+        0x456CAC67ul, 0xB7072F64ul, 0xA457DC90ul, 0x563C5F93ul, 0x082F63B7ul, 0xFA44E0B4ul,
+        0xE9141340ul, 0x1B7F9043ul, 0xCFB5F4A8ul, 0x3DDE77ABul, 0x2E8E845Ful, 0xDCE5075Cul,
+        0x92A8FC17ul, 0x60C37F14ul, 0x73938CE0ul, 0x81F80FE3ul, 0x55326B08ul, 0xA759E80Bul,
+        0xB4091BFFul, 0x466298FCul, 0x1871A4D8ul, 0xEA1A27DBul, 0xF94AD42Ful, 0x0B21572Cul,
+        0xDFEB33C7ul, 0x2D80B0C4ul, 0x3ED04330ul, 0xCCBBC033ul, 0xA24BB5A6ul, 0x502036A5ul,
+        0x4370C551ul, 0xB11B4652ul, 0x65D122B9ul, 0x97BAA1BAul, 0x84EA524Eul, 0x7681D14Dul,
+        0x2892ED69ul, 0xDAF96E6Aul, 0xC9A99D9Eul, 0x3BC21E9Dul, 0xEF087A76ul, 0x1D63F975ul,
+        0x0E330A81ul, 0xFC588982ul, 0xB21572C9ul, 0x407EF1CAul, 0x532E023Eul, 0xA145813Dul,
+        0x758FE5D6ul, 0x87E466D5ul, 0x94B49521ul, 0x66DF1622ul, 0x38CC2A06ul, 0xCAA7A905ul,
+        0xD9F75AF1ul, 0x2B9CD9F2ul, 0xFF56BD19ul, 0x0D3D3E1Aul, 0x1E6DCDEEul, 0xEC064EEDul,
+        0xC38D26C4ul, 0x31E6A5C7ul, 0x22B65633ul, 0xD0DDD530ul, 0x0417B1DBul, 0xF67C32D8ul,
+        0xE52CC12Cul, 0x1747422Ful, 0x49547E0Bul, 0xBB3FFD08ul, 0xA86F0EFCul, 0x5A048DFFul,
+        0x8ECEE914ul, 0x7CA56A17ul, 0x6FF599E3ul, 0x9D9E1AE0ul, 0xD3D3E1ABul, 0x21B862A8ul,
+        0x32E8915Cul, 0xC083125Ful, 0x144976B4ul, 0xE622F5B7ul, 0xF5720643ul, 0x07198540ul,
+        0x590AB964ul, 0xAB613A67ul, 0xB831C993ul, 0x4A5A4A90ul, 0x9E902E7Bul, 0x6CFBAD78ul,
+        0x7FAB5E8Cul, 0x8DC0DD8Ful, 0xE330A81Aul, 0x115B2B19ul, 0x020BD8EDul, 0xF0605BEEul,
+        0x24AA3F05ul, 0xD6C1BC06ul, 0xC5914FF2ul, 0x37FACCF1ul, 0x69E9F0D5ul, 0x9B8273D6ul,
+        0x88D28022ul, 0x7AB90321ul, 0xAE7367CAul, 0x5C18E4C9ul, 0x4F48173Dul, 0xBD23943Eul,
+        0xF36E6F75ul, 0x0105EC76ul, 0x12551F82ul, 0xE03E9C81ul, 0x34F4F86Aul, 0xC69F7B69ul,
+        0xD5CF889Dul, 0x27A40B9Eul, 0x79B737BAul, 0x8BDCB4B9ul, 0x988C474Dul, 0x6AE7C44Eul,
+        0xBE2DA0A5ul, 0x4C4623A6ul, 0x5F16D052ul, 0xAD7D5351ul
+    },
+    {
+        0x00000000ul, 0x13A29877ul, 0x274530EEul, 0x34E7A899ul, 0x4E8A61DCul, 0x5D28F9ABul,
+        0x69CF5132ul, 0x7A6DC945ul, 0x9D14C3B8ul, 0x8EB65BCFul, 0xBA51F356ul, 0xA9F36B21ul,
+        0xD39EA264ul, 0xC03C3A13ul, 0xF4DB928Aul, 0xE7790AFDul, 0x3FC5F181ul, 0x2C6769F6ul,
+        0x1880C16Ful, 0x0B225918ul, 0x714F905Dul, 0x62ED082Aul, 0x560AA0B3ul, 0x45A838C4ul,
+        0xA2D13239ul, 0xB173AA4Eul, 0x859402D7ul, 0x96369AA0ul, 0xEC5B53E5ul, 0xFFF9CB92ul,
+        0xCB1E630Bul, 0xD8BCFB7Cul, 0x7F8BE302ul, 0x6C297B75ul, 0x58CED3ECul, 0x4B6C4B9Bul,
+        0x310182DEul, 0x22A31AA9ul, 0x1644B230ul, 0x05E62A47ul, 0xE29F20BAul, 0xF13DB8CDul,
+        0xC5DA1054ul, 0xD6788823ul, 0xAC154166ul, 0xBFB7D911ul, 0x8B507188ul, 0x98F2E9FFul,
+        0x404E1283ul, 0x53EC8AF4ul, 0x670B226Dul, 0x74A9BA1Aul, 0x0EC4735Ful, 0x1D66EB28ul,
+        0x298143B1ul, 0x3A23DBC6ul, 0xDD5AD13Bul, 0xCEF8494Cul, 0xFA1FE1D5ul, 0xE9BD79A2ul,
+        0x93D0B0E7ul, 0x80722890ul, 0xB4958009ul, 0xA737187Eul, 0xFF17C604ul, 0xECB55E73ul,
+        0xD852F6EAul, 0xCBF06E9Dul, 0xB19DA7D8ul, 0xA23F3FAFul, 0x96D89736ul, 0x857A0F41ul,
+        0x620305BCul, 0x71A19DCBul, 0x45463552ul, 0x56E4AD25ul, 0x2C896460ul, 0x3F2BFC17ul,
+        0x0BCC548Eul, 0x186ECCF9ul, 0xC0D23785ul, 0xD370AFF2ul, 0xE797076Bul, 0xF4359F1Cul,
+        0x8E585659ul, 0x9DFACE2Eul, 0xA91D66B7ul, 0xBABFFEC0ul, 0x5DC6F43Dul, 0x4E646C4Aul,
+        0x7A83C4D3ul, 0x69215CA4ul, 0x134C95E1ul, 0x00EE0D96ul, 0x3409A50Ful, 0x27AB3D78ul,
+        0x809C2506ul, 0x933EBD71ul, 0xA7D915E8ul, 0xB47B8D9Ful, 0xCE1644DAul, 0xDDB4DCADul,
+        0xE9537434ul, 0xFAF1EC43ul, 0x1D88E6BEul, 0x0E2A7EC9ul, 0x3ACDD650ul, 0x296F4E27ul,
+        0x53028762ul, 0x40A01F15ul, 0x7447B78Cul, 0x67E52FFBul, 0xBF59D487ul, 0xACFB4CF0ul,
+        0x981CE469ul, 0x8BBE7C1Eul, 0xF1D3B55Bul, 0xE2712D2Cul, 0xD69685B5ul, 0xC5341DC2ul,
+        0x224D173Ful, 0x31EF8F48ul, 0x050827D1ul, 0x16AABFA6ul, 0x6CC776E3ul, 0x7F65EE94ul,
+        0x4B82460Dul, 0x5820DE7Aul, 0xFBC3FAF9ul, 0xE861628Eul, 0xDC86CA17ul, 0xCF245260ul,
+        0xB5499B25ul, 0xA6EB0352ul, 0x920CABCBul, 0x81AE33BCul, 0x66D73941ul, 0x7575A136ul,
+        0x419209AFul, 0x523091D8ul, 0x285D589Dul, 0x3BFFC0EAul, 0x0F186873ul, 0x1CBAF004ul,
+        0xC4060B78ul, 0xD7A4930Ful, 0xE3433B96ul, 0xF0E1A3E1ul, 0x8A8C6AA4ul, 0x992EF2D3ul,
+        0xADC95A4Aul, 0xBE6BC23Dul, 0x5912C8C0ul, 0x4AB050B7ul, 0x7E57F82Eul, 0x6DF56059ul,
+        0x1798A91Cul, 0x043A316Bul, 0x30DD99F2ul, 0x237F0185ul, 0x844819FBul, 0x97EA818Cul,
+        0xA30D2915ul, 0xB0AFB162ul, 0xCAC27827ul, 0xD960E050ul, 0xED8748C9ul, 0xFE25D0BEul,
+        0x195CDA43ul, 0x0AFE4234ul, 0x3E19EAADul, 0x2DBB72DAul, 0x57D6BB9Ful, 0x447423E8ul,
+        0x70938B71ul, 0x63311306ul, 0xBB8DE87Aul, 0xA82F700Dul, 0x9CC8D894ul, 0x8F6A40E3ul,
+        0xF50789A6ul, 0xE6A511D1ul, 0xD242B948ul, 0xC1E0213Ful, 0x26992BC2ul, 0x353BB3B5ul,
+        0x01DC1B2Cul, 0x127E835Bul, 0x68134A1Eul, 0x7BB1D269ul, 0x4F567AF0ul, 0x5CF4E287ul,
+        0x04D43CFDul, 0x1776A48Aul, 0x23910C13ul, 0x30339464ul, 0x4A5E5D21ul, 0x59FCC556ul,
+        0x6D1B6DCFul, 0x7EB9F5B8ul, 0x99C0FF45ul, 0x8A626732ul, 0xBE85CFABul, 0xAD2757DCul,
+        0xD74A9E99ul, 0xC4E806EEul, 0xF00FAE77ul, 0xE3AD3600ul, 0x3B11CD7Cul, 0x28B3550Bul,
+        0x1C54FD92ul, 0x0FF665E5ul, 0x759BACA0ul, 0x663934D7ul, 0x52DE9C4Eul, 0x417C0439ul,
+        0xA6050EC4ul, 0xB5A796B3ul, 0x81403E2Aul, 0x92E2A65Dul, 0xE88F6F18ul, 0xFB2DF76Ful,
+        0xCFCA5FF6ul, 0xDC68C781ul, 0x7B5FDFFFul, 0x68FD4788ul, 0x5C1AEF11ul, 0x4FB87766ul,
+        0x35D5BE23ul, 0x26772654ul, 0x12908ECDul, 0x013216BAul, 0xE64B1C47ul, 0xF5E98430ul,
+        0xC10E2CA9ul, 0xD2ACB4DEul, 0xA8C17D9Bul, 0xBB63E5ECul, 0x8F844D75ul, 0x9C26D502ul,
+        0x449A2E7Eul, 0x5738B609ul, 0x63DF1E90ul, 0x707D86E7ul, 0x0A104FA2ul, 0x19B2D7D5ul,
+        0x2D557F4Cul, 0x3EF7E73Bul, 0xD98EEDC6ul, 0xCA2C75B1ul, 0xFECBDD28ul, 0xED69455Ful,
+        0x97048C1Aul, 0x84A6146Dul, 0xB041BCF4ul, 0xA3E32483ul
+    },
+    {
+        0x00000000ul, 0xA541927Eul, 0x4F6F520Dul, 0xEA2EC073ul, 0x9EDEA41Aul, 0x3B9F3664ul,
+        0xD1B1F617ul, 0x74F06469ul, 0x38513EC5ul, 0x9D10ACBBul, 0x773E6CC8ul, 0xD27FFEB6ul,
+        0xA68F9ADFul, 0x03CE08A1ul, 0xE9E0C8D2ul, 0x4CA15AACul, 0x70A27D8Aul, 0xD5E3EFF4ul,
+        0x3FCD2F87ul, 0x9A8CBDF9ul, 0xEE7CD990ul, 0x4B3D4BEEul, 0xA1138B9Dul, 0x045219E3ul,
+        0x48F3434Ful, 0xEDB2D131ul, 0x079C1142ul, 0xA2DD833Cul, 0xD62DE755ul, 0x736C752Bul,
+        0x9942B558ul, 0x3C032726ul, 0xE144FB14ul, 0x4405696Aul, 0xAE2BA919ul, 0x0B6A3B67ul,
+        0x7F9A5F0Eul, 0xDADBCD70ul, 0x30F50D03ul, 0x95B49F7Dul, 0xD915C5D1ul, 0x7C5457AFul,
+        0x967A97DCul, 0x333B05A2ul, 0x47CB61CBul, 0xE28AF3B5ul, 0x08A433C6ul, 0xADE5A1B8ul,
+        0x91E6869Eul, 0x34A714E0ul, 0xDE89D493ul, 0x7BC846EDul, 0x0F382284ul, 0xAA79B0FAul,
+        0x40577089ul, 0xE516E2F7ul, 0xA9B7B85Bul, 0x0CF62A25ul, 0xE6D8EA56ul, 0x43997828ul,
+        0x37691C41ul, 0x92288E3Ful, 0x78064E4Cul, 0xDD47DC32ul, 0xC76580D9ul, 0x622412A7ul,
+        0x880AD2D4ul, 0x2D4B40AAul, 0x59BB24C3ul, 0xFCFAB6BDul, 0x16D476CEul, 0xB395E4B0ul,
+        0xFF34BE1Cul, 0x5A752C62ul, 0xB05BEC11ul, 0x151A7E6Ful, 0x61EA1A06ul, 0xC4AB8878ul,
+        0x2E85480Bul, 0x8BC4DA75ul, 0xB7C7FD53ul, 0x12866F2Dul, 0xF8A8AF5Eul, 0x5DE93D20ul,
+        0x29195949ul, 0x8C58CB37ul, 0x66760B44ul, 0xC337993Aul, 0x8F96C396ul, 0x2AD751E8ul,
+        0xC0F9919Bul, 0x65B803E5ul, 0x1148678Cul, 0xB409F5F2ul, 0x5E273581ul, 0xFB66A7FFul,
+        0x26217BCDul, 0x8360E9B3ul, 0x694E29C0ul, 0xCC0FBBBEul, 0xB8FFDFD7ul, 0x1DBE4DA9ul,
+        0xF7908DDAul, 0x52D11FA4ul, 0x1E704508ul, 0xBB31D776ul, 0x511F1705ul, 0xF45E857Bul,
+        0x80AEE112ul, 0x25EF736Cul, 0xCFC1B31Ful, 0x6A802161ul, 0x56830647ul, 0xF3C29439ul,
+        0x19EC544Aul, 0xBCADC634ul, 0xC85DA25Dul, 0x6D1C3023ul, 0x8732F050ul, 0x2273622Eul,
+        0x6ED23882ul, 0xCB93AAFCul, 0x21BD6A8Ful, 0x84FCF8F1ul, 0xF00C9C98ul, 0x554D0EE6ul,
+        0xBF63CE95ul, 0x1A225CEBul, 0x8B277743ul, 0x2E66E53Dul, 0xC448254Eul, 0x6109B730ul,
+        0x15F9D359ul, 0xB0B84127ul, 0x5A968154ul, 0xFFD7132Aul, 0xB3764986ul, 0x1637DBF8ul,
+        0xFC191B8Bul, 0x595889F5ul, 0x2DA8ED9Cul, 0x88E97FE2ul, 0x62C7BF91ul, 0xC7862DEFul,
+        0xFB850AC9ul, 0x5EC498B7ul, 0xB4EA58C4ul, 0x11ABCABAul, 0x655BAED3ul, 0xC01A3CADul,
+        0x2A34FCDEul, 0x8F756EA0ul, 0xC3D4340Cul, 0x6695A672ul, 0x8CBB6601ul, 0x29FAF47Ful,
+        0x5D0A9016ul, 0xF84B0268ul, 0x1265C21Bul, 0xB7245065ul, 0x6A638C57ul, 0xCF221E29ul,
+        0x250CDE5Aul, 0x804D4C24ul, 0xF4BD284Dul, 0x51FCBA33ul, 0xBBD27A40ul, 0x1E93E83Eul,
+        0x5232B292ul, 0xF77320ECul, 0x1D5DE09Ful, 0xB81C72E1ul, 0xCCEC1688ul, 0x69AD84F6ul,
+        0x83834485ul, 0x26C2D6FBul, 0x1AC1F1DDul, 0xBF8063A3ul, 0x55AEA3D0ul, 0xF0EF31AEul,
+        0x841F55C7ul, 0x215EC7B9ul, 0xCB7007CAul, 0x6E3195B4ul, 0x2290CF18ul, 0x87D15D66ul,
+        0x6DFF9D15ul, 0xC8BE0F6Bul, 0xBC4E6B02ul, 0x190FF97Cul, 0xF321390Ful, 0x5660AB71ul,
+        0x4C42F79Aul, 0xE90365E4ul, 0x032DA597ul, 0xA66C37E9ul, 0xD29C5380ul, 0x77DDC1FEul,
+        0x9DF3018Dul, 0x38B293F3ul, 0x7413C95Ful, 0xD1525B21ul, 0x3B7C9B52ul, 0x9E3D092Cul,
+        0xEACD6D45ul, 0x4F8CFF3Bul, 0xA5A23F48ul, 0x00E3AD36ul, 0x3CE08A10ul, 0x99A1186Eul,
+        0x738FD81Dul, 0xD6CE4A63ul, 0xA23E2E0Aul, 0x077FBC74ul, 0xED517C07ul, 0x4810EE79ul,
+        0x04B1B4D5ul, 0xA1F026ABul, 0x4BDEE6D8ul, 0xEE9F74A6ul, 0x9A6F10CFul, 0x3F2E82B1ul,
+        0xD50042C2ul, 0x7041D0BCul, 0xAD060C8Eul, 0x08479EF0ul, 0xE2695E83ul, 0x4728CCFDul,
+        0x33D8A894ul, 0x96993AEAul, 0x7CB7FA99ul, 0xD9F668E7ul, 0x9557324Bul, 0x3016A035ul,
+        0xDA386046ul, 0x7F79F238ul, 0x0B899651ul, 0xAEC8042Ful, 0x44E6C45Cul, 0xE1A75622ul,
+        0xDDA47104ul, 0x78E5E37Aul, 0x92CB2309ul, 0x378AB177ul, 0x437AD51Eul, 0xE63B4760ul,
+        0x0C158713ul, 0xA954156Dul, 0xE5F54FC1ul, 0x40B4DDBFul, 0xAA9A1DCCul, 0x0FDB8FB2ul,
+        0x7B2BEBDBul, 0xDE6A79A5ul, 0x3444B9D6ul, 0x91052BA8ul
+    },
+    {
+        0x00000000ul, 0xDD45AAB8ul, 0xBF672381ul, 0x62228939ul, 0x7B2231F3ul, 0xA6679B4Bul,
+        0xC4451272ul, 0x1900B8CAul, 0xF64463E6ul, 0x2B01C95Eul, 0x49234067ul, 0x9466EADFul,
+        0x8D665215ul, 0x5023F8ADul, 0x32017194ul, 0xEF44DB2Cul, 0xE964B13Dul, 0x34211B85ul,
+        0x560392BCul, 0x8B463804ul, 0x924680CEul, 0x4F032A76ul, 0x2D21A34Ful, 0xF06409F7ul,
+        0x1F20D2DBul, 0xC2657863ul, 0xA047F15Aul, 0x7D025BE2ul, 0x6402E328ul, 0xB9474990ul,
+        0xDB65C0A9ul, 0x06206A11ul, 0xD725148Bul, 0x0A60BE33ul, 0x6842370Aul, 0xB5079DB2ul,
+        0xAC072578ul, 0x71428FC0ul, 0x136006F9ul, 0xCE25AC41ul, 0x2161776Dul, 0xFC24DDD5ul,
+        0x9E0654ECul, 0x4343FE54ul, 0x5A43469Eul, 0x8706EC26ul, 0xE524651Ful, 0x3861CFA7ul,
+        0x3E41A5B6ul, 0xE3040F0Eul, 0x81268637ul, 0x5C632C8Ful, 0x45639445ul, 0x98263EFDul,
+        0xFA04B7C4ul, 0x27411D7Cul, 0xC805C650ul, 0x15406CE8ul, 0x7762E5D1ul, 0xAA274F69ul,
+        0xB327F7A3ul, 0x6E625D1Bul, 0x0C40D422ul, 0xD1057E9Aul, 0xABA65FE7ul, 0x76E3F55Ful,
+        0x14C17C66ul, 0xC984D6DEul, 0xD0846E14ul, 0x0DC1C4ACul, 0x6FE34D95ul, 0xB2A6E72Dul,
+        0x5DE23C01ul, 0x80A796B9ul, 0xE2851F80ul, 0x3FC0B538ul, 0x26C00DF2ul, 0xFB85A74Aul,
+        0x99A72E73ul, 0x44E284CBul, 0x42C2EEDAul, 0x9F874462ul, 0xFDA5CD5Bul, 0x20E067E3ul,
+        0x39E0DF29ul, 0xE4A57591ul, 0x8687FCA8ul, 0x5BC25610ul, 0xB4868D3Cul, 0x69C32784ul,
+        0x0BE1AEBDul, 0xD6A40405ul, 0xCFA4BCCFul, 0x12E11677ul, 0x70C39F4Eul, 0xAD8635F6ul,
+        0x7C834B6Cul, 0xA1C6E1D4ul, 0xC3E468EDul, 0x1EA1C255ul, 0x07A17A9Ful, 0xDAE4D027ul,
+        0xB8C6591Eul, 0x6583F3A6ul, 0x8AC7288Aul, 0x57828232ul, 0x35A00B0Bul, 0xE8E5A1B3ul,
+        0xF1E51979ul, 0x2CA0B3C1ul, 0x4E823AF8ul, 0x93C79040ul, 0x95E7FA51ul, 0x48A250E9ul,
+        0x2A80D9D0ul, 0xF7C57368ul, 0xEEC5CBA2ul, 0x3380611Aul, 0x51A2E823ul, 0x8CE7429Bul,
+        0x63A399B7ul, 0xBEE6330Ful, 0xDCC4BA36ul, 0x0181108Eul, 0x1881A844ul, 0xC5C402FCul,
+        0xA7E68BC5ul, 0x7AA3217Dul, 0x52A0C93Ful, 0x8FE56387ul, 0xEDC7EABEul, 0x30824006ul,
+        0x2982F8CCul, 0xF4C75274ul, 0x96E5DB4Dul, 0x4BA071F5ul, 0xA4E4AAD9ul, 0x79A10061ul,
+        0x1B838958ul, 0xC6C623E0ul, 0xDFC69B2Aul, 0x02833192ul, 0x60A1B8ABul, 0xBDE41213ul,
+        0xBBC47802ul, 0x6681D2BAul, 0x04A35B83ul, 0xD9E6F13Bul, 0xC0E649F1ul, 0x1DA3E349ul,
+        0x7F816A70ul, 0xA2C4C0C8ul, 0x4D801BE4ul, 0x90C5B15Cul, 0xF2E73865ul, 0x2FA292DDul,
+        0x36A22A17ul, 0xEBE780AFul, 0x89C50996ul, 0x5480A32Eul, 0x8585DDB4ul, 0x58C0770Cul,
+        0x3AE2FE35ul, 0xE7A7548Dul, 0xFEA7EC47ul, 0x23E246FFul, 0x41C0CFC6ul, 0x9C85657Eul,
+        0x73C1BE52ul, 0xAE8414EAul, 0xCCA69DD3ul, 0x11E3376Bul, 0x08E38FA1ul, 0xD5A62519ul,
+        0xB784AC20ul, 0x6AC10698ul, 0x6CE16C89ul, 0xB1A4C631ul, 0xD3864F08ul, 0x0EC3E5B0ul,
+        0x17C35D7Aul, 0xCA86F7C2ul, 0xA8A47EFBul, 0x75E1D443ul, 0x9AA50F6Ful, 0x47E0A5D7ul,
+        0x25C22CEEul, 0xF8878656ul, 0xE1873E9Cul, 0x3CC29424ul, 0x5EE01D1Dul, 0x83A5B7A5ul,
+        0xF90696D8ul, 0x24433C60ul, 0x4661B559ul, 0x9B241FE1ul, 0x8224A72Bul, 0x5F610D93ul,
+        0x3D4384AAul, 0xE0062E12ul, 0x0F42F53Eul, 0xD2075F86ul, 0xB025D6BFul, 0x6D607C07ul,
+        0x7460C4CDul, 0xA9256E75ul, 0xCB07E74Cul, 0x16424DF4ul, 0x106227E5ul, 0xCD278D5Dul,
+        0xAF050464ul, 0x7240AEDCul, 0x6B401616ul, 0xB605BCAEul, 0xD4273597ul, 0x09629F2Ful,
+        0xE6264403ul, 0x3B63EEBBul, 0x59416782ul, 0x8404CD3Aul, 0x9D0475F0ul, 0x4041DF48ul,
+        0x22635671ul, 0xFF26FCC9ul, 0x2E238253ul, 0xF36628EBul, 0x9144A1D2ul, 0x4C010B6Aul,
+        0x5501B3A0ul, 0x88441918ul, 0xEA669021ul, 0x37233A99ul, 0xD867E1B5ul, 0x05224B0Dul,
+        0x6700C234ul, 0xBA45688Cul, 0xA345D046ul, 0x7E007AFEul, 0x1C22F3C7ul, 0xC167597Ful,
+        0xC747336Eul, 0x1A0299D6ul, 0x782010EFul, 0xA565BA57ul, 0xBC65029Dul, 0x6120A825ul,
+        0x0302211Cul, 0xDE478BA4ul, 0x31035088ul, 0xEC46FA30ul, 0x8E647309ul, 0x5321D9B1ul,
+        0x4A21617Bul, 0x9764CBC3ul, 0xF54642FAul, 0x2803E842ul
+    },
+    {
+        0x00000000ul, 0x38116FACul, 0x7022DF58ul, 0x4833B0F4ul, 0xE045BEB0ul, 0xD854D11Cul,
+        0x906761E8ul, 0xA8760E44ul, 0xC5670B91ul, 0xFD76643Dul, 0xB545D4C9ul, 0x8D54BB65ul,
+        0x2522B521ul, 0x1D33DA8Dul, 0x55006A79ul, 0x6D1105D5ul, 0x8F2261D3ul, 0xB7330E7Ful,
+        0xFF00BE8Bul, 0xC711D127ul, 0x6F67DF63ul, 0x5776B0CFul, 0x1F45003Bul, 0x27546F97ul,
+        0x4A456A42ul, 0x725405EEul, 0x3A67B51Aul, 0x0276DAB6ul, 0xAA00D4F2ul, 0x9211BB5Eul,
+        0xDA220BAAul, 0xE2336406ul, 0x1BA8B557ul, 0x23B9DAFBul, 0x6B8A6A0Ful, 0x539B05A3ul,
+        0xFBED0BE7ul, 0xC3FC644Bul, 0x8BCFD4BFul, 0xB3DEBB13ul, 0xDECFBEC6ul, 0xE6DED16Aul,
+        0xAEED619Eul, 0x96FC0E32ul, 0x3E8A0076ul, 0x069B6FDAul, 0x4EA8DF2Eul, 0x76B9B082ul,
+        0x948AD484ul, 0xAC9BBB28ul, 0xE4A80BDCul, 0xDCB96470ul, 0x74CF6A34ul, 0x4CDE0598ul,
+        0x04EDB56Cul, 0x3CFCDAC0ul, 0x51EDDF15ul, 0x69FCB0B9ul, 0x21CF004Dul, 0x19DE6FE1ul,
+        0xB1A861A5ul, 0x89B90E09ul, 0xC18ABEFDul, 0xF99BD151ul, 0x37516AAEul, 0x0F400502ul,
+        0x4773B5F6ul, 0x7F62DA5Aul, 0xD714D41Eul, 0xEF05BBB2ul, 0xA7360B46ul, 0x9F2764EAul,
+        0xF236613Ful, 0xCA270E93ul, 0x8214BE67ul, 0xBA05D1CBul, 0x1273DF8Ful, 0x2A62B023ul,
+        0x625100D7ul, 0x5A406F7Bul, 0xB8730B7Dul, 0x806264D1ul, 0xC851D425ul, 0xF040BB89ul,
+        0x5836B5CDul, 0x6027DA61ul, 0x28146A95ul, 0x10050539ul, 0x7D1400ECul, 0x45056F40ul,
+        0x0D36DFB4ul, 0x3527B018ul, 0x9D51BE5Cul, 0xA540D1F0ul, 0xED736104ul, 0xD5620EA8ul,
+        0x2CF9DFF9ul, 0x14E8B055ul, 0x5CDB00A1ul, 0x64CA6F0Dul, 0xCCBC6149ul, 0xF4AD0EE5ul,
+        0xBC9EBE11ul, 0x848FD1BDul, 0xE99ED468ul, 0xD18FBBC4ul, 0x99BC0B30ul, 0xA1AD649Cul,
+        0x09DB6AD8ul, 0x31CA0574ul, 0x79F9B580ul, 0x41E8DA2Cul, 0xA3DBBE2Aul, 0x9BCAD186ul,
+        0xD3F96172ul, 0xEBE80EDEul, 0x439E009Aul, 0x7B8F6F36ul, 0x33BCDFC2ul, 0x0BADB06Eul,
+        0x66BCB5BBul, 0x5EADDA17ul, 0x169E6AE3ul, 0x2E8F054Ful, 0x86F90B0Bul, 0xBEE864A7ul,
+        0xF6DBD453ul, 0xCECABBFFul, 0x6EA2D55Cul, 0x56B3BAF0ul, 0x1E800A04ul, 0x269165A8ul,
+        0x8EE76BECul, 0xB6F60440ul, 0xFEC5B4B4ul, 0xC6D4DB18ul, 0xABC5DECDul, 0x93D4B161ul,
+        0xDBE70195ul, 0xE3F66E39ul, 0x4B80607Dul, 0x73910FD1ul, 0x3BA2BF25ul, 0x03B3D089ul,
+        0xE180B48Ful, 0xD991DB23ul, 0x91A26BD7ul, 0xA9B3047Bul, 0x01C50A3Ful, 0x39D46593ul,
+        0x71E7D567ul, 0x49F6BACBul, 0x24E7BF1Eul, 0x1CF6D0B2ul, 0x54C56046ul, 0x6CD40FEAul,
+        0xC4A201AEul, 0xFCB36E02ul, 0xB480DEF6ul, 0x8C91B15Aul, 0x750A600Bul, 0x4D1B0FA7ul,
+        0x0528BF53ul, 0x3D39D0FFul, 0x954FDEBBul, 0xAD5EB117ul, 0xE56D01E3ul, 0xDD7C6E4Ful,
+        0xB06D6B9Aul, 0x887C0436ul, 0xC04FB4C2ul, 0xF85EDB6Eul, 0x5028D52Aul, 0x6839BA86ul,
+        0x200A0A72ul, 0x181B65DEul, 0xFA2801D8ul, 0xC2396E74ul, 0x8A0ADE80ul, 0xB21BB12Cul,
+        0x1A6DBF68ul, 0x227CD0C4ul, 0x6A4F6030ul, 0x525E0F9Cul, 0x3F4F0A49ul, 0x075E65E5ul,
+        0x4F6DD511ul, 0x777CBABDul, 0xDF0AB4F9ul, 0xE71BDB55ul, 0xAF286BA1ul, 0x9739040Dul,
+        0x59F3BFF2ul, 0x61E2D05Eul, 0x29D160AAul, 0x11C00F06ul, 0xB9B60142ul, 0x81A76EEEul,
+        0xC994DE1Aul, 0xF185B1B6ul, 0x9C94B463ul, 0xA485DBCFul, 0xECB66B3Bul, 0xD4A70497ul,
+        0x7CD10AD3ul, 0x44C0657Ful, 0x0CF3D58Bul, 0x34E2BA27ul, 0xD6D1DE21ul, 0xEEC0B18Dul,
+        0xA6F30179ul, 0x9EE26ED5ul, 0x36946091ul, 0x0E850F3Dul, 0x46B6BFC9ul, 0x7EA7D065ul,
+        0x13B6D5B0ul, 0x2BA7BA1Cul, 0x63940AE8ul, 0x5B856544ul, 0xF3F36B00ul, 0xCBE204ACul,
+        0x83D1B458ul, 0xBBC0DBF4ul, 0x425B0AA5ul, 0x7A4A6509ul, 0x3279D5FDul, 0x0A68BA51ul,
+        0xA21EB415ul, 0x9A0FDBB9ul, 0xD23C6B4Dul, 0xEA2D04E1ul, 0x873C0134ul, 0xBF2D6E98ul,
+        0xF71EDE6Cul, 0xCF0FB1C0ul, 0x6779BF84ul, 0x5F68D028ul, 0x175B60DCul, 0x2F4A0F70ul,
+        0xCD796B76ul, 0xF56804DAul, 0xBD5BB42Eul, 0x854ADB82ul, 0x2D3CD5C6ul, 0x152DBA6Aul,
+        0x5D1E0A9Eul, 0x650F6532ul, 0x081E60E7ul, 0x300F0F4Bul, 0x783CBFBFul, 0x402DD013ul,
+        0xE85BDE57ul, 0xD04AB1FBul, 0x9879010Ful, 0xA0686EA3ul
+    },
+    {
+        0x00000000ul, 0xEF306B19ul, 0xDB8CA0C3ul, 0x34BCCBDAul, 0xB2F53777ul, 0x5DC55C6Eul,
+        0x697997B4ul, 0x8649FCADul, 0x6006181Ful, 0x8F367306ul, 0xBB8AB8DCul, 0x54BAD3C5ul,
+        0xD2F32F68ul, 0x3DC34471ul, 0x097F8FABul, 0xE64FE4B2ul, 0xC00C303Eul, 0x2F3C5B27ul,
+        0x1B8090FDul, 0xF4B0FBE4ul, 0x72F90749ul, 0x9DC96C50ul, 0xA975A78Aul, 0x4645CC93ul,
+        0xA00A2821ul, 0x4F3A4338ul, 0x7B8688E2ul, 0x94B6E3FBul, 0x12FF1F56ul, 0xFDCF744Ful,
+        0xC973BF95ul, 0x2643D48Cul, 0x85F4168Dul, 0x6AC47D94ul, 0x5E78B64Eul, 0xB148DD57ul,
+        0x370121FAul, 0xD8314AE3ul, 0xEC8D8139ul, 0x03BDEA20ul, 0xE5F20E92ul, 0x0AC2658Bul,
+        0x3E7EAE51ul, 0xD14EC548ul, 0x570739E5ul, 0xB83752FCul, 0x8C8B9926ul, 0x63BBF23Ful,
+        0x45F826B3ul, 0xAAC84DAAul, 0x9E748670ul, 0x7144ED69ul, 0xF70D11C4ul, 0x183D7ADDul,
+        0x2C81B107ul, 0xC3B1DA1Eul, 0x25FE3EACul, 0xCACE55B5ul, 0xFE729E6Ful, 0x1142F576ul,
+        0x970B09DBul, 0x783B62C2ul, 0x4C87A918ul, 0xA3B7C201ul, 0x0E045BEBul, 0xE13430F2ul,
+        0xD588FB28ul, 0x3AB89031ul, 0xBCF16C9Cul, 0x53C10785ul, 0x677DCC5Ful, 0x884DA746ul,
+        0x6E0243F4ul, 0x813228EDul, 0xB58EE337ul, 0x5ABE882Eul, 0xDCF77483ul, 0x33C71F9Aul,
+        0x077BD440ul, 0xE84BBF59ul, 0xCE086BD5ul, 0x213800CCul, 0x1584CB16ul, 0xFAB4A00Ful,
+        0x7CFD5CA2ul, 0x93CD37BBul, 0xA771FC61ul, 0x48419778ul, 0xAE0E73CAul, 0x413E18D3ul,
+        0x7582D309ul, 0x9AB2B810ul, 0x1CFB44BDul, 0xF3CB2FA4ul, 0xC777E47Eul, 0x28478F67ul,
+        0x8BF04D66ul, 0x64C0267Ful, 0x507CEDA5ul, 0xBF4C86BCul, 0x39057A11ul, 0xD6351108ul,
+        0xE289DAD2ul, 0x0DB9B1CBul, 0xEBF65579ul, 0x04C63E60ul, 0x307AF5BAul, 0xDF4A9EA3ul,
+        0x5903620Eul, 0xB6330917ul, 0x828FC2CDul, 0x6DBFA9D4ul, 0x4BFC7D58ul, 0xA4CC1641ul,
+        0x9070DD9Bul, 0x7F40B682ul, 0xF9094A2Ful, 0x16392136ul, 0x2285EAECul, 0xCDB581F5ul,
+        0x2BFA6547ul, 0xC4CA0E5Eul, 0xF076C584ul, 0x1F46AE9Dul, 0x990F5230ul, 0x763F3929ul,
+        0x4283F2F3ul, 0xADB399EAul, 0x1C08B7D6ul, 0xF338DCCFul, 0xC7841715ul, 0x28B47C0Cul,
+        0xAEFD80A1ul, 0x41CDEBB8ul, 0x75712062ul, 0x9A414B7Bul, 0x7C0EAFC9ul, 0x933EC4D0ul,
+        0xA7820F0Aul, 0x48B26413ul, 0xCEFB98BEul, 0x21CBF3A7ul, 0x1577387Dul, 0xFA475364ul,
+        0xDC0487E8ul, 0x3334ECF1ul, 0x0788272Bul, 0xE8B84C32ul, 0x6EF1B09Ful, 0x81C1DB86ul,
+        0xB57D105Cul, 0x5A4D7B45ul, 0xBC029FF7ul, 0x5332F4EEul, 0x678E3F34ul, 0x88BE542Dul,
+        0x0EF7A880ul, 0xE1C7C399ul, 0xD57B0843ul, 0x3A4B635Aul, 0x99FCA15Bul, 0x76CCCA42ul,
+        0x42700198ul, 0xAD406A81ul, 0x2B09962Cul, 0xC439FD35ul, 0xF08536EFul, 0x1FB55DF6ul,
+        0xF9FAB944ul, 0x16CAD25Dul, 0x22761987ul, 0xCD46729Eul, 0x4B0F8E33ul, 0xA43FE52Aul,
+        0x90832EF0ul, 0x7FB345E9ul, 0x59F09165ul, 0xB6C0FA7Cul, 0x827C31A6ul, 0x6D4C5ABFul,
+        0xEB05A612ul, 0x0435CD0Bul, 0x308906D1ul, 0xDFB96DC8ul, 0x39F6897Aul, 0xD6C6E263ul,
+        0xE27A29B9ul, 0x0D4A42A0ul, 0x8B03BE0Dul, 0x6433D514ul, 0x508F1ECEul, 0xBFBF75D7ul,
+        0x120CEC3Dul, 0xFD3C8724ul, 0xC9804CFEul, 0x26B027E7ul, 0xA0F9DB4Aul, 0x4FC9B053ul,
+        0x7B757B89ul, 0x94451090ul, 0x720AF422ul, 0x9D3A9F3Bul, 0xA98654E1ul, 0x46B63FF8ul,
+        0xC0FFC355ul, 0x2FCFA84Cul, 0x1B736396ul, 0xF443088Ful, 0xD200DC03ul, 0x3D30B71Aul,
+        0x098C7CC0ul, 0xE6BC17D9ul, 0x60F5EB74ul, 0x8FC5806Dul, 0xBB794BB7ul, 0x544920AEul,
+        0xB206C41Cul, 0x5D36AF05ul, 0x698A64DFul, 0x86BA0FC6ul, 0x00F3F36Bul, 0xEFC39872ul,
+        0xDB7F53A8ul, 0x344F38B1ul, 0x97F8FAB0ul, 0x78C891A9ul, 0x4C745A73ul, 0xA344316Aul,
+        0x250DCDC7ul, 0xCA3DA6DEul, 0xFE816D04ul, 0x11B1061Dul, 0xF7FEE2AFul, 0x18CE89B6ul,
+        0x2C72426Cul, 0xC3422975ul, 0x450BD5D8ul, 0xAA3BBEC1ul, 0x9E87751Bul, 0x71B71E02ul,
+        0x57F4CA8Eul, 0xB8C4A197ul, 0x8C786A4Dul, 0x63480154ul, 0xE501FDF9ul, 0x0A3196E0ul,
+        0x3E8D5D3Aul, 0xD1BD3623ul, 0x37F2D291ul, 0xD8C2B988ul, 0xEC7E7252ul, 0x034E194Bul,
+        0x8507E5E6ul, 0x6A378EFFul, 0x5E8B4525ul, 0xB1BB2E3Cul
+    },
+    {
+        0x00000000ul, 0x68032CC8ul, 0xD0065990ul, 0xB8057558ul, 0xA5E0C5D1ul, 0xCDE3E919ul,
+        0x75E69C41ul, 0x1DE5B089ul, 0x4E2DFD53ul, 0x262ED19Bul, 0x9E2BA4C3ul, 0xF628880Bul,
+        0xEBCD3882ul, 0x83CE144Aul, 0x3BCB6112ul, 0x53C84DDAul, 0x9C5BFAA6ul, 0xF458D66Eul,
+        0x4C5DA336ul, 0x245E8FFEul, 0x39BB3F77ul, 0x51B813BFul, 0xE9BD66E7ul, 0x81BE4A2Ful,
+        0xD27607F5ul, 0xBA752B3Dul, 0x02705E65ul, 0x6A7372ADul, 0x7796C224ul, 0x1F95EEECul,
+        0xA7909BB4ul, 0xCF93B77Cul, 0x3D5B83BDul, 0x5558AF75ul, 0xED5DDA2Dul, 0x855EF6E5ul,
+        0x98BB466Cul, 0xF0B86AA4ul, 0x48BD1FFCul, 0x20BE3334ul, 0x73767EEEul, 0x1B755226ul,
+        0xA370277Eul, 0xCB730BB6ul, 0xD696BB3Ful, 0xBE9597F7ul, 0x0690E2AFul, 0x6E93CE67ul,
+        0xA100791Bul, 0xC90355D3ul, 0x7106208Bul, 0x19050C43ul, 0x04E0BCCAul, 0x6CE39002ul,
+        0xD4E6E55Aul, 0xBCE5C992ul, 0xEF2D8448ul, 0x872EA880ul, 0x3F2BDDD8ul, 0x5728F110ul,
+        0x4ACD4199ul, 0x22CE6D51ul, 0x9ACB1809ul, 0xF2C834C1ul, 0x7AB7077Aul, 0x12B42BB2ul,
+        0xAAB15EEAul, 0xC2B27222ul, 0xDF57C2ABul, 0xB754EE63ul, 0x0F519B3Bul, 0x6752B7F3ul,
+        0x349AFA29ul, 0x5C99D6E1ul, 0xE49CA3B9ul, 0x8C9F8F71ul, 0x917A3FF8ul, 0xF9791330ul,
+        0x417C6668ul, 0x297F4AA0ul, 0xE6ECFDDCul, 0x8EEFD114ul, 0x36EAA44Cul, 0x5EE98884ul,
+        0x430C380Dul, 0x2B0F14C5ul, 0x930A619Dul, 0xFB094D55ul, 0xA8C1008Ful, 0xC0C22C47ul,
+        0x78C7591Ful, 0x10C475D7ul, 0x0D21C55Eul, 0x6522E996ul, 0xDD279CCEul, 0xB524B006ul,
+        0x47EC84C7ul, 0x2FEFA80Ful, 0x97EADD57ul, 0xFFE9F19Ful, 0xE20C4116ul, 0x8A0F6DDEul,
+        0x320A1886ul, 0x5A09344Eul, 0x09C17994ul, 0x61C2555Cul, 0xD9C72004ul, 0xB1C40CCCul,
+        0xAC21BC45ul, 0xC422908Dul, 0x7C27E5D5ul, 0x1424C91Dul, 0xDBB77E61ul, 0xB3B452A9ul,
+        0x0BB127F1ul, 0x63B20B39ul, 0x7E57BBB0ul, 0x16549778ul, 0xAE51E220ul, 0xC652CEE8ul,
+        0x959A8332ul, 0xFD99AFFAul, 0x459CDAA2ul, 0x2D9FF66Aul, 0x307A46E3ul, 0x58796A2Bul,
+        0xE07C1F73ul, 0x887F33BBul, 0xF56E0EF4ul, 0x9D6D223Cul, 0x25685764ul, 0x4D6B7BACul,
+        0x508ECB25ul, 0x388DE7EDul, 0x808892B5ul, 0xE88BBE7Dul, 0xBB43F3A7ul, 0xD340DF6Ful,
+        0x6B45AA37ul, 0x034686FFul, 0x1EA33676ul, 0x76A01ABEul, 0xCEA56FE6ul, 0xA6A6432Eul,
+        0x6935F452ul, 0x0136D89Aul, 0xB933ADC2ul, 0xD130810Aul, 0xCCD53183ul, 0xA4D61D4Bul,
+        0x1CD36813ul, 0x74D044DBul, 0x27180901ul, 0x4F1B25C9ul, 0xF71E5091ul, 0x9F1D7C59ul,
+        0x82F8CCD0ul, 0xEAFBE018ul, 0x52FE9540ul, 0x3AFDB988ul, 0xC8358D49ul, 0xA036A181ul,
+        0x1833D4D9ul, 0x7030F811ul, 0x6DD54898ul, 0x05D66450ul, 0xBDD31108ul, 0xD5D03DC0ul,
+        0x8618701Aul, 0xEE1B5CD2ul, 0x561E298Aul, 0x3E1D0542ul, 0x23F8B5CBul, 0x4BFB9903ul,
+        0xF3FEEC5Bul, 0x9BFDC093ul, 0x546E77EFul, 0x3C6D5B27ul, 0x84682E7Ful, 0xEC6B02B7ul,
+        0xF18EB23Eul, 0x998D9EF6ul, 0x2188EBAEul, 0x498BC766ul, 0x1A438ABCul, 0x7240A674ul,
+        0xCA45D32Cul, 0xA246FFE4ul, 0xBFA34F6Dul, 0xD7A063A5ul, 0x6FA516FDul, 0x07A63A35ul,
+        0x8FD9098Eul, 0xE7DA2546ul, 0x5FDF501Eul, 0x37DC7CD6ul, 0x2A39CC5Ful, 0x423AE097ul,
+        0xFA3F95CFul, 0x923CB907ul, 0xC1F4F4DDul, 0xA9F7D815ul, 0x11F2AD4Dul, 0x79F18185ul,
+        0x6414310Cul, 0x0C171DC4ul, 0xB412689Cul, 0xDC114454ul, 0x1382F328ul, 0x7B81DFE0ul,
+        0xC384AAB8ul, 0xAB878670ul, 0xB66236F9ul, 0xDE611A31ul, 0x66646F69ul, 0x0E6743A1ul,
+        0x5DAF0E7Bul, 0x35AC22B3ul, 0x8DA957EBul, 0xE5AA7B23ul, 0xF84FCBAAul, 0x904CE762ul,
+        0x2849923Aul, 0x404ABEF2ul, 0xB2828A33ul, 0xDA81A6FBul, 0x6284D3A3ul, 0x0A87FF6Bul,
+        0x17624FE2ul, 0x7F61632Aul, 0xC7641672ul, 0xAF673ABAul, 0xFCAF7760ul, 0x94AC5BA8ul,
+        0x2CA92EF0ul, 0x44AA0238ul, 0x594FB2B1ul, 0x314C9E79ul, 0x8949EB21ul, 0xE14AC7E9ul,
+        0x2ED97095ul, 0x46DA5C5Dul, 0xFEDF2905ul, 0x96DC05CDul, 0x8B39B544ul, 0xE33A998Cul,
+        0x5B3FECD4ul, 0x333CC01Cul, 0x60F48DC6ul, 0x08F7A10Eul, 0xB0F2D456ul, 0xD8F1F89Eul,
+        0xC5144817ul, 0xAD1764DFul, 0x15121187ul, 0x7D113D4Ful
+    },
+    {
+        0x00000000ul, 0x493C7D27ul, 0x9278FA4Eul, 0xDB448769ul, 0x211D826Dul, 0x6821FF4Aul,
+        0xB3657823ul, 0xFA590504ul, 0x423B04DAul, 0x0B0779FDul, 0xD043FE94ul, 0x997F83B3ul,
+        0x632686B7ul, 0x2A1AFB90ul, 0xF15E7CF9ul, 0xB86201DEul, 0x847609B4ul, 0xCD4A7493ul,
+        0x160EF3FAul, 0x5F328EDDul, 0xA56B8BD9ul, 0xEC57F6FEul, 0x37137197ul, 0x7E2F0CB0ul,
+        0xC64D0D6Eul, 0x8F717049ul, 0x5435F720ul, 0x1D098A07ul, 0xE7508F03ul, 0xAE6CF224ul,
+        0x7528754Dul, 0x3C14086Aul, 0x0D006599ul, 0x443C18BEul, 0x9F789FD7ul, 0xD644E2F0ul,
+        0x2C1DE7F4ul, 0x65219AD3ul, 0xBE651DBAul, 0xF759609Dul, 0x4F3B6143ul, 0x06071C64ul,
+        0xDD439B0Dul, 0x947FE62Aul, 0x6E26E32Eul, 0x271A9E09ul, 0xFC5E1960ul, 0xB5626447ul,
+        0x89766C2Dul, 0xC04A110Aul, 0x1B0E9663ul, 0x5232EB44ul, 0xA86BEE40ul, 0xE1579367ul,
+        0x3A13140Eul, 0x732F6929ul, 0xCB4D68F7ul, 0x827115D0ul, 0x593592B9ul, 0x1009EF9Eul,
+        0xEA50EA9Aul, 0xA36C97BDul, 0x782810D4ul, 0x31146DF3ul, 0x1A00CB32ul, 0x533CB615ul,
+        0x8878317Cul, 0xC1444C5Bul, 0x3B1D495Ful, 0x72213478ul, 0xA965B311ul, 0xE059CE36ul,
+        0x583BCFE8ul, 0x1107B2CFul, 0xCA4335A6ul, 0x837F4881ul, 0x79264D85ul, 0x301A30A2ul,
+        0xEB5EB7CBul, 0xA262CAECul, 0x9E76C286ul, 0xD74ABFA1ul, 0x0C0E38C8ul, 0x453245EFul,
+        0xBF6B40EBul, 0xF6573DCCul, 0x2D13BAA5ul, 0x642FC782ul, 0xDC4DC65Cul, 0x9571BB7Bul,
+        0x4E353C12ul, 0x07094135ul, 0xFD504431ul, 0xB46C3916ul, 0x6F28BE7Ful, 0x2614C358ul,
+        0x1700AEABul, 0x5E3CD38Cul, 0x857854E5ul, 0xCC4429C2ul, 0x361D2CC6ul, 0x7F2151E1ul,
+        0xA465D688ul, 0xED59ABAFul, 0x553BAA71ul, 0x1C07D756ul, 0xC743503Ful, 0x8E7F2D18ul,
+        0x7426281Cul, 0x3D1A553Bul, 0xE65ED252ul, 0xAF62AF75ul, 0x9376A71Ful, 0xDA4ADA38ul,
+        0x010E5D51ul, 0x48322076ul, 0xB26B2572ul, 0xFB575855ul, 0x2013DF3Cul, 0x692FA21Bul,
+        0xD14DA3C5ul, 0x9871DEE2ul, 0x4335598Bul, 0x0A0924ACul, 0xF05021A8ul, 0xB96C5C8Ful,
+        0x6228DBE6ul, 0x2B14A6C1ul, 0x34019664ul, 0x7D3DEB43ul, 0xA6796C2Aul, 0xEF45110Dul,
+        0x151C1409ul, 0x5C20692Eul, 0x8764EE47ul, 0xCE589360ul, 0x763A92BEul, 0x3F06EF99ul,
+        0xE44268F0ul, 0xAD7E15D7ul, 0x572710D3ul, 0x1E1B6DF4ul, 0xC55FEA9Dul, 0x8C6397BAul,
+        0xB0779FD0ul, 0xF94BE2F7ul, 0x220F659Eul, 0x6B3318B9ul, 0x916A1DBDul, 0xD856609Aul,
+        0x0312E7F3ul, 0x4A2E9AD4ul, 0xF24C9B0Aul, 0xBB70E62Dul, 0x60346144ul, 0x29081C63ul,
+        0xD3511967ul, 0x9A6D6440ul, 0x4129E329ul, 0x08159E0Eul, 0x3901F3FDul, 0x703D8EDAul,
+        0xAB7909B3ul, 0xE2457494ul, 0x181C7190ul, 0x51200CB7ul, 0x8A648BDEul, 0xC358F6F9ul,
+        0x7B3AF727ul, 0x32068A00ul, 0xE9420D69ul, 0xA07E704Eul, 0x5A27754Aul, 0x131B086Dul,
+        0xC85F8F04ul, 0x8163F223ul, 0xBD77FA49ul, 0xF44B876Eul, 0x2F0F0007ul, 0x66337D20ul,
+        0x9C6A7824ul, 0xD5560503ul, 0x0E12826Aul, 0x472EFF4Dul, 0xFF4CFE93ul, 0xB67083B4ul,
+        0x6D3404DDul, 0x240879FAul, 0xDE517CFEul, 0x976D01D9ul, 0x4C2986B0ul, 0x0515FB97ul,
+        0x2E015D56ul, 0x673D2071ul, 0xBC79A718ul, 0xF545DA3Ful, 0x0F1CDF3Bul, 0x4620A21Cul,
+        0x9D642575ul, 0xD4585852ul, 0x6C3A598Cul, 0x250624ABul, 0xFE42A3C2ul, 0xB77EDEE5ul,
+        0x4D27DBE1ul, 0x041BA6C6ul, 0xDF5F21AFul, 0x96635C88ul, 0xAA7754E2ul, 0xE34B29C5ul,
+        0x380FAEACul, 0x7133D38Bul, 0x8B6AD68Ful, 0xC256ABA8ul, 0x19122CC1ul, 0x502E51E6ul,
+        0xE84C5038ul, 0xA1702D1Ful, 0x7A34AA76ul, 0x3308D751ul, 0xC951D255ul, 0x806DAF72ul,
+        0x5B29281Bul, 0x1215553Cul, 0x230138CFul, 0x6A3D45E8ul, 0xB179C281ul, 0xF845BFA6ul,
+        0x021CBAA2ul, 0x4B20C785ul, 0x906440ECul, 0xD9583DCBul, 0x613A3C15ul, 0x28064132ul,
+        0xF342C65Bul, 0xBA7EBB7Cul, 0x4027BE78ul, 0x091BC35Ful, 0xD25F4436ul, 0x9B633911ul,
+        0xA777317Bul, 0xEE4B4C5Cul, 0x350FCB35ul, 0x7C33B612ul, 0x866AB316ul, 0xCF56CE31ul,
+        0x14124958ul, 0x5D2E347Ful, 0xE54C35A1ul, 0xAC704886ul, 0x7734CFEFul, 0x3E08B2C8ul,
+        0xC451B7CCul, 0x8D6DCAEBul, 0x56294D82ul, 0x1F1530A5ul
+    }
+};
+#endif
+
+#endif //FLASH_MX25Series_CRC_Tables_H
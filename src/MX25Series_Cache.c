@@ -0,0 +1,370 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+#include "MX25Series_Cache.h"
+
+static size_t MX25Series__cache_count(MX25Series_Cache_Line_t *entries, size_t count, uint8_t list)
+{
+    size_t total = 0;
+    for(size_t i = 0; i < count; i++)
+    {
+        if(entries[i].tag != MX25Series_CACHE_INVALID_TAG && entries[i].list == list)
+        {
+            total++;
+        }
+    }
+    return total;
+}
+
+static MX25Series_Cache_Line_t* MX25Series__cache_find(MX25Series_Cache_Line_t *entries, size_t count, uint32_t tag)
+{
+    for(size_t i = 0; i < count; i++)
+    {
+        if(entries[i].tag == tag)
+        {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * MX25Series__cache_oldest returns the least recently used entry on list, or any list when list is -1.
+ */
+static MX25Series_Cache_Line_t* MX25Series__cache_oldest(MX25Series_Cache_Line_t *entries, size_t count, int list)
+{
+    MX25Series_Cache_Line_t *oldest = NULL;
+    for(size_t i = 0; i < count; i++)
+    {
+        if(entries[i].tag == MX25Series_CACHE_INVALID_TAG || (list >= 0 && entries[i].list != list))
+        {
+            continue;
+        }
+        if(oldest == NULL || entries[i].stamp < oldest->stamp)
+        {
+            oldest = &entries[i];
+        }
+    }
+    return oldest;
+}
+
+static uint32_t MX25Series__cache_tick(MX25Series_Cache_t *cache)
+{
+    if(++cache->clock == 0)
+    {
+        //The clock wrapped, forget the ordering rather than invert it.
+        for(size_t i = 0; i < cache->line_count; i++)
+        {
+            cache->lines[i].stamp = 0;
+            if(cache->ghosts != NULL)
+            {
+                cache->ghosts[i].stamp = 0;
+            }
+        }
+        cache->clock = 1;
+    }
+    return cache->clock;
+}
+
+/**
+ * MX25Series__cache_ghost moves an evicted ARC line into the ghost directory.
+ */
+static void MX25Series__cache_ghost(MX25Series_Cache_t *cache, MX25Series_Cache_Line_t *line, uint8_t list)
+{
+    MX25Series_Cache_Line_t *ghost = MX25Series__cache_find(cache->ghosts, cache->line_count, MX25Series_CACHE_INVALID_TAG);
+    if(ghost == NULL)
+    {
+        ghost = MX25Series__cache_oldest(cache->ghosts, cache->line_count, list);
+    }
+    if(ghost == NULL)
+    {
+        ghost = MX25Series__cache_oldest(cache->ghosts, cache->line_count, -1);
+    }
+    ghost->tag = line->tag;
+    ghost->stamp = line->stamp;
+    ghost->list = list;
+}
+
+/**
+ * MX25Series__cache_replace is ARC's REPLACE, it evicts a line from T1 or T2 depending on the adaptation target.
+ */
+static MX25Series_Cache_Line_t* MX25Series__cache_replace(MX25Series_Cache_t *cache, bool hit_in_b2)
+{
+    size_t t1 = MX25Series__cache_count(cache->lines, cache->line_count, MX25Series_Cache_List_T1);
+    MX25Series_Cache_Line_t *victim;
+
+    if(t1 > 0 && (t1 > cache->target_t1 || (hit_in_b2 && t1 == cache->target_t1)))
+    {
+        victim = MX25Series__cache_oldest(cache->lines, cache->line_count, MX25Series_Cache_List_T1);
+        MX25Series__cache_ghost(cache, victim, MX25Series_Cache_List_B1);
+    }
+    else
+    {
+        victim = MX25Series__cache_oldest(cache->lines, cache->line_count, MX25Series_Cache_List_T2);
+        if(victim == NULL)
+        {
+            victim = MX25Series__cache_oldest(cache->lines, cache->line_count, MX25Series_Cache_List_T1);
+            MX25Series__cache_ghost(cache, victim, MX25Series_Cache_List_B1);
+        }
+        else
+        {
+            MX25Series__cache_ghost(cache, victim, MX25Series_Cache_List_B2);
+        }
+    }
+    cache->stats.evictions++;
+    victim->tag = MX25Series_CACHE_INVALID_TAG;
+    return victim;
+}
+
+/**
+ * MX25Series__cache_allocate picks the line to load tag into and the list it joins, following the ARC or LRU policy.
+ */
+static MX25Series_Cache_Line_t* MX25Series__cache_allocate(MX25Series_Cache_t *cache, uint32_t tag, uint8_t *list)
+{
+    MX25Series_Cache_Line_t *line = MX25Series__cache_find(cache->lines, cache->line_count, MX25Series_CACHE_INVALID_TAG);
+    MX25Series_Cache_Line_t *ghost;
+    size_t c = cache->line_count;
+    size_t t1, t2, b1, b2;
+
+    *list = MX25Series_Cache_List_T1;
+
+    if(cache->policy == MX25Series_Cache_Policy_LRU)
+    {
+        if(line == NULL)
+        {
+            line = MX25Series__cache_oldest(cache->lines, c, -1);
+            cache->stats.evictions++;
+        }
+        return line;
+    }
+
+    t1 = MX25Series__cache_count(cache->lines, c, MX25Series_Cache_List_T1);
+    t2 = MX25Series__cache_count(cache->lines, c, MX25Series_Cache_List_T2);
+    b1 = MX25Series__cache_count(cache->ghosts, c, MX25Series_Cache_List_B1);
+    b2 = MX25Series__cache_count(cache->ghosts, c, MX25Series_Cache_List_B2);
+    ghost = MX25Series__cache_find(cache->ghosts, c, tag);
+
+    if(ghost != NULL && ghost->list == MX25Series_Cache_List_B1)
+    {
+        //Recently evicted after a single use, favour recency.
+        size_t delta = b2 > b1 ? b2 / b1 : 1;
+        cache->target_t1 = cache->target_t1 + delta > c ? c : cache->target_t1 + delta;
+        ghost->tag = MX25Series_CACHE_INVALID_TAG;
+        *list = MX25Series_Cache_List_T2;
+        return line != NULL ? line : MX25Series__cache_replace(cache, false);
+    }
+
+    if(ghost != NULL && ghost->list == MX25Series_Cache_List_B2)
+    {
+        //Recently evicted after repeated use, favour frequency.
+        size_t delta = b1 > b2 ? b1 / b2 : 1;
+        cache->target_t1 = cache->target_t1 > delta ? cache->target_t1 - delta : 0;
+        ghost->tag = MX25Series_CACHE_INVALID_TAG;
+        *list = MX25Series_Cache_List_T2;
+        return line != NULL ? line : MX25Series__cache_replace(cache, true);
+    }
+
+    if(t1 + b1 >= c)
+    {
+        if(t1 < c)
+        {
+            MX25Series__cache_oldest(cache->ghosts, c, MX25Series_Cache_List_B1)->tag = MX25Series_CACHE_INVALID_TAG;
+            return line != NULL ? line : MX25Series__cache_replace(cache, false);
+        }
+        if(line == NULL)
+        {
+            line = MX25Series__cache_oldest(cache->lines, c, MX25Series_Cache_List_T1);
+            line->tag = MX25Series_CACHE_INVALID_TAG;
+            cache->stats.evictions++;
+        }
+        return line;
+    }
+
+    if(t1 + t2 + b1 + b2 >= 2 * c && b2 > 0)
+    {
+        MX25Series__cache_oldest(cache->ghosts, c, MX25Series_Cache_List_B2)->tag = MX25Series_CACHE_INVALID_TAG;
+    }
+    return line != NULL ? line : MX25Series__cache_replace(cache, false);
+}
+
+static MX25Series_status_enum_t MX25Series__cache_load(MX25Series_Cache_t *cache, uint32_t tag, MX25Series_Cache_Line_t **loaded)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t list = MX25Series_Cache_List_T1;
+    MX25Series_Cache_Line_t *line = MX25Series__cache_allocate(cache, tag, &list);
+    uint8_t *data = cache->data + (size_t)(line - cache->lines) * cache->line_size;
+
+    line->tag = MX25Series_CACHE_INVALID_TAG;
+    result = MX25Series_read_stored_data_mode(cache->dev, cache->dev->read_mode, tag, cache->line_size, data);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    line->tag = tag;
+    line->list = list;
+    line->stamp = MX25Series__cache_tick(cache);
+    *loaded = line;
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_cache_init(
+        MX25Series_Cache_t *cache,
+        MX25Series_t *dev,
+        MX25Series_Cache_Policy_enum_t policy,
+        uint32_t line_size,
+        size_t line_count,
+        MX25Series_Cache_Line_t *lines,
+        MX25Series_Cache_Line_t *ghosts,
+        uint8_t *data)
+{
+    memset(cache, 0, sizeof(MX25Series_Cache_t));
+
+    if(line_size == 0 || line_size > MX25Series_BLOCK_64K_SIZE || (line_size & (line_size - 1)) != 0 ||
+       line_count == 0 || lines == NULL || data == NULL ||
+       (policy == MX25Series_Cache_Policy_ARC && ghosts == NULL) ||
+       (policy != MX25Series_Cache_Policy_ARC && policy != MX25Series_Cache_Policy_LRU))
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    cache->dev = dev;
+    cache->policy = policy;
+    cache->line_size = line_size;
+    cache->line_count = line_count;
+    cache->lines = lines;
+    cache->ghosts = policy == MX25Series_Cache_Policy_ARC ? ghosts : NULL;
+    cache->data = data;
+    cache->last_line = MX25Series_CACHE_INVALID_TAG;
+    cache->prefetch = true;
+
+    for(size_t i = 0; i < line_count; i++)
+    {
+        lines[i].tag = MX25Series_CACHE_INVALID_TAG;
+        if(cache->ghosts != NULL)
+        {
+            cache->ghosts[i].tag = MX25Series_CACHE_INVALID_TAG;
+        }
+    }
+
+    dev->cache = cache;
+    return MX25Series_status_ok;
+}
+
+void MX25Series_cache_deinit(MX25Series_Cache_t *cache)
+{
+    if(cache->dev != NULL && cache->dev->cache == cache)
+    {
+        cache->dev->cache = NULL;
+    }
+    cache->dev = NULL;
+}
+
+MX25Series_status_enum_t MX25Series_cache_read(
+        MX25Series_Cache_t *cache,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+
+    while(length > 0)
+    {
+        uint32_t tag = memory_address & ~(cache->line_size - 1);
+        uint32_t offset = memory_address - tag;
+        size_t chunk = cache->line_size - offset;
+        bool sequential = cache->last_line != MX25Series_CACHE_INVALID_TAG && tag == cache->last_line + cache->line_size;
+        MX25Series_Cache_Line_t *line = MX25Series__cache_find(cache->lines, cache->line_count, tag);
+
+        if(chunk > length)
+        {
+            chunk = length;
+        }
+
+        if(line != NULL)
+        {
+            cache->stats.hits++;
+            line->stamp = MX25Series__cache_tick(cache);
+            if(cache->policy == MX25Series_Cache_Policy_ARC)
+            {
+                line->list = MX25Series_Cache_List_T2;
+            }
+        }
+        else
+        {
+            cache->stats.misses++;
+            result = MX25Series__cache_load(cache, tag, &line);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+        }
+
+        memcpy(buffer, cache->data + (size_t)(line - cache->lines) * cache->line_size + offset, chunk);
+        cache->last_line = tag;
+
+        //Sequential access, bring the following line in before it is asked for.
+        if(sequential && cache->prefetch && cache->line_count > 1 &&
+           tag + cache->line_size < cache->dev->chip_def->memory_size &&
+           MX25Series__cache_find(cache->lines, cache->line_count, tag + cache->line_size) == NULL)
+        {
+            MX25Series_Cache_Line_t *next;
+            result = MX25Series__cache_load(cache, tag + cache->line_size, &next);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+            cache->stats.prefetches++;
+        }
+
+        memory_address += chunk;
+        buffer += chunk;
+        length -= chunk;
+    }
+
+    return result;
+}
+
+void MX25Series_cache_invalidate(MX25Series_Cache_t *cache, uint32_t memory_address, uint32_t length)
+{
+    if(cache == NULL || length == 0)
+    {
+        return;
+    }
+
+    for(size_t i = 0; i < cache->line_count; i++)
+    {
+        MX25Series_Cache_Line_t *line = &cache->lines[i];
+        if(line->tag != MX25Series_CACHE_INVALID_TAG &&
+           line->tag < memory_address + length && memory_address < line->tag + cache->line_size)
+        {
+            line->tag = MX25Series_CACHE_INVALID_TAG;
+            cache->stats.invalidations++;
+        }
+    }
+}
+
+void MX25Series_cache_reset_stats(MX25Series_Cache_t *cache)
+{
+    memset(&cache->stats, 0, sizeof(cache->stats));
+}
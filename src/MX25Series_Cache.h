@@ -0,0 +1,141 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+#ifndef FLASH_MX25Series_Cache_H
+#define FLASH_MX25Series_Cache_H
+
+#include "MX25Series.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define MX25Series_CACHE_INVALID_TAG 0xFFFFFFFFul
+
+typedef enum {
+    MX25Series_Cache_Policy_LRU = 0, /**< Evict the least recently used line */
+    MX25Series_Cache_Policy_ARC = 1, /**< Adaptive Replacement Cache, balances recency against frequency */
+} MX25Series_Cache_Policy_enum_t;
+
+typedef enum {
+    MX25Series_Cache_List_T1 = 0, /**< ARC, resident and seen once */
+    MX25Series_Cache_List_T2 = 1, /**< ARC, resident and seen more than once */
+    MX25Series_Cache_List_B1 = 2, /**< ARC, recently evicted from T1 */
+    MX25Series_Cache_List_B2 = 3, /**< ARC, recently evicted from T2 */
+} MX25Series_Cache_List_enum_t;
+
+/**
+ * @brief Book keeping for a cache line or an ARC ghost entry.
+ */
+typedef struct {
+    uint32_t tag;   /**! Address of the first byte of the line, MX25Series_CACHE_INVALID_TAG when empty */
+    uint32_t stamp; /**! Access clock of the last use, larger is more recent */
+    uint8_t list;   /**! MX25Series_Cache_List_enum_t, only used by MX25Series_Cache_Policy_ARC */
+} MX25Series_Cache_Line_t;
+
+typedef struct MX25Series_Cache_t
+{
+    MX25Series_t *dev;
+    MX25Series_Cache_Policy_enum_t policy;
+    uint32_t line_size;                  /**! Bytes per line, a power of two, normally the page or sector size */
+    size_t line_count;
+    MX25Series_Cache_Line_t *lines;      /**! line_count entries */
+    MX25Series_Cache_Line_t *ghosts;     /**! line_count entries, ARC ghost directory, NULL for LRU */
+    uint8_t *data;                       /**! line_count * line_size bytes */
+    uint32_t clock;
+    size_t target_t1;                    /**! ARC adaptation target for the size of T1 */
+    uint32_t last_line;                  /**! Tag of the last line accessed, used to detect sequential reads */
+    bool prefetch;                       /**! Load the following line when reads are sequential */
+    struct{
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t evictions;
+        uint32_t prefetches;
+        uint32_t invalidations;
+    }stats;
+} MX25Series_Cache_t;
+
+/**
+ * MX25Series_cache_init sets up a read cache in front of MX25Series_read_stored_data_mode and attaches it to dev, so
+ * that MX25Series_write_stored_data and MX25Series_erase invalidate the affected lines. All memory is supplied by
+ * the caller.
+ * @param cache the cache structure to initialise.
+ * @param dev the device structure for the MX25Series chip.
+ * @param policy the eviction policy.
+ * @param line_size bytes per line, a power of two no larger than 64 KB.
+ * @param line_count number of lines.
+ * @param lines line_count entries of line book keeping.
+ * @param ghosts line_count entries for the ARC ghost directory, may be NULL for MX25Series_Cache_Policy_LRU.
+ * @param data line_count * line_size bytes of line storage.
+ * @return MX25Series_status_error_invalid_argument if the geometry or buffers are invalid.
+ */
+MX25Series_status_enum_t MX25Series_cache_init(
+        MX25Series_Cache_t *cache,
+        MX25Series_t *dev,
+        MX25Series_Cache_Policy_enum_t policy,
+        uint32_t line_size,
+        size_t line_count,
+        MX25Series_Cache_Line_t *lines,
+        MX25Series_Cache_Line_t *ghosts,
+        uint8_t *data);
+
+/**
+ * MX25Series_cache_deinit detaches the cache from its device.
+ * @param cache the cache structure.
+ */
+void MX25Series_cache_deinit(MX25Series_Cache_t *cache);
+
+/**
+ * MX25Series_cache_read reads data through the cache, missing lines are loaded with dev->read_mode.
+ * @param cache the cache structure.
+ * @param memory_address the 24-bit memory address to read from.
+ * @param length the number of bytes to read.
+ * @param buffer the buffer in which to store the read data.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_cache_read(
+        MX25Series_Cache_t *cache,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* buffer);
+
+/**
+ * MX25Series_cache_invalidate drops every line overlapping the range.
+ * @param cache the cache structure, may be NULL.
+ * @param memory_address the first address of the range.
+ * @param length the number of bytes in the range.
+ */
+void MX25Series_cache_invalidate(MX25Series_Cache_t *cache, uint32_t memory_address, uint32_t length);
+
+/**
+ * MX25Series_cache_reset_stats zeroes the hit, miss, eviction, prefetch and invalidation counters.
+ * @param cache the cache structure.
+ */
+void MX25Series_cache_reset_stats(MX25Series_Cache_t *cache);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_Cache_H
@@ -0,0 +1,941 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#include "MX25Series_FTL.h"
+#include "MX25Series_CRC.h"
+
+#define MX25Series_FTL_ERASE_RECORD_SIZE 12      //Magic, erase count and CRC-32 at offset 0
+#define MX25Series_FTL_ALLOCATION_OFFSET 12      //Logical sector, its inverse, sequence and CRC-32
+#define MX25Series_FTL_ALLOCATION_SIZE 12
+#define MX25Series_FTL_COMMIT_OFFSET 24          //0x00 once the data is programmed
+#define MX25Series_FTL_STALE_OFFSET 16           //0x00 once the checkpoint no longer matches the map
+#define MX25Series_FTL_CHECKPOINT_HEADER_SIZE 32
+
+static void MX25Series__ftl_put16(uint8_t *buffer, uint16_t value)
+{
+    buffer[0] = value & 0xFF;
+    buffer[1] = (value >> 8) & 0xFF;
+}
+
+static void MX25Series__ftl_put32(uint8_t *buffer, uint32_t value)
+{
+    MX25Series__ftl_put16(buffer, value & 0xFFFF);
+    MX25Series__ftl_put16(buffer + 2, (value >> 16) & 0xFFFF);
+}
+
+static uint16_t MX25Series__ftl_get16(const uint8_t *buffer)
+{
+    return (uint16_t)(buffer[0] | (buffer[1] << 8));
+}
+
+static uint32_t MX25Series__ftl_get32(const uint8_t *buffer)
+{
+    return MX25Series__ftl_get16(buffer) | ((uint32_t)MX25Series__ftl_get16(buffer + 2) << 16);
+}
+
+static bool MX25Series__ftl_test(const uint8_t *bitmap, uint16_t index)
+{
+    return (bitmap[index / 8] & (1 << (index % 8))) != 0;
+}
+
+static void MX25Series__ftl_set(uint8_t *bitmap, uint16_t index, bool value)
+{
+    if(value)
+    {
+        bitmap[index / 8] |= (uint8_t)(1 << (index % 8));
+    }
+    else
+    {
+        bitmap[index / 8] &= (uint8_t)~(1 << (index % 8));
+    }
+}
+
+static uint32_t MX25Series__ftl_address(MX25Series_FTL_t *ftl, uint16_t physical)
+{
+    return ftl->data_base + (uint32_t)physical * MX25Series_SECTOR_SIZE;
+}
+
+static uint32_t MX25Series__ftl_checkpoint_address(MX25Series_FTL_t *ftl, uint8_t copy)
+{
+    return ftl->base + (uint32_t)copy * ftl->checkpoint_sectors * MX25Series_SECTOR_SIZE;
+}
+
+static uint32_t MX25Series__ftl_checkpoint_length(MX25Series_FTL_t *ftl)
+{
+    return 4 + 2 * (uint32_t)ftl->logical_count + 2 * MX25Series_FTL_BITMAP_SIZE((uint32_t)ftl->physical_count);
+}
+
+static MX25Series_status_enum_t MX25Series__ftl_read(MX25Series_FTL_t *ftl, uint32_t memory_address, size_t length, uint8_t *buffer)
+{
+    return MX25Series_read_stored_data_mode(ftl->dev, ftl->dev->read_mode, memory_address, length, buffer);
+}
+
+static MX25Series_status_enum_t MX25Series__ftl_read_erase_record(MX25Series_FTL_t *ftl, uint16_t physical, bool *valid, uint32_t *erase_count)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t record[MX25Series_FTL_ERASE_RECORD_SIZE];
+
+    result = MX25Series__ftl_read(ftl, MX25Series__ftl_address(ftl, physical), sizeof(record), record);
+    *erase_count = MX25Series__ftl_get32(record + 4);
+    *valid = !MX25Series_HAS_ERROR(result) && MX25Series__ftl_get32(record) == MX25Series_FTL_MAGIC &&
+             MX25Series__ftl_get32(record + 8) == MX25Series_crc32(0, record, 8);
+    return result;
+}
+
+static MX25Series_status_enum_t MX25Series__ftl_write_erase_record(MX25Series_FTL_t *ftl, uint16_t physical, uint32_t erase_count)
+{
+    uint8_t record[MX25Series_FTL_ERASE_RECORD_SIZE];
+
+    MX25Series__ftl_put32(record, MX25Series_FTL_MAGIC);
+    MX25Series__ftl_put32(record + 4, erase_count);
+    MX25Series__ftl_put32(record + 8, MX25Series_crc32(0, record, 8));
+    return MX25Series_write_stored_data_paged(ftl->dev, MX25Series__ftl_address(ftl, physical), sizeof(record), record);
+}
+
+/**
+ * MX25Series__ftl_highest_erase_count reads the highest erase count recorded by any physical sector.
+ */
+static MX25Series_status_enum_t MX25Series__ftl_highest_erase_count(MX25Series_FTL_t *ftl, uint32_t *highest)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint16_t physical;
+
+    *highest = 0;
+    for(physical = 0; physical < ftl->physical_count; physical++)
+    {
+        uint32_t erase_count = 0;
+        bool valid = false;
+
+        result = MX25Series__ftl_read_erase_record(ftl, physical, &valid, &erase_count);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        if(valid && erase_count > *highest)
+        {
+            *highest = erase_count;
+        }
+    }
+    return MX25Series_status_ok;
+}
+
+/**
+ * MX25Series__ftl_erase erases a physical sector and records its new erase count straight away.
+ */
+static MX25Series_status_enum_t MX25Series__ftl_erase(MX25Series_FTL_t *ftl, uint16_t physical)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t erase_count = 0;
+    bool valid = false;
+
+    result = MX25Series__ftl_read_erase_record(ftl, physical, &valid, &erase_count);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    if(!valid)
+    {
+        //A power loss after the last erase lost the record, so assume the sector is as worn as the worst one.
+        result = MX25Series__ftl_highest_erase_count(ftl, &erase_count);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+
+    result = MX25Series_set_write_enable(ftl->dev, true);
+    result |= MX25Series_erase(ftl->dev, MX25Series_Erase_Block_4K, MX25Series__ftl_address(ftl, physical));
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    result = MX25Series_wait_for_operation(ftl->dev);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    result = MX25Series__ftl_write_erase_record(ftl, physical, erase_count + 1);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    MX25Series__ftl_set(ftl->dirty, physical, false);
+    return MX25Series_status_ok;
+}
+
+/**
+ * MX25Series__ftl_mark_stale clears the stale flag of the newest checkpoint before the map first changes.
+ */
+static MX25Series_status_enum_t MX25Series__ftl_mark_stale(MX25Series_FTL_t *ftl)
+{
+    uint8_t flag = 0x00;
+
+    if(!ftl->checkpoint_current)
+    {
+        return MX25Series_status_ok;
+    }
+    ftl->checkpoint_current = false;
+    return MX25Series_write_stored_data_paged(ftl->dev,
+                                              MX25Series__ftl_checkpoint_address(ftl, ftl->checkpoint_copy) + MX25Series_FTL_STALE_OFFSET,
+                                              1, &flag);
+}
+
+static void MX25Series__ftl_pool_insert(MX25Series_FTL_t *ftl, uint16_t physical, uint32_t erase_count)
+{
+    uint8_t i = ftl->pool_count;
+
+    //Keep the lowest erase counts, sorted.
+    if(ftl->pool_count == MX25Series_FTL_POOL_SIZE)
+    {
+        if(erase_count >= ftl->pool[MX25Series_FTL_POOL_SIZE - 1].erase_count)
+        {
+            return;
+        }
+        i = MX25Series_FTL_POOL_SIZE - 1;
+    }
+    else
+    {
+        ftl->pool_count++;
+    }
+
+    while(i > 0 && ftl->pool[i - 1].erase_count > erase_count)
+    {
+        ftl->pool[i] = ftl->pool[i - 1];
+        i--;
+    }
+    ftl->pool[i].physical = physical;
+    ftl->pool[i].erase_count = erase_count;
+}
+
+static void MX25Series__ftl_pool_remove(MX25Series_FTL_t *ftl, uint8_t index)
+{
+    memmove(&ftl->pool[index], &ftl->pool[index + 1], (ftl->pool_count - index - 1) * sizeof(MX25Series_FTL_Pool_Entry_t));
+    ftl->pool_count--;
+}
+
+/**
+ * MX25Series__ftl_refill reads the erase counts of up to MX25Series_FTL_REFILL_SCAN clean sectors, continuing where
+ * the last refill stopped, and keeps the least worn in the pool and the most worn in ftl->worn.
+ */
+static MX25Series_status_enum_t MX25Series__ftl_refill(MX25Series_FTL_t *ftl)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint16_t scanned = 0;
+    uint16_t visited;
+
+    ftl->worn_valid = false;
+    for(visited = 0; visited < ftl->physical_count && scanned < MX25Series_FTL_REFILL_SCAN; visited++)
+    {
+        uint16_t physical = ftl->refill_cursor;
+        uint32_t erase_count = 0;
+        bool valid = false;
+
+        ftl->refill_cursor = (ftl->refill_cursor + 1) % ftl->physical_count;
+        if(MX25Series__ftl_test(ftl->used, physical) || MX25Series__ftl_test(ftl->dirty, physical))
+        {
+            continue;
+        }
+
+        result = MX25Series__ftl_read_erase_record(ftl, physical, &valid, &erase_count);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        if(!valid)
+        {
+            MX25Series__ftl_set(ftl->dirty, physical, true);
+            continue;
+        }
+
+        scanned++;
+        MX25Series__ftl_pool_insert(ftl, physical, erase_count);
+        if(!ftl->worn_valid || erase_count > ftl->worn.erase_count)
+        {
+            ftl->worn.physical = physical;
+            ftl->worn.erase_count = erase_count;
+            ftl->worn_valid = true;
+        }
+    }
+    return MX25Series_status_ok;
+}
+
+/**
+ * MX25Series__ftl_allocate takes a clean sector, the least worn one for new data or the most worn one for cold data.
+ */
+static MX25Series_status_enum_t MX25Series__ftl_allocate(MX25Series_FTL_t *ftl, bool worn, uint16_t *physical)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t i;
+
+    if(worn && ftl->worn_valid)
+    {
+        *physical = ftl->worn.physical;
+        ftl->worn_valid = false;
+        for(i = 0; i < ftl->pool_count; i++)
+        {
+            if(ftl->pool[i].physical == *physical)
+            {
+                MX25Series__ftl_pool_remove(ftl, i);
+                break;
+            }
+        }
+        return MX25Series_status_ok;
+    }
+
+    if(ftl->pool_count == 0)
+    {
+        result = MX25Series__ftl_refill(ftl);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+
+    if(ftl->pool_count == 0)
+    {
+        //No clean sector left, erase a replaced one now.
+        result = MX25Series_ftl_collect(ftl, 1);
+        result |= MX25Series__ftl_refill(ftl);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        if(ftl->pool_count == 0)
+        {
+            return MX25Series_status_error_busy;
+        }
+    }
+
+    *physical = ftl->pool[0].physical;
+    MX25Series__ftl_pool_remove(ftl, 0);
+    if(ftl->worn_valid && ftl->worn.physical == *physical)
+    {
+        ftl->worn_valid = false;
+    }
+    return MX25Series_status_ok;
+}
+
+/**
+ * MX25Series__ftl_place writes logical to the clean sector physical, taking [offset, offset + length) from buffer
+ * and the rest from the current copy, commits it, and moves the map over to it.
+ */
+static MX25Series_status_enum_t MX25Series__ftl_place(
+        MX25Series_FTL_t *ftl,
+        uint16_t logical,
+        uint16_t physical,
+        uint32_t offset,
+        size_t length,
+        uint8_t *buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t memory_address = MX25Series__ftl_address(ftl, physical);
+    uint32_t page_size = ftl->dev->chip_def->page_size;
+    uint16_t previous = ftl->map[logical];
+    uint8_t record[MX25Series_FTL_ALLOCATION_SIZE];
+    uint8_t commit = 0x00;
+    uint32_t position;
+
+    //The allocation record goes first, a sector with one but no commit flag is known to be partly written.
+    MX25Series__ftl_put16(record, logical);
+    MX25Series__ftl_put16(record + 2, (uint16_t)~logical);
+    MX25Series__ftl_put32(record + 4, ftl->sequence);
+    MX25Series__ftl_put32(record + 8, MX25Series_crc32(0, record, 8));
+    result = MX25Series_write_stored_data_paged(ftl->dev, memory_address + MX25Series_FTL_ALLOCATION_OFFSET, sizeof(record), record);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    for(position = MX25Series_FTL_HEADER_SIZE; position < MX25Series_SECTOR_SIZE;)
+    {
+        uint32_t chunk = page_size - (position % page_size);
+        uint32_t data_offset = position - MX25Series_FTL_HEADER_SIZE;
+        uint32_t from = data_offset > offset ? data_offset : offset;
+        uint32_t to = data_offset + chunk < offset + length ? data_offset + chunk : offset + length;
+        uint32_t i;
+        bool blank = true;
+
+        if(from >= to || from > data_offset || to < data_offset + chunk)
+        {
+            //Part of the page keeps its current contents.
+            if(previous != MX25Series_FTL_UNMAPPED)
+            {
+                result = MX25Series__ftl_read(ftl, MX25Series__ftl_address(ftl, previous) + position, chunk, ftl->page_buffer);
+                if(MX25Series_HAS_ERROR(result))
+                {
+                    return result;
+                }
+            }
+            else
+            {
+                memset(ftl->page_buffer, 0xFF, chunk);
+            }
+        }
+        if(from < to)
+        {
+            memcpy(ftl->page_buffer + (from - data_offset), buffer + (from - offset), to - from);
+        }
+
+        for(i = 0; i < chunk && blank; i++)
+        {
+            blank = ftl->page_buffer[i] == 0xFF;
+        }
+        if(!blank)
+        {
+            result = MX25Series_write_stored_data_paged(ftl->dev, memory_address + position, chunk, ftl->page_buffer);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+        }
+        position += chunk;
+    }
+
+    result = MX25Series_write_stored_data_paged(ftl->dev, memory_address + MX25Series_FTL_COMMIT_OFFSET, 1, &commit);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    ftl->map[logical] = physical;
+    MX25Series__ftl_set(ftl->used, physical, true);
+    if(previous != MX25Series_FTL_UNMAPPED)
+    {
+        MX25Series__ftl_set(ftl->used, previous, false);
+        MX25Series__ftl_set(ftl->dirty, previous, true);
+    }
+    ftl->sequence++;
+    return MX25Series_status_ok;
+}
+
+/**
+ * MX25Series__ftl_wear_step reads the erase counts of the next MX25Series_FTL_STATIC_SCAN mapped sectors, and at
+ * the end of each sweep moves the data of the least worn one to the most worn clean sector if the spread is too wide.
+ */
+static MX25Series_status_enum_t MX25Series__ftl_wear_step(MX25Series_FTL_t *ftl)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint16_t checked = 0;
+    uint16_t visited;
+
+    for(visited = 0; visited < ftl->physical_count && checked < MX25Series_FTL_STATIC_SCAN; visited++)
+    {
+        uint16_t physical = ftl->wear.cursor++;
+
+        if(MX25Series__ftl_test(ftl->used, physical))
+        {
+            uint32_t erase_count = 0;
+            bool valid = false;
+
+            result = MX25Series__ftl_read_erase_record(ftl, physical, &valid, &erase_count);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+            checked++;
+            if(valid && erase_count < ftl->wear.coldest_count)
+            {
+                ftl->wear.coldest = physical;
+                ftl->wear.coldest_count = erase_count;
+            }
+            if(valid && erase_count > ftl->wear.hottest_count)
+            {
+                ftl->wear.hottest_count = erase_count;
+            }
+        }
+
+        if(ftl->wear.cursor < ftl->physical_count)
+        {
+            continue;
+        }
+
+        //End of a sweep.
+        ftl->wear.cursor = 0;
+        if(ftl->worn_valid && ftl->worn.erase_count > ftl->wear.hottest_count)
+        {
+            ftl->wear.hottest_count = ftl->worn.erase_count;
+        }
+        if(ftl->wear.coldest_count != 0xFFFFFFFFul &&
+           ftl->wear.hottest_count - ftl->wear.coldest_count > MX25Series_FTL_WEAR_THRESHOLD &&
+           MX25Series__ftl_test(ftl->used, ftl->wear.coldest))
+        {
+            uint8_t record[MX25Series_FTL_ALLOCATION_SIZE];
+            uint16_t logical;
+            uint16_t target;
+
+            result = MX25Series__ftl_read(ftl, MX25Series__ftl_address(ftl, ftl->wear.coldest) + MX25Series_FTL_ALLOCATION_OFFSET,
+                                          sizeof(record), record);
+            logical = MX25Series__ftl_get16(record);
+            if(!MX25Series_HAS_ERROR(result) && logical < ftl->logical_count && ftl->map[logical] == ftl->wear.coldest)
+            {
+                result = MX25Series__ftl_allocate(ftl, true, &target);
+                if(!MX25Series_HAS_ERROR(result))
+                {
+                    result = MX25Series__ftl_place(ftl, logical, target, 0, 0, NULL);
+                    if(MX25Series_HAS_ERROR(result))
+                    {
+                        MX25Series__ftl_set(ftl->dirty, target, true);
+                    }
+                    ftl->wear.relocations++;
+                }
+            }
+        }
+        ftl->wear.coldest_count = 0xFFFFFFFFul;
+        ftl->wear.hottest_count = 0;
+        return result;
+    }
+    return MX25Series_status_ok;
+}
+
+/**
+ * MX25Series__ftl_load_checkpoint loads the newest checkpoint if its stale flag is clear and its CRC matches.
+ */
+static MX25Series_status_enum_t MX25Series__ftl_load_checkpoint(MX25Series_FTL_t *ftl, bool *loaded)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t length = MX25Series__ftl_checkpoint_length(ftl);
+    uint32_t bitmap_size = MX25Series_FTL_BITMAP_SIZE((uint32_t)ftl->physical_count);
+    uint8_t header[MX25Series_FTL_STALE_OFFSET + 1];
+    uint8_t sequence[4];
+    uint32_t memory_address;
+    uint32_t crc = 0;
+    bool stale = true;
+    uint8_t copy;
+
+    *loaded = false;
+    ftl->checkpoint_sequence = 0;
+    ftl->checkpoint_copy = 1;
+    ftl->checkpoint_current = false;
+
+    for(copy = 0; copy < 2; copy++)
+    {
+        result = MX25Series__ftl_read(ftl, MX25Series__ftl_checkpoint_address(ftl, copy), sizeof(header), header);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        if(MX25Series__ftl_get32(header) != MX25Series_FTL_CHECKPOINT_MAGIC || MX25Series__ftl_get32(header + 8) != length)
+        {
+            continue;
+        }
+        if(ftl->checkpoint_sequence == 0 || (int32_t)(MX25Series__ftl_get32(header + 4) - ftl->checkpoint_sequence) > 0)
+        {
+            ftl->checkpoint_copy = copy;
+            ftl->checkpoint_sequence = MX25Series__ftl_get32(header + 4);
+            crc = MX25Series__ftl_get32(header + 12);
+            stale = header[MX25Series_FTL_STALE_OFFSET] != 0xFF;
+        }
+    }
+
+    if(ftl->checkpoint_sequence == 0 || stale)
+    {
+        return MX25Series_status_ok;
+    }
+
+    //Read straight into the map and bitmaps, the scan overwrites them if the CRC does not match.
+    memory_address = MX25Series__ftl_checkpoint_address(ftl, ftl->checkpoint_copy) + MX25Series_FTL_CHECKPOINT_HEADER_SIZE;
+    result = MX25Series__ftl_read(ftl, memory_address, sizeof(sequence), sequence);
+    result |= MX25Series__ftl_read(ftl, memory_address + 4, 2 * (uint32_t)ftl->logical_count, (uint8_t*)ftl->map);
+    result |= MX25Series__ftl_read(ftl, memory_address + 4 + 2 * (uint32_t)ftl->logical_count, bitmap_size, ftl->used);
+    result |= MX25Series__ftl_read(ftl, memory_address + 4 + 2 * (uint32_t)ftl->logical_count + bitmap_size, bitmap_size, ftl->dirty);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    if(MX25Series_crc32(MX25Series_crc32(MX25Series_crc32(MX25Series_crc32(0, sequence, sizeof(sequence)),
+                                                          (uint8_t*)ftl->map, 2 * (uint32_t)ftl->logical_count),
+                                         ftl->used, bitmap_size),
+                        ftl->dirty, bitmap_size) != crc)
+    {
+        return MX25Series_status_ok;
+    }
+
+    ftl->sequence = MX25Series__ftl_get32(sequence);
+    ftl->checkpoint_current = true;
+    *loaded = true;
+    return MX25Series_status_ok;
+}
+
+/**
+ * MX25Series__ftl_scan rebuilds the map and bitmaps from the header of every physical sector.
+ */
+static MX25Series_status_enum_t MX25Series__ftl_scan(MX25Series_FTL_t *ftl)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t next_sequence = 0;
+    uint16_t physical;
+
+    memset(ftl->map, 0xFF, 2 * (uint32_t)ftl->logical_count);
+    memset(ftl->used, 0, MX25Series_FTL_BITMAP_SIZE((uint32_t)ftl->physical_count));
+    memset(ftl->dirty, 0, MX25Series_FTL_BITMAP_SIZE((uint32_t)ftl->physical_count));
+
+    for(physical = 0; physical < ftl->physical_count; physical++)
+    {
+        uint8_t header[MX25Series_FTL_HEADER_SIZE];
+        uint8_t *allocation = header + MX25Series_FTL_ALLOCATION_OFFSET;
+        uint16_t logical;
+        uint32_t sequence;
+        bool erased;
+        uint8_t i;
+
+        result = MX25Series__ftl_read(ftl, MX25Series__ftl_address(ftl, physical), sizeof(header), header);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        logical = MX25Series__ftl_get16(allocation);
+        sequence = MX25Series__ftl_get32(allocation + 4);
+        if((logical ^ MX25Series__ftl_get16(allocation + 2)) == 0xFFFF && logical < ftl->logical_count &&
+           MX25Series__ftl_get32(allocation + 8) == MX25Series_crc32(0, allocation, 8) &&
+           header[MX25Series_FTL_COMMIT_OFFSET] == 0x00)
+        {
+            if((int32_t)(sequence + 1 - next_sequence) > 0)
+            {
+                next_sequence = sequence + 1;
+            }
+
+            //A power loss between writing a copy and the next mount leaves two, the newer one wins.
+            if(ftl->map[logical] != MX25Series_FTL_UNMAPPED)
+            {
+                uint8_t other[4];
+
+                result = MX25Series__ftl_read(ftl, MX25Series__ftl_address(ftl, ftl->map[logical]) + MX25Series_FTL_ALLOCATION_OFFSET + 4,
+                                              sizeof(other), other);
+                if(MX25Series_HAS_ERROR(result))
+                {
+                    return result;
+                }
+                if((int32_t)(sequence - MX25Series__ftl_get32(other)) < 0)
+                {
+                    MX25Series__ftl_set(ftl->dirty, physical, true);
+                    continue;
+                }
+                MX25Series__ftl_set(ftl->used, ftl->map[logical], false);
+                MX25Series__ftl_set(ftl->dirty, ftl->map[logical], true);
+            }
+            ftl->map[logical] = physical;
+            MX25Series__ftl_set(ftl->used, physical, true);
+            continue;
+        }
+
+        //Clean only with an erase record and nothing written after it.
+        erased = MX25Series__ftl_get32(header) == MX25Series_FTL_MAGIC &&
+                 MX25Series__ftl_get32(header + 8) == MX25Series_crc32(0, header, 8);
+        for(i = MX25Series_FTL_ERASE_RECORD_SIZE; i < MX25Series_FTL_HEADER_SIZE && erased; i++)
+        {
+            erased = header[i] == 0xFF;
+        }
+        if(!erased)
+        {
+            MX25Series__ftl_set(ftl->dirty, physical, true);
+        }
+    }
+
+    ftl->sequence = next_sequence;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_ftl_init(
+        MX25Series_FTL_t *ftl,
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        uint32_t length,
+        uint16_t logical_count,
+        uint16_t *map,
+        uint8_t *used,
+        uint8_t *dirty,
+        uint8_t *page_buffer)
+{
+    uint32_t sectors = length / MX25Series_SECTOR_SIZE;
+    uint32_t checkpoint_sectors = 1;
+    uint32_t physical_count;
+
+    memset(ftl, 0, sizeof(MX25Series_FTL_t));
+
+    if(dev->chip_def == NULL || dev->chip_def->page_size == 0 || (MX25Series_SECTOR_SIZE % dev->chip_def->page_size) != 0)
+    {
+        return MX25Series_status_error_invalid_chip_def;
+    }
+
+    if(map == NULL || used == NULL || dirty == NULL || page_buffer == NULL || logical_count == 0 ||
+       logical_count == MX25Series_FTL_UNMAPPED || (memory_address % MX25Series_SECTOR_SIZE) != 0 ||
+       (length % MX25Series_SECTOR_SIZE) != 0 || memory_address > dev->chip_def->memory_size ||
+       length > dev->chip_def->memory_size - memory_address)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    //Grow the checkpoint copies until the map and bitmaps of the sectors left over fit in one.
+    for(;;)
+    {
+        if(sectors <= 2 * checkpoint_sectors + logical_count)
+        {
+            return MX25Series_status_error_invalid_argument;
+        }
+        physical_count = sectors - 2 * checkpoint_sectors;
+        if(MX25Series_FTL_CHECKPOINT_HEADER_SIZE + 4 + 2 * (uint32_t)logical_count + 2 * MX25Series_FTL_BITMAP_SIZE(physical_count) <=
+           checkpoint_sectors * MX25Series_SECTOR_SIZE)
+        {
+            break;
+        }
+        checkpoint_sectors++;
+    }
+    if(physical_count >= MX25Series_FTL_UNMAPPED)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    ftl->dev = dev;
+    ftl->base = memory_address;
+    ftl->checkpoint_sectors = (uint16_t)checkpoint_sectors;
+    ftl->data_base = memory_address + 2 * checkpoint_sectors * MX25Series_SECTOR_SIZE;
+    ftl->physical_count = (uint16_t)physical_count;
+    ftl->logical_count = logical_count;
+    ftl->map = map;
+    ftl->used = used;
+    ftl->dirty = dirty;
+    ftl->page_buffer = page_buffer;
+    ftl->wear.coldest_count = 0xFFFFFFFFul;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_ftl_format(MX25Series_FTL_t *ftl)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint16_t physical;
+
+    result = MX25Series_erase_range(ftl->dev, ftl->base,
+                                    (2 * (uint32_t)ftl->checkpoint_sectors + ftl->physical_count) * MX25Series_SECTOR_SIZE);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    for(physical = 0; physical < ftl->physical_count; physical++)
+    {
+        result = MX25Series__ftl_write_erase_record(ftl, physical, 0);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+
+    memset(ftl->map, 0xFF, 2 * (uint32_t)ftl->logical_count);
+    memset(ftl->used, 0, MX25Series_FTL_BITMAP_SIZE((uint32_t)ftl->physical_count));
+    memset(ftl->dirty, 0, MX25Series_FTL_BITMAP_SIZE((uint32_t)ftl->physical_count));
+    ftl->sequence = 0;
+    ftl->pool_count = 0;
+    ftl->worn_valid = false;
+    ftl->checkpoint_sequence = 0;
+    ftl->checkpoint_current = false;
+    return MX25Series_ftl_checkpoint(ftl);
+}
+
+MX25Series_status_enum_t MX25Series_ftl_mount(MX25Series_FTL_t *ftl)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    bool loaded = false;
+
+    ftl->pool_count = 0;
+    ftl->worn_valid = false;
+    ftl->refill_cursor = 0;
+    ftl->collect_cursor = 0;
+    ftl->wear.cursor = 0;
+    ftl->wear.coldest_count = 0xFFFFFFFFul;
+    ftl->wear.hottest_count = 0;
+
+    result = MX25Series__ftl_load_checkpoint(ftl, &loaded);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    ftl->mounted_from_checkpoint = loaded;
+    if(loaded)
+    {
+        return MX25Series_status_ok;
+    }
+    return MX25Series__ftl_scan(ftl);
+}
+
+MX25Series_status_enum_t MX25Series_ftl_checkpoint(MX25Series_FTL_t *ftl)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t bitmap_size = MX25Series_FTL_BITMAP_SIZE((uint32_t)ftl->physical_count);
+    uint8_t copy = ftl->checkpoint_sequence == 0 ? 0 : ftl->checkpoint_copy ^ 1;
+    uint32_t memory_address = MX25Series__ftl_checkpoint_address(ftl, copy);
+    uint8_t header[16];
+    uint8_t sequence[4];
+    uint32_t crc;
+
+    result = MX25Series_erase_range(ftl->dev, memory_address, ftl->checkpoint_sectors * MX25Series_SECTOR_SIZE);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    MX25Series__ftl_put32(sequence, ftl->sequence);
+    crc = MX25Series_crc32(0, sequence, sizeof(sequence));
+    crc = MX25Series_crc32(crc, (uint8_t*)ftl->map, 2 * (uint32_t)ftl->logical_count);
+    crc = MX25Series_crc32(crc, ftl->used, bitmap_size);
+    crc = MX25Series_crc32(crc, ftl->dirty, bitmap_size);
+
+    memory_address += MX25Series_FTL_CHECKPOINT_HEADER_SIZE;
+    result = MX25Series_write_stored_data_paged(ftl->dev, memory_address, sizeof(sequence), sequence);
+    memory_address += sizeof(sequence);
+    result |= MX25Series_write_stored_data_paged(ftl->dev, memory_address, 2 * (uint32_t)ftl->logical_count, (uint8_t*)ftl->map);
+    memory_address += 2 * (uint32_t)ftl->logical_count;
+    result |= MX25Series_write_stored_data_paged(ftl->dev, memory_address, bitmap_size, ftl->used);
+    memory_address += bitmap_size;
+    result |= MX25Series_write_stored_data_paged(ftl->dev, memory_address, bitmap_size, ftl->dirty);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    //The header goes last, a checkpoint without one is ignored.
+    MX25Series__ftl_put32(header, MX25Series_FTL_CHECKPOINT_MAGIC);
+    MX25Series__ftl_put32(header + 4, ftl->checkpoint_sequence + 1);
+    MX25Series__ftl_put32(header + 8, MX25Series__ftl_checkpoint_length(ftl));
+    MX25Series__ftl_put32(header + 12, crc);
+    result = MX25Series_write_stored_data_paged(ftl->dev, MX25Series__ftl_checkpoint_address(ftl, copy), sizeof(header), header);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    ftl->checkpoint_copy = copy;
+    ftl->checkpoint_sequence++;
+    ftl->checkpoint_current = true;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_ftl_read(
+        MX25Series_FTL_t *ftl,
+        uint16_t logical,
+        uint32_t offset,
+        size_t length,
+        uint8_t *buffer)
+{
+    if(logical >= ftl->logical_count || offset > MX25Series_FTL_SECTOR_SIZE || length > MX25Series_FTL_SECTOR_SIZE - offset ||
+       (length > 0 && buffer == NULL))
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    if(ftl->map[logical] == MX25Series_FTL_UNMAPPED)
+    {
+        memset(buffer, 0xFF, length);
+        return MX25Series_status_ok;
+    }
+    return MX25Series__ftl_read(ftl, MX25Series__ftl_address(ftl, ftl->map[logical]) + MX25Series_FTL_HEADER_SIZE + offset,
+                                length, buffer);
+}
+
+MX25Series_status_enum_t MX25Series_ftl_write(
+        MX25Series_FTL_t *ftl,
+        uint16_t logical,
+        uint32_t offset,
+        size_t length,
+        uint8_t *buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint16_t physical;
+
+    if(logical >= ftl->logical_count || offset > MX25Series_FTL_SECTOR_SIZE || length > MX25Series_FTL_SECTOR_SIZE - offset ||
+       (length > 0 && buffer == NULL))
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    result = MX25Series__ftl_mark_stale(ftl);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    result = MX25Series__ftl_allocate(ftl, false, &physical);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    result = MX25Series__ftl_place(ftl, logical, physical, offset, length, buffer);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        //The sector is partly written, it has to be erased before it is used again.
+        MX25Series__ftl_set(ftl->dirty, physical, true);
+        return result;
+    }
+
+    return MX25Series__ftl_wear_step(ftl);
+}
+
+MX25Series_status_enum_t MX25Series_ftl_collect(MX25Series_FTL_t *ftl, uint16_t max_sectors)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint16_t visited;
+
+    //Turning a dirty sector clean leaves the checkpoint usable, it just erases the sector again.
+    for(visited = 0; visited < ftl->physical_count && max_sectors > 0; visited++)
+    {
+        uint16_t physical = ftl->collect_cursor;
+
+        ftl->collect_cursor = (ftl->collect_cursor + 1) % ftl->physical_count;
+        if(!MX25Series__ftl_test(ftl->dirty, physical))
+        {
+            continue;
+        }
+
+        result = MX25Series__ftl_erase(ftl, physical);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        max_sectors--;
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_ftl_read_erase_count(MX25Series_FTL_t *ftl, uint16_t physical, uint32_t *erase_count)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    bool valid = false;
+
+    if(physical >= ftl->physical_count)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    result = MX25Series__ftl_read_erase_record(ftl, physical, &valid, erase_count);
+    if(!valid)
+    {
+        *erase_count = 0;
+    }
+    return result;
+}
@@ -0,0 +1,215 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#ifndef FLASH_MX25Series_FTL_H
+#define FLASH_MX25Series_FTL_H
+
+#include "MX25Series.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define MX25Series_FTL_MAGIC 0x5446584Dul            /**! "MXFT", the first word of every data sector */
+#define MX25Series_FTL_CHECKPOINT_MAGIC 0x5043584Dul /**! "MXCP", the first word of a checkpoint */
+#define MX25Series_FTL_HEADER_SIZE 32                /**! Erase record, allocation record and commit flag of a data sector */
+#define MX25Series_FTL_SECTOR_SIZE (MX25Series_SECTOR_SIZE - MX25Series_FTL_HEADER_SIZE) /**! Bytes in a logical sector */
+#define MX25Series_FTL_UNMAPPED 0xFFFF               /**! Map entry of a logical sector that has never been written */
+#define MX25Series_FTL_BITMAP_SIZE(SECTORS) (((SECTORS) + 7) / 8) /**! Bytes in a bitmap of SECTORS physical sectors */
+
+#ifndef MX25Series_FTL_POOL_SIZE
+    #define MX25Series_FTL_POOL_SIZE 8          /**! Clean sectors with the lowest erase counts kept ready for writes */
+#endif
+
+#ifndef MX25Series_FTL_REFILL_SCAN
+    #define MX25Series_FTL_REFILL_SCAN 64       /**! Most clean sectors whose erase counts are read to refill the pool */
+#endif
+
+#ifndef MX25Series_FTL_STATIC_SCAN
+    #define MX25Series_FTL_STATIC_SCAN 2        /**! Mapped sectors whose erase counts are read per write for static wear leveling */
+#endif
+
+#ifndef MX25Series_FTL_WEAR_THRESHOLD
+    #define MX25Series_FTL_WEAR_THRESHOLD 256   /**! Erase count spread at which cold data is moved off a young sector */
+#endif
+
+/**
+ * @brief A clean sector and its erase count.
+ */
+typedef struct
+{
+    uint16_t physical;
+    uint32_t erase_count;
+} MX25Series_FTL_Pool_Entry_t;
+
+/**
+ * @brief A wear leveling flash translation layer over a 4 KB aligned region.
+ * Two copies of a checkpoint come first, then the physical sectors. Every physical sector starts with a header
+ * holding its erase count, written straight after it is erased, and the logical sector and write sequence it
+ * holds, written before the data and committed after it. Writes go out of place to the clean sector with the
+ * lowest erase count seen (dynamic wear leveling), the sector they replace is erased later, and a sweep over the
+ * mapped sectors moves cold data off young sectors once the erase count spread passes MX25Series_FTL_WEAR_THRESHOLD
+ * (static wear leveling). Erase counts are only kept in flash, so the RAM used is the caller supplied map and
+ * bitmaps plus this structure.
+ */
+typedef struct
+{
+    MX25Series_t *dev;
+    uint32_t base;                  /**! First address of the region, the checkpoint copies */
+    uint32_t data_base;             /**! Address of physical sector 0 */
+    uint16_t physical_count;
+    uint16_t logical_count;
+    uint16_t checkpoint_sectors;    /**! Sectors in one checkpoint copy */
+    uint16_t *map;                  /**! Physical sector of each logical sector, MX25Series_FTL_UNMAPPED if never written */
+    uint8_t *used;                  /**! Bitmap of physical sectors holding a mapped logical sector */
+    uint8_t *dirty;                 /**! Bitmap of physical sectors waiting to be erased */
+    uint8_t *page_buffer;           /**! One page used to assemble and copy data */
+    uint32_t sequence;              /**! Sequence of the next write, decides between two copies of a logical sector */
+    MX25Series_FTL_Pool_Entry_t pool[MX25Series_FTL_POOL_SIZE]; /**! Lowest erase count first */
+    uint8_t pool_count;
+    MX25Series_FTL_Pool_Entry_t worn;   /**! The most worn clean sector seen by the last refill, destination of cold data */
+    bool worn_valid;
+    uint16_t refill_cursor;
+    uint16_t collect_cursor;
+    struct{
+        uint16_t cursor;
+        uint16_t coldest;
+        uint32_t coldest_count;
+        uint32_t hottest_count;
+        uint32_t relocations;       /**! Cold sectors moved by static wear leveling */
+    }wear;
+    uint8_t checkpoint_copy;        /**! Copy holding the newest checkpoint */
+    uint32_t checkpoint_sequence;   /**! Sequence of the newest checkpoint, 0 if there is none */
+    bool checkpoint_current;        /**! The newest checkpoint matches the map, its stale flag is still clear */
+    bool mounted_from_checkpoint;   /**! The last mount loaded the checkpoint instead of scanning */
+} MX25Series_FTL_t;
+
+/**
+ * MX25Series_ftl_init describes the FTL region and its RAM, MX25Series_ftl_format or MX25Series_ftl_mount must follow.
+ * @param ftl the FTL structure to initialise.
+ * @param dev the device structure for the MX25Series chip.
+ * @param memory_address the 4 KB aligned start of the region.
+ * @param length the size of the region, a multiple of 4 KB.
+ * @param logical_count the number of logical sectors, the physical sectors left after the checkpoints must
+ * number at least one more.
+ * @param map logical_count entries.
+ * @param used MX25Series_FTL_BITMAP_SIZE(physical sectors) bytes, at most MX25Series_FTL_BITMAP_SIZE(length / 4 KB).
+ * @param dirty the same size as used.
+ * @param page_buffer chip_def->page_size bytes.
+ * @return MX25Series_status_error_invalid_argument if the region cannot hold logical_count sectors.
+ */
+MX25Series_status_enum_t MX25Series_ftl_init(
+        MX25Series_FTL_t *ftl,
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        uint32_t length,
+        uint16_t logical_count,
+        uint16_t *map,
+        uint8_t *used,
+        uint8_t *dirty,
+        uint8_t *page_buffer);
+
+/**
+ * MX25Series_ftl_format erases the region, resetting every erase count, and writes an empty checkpoint.
+ * @param ftl the FTL structure.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_ftl_format(MX25Series_FTL_t *ftl);
+
+/**
+ * MX25Series_ftl_mount loads the newest checkpoint if nothing has been written since it was taken, otherwise
+ * rebuilds the map from the header of every physical sector, keeping the newest committed copy of each logical
+ * sector and queueing the rest for erasure.
+ * @param ftl the FTL structure.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_ftl_mount(MX25Series_FTL_t *ftl);
+
+/**
+ * MX25Series_ftl_checkpoint saves the map so the next mount does not have to scan, call it before powering down.
+ * The first write after a checkpoint marks it stale.
+ * @param ftl the FTL structure.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_ftl_checkpoint(MX25Series_FTL_t *ftl);
+
+/**
+ * MX25Series_ftl_read reads from a logical sector, a sector that has never been written reads as 0xFF.
+ * @param ftl the FTL structure.
+ * @param logical the logical sector.
+ * @param offset the first byte to read, below MX25Series_FTL_SECTOR_SIZE.
+ * @param length the number of bytes to read.
+ * @param buffer where to store the data.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_ftl_read(
+        MX25Series_FTL_t *ftl,
+        uint16_t logical,
+        uint32_t offset,
+        size_t length,
+        uint8_t *buffer);
+
+/**
+ * MX25Series_ftl_write replaces part of a logical sector. The sector is written to a clean physical sector with
+ * the rest copied from its current one, and only takes the new place once all of it is programmed, so a power loss
+ * leaves either the old or the new contents. No erase is waited for unless there is no clean sector left.
+ * @param ftl the FTL structure.
+ * @param logical the logical sector.
+ * @param offset the first byte to write, below MX25Series_FTL_SECTOR_SIZE.
+ * @param length the number of bytes to write.
+ * @param buffer the data to write.
+ * @return MX25Series_status_error_busy if no physical sector can be freed.
+ */
+MX25Series_status_enum_t MX25Series_ftl_write(
+        MX25Series_FTL_t *ftl,
+        uint16_t logical,
+        uint32_t offset,
+        size_t length,
+        uint8_t *buffer);
+
+/**
+ * MX25Series_ftl_collect erases up to max_sectors replaced sectors, call it when the application is idle to keep
+ * erases out of later writes.
+ * @param ftl the FTL structure.
+ * @param max_sectors the most sectors to erase.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_ftl_collect(MX25Series_FTL_t *ftl, uint16_t max_sectors);
+
+/**
+ * MX25Series_ftl_read_erase_count reads the erase count a physical sector has recorded.
+ * @param ftl the FTL structure.
+ * @param physical the physical sector.
+ * @param erase_count set to the erase count, 0 if the sector has none recorded.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_ftl_read_erase_count(MX25Series_FTL_t *ftl, uint16_t physical, uint32_t *erase_count);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_FTL_H
@@ -0,0 +1,265 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#include "MX25Series_Image.h"
+#include "MX25Series_Verify.h"
+
+static uint32_t MX25Series__image_limit(MX25Series_Image_t *image)
+{
+    return (image->length + MX25Series_SECTOR_SIZE - 1) & ~(uint32_t)(MX25Series_SECTOR_SIZE - 1);
+}
+
+static MX25Series_status_enum_t MX25Series__image_fail(MX25Series_Image_t *image, MX25Series_status_enum_t result)
+{
+    image->state = MX25Series_Image_State_Failed;
+    image->result = result;
+    return result;
+}
+
+static void MX25Series__image_complete(MX25Series_Image_t *image)
+{
+    if(image->programming)
+    {
+        image->programmed += image->step;
+    }
+    else
+    {
+        image->erased += image->step;
+    }
+    image->state = MX25Series_Image_State_Idle;
+}
+
+/**
+ * MX25Series__image_start sends the next program, or failing that the next erase ahead of the data.
+ */
+static MX25Series_status_enum_t MX25Series__image_start(MX25Series_Image_t *image)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_t *dev = image->dev;
+    uint32_t page_size = dev->chip_def->page_size;
+    uint32_t limit = MX25Series__image_limit(image);
+    uint32_t chunk = image->length - image->programmed < page_size ? image->length - image->programmed : page_size;
+
+    if(image->programmed < image->length && image->received - image->programmed >= chunk &&
+       image->programmed + chunk <= image->erased)
+    {
+        image->step = chunk;
+        image->programming = true;
+        result = MX25Series_set_write_enable(dev, true);
+        result |= MX25Series_write_stored_data(dev, image->base + image->programmed, chunk,
+                                               image->buffer + (image->programmed % image->buffer_size));
+    }
+    else if(image->erased < limit)
+    {
+        MX25Series_Erase_enum_t erase_type = MX25Series_next_erase_step(dev, image->base + image->erased, limit - image->erased);
+        if(erase_type == MX25Series_Erase_Undefined)
+        {
+            return MX25Series__image_fail(image, MX25Series_status_error_invalid_argument);
+        }
+        image->step = MX25Series_get_erasure_size(dev, erase_type);
+        image->programming = false;
+        result = MX25Series_set_write_enable(dev, true);
+        result |= MX25Series_erase(dev, erase_type, image->base + image->erased);
+    }
+    else
+    {
+        return MX25Series_status_ok;
+    }
+
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return MX25Series__image_fail(image, result);
+    }
+    image->state = MX25Series_Image_State_Busy;
+    image->last_poll = dev->busy_start;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_image_begin(
+        MX25Series_Image_t *image,
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        uint32_t length,
+        uint8_t *buffer,
+        uint32_t buffer_size,
+        MX25Series_CRC_enum_t crc_type)
+{
+    memset(image, 0, sizeof(MX25Series_Image_t));
+
+    if(dev->chip_def == NULL || dev->chip_def->page_size == 0)
+    {
+        return MX25Series_status_error_invalid_chip_def;
+    }
+
+    if(buffer == NULL || buffer_size < 2 * dev->chip_def->page_size || (buffer_size % dev->chip_def->page_size) != 0 ||
+       (memory_address % MX25Series_SECTOR_SIZE) != 0 || memory_address > dev->chip_def->memory_size ||
+       length > dev->chip_def->memory_size - memory_address)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    image->dev = dev;
+    image->base = memory_address;
+    image->length = length;
+    image->buffer = buffer;
+    image->buffer_size = buffer_size;
+    image->crc_type = crc_type;
+    image->result = MX25Series_status_ok;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_image_write(
+        MX25Series_Image_t *image,
+        const uint8_t *data,
+        size_t length,
+        size_t *accepted)
+{
+    size_t free_space = image->buffer_size - (image->received - image->programmed);
+
+    *accepted = 0;
+    if(length > image->length - image->received)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    if(length > free_space)
+    {
+        length = free_space;
+    }
+
+    image->crc = MX25Series_crc(image->crc_type, image->crc, data, length);
+    *accepted = length;
+
+    //The ring is a whole number of pages, so a page is always contiguous.
+    while(length > 0)
+    {
+        uint32_t offset = image->received % image->buffer_size;
+        size_t step = image->buffer_size - offset < length ? image->buffer_size - offset : length;
+
+        memcpy(image->buffer + offset, data, step);
+        image->received += step;
+        data += step;
+        length -= step;
+    }
+
+    return MX25Series_image_tick(image);
+}
+
+MX25Series_status_enum_t MX25Series_image_tick(MX25Series_Image_t *image)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_t *dev = image->dev;
+
+    if(image->state == MX25Series_Image_State_Failed)
+    {
+        return image->result;
+    }
+
+    if(image->state == MX25Series_Image_State_Busy)
+    {
+        uint32_t now = MX25Series___get_micro_seconds(dev);
+        uint32_t estimate = MX25Series_get_operation_typical_time(dev, dev->busy_operation);
+        bool busy = true;
+
+        //Leave the bus alone for most of the typical time, then poll no faster than MX25Series_WIP_POLL_INTERVAL.
+        if(now - dev->busy_start < estimate - estimate / 8 || now - image->last_poll < MX25Series_WIP_POLL_INTERVAL)
+        {
+            return MX25Series_status_ok;
+        }
+
+        image->last_poll = now;
+        result = MX25Series_check_completion(dev, &busy);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return MX25Series__image_fail(image, result);
+        }
+        if(busy)
+        {
+            return MX25Series_status_ok;
+        }
+        MX25Series__image_complete(image);
+    }
+
+    return MX25Series__image_start(image);
+}
+
+MX25Series_status_enum_t MX25Series_image_finish(MX25Series_Image_t *image, uint32_t *crc)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t value = 0;
+    uint32_t offset;
+
+    if(image->received < image->length)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    for(;;)
+    {
+        if(image->state == MX25Series_Image_State_Failed)
+        {
+            return image->result;
+        }
+
+        if(image->state == MX25Series_Image_State_Busy)
+        {
+            result = MX25Series_wait_for_operation(image->dev);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return MX25Series__image_fail(image, result);
+            }
+            MX25Series__image_complete(image);
+        }
+
+        if(image->programmed >= image->length)
+        {
+            break;
+        }
+
+        result = MX25Series__image_start(image);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+
+    //Every byte has been programmed, so the ring is free to read the image back through.
+    for(offset = 0; offset < image->length; offset += image->buffer_size)
+    {
+        uint32_t step = image->length - offset < image->buffer_size ? image->length - offset : image->buffer_size;
+
+        result = MX25Series_read_crc(image->dev, image->crc_type, image->base + offset, step, image->buffer, &value);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+
+    if(crc != NULL)
+    {
+        *crc = value;
+    }
+    return value == image->crc ? MX25Series_status_ok : MX25Series_status_error_verify;
+}
@@ -0,0 +1,129 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#ifndef FLASH_MX25Series_Image_H
+#define FLASH_MX25Series_Image_H
+
+#include "MX25Series.h"
+#include "MX25Series_CRC.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+typedef enum {
+    MX25Series_Image_State_Idle = 0,    /**< The chip is free for the next erase or program */
+    MX25Series_Image_State_Busy = 1,    /**< Waiting for an erase or program to clear WIP */
+    MX25Series_Image_State_Failed = 2,  /**< An operation failed, see result */
+} MX25Series_Image_State_enum_t;
+
+/**
+ * @brief Streams an image into a flash region while it is still being received. The region is erased ahead of
+ * the data with the largest erases that fit, and received pages are programmed from a ring of page buffers, so
+ * the caller keeps receiving while the chip erases or programs.
+ */
+typedef struct
+{
+    MX25Series_t *dev;
+    uint32_t base;                          /**! 4 KB aligned address of the image */
+    uint32_t length;                        /**! Image size in bytes */
+    uint8_t *buffer;                        /**! Ring of buffer_size bytes holding received, unprogrammed data */
+    uint32_t buffer_size;                   /**! A multiple of the page size, at least two pages */
+    uint32_t received;                      /**! Bytes accepted by MX25Series_image_write */
+    uint32_t programmed;                    /**! Bytes programmed */
+    uint32_t erased;                        /**! Bytes erased from base, a multiple of 4 KB */
+    uint32_t step;                          /**! Bytes covered by the erase or program in flight */
+    bool programming;                       /**! The operation in flight is a program rather than an erase */
+    MX25Series_Image_State_enum_t state;
+    MX25Series_status_enum_t result;        /**! Error that stopped the image */
+    uint32_t last_poll;                     /**! MX25Series___get_micro_seconds() of the last Status Register read */
+    MX25Series_CRC_enum_t crc_type;
+    uint32_t crc;                           /**! CRC of the bytes received so far */
+} MX25Series_Image_t;
+
+/**
+ * MX25Series_image_begin starts streaming an image of length bytes to memory_address. The 4 KB sectors covering
+ * the image are erased as the image is written, including the tail of the last sector.
+ * While the image is being written the synchronous functions must not be used on dev.
+ * @param image the image structure to initialise.
+ * @param dev the device structure for the MX25Series chip.
+ * @param memory_address the 4 KB aligned address to write the image to.
+ * @param length the size of the image in bytes.
+ * @param buffer buffer_size bytes of ring buffer.
+ * @param buffer_size a multiple of chip_def->page_size, at least two pages. Larger rings absorb longer erases.
+ * @param crc_type the CRC used to verify the image in MX25Series_image_finish.
+ * @return MX25Series_status_error_invalid_argument if the region or buffer are invalid.
+ */
+MX25Series_status_enum_t MX25Series_image_begin(
+        MX25Series_Image_t *image,
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        uint32_t length,
+        uint8_t *buffer,
+        uint32_t buffer_size,
+        MX25Series_CRC_enum_t crc_type);
+
+/**
+ * MX25Series_image_write copies as much of data as the ring has room for, then calls MX25Series_image_tick. Never
+ * waits for WIP.
+ * @param image the image structure.
+ * @param data the next bytes of the image.
+ * @param length the number of bytes in data.
+ * @param accepted set to the number of bytes taken, the rest must be offered again later.
+ * @return MX25Series_status_error_invalid_argument if data runs past the image length, otherwise the result of
+ * MX25Series_image_tick.
+ */
+MX25Series_status_enum_t MX25Series_image_write(
+        MX25Series_Image_t *image,
+        const uint8_t *data,
+        size_t length,
+        size_t *accepted);
+
+/**
+ * MX25Series_image_tick polls WIP once the operation in flight could plausibly have finished, then starts the next
+ * one: a page program when a whole page has been received and its sector erased, otherwise the next erase ahead of
+ * the data. Call it from the main loop between received chunks.
+ * @param image the image structure.
+ * @return the error that stopped the image, otherwise MX25Series_status_ok.
+ */
+MX25Series_status_enum_t MX25Series_image_tick(MX25Series_Image_t *image);
+
+/**
+ * MX25Series_image_finish waits for every received byte to be programmed, then reads the whole image back in one
+ * streaming pass through the ring buffer and checks its CRC against the CRC of the bytes received.
+ * @param image the image structure.
+ * @param crc set to the CRC of the image as read back, for comparison with the CRC the image was published with.
+ * May be NULL.
+ * @return MX25Series_status_error_invalid_argument if fewer than length bytes were written,
+ * MX25Series_status_error_verify if the image reads back with a different CRC.
+ */
+MX25Series_status_enum_t MX25Series_image_finish(MX25Series_Image_t *image, uint32_t *crc);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_Image_H
@@ -0,0 +1,999 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#include "MX25Series_Journal.h"
+#include "MX25Series_CRC.h"
+
+#define MX25Series_JOURNAL_TRANSACTION 0x54      //'T', the ranges and data of a transaction
+#define MX25Series_JOURNAL_SCRATCH 0x53          //'S', a sector of the transaction copied to the scratch sector
+#define MX25Series_JOURNAL_SCRATCH_SIZE (MX25Series_JOURNAL_RECORD_HEADER_SIZE + 8)
+#define MX25Series_JOURNAL_COMPARE_CHUNK 32
+
+/**
+ * @brief A range of a transaction with its data in the journal.
+ */
+typedef struct
+{
+    uint32_t memory_address;
+    uint32_t length;
+    uint32_t data;              //Address of the range's data in the transaction record
+} MX25Series_Journal_Entry_t;
+
+static void MX25Series__journal_put16(uint8_t *buffer, uint16_t value)
+{
+    buffer[0] = value & 0xFF;
+    buffer[1] = (value >> 8) & 0xFF;
+}
+
+static void MX25Series__journal_put32(uint8_t *buffer, uint32_t value)
+{
+    MX25Series__journal_put16(buffer, value & 0xFFFF);
+    MX25Series__journal_put16(buffer + 2, (value >> 16) & 0xFFFF);
+}
+
+static uint16_t MX25Series__journal_get16(const uint8_t *buffer)
+{
+    return (uint16_t)(buffer[0] | (buffer[1] << 8));
+}
+
+static uint32_t MX25Series__journal_get32(const uint8_t *buffer)
+{
+    return MX25Series__journal_get16(buffer) | ((uint32_t)MX25Series__journal_get16(buffer + 2) << 16);
+}
+
+static MX25Series_status_enum_t MX25Series__journal_read(MX25Series_Journal_t *journal, uint32_t memory_address, size_t length, uint8_t *buffer)
+{
+    return MX25Series_read_stored_data_mode(journal->dev, journal->dev->read_mode, memory_address, length, buffer);
+}
+
+static uint32_t MX25Series__journal_sector(MX25Series_Journal_t *journal, uint32_t index)
+{
+    return journal->base + index * MX25Series_SECTOR_SIZE;
+}
+
+static MX25Series_status_enum_t MX25Series__journal_erase(MX25Series_Journal_t *journal, uint32_t memory_address)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    result = MX25Series_set_write_enable(journal->dev, true);
+    result |= MX25Series_erase(journal->dev, MX25Series_Erase_Block_4K, memory_address);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    return MX25Series_wait_for_operation(journal->dev);
+}
+
+/**
+ * MX25Series__journal_crc continues a CRC-32 over length bytes of flash, read a page at a time.
+ */
+static MX25Series_status_enum_t MX25Series__journal_crc(MX25Series_Journal_t *journal, uint32_t memory_address, uint32_t length, uint32_t *crc)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint32_t page_size = journal->dev->chip_def->page_size;
+
+    while(length > 0)
+    {
+        uint32_t step = length < page_size ? length : page_size;
+
+        result = MX25Series__journal_read(journal, memory_address, step, journal->page_buffer);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        *crc = MX25Series_crc32(*crc, journal->page_buffer, step);
+        memory_address += step;
+        length -= step;
+    }
+    return result;
+}
+
+/**
+ * MX25Series__journal_place moves a record that fits in a page but would straddle two to the next page, so it is
+ * programmed with a single Page Program.
+ */
+static uint32_t MX25Series__journal_place(MX25Series_Journal_t *journal, uint32_t position, uint32_t size)
+{
+    uint32_t page_size = journal->dev->chip_def->page_size;
+
+    if(size <= page_size && position / page_size != (position + size - 1) / page_size)
+    {
+        return position - position % page_size + page_size;
+    }
+    return position;
+}
+
+/**
+ * MX25Series__journal_emit appends bytes to the record being assembled in the page buffer, programming each page
+ * as it fills.
+ */
+static MX25Series_status_enum_t MX25Series__journal_emit(MX25Series_Journal_t *journal, const uint8_t *data, size_t length)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint32_t page_size = journal->dev->chip_def->page_size;
+
+    while(length > 0)
+    {
+        size_t room = page_size - ((journal->emit_address + journal->emit_length) % page_size);
+        size_t step = length < room ? length : room;
+
+        memcpy(journal->page_buffer + journal->emit_length, data, step);
+        journal->emit_length += step;
+        data += step;
+        length -= step;
+
+        if(step == room)
+        {
+            result = MX25Series_write_stored_data_paged(journal->dev, journal->emit_address, journal->emit_length, journal->page_buffer);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+            journal->emit_address += journal->emit_length;
+            journal->emit_length = 0;
+        }
+    }
+    return result;
+}
+
+static MX25Series_status_enum_t MX25Series__journal_emit_flush(MX25Series_Journal_t *journal)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+
+    if(journal->emit_length > 0)
+    {
+        result = MX25Series_write_stored_data_paged(journal->dev, journal->emit_address, journal->emit_length, journal->page_buffer);
+        journal->emit_address += journal->emit_length;
+        journal->emit_length = 0;
+    }
+    return result;
+}
+
+/**
+ * MX25Series__journal_open erases the next journal sector and makes it the head.
+ */
+static MX25Series_status_enum_t MX25Series__journal_open(MX25Series_Journal_t *journal)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t head = (journal->head + 1) % journal->sector_count;
+    uint8_t header[12];
+
+    result = MX25Series__journal_erase(journal, MX25Series__journal_sector(journal, head));
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    MX25Series__journal_put32(header, MX25Series_JOURNAL_MAGIC);
+    MX25Series__journal_put32(header + 4, journal->sequence);
+    MX25Series__journal_put32(header + 8, MX25Series_crc32(0, header, 8));
+    result = MX25Series_write_stored_data_paged(journal->dev, MX25Series__journal_sector(journal, head), sizeof(header), header);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    //Every sector gets its own sequence so the newest is never ambiguous.
+    journal->head = head;
+    journal->position = MX25Series_JOURNAL_SECTOR_HEADER_SIZE;
+    journal->sequence++;
+    return MX25Series_status_ok;
+}
+
+static bool MX25Series__journal_seen(const MX25Series_Journal_Entry_t *entries, uint8_t index, uint32_t sector)
+{
+    uint8_t i;
+
+    for(i = 0; i < index; i++)
+    {
+        uint32_t first = entries[i].memory_address - entries[i].memory_address % MX25Series_SECTOR_SIZE;
+        if(sector >= first && sector < entries[i].memory_address + entries[i].length)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * MX25Series__journal_compare reports whether the sector differs from the transaction and whether reaching it
+ * needs bits set, which only an erase can do.
+ */
+static MX25Series_status_enum_t MX25Series__journal_compare(
+        MX25Series_Journal_t *journal,
+        const MX25Series_Journal_Entry_t *entries,
+        uint8_t count,
+        uint32_t sector,
+        bool *differs,
+        bool *needs_erase)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint8_t current[MX25Series_JOURNAL_COMPARE_CHUNK];
+    uint8_t wanted[MX25Series_JOURNAL_COMPARE_CHUNK];
+    uint8_t i;
+
+    *differs = false;
+    *needs_erase = false;
+    for(i = 0; i < count && !*needs_erase; i++)
+    {
+        uint32_t from = entries[i].memory_address > sector ? entries[i].memory_address : sector;
+        uint32_t to = entries[i].memory_address + entries[i].length;
+
+        if(to > sector + MX25Series_SECTOR_SIZE)
+        {
+            to = sector + MX25Series_SECTOR_SIZE;
+        }
+        while(from < to && !*needs_erase)
+        {
+            uint32_t step = to - from < sizeof(current) ? to - from : sizeof(current);
+            uint32_t k;
+
+            result = MX25Series__journal_read(journal, from, step, current);
+            result |= MX25Series__journal_read(journal, entries[i].data + (from - entries[i].memory_address), step, wanted);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+            for(k = 0; k < step; k++)
+            {
+                *differs |= current[k] != wanted[k];
+                *needs_erase |= (current[k] & wanted[k]) != wanted[k];
+            }
+            from += step;
+        }
+    }
+    return result;
+}
+
+/**
+ * MX25Series__journal_program programs the transaction's bytes in the sector directly, every bit they need is still set.
+ */
+static MX25Series_status_enum_t MX25Series__journal_program(
+        MX25Series_Journal_t *journal,
+        const MX25Series_Journal_Entry_t *entries,
+        uint8_t count,
+        uint32_t sector)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint32_t page_size = journal->dev->chip_def->page_size;
+    uint8_t i;
+
+    for(i = 0; i < count; i++)
+    {
+        uint32_t from = entries[i].memory_address > sector ? entries[i].memory_address : sector;
+        uint32_t to = entries[i].memory_address + entries[i].length;
+
+        if(to > sector + MX25Series_SECTOR_SIZE)
+        {
+            to = sector + MX25Series_SECTOR_SIZE;
+        }
+        while(from < to)
+        {
+            uint32_t step = page_size - from % page_size;
+
+            if(step > to - from)
+            {
+                step = to - from;
+            }
+            result = MX25Series__journal_read(journal, entries[i].data + (from - entries[i].memory_address), step, journal->page_buffer);
+            result |= MX25Series_write_stored_data_paged(journal->dev, from, step, journal->page_buffer);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+            from += step;
+        }
+    }
+    return result;
+}
+
+/**
+ * MX25Series__journal_merge fills the page buffer with a page of the scratch copy overlaid with the transaction.
+ */
+static MX25Series_status_enum_t MX25Series__journal_merge(
+        MX25Series_Journal_t *journal,
+        const MX25Series_Journal_Entry_t *entries,
+        uint8_t count,
+        uint32_t page)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t page_size = journal->dev->chip_def->page_size;
+    uint8_t i;
+
+    result = MX25Series__journal_read(journal, journal->scratch + page % MX25Series_SECTOR_SIZE, page_size, journal->page_buffer);
+    for(i = 0; i < count && !MX25Series_HAS_ERROR(result); i++)
+    {
+        uint32_t from = entries[i].memory_address > page ? entries[i].memory_address : page;
+        uint32_t to = entries[i].memory_address + entries[i].length;
+
+        if(to > page + page_size)
+        {
+            to = page + page_size;
+        }
+        if(from < to)
+        {
+            result = MX25Series__journal_read(journal, entries[i].data + (from - entries[i].memory_address), to - from,
+                                              journal->page_buffer + (from - page));
+        }
+    }
+    return result;
+}
+
+/**
+ * MX25Series__journal_rebuild rewrites the sector from the scratch copy and the transaction, unless it already
+ * holds exactly that.
+ */
+static MX25Series_status_enum_t MX25Series__journal_rebuild(
+        MX25Series_Journal_t *journal,
+        const MX25Series_Journal_Entry_t *entries,
+        uint8_t count,
+        uint32_t sector,
+        bool check)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t page_size = journal->dev->chip_def->page_size;
+    uint8_t current[MX25Series_JOURNAL_COMPARE_CHUNK];
+    uint32_t page;
+
+    //After a power loss the sector may already have been rebuilt, or be half erased.
+    for(page = sector; check && page < sector + MX25Series_SECTOR_SIZE; page += page_size)
+    {
+        uint32_t offset;
+
+        result = MX25Series__journal_merge(journal, entries, count, page);
+        for(offset = 0; offset < page_size && !MX25Series_HAS_ERROR(result); offset += sizeof(current))
+        {
+            uint32_t step = page_size - offset < sizeof(current) ? page_size - offset : sizeof(current);
+
+            result = MX25Series__journal_read(journal, page + offset, step, current);
+            check = memcmp(current, journal->page_buffer + offset, step) == 0;
+            if(!check)
+            {
+                break;
+            }
+        }
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+    if(check)
+    {
+        return MX25Series_status_ok;
+    }
+
+    result = MX25Series__journal_erase(journal, sector);
+    for(page = sector; page < sector + MX25Series_SECTOR_SIZE && !MX25Series_HAS_ERROR(result); page += page_size)
+    {
+        uint32_t k;
+        bool blank = true;
+
+        result = MX25Series__journal_merge(journal, entries, count, page);
+        for(k = 0; k < page_size && blank; k++)
+        {
+            blank = journal->page_buffer[k] == 0xFF;
+        }
+        if(!blank && !MX25Series_HAS_ERROR(result))
+        {
+            result = MX25Series_write_stored_data_paged(journal->dev, page, page_size, journal->page_buffer);
+        }
+    }
+    return result;
+}
+
+/**
+ * MX25Series__journal_relocate copies the record of the transaction being applied to a new journal sector, for a
+ * replay that has no room left for scratch records in the old one.
+ */
+static MX25Series_status_enum_t MX25Series__journal_relocate(MX25Series_Journal_t *journal, MX25Series_Journal_Entry_t *entries, uint8_t count)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t page_size = journal->dev->chip_def->page_size;
+    uint32_t source = journal->transaction;
+    uint32_t destination;
+    uint32_t offset;
+    uint8_t i;
+
+    result = MX25Series__journal_open(journal);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    destination = MX25Series__journal_sector(journal, journal->head) +
+                  MX25Series__journal_place(journal, journal->position, journal->transaction_size);
+    for(offset = 0; offset < journal->transaction_size;)
+    {
+        uint32_t step = page_size - (destination + offset) % page_size;
+
+        if(step > journal->transaction_size - offset)
+        {
+            step = journal->transaction_size - offset;
+        }
+        result = MX25Series__journal_read(journal, source + offset, step, journal->page_buffer);
+        result |= MX25Series_write_stored_data_paged(journal->dev, destination + offset, step, journal->page_buffer);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        offset += step;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        entries[i].data = entries[i].data - source + destination;
+    }
+    journal->transaction = destination;
+    journal->position = destination - MX25Series__journal_sector(journal, journal->head) + journal->transaction_size;
+    return MX25Series_status_ok;
+}
+
+/**
+ * MX25Series__journal_copy copies the sector to the scratch sector and appends a record naming it, after which the
+ * sector can be erased safely.
+ */
+static MX25Series_status_enum_t MX25Series__journal_copy(
+        MX25Series_Journal_t *journal,
+        MX25Series_Journal_Entry_t *entries,
+        uint8_t count,
+        uint32_t sector,
+        uint32_t sequence)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint32_t page_size = journal->dev->chip_def->page_size;
+    uint8_t record[MX25Series_JOURNAL_SCRATCH_SIZE];
+    uint32_t crc = 0;
+    uint32_t offset;
+
+    //Each power loss during a replay can cost another scratch record.
+    if(journal->position >= MX25Series_SECTOR_SIZE ||
+       MX25Series__journal_place(journal, journal->position, sizeof(record)) + sizeof(record) > MX25Series_SECTOR_SIZE)
+    {
+        result = MX25Series__journal_relocate(journal, entries, count);
+    }
+    if(!MX25Series_HAS_ERROR(result))
+    {
+        result = MX25Series__journal_erase(journal, journal->scratch);
+    }
+    for(offset = 0; offset < MX25Series_SECTOR_SIZE && !MX25Series_HAS_ERROR(result); offset += page_size)
+    {
+        uint32_t k;
+        bool blank = true;
+
+        result = MX25Series__journal_read(journal, sector + offset, page_size, journal->page_buffer);
+        crc = MX25Series_crc32(crc, journal->page_buffer, page_size);
+        for(k = 0; k < page_size && blank; k++)
+        {
+            blank = journal->page_buffer[k] == 0xFF;
+        }
+        if(!blank && !MX25Series_HAS_ERROR(result))
+        {
+            result = MX25Series_write_stored_data_paged(journal->dev, journal->scratch + offset, page_size, journal->page_buffer);
+        }
+    }
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    memset(record, 0xFF, sizeof(record));
+    record[0] = MX25Series_JOURNAL_SCRATCH;
+    MX25Series__journal_put16(record + 2, 8);
+    MX25Series__journal_put32(record + 4, sequence);
+    MX25Series__journal_put32(record + 12, sector);
+    MX25Series__journal_put32(record + 16, crc);
+    MX25Series__journal_put32(record + 8, MX25Series_crc32(MX25Series_crc32(0, record, 8), record + 12, 8));
+
+    journal->position = MX25Series__journal_place(journal, journal->position, sizeof(record));
+    result = MX25Series_write_stored_data_paged(journal->dev, MX25Series__journal_sector(journal, journal->head) + journal->position,
+                                                sizeof(record), record);
+    journal->position += sizeof(record);
+    return result;
+}
+
+/**
+ * MX25Series__journal_apply brings every sector the transaction touches up to date, rebuilding scratch_sector
+ * from the scratch copy if a power loss interrupted it.
+ */
+static MX25Series_status_enum_t MX25Series__journal_apply(
+        MX25Series_Journal_t *journal,
+        MX25Series_Journal_Entry_t *entries,
+        uint8_t count,
+        uint32_t sequence,
+        bool scratch_valid,
+        uint32_t scratch_sector)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint8_t i;
+
+    //The interrupted sector first, before another copy reuses the scratch sector.
+    if(scratch_valid)
+    {
+        result = MX25Series__journal_rebuild(journal, entries, count, scratch_sector, true);
+        journal->replayed_sectors++;
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        uint32_t sector;
+
+        for(sector = entries[i].memory_address - entries[i].memory_address % MX25Series_SECTOR_SIZE;
+            sector < entries[i].memory_address + entries[i].length;
+            sector += MX25Series_SECTOR_SIZE)
+        {
+            bool differs = false;
+            bool needs_erase = false;
+
+            if(MX25Series__journal_seen(entries, i, sector) || (scratch_valid && sector == scratch_sector))
+            {
+                continue;
+            }
+
+            result = MX25Series__journal_compare(journal, entries, count, sector, &differs, &needs_erase);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+            if(!differs)
+            {
+                continue;
+            }
+
+            journal->replayed_sectors++;
+            if(needs_erase)
+            {
+                result = MX25Series__journal_copy(journal, entries, count, sector, sequence);
+                if(!MX25Series_HAS_ERROR(result))
+                {
+                    result = MX25Series__journal_rebuild(journal, entries, count, sector, false);
+                }
+            }
+            else
+            {
+                result = MX25Series__journal_program(journal, entries, count, sector);
+            }
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * MX25Series__journal_load reads the range table of a transaction record.
+ */
+static MX25Series_status_enum_t MX25Series__journal_load(
+        MX25Series_Journal_t *journal,
+        uint32_t memory_address,
+        MX25Series_Journal_Entry_t *entries,
+        uint8_t *count)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t table[2 + 6 * MX25Series_JOURNAL_MAX_RANGES];
+    uint32_t data;
+    uint8_t i;
+
+    result = MX25Series__journal_read(journal, memory_address, sizeof(table), table);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    if(MX25Series__journal_get16(table) == 0 || MX25Series__journal_get16(table) > MX25Series_JOURNAL_MAX_RANGES)
+    {
+        return MX25Series_status_error;
+    }
+
+    *count = (uint8_t)MX25Series__journal_get16(table);
+    data = memory_address + 2 + 6 * (uint32_t)*count;
+    for(i = 0; i < *count; i++)
+    {
+        entries[i].memory_address = MX25Series__journal_get32(table + 2 + 6 * i);
+        entries[i].length = MX25Series__journal_get16(table + 6 + 6 * i);
+        entries[i].data = data;
+        data += entries[i].length;
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_journal_init(
+        MX25Series_Journal_t *journal,
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        uint32_t length,
+        uint8_t *page_buffer)
+{
+    memset(journal, 0, sizeof(MX25Series_Journal_t));
+
+    if(dev->chip_def == NULL || dev->chip_def->page_size == 0 || (MX25Series_SECTOR_SIZE % dev->chip_def->page_size) != 0)
+    {
+        return MX25Series_status_error_invalid_chip_def;
+    }
+
+    if(page_buffer == NULL || (memory_address % MX25Series_SECTOR_SIZE) != 0 || (length % MX25Series_SECTOR_SIZE) != 0 ||
+       length < 3 * MX25Series_SECTOR_SIZE || memory_address > dev->chip_def->memory_size ||
+       length > dev->chip_def->memory_size - memory_address)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    journal->dev = dev;
+    journal->scratch = memory_address;
+    journal->base = memory_address + MX25Series_SECTOR_SIZE;
+    journal->sector_count = length / MX25Series_SECTOR_SIZE - 1;
+    journal->page_buffer = page_buffer;
+    journal->head = journal->sector_count - 1;
+    journal->position = MX25Series_SECTOR_SIZE;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_journal_format(MX25Series_Journal_t *journal)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    result = MX25Series_erase_range(journal->dev, journal->scratch, (journal->sector_count + 1) * MX25Series_SECTOR_SIZE);
+    journal->head = journal->sector_count - 1;
+    journal->position = MX25Series_SECTOR_SIZE;
+    journal->sequence = 1;
+    return result;
+}
+
+/**
+ * @brief What MX25Series__journal_scan found in a journal sector.
+ */
+typedef struct
+{
+    uint32_t transaction;       //Address of the last complete transaction record, 0 if there is none
+    uint32_t sequence;          //Sequence of that transaction
+    uint32_t scratch_sector;    //Sector named by the transaction's last scratch record
+    uint32_t scratch_crc;
+    bool scratch_valid;         //A scratch record of the transaction was found
+} MX25Series_Journal_Scan_t;
+
+/**
+ * MX25Series__journal_scan walks the records of journal sector index, leaving journal->position after the last one.
+ */
+static MX25Series_status_enum_t MX25Series__journal_scan(MX25Series_Journal_t *journal, uint32_t index, MX25Series_Journal_Scan_t *scan)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint8_t header[MX25Series_JOURNAL_RECORD_HEADER_SIZE];
+    uint32_t page_size = journal->dev->chip_def->page_size;
+    uint32_t sector_address = MX25Series__journal_sector(journal, index);
+
+    memset(scan, 0, sizeof(MX25Series_Journal_Scan_t));
+    journal->position = MX25Series_JOURNAL_SECTOR_HEADER_SIZE;
+    while(journal->position + MX25Series_JOURNAL_RECORD_HEADER_SIZE <= MX25Series_SECTOR_SIZE)
+    {
+        uint32_t length;
+        uint32_t crc;
+
+        result = MX25Series__journal_read(journal, sector_address + journal->position, sizeof(header), header);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        if(header[0] == 0xFF)
+        {
+            //A record that would have straddled a page starts on the next one.
+            uint32_t next = journal->position - journal->position % page_size + page_size;
+            uint8_t type = 0xFF;
+
+            if(journal->position % page_size != 0 && next < MX25Series_SECTOR_SIZE)
+            {
+                result = MX25Series__journal_read(journal, sector_address + next, 1, &type);
+                if(MX25Series_HAS_ERROR(result))
+                {
+                    return result;
+                }
+            }
+            if(type == 0xFF)
+            {
+                break;
+            }
+            journal->position = next;
+            continue;
+        }
+
+        length = MX25Series__journal_get16(header + 2);
+        crc = MX25Series_crc32(0, header, 8);
+        if(length <= MX25Series_SECTOR_SIZE - journal->position - sizeof(header))
+        {
+            result = MX25Series__journal_crc(journal, sector_address + journal->position + sizeof(header), length, &crc);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+        }
+        if(length > MX25Series_SECTOR_SIZE - journal->position - sizeof(header) || crc != MX25Series__journal_get32(header + 8) ||
+           (header[0] != MX25Series_JOURNAL_TRANSACTION && header[0] != MX25Series_JOURNAL_SCRATCH))
+        {
+            //Torn by a power loss, the next transaction starts a new sector.
+            journal->position = MX25Series_SECTOR_SIZE;
+            break;
+        }
+
+        if(header[0] == MX25Series_JOURNAL_TRANSACTION)
+        {
+            scan->transaction = sector_address + journal->position;
+            journal->transaction_size = sizeof(header) + length;
+            scan->sequence = MX25Series__journal_get32(header + 4);
+            if((int32_t)(scan->sequence + 1 - journal->sequence) > 0)
+            {
+                journal->sequence = scan->sequence + 1;
+            }
+            scan->scratch_valid = false;
+        }
+        else if(scan->transaction != 0 && MX25Series__journal_get32(header + 4) == scan->sequence && length == 8)
+        {
+            uint8_t payload[8];
+
+            result = MX25Series__journal_read(journal, sector_address + journal->position + sizeof(header), sizeof(payload), payload);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+            scan->scratch_sector = MX25Series__journal_get32(payload);
+            scan->scratch_crc = MX25Series__journal_get32(payload + 4);
+            scan->scratch_valid = true;
+        }
+        journal->position += sizeof(header) + length;
+    }
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_journal_mount(MX25Series_Journal_t *journal)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Journal_Entry_t entries[MX25Series_JOURNAL_MAX_RANGES];
+    MX25Series_Journal_Scan_t scan;
+    uint8_t header[MX25Series_JOURNAL_RECORD_HEADER_SIZE];
+    uint32_t previous = 0;
+    uint32_t previous_sequence = 0;
+    bool found = false;
+    bool found_previous = false;
+    uint32_t i;
+    uint8_t count = 0;
+
+    journal->head = journal->sector_count - 1;
+    journal->position = MX25Series_SECTOR_SIZE;
+    journal->sequence = 1;
+    journal->replayed_sectors = 0;
+
+    //The newest journal sector is the only one that can hold an unfinished transaction, unless the sector opened
+    //for it lost the power before the record was complete, then it is still in the one before.
+    for(i = 0; i < journal->sector_count; i++)
+    {
+        uint32_t sequence;
+
+        result = MX25Series__journal_read(journal, MX25Series__journal_sector(journal, i), sizeof(header), header);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        if(MX25Series__journal_get32(header) != MX25Series_JOURNAL_MAGIC ||
+           MX25Series__journal_get32(header + 8) != MX25Series_crc32(0, header, 8))
+        {
+            continue;
+        }
+        sequence = MX25Series__journal_get32(header + 4);
+        if(!found || (int32_t)(sequence + 1 - journal->sequence) > 0)
+        {
+            if(found)
+            {
+                previous = journal->head;
+                previous_sequence = journal->sequence - 1;
+                found_previous = true;
+            }
+            journal->head = i;
+            journal->sequence = sequence + 1;
+            found = true;
+        }
+        else if(!found_previous || (int32_t)(sequence - previous_sequence) > 0)
+        {
+            previous = i;
+            previous_sequence = sequence;
+            found_previous = true;
+        }
+    }
+    if(!found)
+    {
+        return MX25Series_status_ok;
+    }
+
+    result = MX25Series__journal_scan(journal, journal->head, &scan);
+    if(!MX25Series_HAS_ERROR(result) && scan.transaction == 0 && found_previous)
+    {
+        //The empty newest sector is reused by the next transaction.
+        journal->head = previous;
+        result = MX25Series__journal_scan(journal, journal->head, &scan);
+        journal->position = MX25Series_SECTOR_SIZE;
+    }
+    if(MX25Series_HAS_ERROR(result) || scan.transaction == 0)
+    {
+        return result;
+    }
+
+    //The copy is only trusted if all of it made it to the scratch sector.
+    if(scan.scratch_valid)
+    {
+        uint32_t crc = 0;
+
+        result = MX25Series__journal_crc(journal, journal->scratch, MX25Series_SECTOR_SIZE, &crc);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        scan.scratch_valid = crc == scan.scratch_crc;
+    }
+
+    journal->transaction = scan.transaction;
+    result = MX25Series__journal_load(journal, scan.transaction + sizeof(header), entries, &count);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    return MX25Series__journal_apply(journal, entries, count, scan.sequence, scan.scratch_valid, scan.scratch_sector);
+}
+
+MX25Series_status_enum_t MX25Series_journal_write(
+        MX25Series_Journal_t *journal,
+        const MX25Series_Journal_Range_t *ranges,
+        uint8_t count)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Journal_Entry_t entries[MX25Series_JOURNAL_MAX_RANGES];
+    uint32_t region_end = journal->base + journal->sector_count * MX25Series_SECTOR_SIZE;
+    uint8_t header[MX25Series_JOURNAL_RECORD_HEADER_SIZE];
+    uint8_t table[6];
+    uint32_t size = MX25Series_JOURNAL_RECORD_HEADER_SIZE + 2 + 6 * (uint32_t)count;
+    uint32_t sectors = 0;
+    uint32_t position;
+    uint32_t data;
+    uint32_t crc;
+    uint8_t i;
+    uint8_t j;
+
+    if(ranges == NULL || count == 0 || count > MX25Series_JOURNAL_MAX_RANGES)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        uint32_t start = ranges[i].memory_address;
+        uint32_t end = start + ranges[i].length;
+
+        if(ranges[i].buffer == NULL || ranges[i].length == 0 || ranges[i].length > 0xFFFF ||
+           start > journal->dev->chip_def->memory_size || ranges[i].length > journal->dev->chip_def->memory_size - start ||
+           (start < region_end && end > journal->scratch))
+        {
+            return MX25Series_status_error_invalid_argument;
+        }
+        for(j = 0; j < i; j++)
+        {
+            if(start < ranges[j].memory_address + ranges[j].length && end > ranges[j].memory_address)
+            {
+                return MX25Series_status_error_invalid_argument;
+            }
+        }
+        size += ranges[i].length;
+        entries[i].memory_address = start;
+        entries[i].length = ranges[i].length;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        uint32_t sector;
+
+        for(sector = entries[i].memory_address - entries[i].memory_address % MX25Series_SECTOR_SIZE;
+            sector < entries[i].memory_address + entries[i].length;
+            sector += MX25Series_SECTOR_SIZE)
+        {
+            sectors += MX25Series__journal_seen(entries, i, sector) ? 0 : 1;
+        }
+    }
+
+    //The transaction and a scratch record per sector it touches, each possibly moved to a page boundary, share a sector.
+    if(MX25Series__journal_place(journal, MX25Series_JOURNAL_SECTOR_HEADER_SIZE, size) + size + 2 * sectors * MX25Series_JOURNAL_SCRATCH_SIZE >
+       MX25Series_SECTOR_SIZE)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    position = journal->position < MX25Series_SECTOR_SIZE ? MX25Series__journal_place(journal, journal->position, size) : MX25Series_SECTOR_SIZE;
+    if(position + size + 2 * sectors * MX25Series_JOURNAL_SCRATCH_SIZE > MX25Series_SECTOR_SIZE)
+    {
+        result = MX25Series__journal_open(journal);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        position = MX25Series__journal_place(journal, journal->position, size);
+    }
+
+    //Header, range table and data are covered by one CRC, a record torn by a power loss is dropped at mount.
+    memset(header, 0xFF, sizeof(header));
+    header[0] = MX25Series_JOURNAL_TRANSACTION;
+    MX25Series__journal_put16(header + 2, (uint16_t)(size - MX25Series_JOURNAL_RECORD_HEADER_SIZE));
+    MX25Series__journal_put32(header + 4, journal->sequence);
+    MX25Series__journal_put16(table, count);
+    crc = MX25Series_crc32(MX25Series_crc32(0, header, 8), table, 2);
+    for(i = 0; i < count; i++)
+    {
+        MX25Series__journal_put32(table, ranges[i].memory_address);
+        MX25Series__journal_put16(table + 4, (uint16_t)ranges[i].length);
+        crc = MX25Series_crc32(crc, table, 6);
+    }
+    for(i = 0; i < count; i++)
+    {
+        crc = MX25Series_crc32(crc, ranges[i].buffer, ranges[i].length);
+    }
+    MX25Series__journal_put32(header + 8, crc);
+
+    journal->emit_address = MX25Series__journal_sector(journal, journal->head) + position;
+    journal->emit_length = 0;
+    MX25Series__journal_put16(table, count);
+    result = MX25Series__journal_emit(journal, header, sizeof(header));
+    result |= MX25Series__journal_emit(journal, table, 2);
+    for(i = 0; i < count && !MX25Series_HAS_ERROR(result); i++)
+    {
+        MX25Series__journal_put32(table, ranges[i].memory_address);
+        MX25Series__journal_put16(table + 4, (uint16_t)ranges[i].length);
+        result = MX25Series__journal_emit(journal, table, 6);
+    }
+    for(i = 0; i < count && !MX25Series_HAS_ERROR(result); i++)
+    {
+        result = MX25Series__journal_emit(journal, ranges[i].buffer, ranges[i].length);
+    }
+    if(!MX25Series_HAS_ERROR(result))
+    {
+        result = MX25Series__journal_emit_flush(journal);
+    }
+    if(MX25Series_HAS_ERROR(result))
+    {
+        journal->position = MX25Series_SECTOR_SIZE;
+        return result;
+    }
+    journal->position = position + size;
+    journal->transaction = MX25Series__journal_sector(journal, journal->head) + position;
+    journal->transaction_size = size;
+
+    data = MX25Series__journal_sector(journal, journal->head) + position + size;
+    for(i = count; i > 0; i--)
+    {
+        data -= entries[i - 1].length;
+        entries[i - 1].data = data;
+    }
+
+    result = MX25Series__journal_apply(journal, entries, count, journal->sequence, false, 0);
+    journal->sequence++;
+    return result;
+}
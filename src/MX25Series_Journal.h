@@ -0,0 +1,133 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#ifndef FLASH_MX25Series_Journal_H
+#define FLASH_MX25Series_Journal_H
+
+#include "MX25Series.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define MX25Series_JOURNAL_MAGIC 0x4E4A584Dul        /**! "MXJN", the first word of every journal sector */
+#define MX25Series_JOURNAL_SECTOR_HEADER_SIZE 16     /**! Magic, sequence and CRC-32, padded */
+#define MX25Series_JOURNAL_RECORD_HEADER_SIZE 12     /**! Type, length, sequence and CRC-32 of the header and payload */
+
+#ifndef MX25Series_JOURNAL_MAX_RANGES
+    #define MX25Series_JOURNAL_MAX_RANGES 8     /**! Most ranges in one transaction, bounds the stack used to apply it */
+#endif
+
+/**
+ * @brief One range of a transaction.
+ */
+typedef struct
+{
+    uint32_t memory_address;
+    size_t length;              /**! At most 0xFFFF bytes */
+    uint8_t *buffer;
+} MX25Series_Journal_Range_t;
+
+/**
+ * @brief A redo journal that makes a write of several ranges atomic.
+ * The region holds a scratch sector followed by a ring of journal sectors. A transaction is committed by appending
+ * one record holding every range and its data, placed so that it does not straddle a page when it fits in one,
+ * and is then applied in place. A sector whose new contents only clear bits is programmed directly, so a small
+ * transaction costs one extra Page Program. A sector that needs an erase is first copied to the scratch sector and
+ * a record naming it is appended, then it is erased and rebuilt from the copy and the journal. MX25Series_journal_mount
+ * reads the journal sector headers and the newest sector's records, then applies the last transaction again,
+ * skipping whatever already matches, so replay is bounded by one sector of records and one transaction.
+ */
+typedef struct
+{
+    MX25Series_t *dev;
+    uint32_t scratch;           /**! Address of the scratch sector, the first sector of the region */
+    uint32_t base;              /**! Address of journal sector 0 */
+    uint32_t sector_count;      /**! Journal sectors, not counting the scratch sector */
+    uint32_t head;              /**! Journal sector records are appended to */
+    uint32_t position;          /**! Offset of the next record in the head sector, MX25Series_SECTOR_SIZE when it is closed */
+    uint32_t sequence;          /**! Sequence of the next transaction */
+    uint8_t *page_buffer;       /**! One page used to assemble records and copy sectors */
+    uint32_t emit_address;      /**! Address of page_buffer[0] while a record is being assembled */
+    size_t emit_length;
+    uint32_t transaction;       /**! Address of the record of the transaction being applied */
+    uint32_t transaction_size;
+    uint32_t replayed_sectors;  /**! Sectors the last mount brought up to date or checked against the scratch copy */
+} MX25Series_Journal_t;
+
+/**
+ * MX25Series_journal_init describes the journal region, MX25Series_journal_format or MX25Series_journal_mount must follow.
+ * @param journal the journal structure to initialise.
+ * @param dev the device structure for the MX25Series chip.
+ * @param memory_address the 4 KB aligned start of the region.
+ * @param length the size of the region, a multiple of 4 KB of at least three sectors.
+ * @param page_buffer chip_def->page_size bytes.
+ * @return MX25Series_status_error_invalid_argument if the region is invalid.
+ */
+MX25Series_status_enum_t MX25Series_journal_init(
+        MX25Series_Journal_t *journal,
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        uint32_t length,
+        uint8_t *page_buffer);
+
+/**
+ * MX25Series_journal_format erases the region, leaving an empty journal.
+ * @param journal the journal structure.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_journal_format(MX25Series_Journal_t *journal);
+
+/**
+ * MX25Series_journal_mount finds the newest journal sector and finishes applying the last transaction in it, so a
+ * transaction interrupted by a power loss is either completed or, if its record was not fully programmed, dropped.
+ * A newest sector that lost the power before its first record was complete is passed over for the one before it.
+ * Ranges written through the journal must only be written through it, or replay would undo the other writes.
+ * @param journal the journal structure.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_journal_mount(MX25Series_Journal_t *journal);
+
+/**
+ * MX25Series_journal_write writes every range or, after a power loss and MX25Series_journal_mount, none of them.
+ * The ranges may be anywhere outside the journal region but must not overlap each other, and the transaction
+ * record, 14 bytes plus 6 per range plus the data, must fit in a journal sector along with one scratch record for
+ * each sector touched.
+ * @param journal the journal structure.
+ * @param ranges the ranges to write.
+ * @param count between 1 and MX25Series_JOURNAL_MAX_RANGES.
+ * @return MX25Series_status_error_invalid_argument if the ranges overlap or the transaction is too large.
+ */
+MX25Series_status_enum_t MX25Series_journal_write(
+        MX25Series_Journal_t *journal,
+        const MX25Series_Journal_Range_t *ranges,
+        uint8_t count);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_Journal_H
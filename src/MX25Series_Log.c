@@ -0,0 +1,621 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#include "MX25Series_Log.h"
+#include "MX25Series_CRC.h"
+
+static void MX25Series__log_put16(uint8_t *buffer, uint16_t value)
+{
+    buffer[0] = value & 0xFF;
+    buffer[1] = (value >> 8) & 0xFF;
+}
+
+static void MX25Series__log_put32(uint8_t *buffer, uint32_t value)
+{
+    MX25Series__log_put16(buffer, value & 0xFFFF);
+    MX25Series__log_put16(buffer + 2, (value >> 16) & 0xFFFF);
+}
+
+static uint16_t MX25Series__log_get16(const uint8_t *buffer)
+{
+    return (uint16_t)(buffer[0] | (buffer[1] << 8));
+}
+
+static uint32_t MX25Series__log_get32(const uint8_t *buffer)
+{
+    return MX25Series__log_get16(buffer) | ((uint32_t)MX25Series__log_get16(buffer + 2) << 16);
+}
+
+static uint32_t MX25Series__log_sector_address(MX25Series_Log_t *log, uint32_t sequence)
+{
+    return log->base + (sequence % log->sector_count) * MX25Series_SECTOR_SIZE;
+}
+
+/**
+ * MX25Series__log_read_header reads the header of the sector at index, valid is false for a blank or damaged one.
+ */
+static MX25Series_status_enum_t MX25Series__log_read_header(MX25Series_Log_t *log, uint32_t index, bool *valid, uint32_t *sequence)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t header[MX25Series_LOG_SECTOR_HEADER_SIZE];
+
+    *valid = false;
+    result = MX25Series_read_stored_data_mode(log->dev, log->dev->read_mode, log->base + index * MX25Series_SECTOR_SIZE,
+                                              sizeof(header), header);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    *sequence = MX25Series__log_get32(header + 4);
+    *valid = MX25Series__log_get32(header) == MX25Series_LOG_MAGIC &&
+             MX25Series__log_get32(header + 8) == MX25Series_crc32(0, header, 8) &&
+             *sequence % log->sector_count == index;
+    return result;
+}
+
+/**
+ * MX25Series__log_is_blank checks a whole sector for 0xFF a page at a time, through the flushed page buffer.
+ */
+static MX25Series_status_enum_t MX25Series__log_is_blank(MX25Series_Log_t *log, uint32_t memory_address, bool *blank)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t page_size = log->dev->chip_def->page_size;
+    uint32_t offset;
+
+    *blank = true;
+    for(offset = 0; offset < MX25Series_SECTOR_SIZE && *blank; offset += page_size)
+    {
+        uint32_t i;
+
+        result = MX25Series_read_stored_data_mode(log->dev, log->dev->read_mode, memory_address + offset, page_size,
+                                                  log->page_buffer);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        for(i = 0; i < page_size && *blank; i++)
+        {
+            *blank = log->page_buffer[i] == 0xFF;
+        }
+    }
+    return MX25Series_status_ok;
+}
+
+/**
+ * MX25Series__log_reclaim erases the oldest sectors with the largest erase that starts at the tail.
+ */
+static MX25Series_status_enum_t MX25Series__log_reclaim(MX25Series_Log_t *log)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t index = log->tail_sequence % log->sector_count;
+    uint32_t sectors = log->sector_count - index;
+    MX25Series_Erase_enum_t erase_type;
+
+    if(sectors > log->reclaim_sectors)
+    {
+        sectors = log->reclaim_sectors;
+    }
+
+    erase_type = MX25Series_next_erase_step(log->dev, log->base + index * MX25Series_SECTOR_SIZE, sectors * MX25Series_SECTOR_SIZE);
+    if(erase_type == MX25Series_Erase_Undefined)
+    {
+        return MX25Series_status_error_unsupported;
+    }
+
+    result = MX25Series_set_write_enable(log->dev, true);
+    result |= MX25Series_erase(log->dev, erase_type, log->base + index * MX25Series_SECTOR_SIZE);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    result = MX25Series_wait_for_operation(log->dev);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    log->tail_sequence += MX25Series_get_erasure_size(log->dev, erase_type) / MX25Series_SECTOR_SIZE;
+    return MX25Series_status_ok;
+}
+
+/**
+ * MX25Series__log_open moves the head to the start of the next sector.
+ */
+static MX25Series_status_enum_t MX25Series__log_open(MX25Series_Log_t *log)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t sequence = log->empty ? 0 : log->head_sequence + 1;
+    uint32_t memory_address = MX25Series__log_sector_address(log, sequence);
+    uint8_t header[MX25Series_LOG_SECTOR_HEADER_SIZE];
+    bool blank = false;
+
+    result = MX25Series_log_flush(log);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    //The next sector is the tail, the ring is full.
+    if(!log->empty && sequence - log->tail_sequence >= log->sector_count)
+    {
+        result = MX25Series__log_reclaim(log);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+
+    //A sector left by an interrupted erase, or never erased, is only reused once it is blank.
+    result = MX25Series__log_is_blank(log, memory_address, &blank);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    if(!blank)
+    {
+        result = MX25Series_set_write_enable(log->dev, true);
+        result |= MX25Series_erase(log->dev, MX25Series_Erase_Block_4K, memory_address);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        result = MX25Series_wait_for_operation(log->dev);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+
+    MX25Series__log_put32(header, MX25Series_LOG_MAGIC);
+    MX25Series__log_put32(header + 4, sequence);
+    MX25Series__log_put32(header + 8, MX25Series_crc32(0, header, 8));
+    result = MX25Series_write_stored_data_paged(log->dev, memory_address, sizeof(header), header);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    if(log->empty)
+    {
+        log->tail_sequence = sequence;
+        log->empty = false;
+    }
+    log->head_sequence = sequence;
+    log->head = memory_address + MX25Series_LOG_SECTOR_HEADER_SIZE;
+    log->pending = log->head;
+    return MX25Series_status_ok;
+}
+
+/**
+ * MX25Series__log_put copies bytes into the page buffer, programming each page as it fills.
+ */
+static MX25Series_status_enum_t MX25Series__log_put(MX25Series_Log_t *log, const uint8_t *data, size_t length)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t page_size = log->dev->chip_def->page_size;
+
+    while(length > 0)
+    {
+        uint32_t offset = log->head % page_size;
+        size_t chunk = page_size - offset;
+
+        if(chunk > length)
+        {
+            chunk = length;
+        }
+
+        memcpy(log->page_buffer + offset, data, chunk);
+        log->head += chunk;
+        data += chunk;
+        length -= chunk;
+
+        if(log->head % page_size == 0)
+        {
+            result = MX25Series_log_flush(log);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+        }
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_log_init(
+        MX25Series_Log_t *log,
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        uint32_t length,
+        uint8_t *page_buffer)
+{
+    memset(log, 0, sizeof(MX25Series_Log_t));
+
+    if(dev->chip_def == NULL || dev->chip_def->page_size == 0 || (MX25Series_SECTOR_SIZE % dev->chip_def->page_size) != 0)
+    {
+        return MX25Series_status_error_invalid_chip_def;
+    }
+
+    if(page_buffer == NULL || (memory_address % MX25Series_SECTOR_SIZE) != 0 || (length % MX25Series_SECTOR_SIZE) != 0 ||
+       length < 3 * MX25Series_SECTOR_SIZE || memory_address > dev->chip_def->memory_size ||
+       length > dev->chip_def->memory_size - memory_address)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    log->dev = dev;
+    log->base = memory_address;
+    log->sector_count = length / MX25Series_SECTOR_SIZE;
+    log->page_buffer = page_buffer;
+
+    //Mount relies on the erased gap ahead of the head never being more than half the region.
+    log->reclaim_sectors = MX25Series_LOG_MAX_RECLAIM / MX25Series_SECTOR_SIZE;
+    if(log->reclaim_sectors == 0)
+    {
+        log->reclaim_sectors = 1;
+    }
+    while(log->reclaim_sectors > (log->sector_count - 1) / 2)
+    {
+        log->reclaim_sectors /= 2;
+    }
+
+    log->empty = true;
+    log->head = memory_address;
+    log->pending = memory_address;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_log_format(MX25Series_Log_t *log)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    result = MX25Series_erase_range(log->dev, log->base, log->sector_count * MX25Series_SECTOR_SIZE);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    log->empty = true;
+    log->head_sequence = 0;
+    log->tail_sequence = 0;
+    log->head = log->base;
+    log->pending = log->base;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_log_mount(MX25Series_Log_t *log)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t count = log->sector_count;
+    uint32_t reference = 0;
+    uint32_t lap;
+    uint32_t low;
+    uint32_t high;
+    uint32_t sequence = 0;
+    uint32_t memory_address;
+    uint32_t sector_end;
+    bool valid = false;
+
+    log->empty = true;
+    log->head = log->base;
+    log->pending = log->base;
+
+    //Sector 0 is only blank while it lies in the erased gap ahead of the head, which is at most reclaim_sectors
+    //long, so the sector reclaim_sectors on is then part of the log.
+    result = MX25Series__log_read_header(log, 0, &valid, &sequence);
+    if(!MX25Series_HAS_ERROR(result) && !valid)
+    {
+        reference = log->reclaim_sectors;
+        result = MX25Series__log_read_header(log, reference, &valid, &sequence);
+    }
+    if(MX25Series_HAS_ERROR(result) || !valid)
+    {
+        return result;
+    }
+    lap = sequence / count;
+
+    //Sectors from the reference up to the head were opened in the same lap, the ones after it are older or blank.
+    low = reference;
+    high = count - 1;
+    while(low < high)
+    {
+        uint32_t middle = low + (high - low + 1) / 2;
+
+        result = MX25Series__log_read_header(log, middle, &valid, &sequence);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+        if(valid && sequence / count == lap)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    log->head_sequence = lap * count + low;
+    log->tail_sequence = lap * count;
+
+    //The tail is the first sector after the erased gap.
+    if(reference == 0)
+    {
+        if(lap > 0 && low < count - 1)
+        {
+            low = low + 1;
+            high = count;
+            while(low < high)
+            {
+                uint32_t middle = low + (high - low) / 2;
+
+                result = MX25Series__log_read_header(log, middle, &valid, &sequence);
+                if(MX25Series_HAS_ERROR(result))
+                {
+                    return result;
+                }
+                if(valid)
+                {
+                    high = middle;
+                }
+                else
+                {
+                    low = middle + 1;
+                }
+            }
+
+            if(low < count)
+            {
+                result = MX25Series__log_read_header(log, low, &valid, &sequence);
+                if(MX25Series_HAS_ERROR(result))
+                {
+                    return result;
+                }
+                if(valid && sequence == (lap - 1) * count + low)
+                {
+                    log->tail_sequence = sequence;
+                }
+            }
+        }
+    }
+    else
+    {
+        low = 1;
+        high = reference;
+        while(low < high)
+        {
+            uint32_t middle = low + (high - low) / 2;
+
+            result = MX25Series__log_read_header(log, middle, &valid, &sequence);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+            if(valid)
+            {
+                high = middle;
+            }
+            else
+            {
+                low = middle + 1;
+            }
+        }
+        log->tail_sequence = lap * count + low;
+    }
+
+    //Walk the record headers of the head sector to the first blank one.
+    memory_address = MX25Series__log_sector_address(log, log->head_sequence);
+    sector_end = memory_address + MX25Series_SECTOR_SIZE;
+    memory_address += MX25Series_LOG_SECTOR_HEADER_SIZE;
+    while(memory_address + MX25Series_LOG_RECORD_HEADER_SIZE <= sector_end)
+    {
+        uint8_t header[MX25Series_LOG_RECORD_HEADER_SIZE];
+        uint16_t length;
+
+        result = MX25Series_read_stored_data_mode(log->dev, log->dev->read_mode, memory_address, sizeof(header), header);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        length = MX25Series__log_get16(header);
+        if(length == 0xFFFF && MX25Series__log_get16(header + 2) == 0xFFFF)
+        {
+            break;
+        }
+        if((length ^ MX25Series__log_get16(header + 2)) != 0xFFFF ||
+           memory_address + MX25Series_LOG_RECORD_HEADER_SIZE + length > sector_end)
+        {
+            //A header torn by a power loss, nothing more can be appended to this sector.
+            memory_address = sector_end;
+            break;
+        }
+        memory_address += MX25Series_LOG_RECORD_HEADER_SIZE + length;
+    }
+
+    log->empty = false;
+    log->head = memory_address;
+    log->pending = memory_address;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_log_append(MX25Series_Log_t *log, const uint8_t *data, size_t length)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t header[MX25Series_LOG_RECORD_HEADER_SIZE];
+
+    if(data == NULL || length == 0 || length > MX25Series_LOG_MAX_RECORD)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    if(log->empty || log->head + MX25Series_LOG_RECORD_HEADER_SIZE + length >
+                     MX25Series__log_sector_address(log, log->head_sequence) + MX25Series_SECTOR_SIZE)
+    {
+        result = MX25Series__log_open(log);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+
+    MX25Series__log_put16(header, (uint16_t)length);
+    MX25Series__log_put16(header + 2, (uint16_t)~length);
+    MX25Series__log_put32(header + 4, MX25Series_crc32(0, data, length));
+
+    result = MX25Series__log_put(log, header, sizeof(header));
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    return MX25Series__log_put(log, data, length);
+}
+
+MX25Series_status_enum_t MX25Series_log_flush(MX25Series_Log_t *log)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t page_size = log->dev->chip_def->page_size;
+
+    if(log->pending == log->head)
+    {
+        return MX25Series_status_ok;
+    }
+
+    //pending and head - 1 are always in the same page.
+    result = MX25Series_write_stored_data_paged(log->dev, log->pending, log->head - log->pending,
+                                                log->page_buffer + (log->pending % page_size));
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    log->pending = log->head;
+    return MX25Series_status_ok;
+}
+
+void MX25Series_log_begin(MX25Series_Log_t *log, MX25Series_Log_Iterator_t *iterator)
+{
+    memset(iterator, 0, sizeof(MX25Series_Log_Iterator_t));
+    iterator->sequence = log->tail_sequence;
+    iterator->address = MX25Series__log_sector_address(log, log->tail_sequence) + MX25Series_LOG_SECTOR_HEADER_SIZE;
+}
+
+MX25Series_status_enum_t MX25Series_log_next(
+        MX25Series_Log_t *log,
+        MX25Series_Log_Iterator_t *iterator,
+        uint8_t *buffer,
+        size_t max_length,
+        size_t *length)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    *length = 0;
+    for(;;)
+    {
+        bool head_sector;
+        uint32_t sector_end;
+        uint16_t record_length;
+        uint32_t crc;
+
+        if(log->empty || (int32_t)(iterator->sequence - log->head_sequence) > 0)
+        {
+            return MX25Series_status_ok;
+        }
+
+        //The sectors being walked have been reclaimed, carry on from the oldest left.
+        if((int32_t)(iterator->sequence - log->tail_sequence) < 0)
+        {
+            MX25Series_log_begin(log, iterator);
+        }
+
+        //Only what has been programmed is visible, the walk stays in the head sector so later appends are seen.
+        head_sector = iterator->sequence == log->head_sequence;
+        sector_end = head_sector ? log->pending : MX25Series__log_sector_address(log, iterator->sequence) + MX25Series_SECTOR_SIZE;
+
+        if(iterator->address + MX25Series_LOG_RECORD_HEADER_SIZE <= sector_end && !iterator->header_loaded)
+        {
+            result = MX25Series_read_stored_data_mode(log->dev, log->dev->read_mode, iterator->address,
+                                                      MX25Series_LOG_RECORD_HEADER_SIZE, iterator->header);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+            iterator->header_loaded = true;
+        }
+
+        record_length = MX25Series__log_get16(iterator->header);
+        if(iterator->address + MX25Series_LOG_RECORD_HEADER_SIZE > sector_end ||
+           (record_length ^ MX25Series__log_get16(iterator->header + 2)) != 0xFFFF ||
+           iterator->address + MX25Series_LOG_RECORD_HEADER_SIZE + record_length > sector_end)
+        {
+            //Blank or damaged, nothing more in this sector.
+            iterator->header_loaded = false;
+            if(head_sector)
+            {
+                return MX25Series_status_ok;
+            }
+            iterator->sequence++;
+            iterator->address = MX25Series__log_sector_address(log, iterator->sequence) + MX25Series_LOG_SECTOR_HEADER_SIZE;
+            continue;
+        }
+
+        if(record_length > max_length)
+        {
+            *length = record_length;
+            return MX25Series_status_error_invalid_argument;
+        }
+
+        crc = MX25Series__log_get32(iterator->header + 4);
+        iterator->address += MX25Series_LOG_RECORD_HEADER_SIZE;
+        if((size_t)record_length + MX25Series_LOG_RECORD_HEADER_SIZE <= max_length &&
+           iterator->address + record_length + MX25Series_LOG_RECORD_HEADER_SIZE <= sector_end)
+        {
+            //Take the next header in the same frame.
+            result = MX25Series_read_stored_data_mode(log->dev, log->dev->read_mode, iterator->address,
+                                                      record_length + MX25Series_LOG_RECORD_HEADER_SIZE, buffer);
+            memcpy(iterator->header, buffer + record_length, MX25Series_LOG_RECORD_HEADER_SIZE);
+        }
+        else
+        {
+            result = MX25Series_read_stored_data_mode(log->dev, log->dev->read_mode, iterator->address, record_length, buffer);
+            iterator->header_loaded = false;
+        }
+        if(MX25Series_HAS_ERROR(result))
+        {
+            iterator->address -= MX25Series_LOG_RECORD_HEADER_SIZE;
+            iterator->header_loaded = false;
+            return result;
+        }
+        iterator->address += record_length;
+
+        if(MX25Series_crc32(0, buffer, record_length) != crc)
+        {
+            iterator->skipped++;
+            continue;
+        }
+
+        *length = record_length;
+        return MX25Series_status_ok;
+    }
+}
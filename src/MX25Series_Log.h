@@ -0,0 +1,159 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#ifndef FLASH_MX25Series_Log_H
+#define FLASH_MX25Series_Log_H
+
+#include "MX25Series.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define MX25Series_LOG_MAGIC 0x474C584Dul        /**! "MXLG", the first word of every log sector */
+#define MX25Series_LOG_SECTOR_HEADER_SIZE 12     /**! Magic, sequence and CRC-32 at the start of every sector */
+#define MX25Series_LOG_RECORD_HEADER_SIZE 8      /**! Length, inverted length and CRC-32 of the payload */
+#define MX25Series_LOG_MAX_RECORD (MX25Series_SECTOR_SIZE - MX25Series_LOG_SECTOR_HEADER_SIZE - MX25Series_LOG_RECORD_HEADER_SIZE)
+
+#ifndef MX25Series_LOG_MAX_RECLAIM
+    #define MX25Series_LOG_MAX_RECLAIM MX25Series_BLOCK_64K_SIZE /**! Most bytes erased from the tail at once */
+#endif
+
+/**
+ * @brief An append only ring of records in a 4 KB aligned region of the chip.
+ * Every sector starts with a header holding its sequence number, the count of sectors opened since the log was
+ * formatted, and the sectors are opened in address order so sequence % sector_count is the sector's index. That
+ * makes the sequence numbers increase across the region up to the head and lets MX25Series_log_mount find the head
+ * and tail with a binary search over sector headers. Records never span sectors. When the head reaches the tail
+ * the oldest sectors are erased with the largest erase that fits, up to MX25Series_LOG_MAX_RECLAIM.
+ */
+typedef struct
+{
+    MX25Series_t *dev;
+    uint32_t base;              /**! First address of the region */
+    uint32_t sector_count;
+    uint32_t reclaim_sectors;   /**! Most sectors erased at once, at most half the region */
+    bool empty;                 /**! No sector has been opened since the log was formatted */
+    uint32_t head_sequence;     /**! Sequence of the sector being appended to */
+    uint32_t tail_sequence;     /**! Sequence of the oldest sector */
+    uint32_t head;              /**! Address the next record is appended at */
+    uint32_t pending;           /**! Address of the first appended byte not yet programmed */
+    uint8_t *page_buffer;       /**! One page of appended bytes waiting to be programmed */
+} MX25Series_Log_t;
+
+/**
+ * @brief Position of a walk through the log, see MX25Series_log_begin.
+ */
+typedef struct
+{
+    uint32_t sequence;          /**! Sequence of the sector being read */
+    uint32_t address;           /**! Address of the next record header */
+    uint8_t header[MX25Series_LOG_RECORD_HEADER_SIZE];
+    bool header_loaded;         /**! header was read along with the previous payload */
+    uint32_t skipped;           /**! Records dropped because their CRC did not match, such as one torn by a power loss */
+} MX25Series_Log_Iterator_t;
+
+/**
+ * MX25Series_log_init describes the log region, MX25Series_log_format or MX25Series_log_mount must follow.
+ * @param log the log structure to initialise.
+ * @param dev the device structure for the MX25Series chip.
+ * @param memory_address the 4 KB aligned start of the region.
+ * @param length the size of the region, a multiple of 4 KB of at least three sectors.
+ * @param page_buffer chip_def->page_size bytes used to batch appends into Page Programs.
+ * @return MX25Series_status_error_invalid_argument if the region is invalid.
+ */
+MX25Series_status_enum_t MX25Series_log_init(
+        MX25Series_Log_t *log,
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        uint32_t length,
+        uint8_t *page_buffer);
+
+/**
+ * MX25Series_log_format erases the region, leaving an empty log.
+ * @param log the log structure.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_log_format(MX25Series_Log_t *log);
+
+/**
+ * MX25Series_log_mount finds the head and tail of a log written earlier by binary search over the sector headers,
+ * then walks the record headers of the head sector to find the append position. Reads O(log sector_count) sector
+ * headers, however full the log is.
+ * @param log the log structure.
+ * @return a MX25Series_status_enum_t indication success or error codes, a region without a valid sector mounts
+ * as an empty log.
+ */
+MX25Series_status_enum_t MX25Series_log_mount(MX25Series_Log_t *log);
+
+/**
+ * MX25Series_log_append adds a record. Records are batched in the page buffer and programmed a page at a time, so
+ * a record is only stored once its page fills or MX25Series_log_flush is called. Opening a new sector erases the
+ * oldest sectors first when the log is full.
+ * @param log the log structure.
+ * @param data the record.
+ * @param length between 1 and MX25Series_LOG_MAX_RECORD bytes.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_log_append(MX25Series_Log_t *log, const uint8_t *data, size_t length);
+
+/**
+ * MX25Series_log_flush programs the records still in the page buffer.
+ * @param log the log structure.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_log_flush(MX25Series_Log_t *log);
+
+/**
+ * MX25Series_log_begin starts a walk at the oldest record. Records still in the page buffer are not seen.
+ * @param log the log structure.
+ * @param iterator the iterator to initialise.
+ */
+void MX25Series_log_begin(MX25Series_Log_t *log, MX25Series_Log_Iterator_t *iterator);
+
+/**
+ * MX25Series_log_next reads the next record, oldest first. The record is read along with the header of the one
+ * after it when buffer has room, so a walk costs one read frame per record.
+ * @param log the log structure.
+ * @param iterator the iterator from MX25Series_log_begin.
+ * @param buffer where to store the record.
+ * @param max_length the size of buffer.
+ * @param length set to the record length, 0 once the walk has reached the head.
+ * @return MX25Series_status_error_invalid_argument, with length set and the iterator left on the record, if the
+ * record does not fit in buffer.
+ */
+MX25Series_status_enum_t MX25Series_log_next(
+        MX25Series_Log_t *log,
+        MX25Series_Log_Iterator_t *iterator,
+        uint8_t *buffer,
+        size_t max_length,
+        size_t *length);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_Log_H
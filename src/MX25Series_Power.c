@@ -0,0 +1,225 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#include "MX25Series_Power.h"
+#include "MX25Series_Async.h"
+
+static uint32_t MX25Series__power_max_time(MX25Series_Chip_Info_t *chip_def, MX25Series_Operation_enum_t operation)
+{
+    switch(operation)
+    {
+        case MX25Series_Operation_Program:
+            return chip_def->timing.tPP;
+        case MX25Series_Operation_Erase_4K:
+            return chip_def->timing.tSE;
+        case MX25Series_Operation_Erase_32K:
+            return chip_def->timing.tBE32K;
+        case MX25Series_Operation_Erase_64K:
+            return chip_def->timing.tBE64K;
+        case MX25Series_Operation_Erase_Chip:
+            return chip_def->timing.tCE;
+        default:
+            return chip_def->timing.tUNKNOWN;
+    }
+}
+
+MX25Series_status_enum_t MX25Series_power_init(
+        MX25Series_Power_t *power,
+        MX25Series_t *dev,
+        MX25Series_Chip_Info_t *low_power,
+        MX25Series_Chip_Info_t *high_performance,
+        MX25Series_Power_Policy_enum_t policy)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint16_t configuration_register = 0;
+
+    memset(power, 0, sizeof(MX25Series_Power_t));
+
+    if(low_power == NULL || high_performance == NULL)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    result = MX25Series_read_configuration_register(dev, &configuration_register);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    power->dev = dev;
+    power->low_power = low_power;
+    power->high_performance = high_performance;
+    power->policy = policy;
+    power->bulk_threshold = MX25Series_POWER_BULK_THRESHOLD;
+    power->idle_time = MX25Series_POWER_IDLE_TIME;
+    power->high = (configuration_register & MX25Series_CR_LH_MASK) != 0;
+    power->last_active = MX25Series___get_micro_seconds(dev);
+    dev->chip_def = power->high ? high_performance : low_power;
+    dev->power = power;
+    return MX25Series_status_ok;
+}
+
+void MX25Series_power_deinit(MX25Series_Power_t *power)
+{
+    if(power->dev != NULL && power->dev->power == power)
+    {
+        power->dev->power = NULL;
+    }
+    power->dev = NULL;
+}
+
+MX25Series_status_enum_t MX25Series_power_set_mode(MX25Series_Power_t *power, bool high)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_t *dev = power->dev;
+    uint8_t status_register = 0;
+    uint16_t configuration_register = 0;
+    uint32_t max_time;
+
+    if(power->high == high)
+    {
+        return MX25Series_status_ok;
+    }
+
+    if(dev->busy_operation != MX25Series_Operation_None || dev->suspend.active)
+    {
+        return MX25Series_status_error_busy;
+    }
+
+    result = MX25Series_read_status_register(dev, &status_register);
+    result |= MX25Series_read_configuration_register(dev, &configuration_register);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    configuration_register &= ~MX25Series_CR_LH_MASK;
+    configuration_register |= high ? MX25Series_CR_LH : 0;
+
+    //WIP and WEL are read only, leave them clear.
+    status_register &= ~(MX25Series_SR_WIP_MASK | MX25Series_SR_WEL_MASK);
+
+    //The write runs at the speed of the mode being left, which is not the table in use once it has been issued.
+    max_time = power->low_power->timing.tWSR > power->high_performance->timing.tWSR ?
+               power->low_power->timing.tWSR : power->high_performance->timing.tWSR;
+
+    result = MX25Series_set_write_enable(dev, true);
+    result |= MX25Series_configure_chip(dev, status_register, configuration_register);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    result = MX25Series_wait_for_completion(dev, max_time);
+    result |= MX25Series_read_configuration_register(dev, &configuration_register);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    power->switches++;
+    power->last_active = MX25Series___get_micro_seconds(dev);
+    if(((configuration_register & MX25Series_CR_LH_MASK) != 0) != high)
+    {
+        MX25Series_power_sync(power, configuration_register);
+        return MX25Series_status_error_verify;
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_power_request(MX25Series_Power_t *power, MX25Series_Operation_enum_t operation, uint32_t length)
+{
+    if(power == NULL)
+    {
+        return MX25Series_status_ok;
+    }
+
+    power->last_active = MX25Series___get_micro_seconds(power->dev);
+
+    if(power->high || power->policy != MX25Series_Power_Policy_Bulk || length < power->bulk_threshold ||
+       power->dev->busy_operation != MX25Series_Operation_None)
+    {
+        return MX25Series_status_ok;
+    }
+
+    //High performance draws more current, only use it where it is faster.
+    if(MX25Series__power_max_time(power->high_performance, operation) >= MX25Series__power_max_time(power->low_power, operation))
+    {
+        return MX25Series_status_ok;
+    }
+
+    return MX25Series_power_set_mode(power, true);
+}
+
+MX25Series_status_enum_t MX25Series_power_tick(MX25Series_Power_t *power)
+{
+    MX25Series_t *dev = power->dev;
+    uint32_t now = MX25Series___get_micro_seconds(dev);
+
+    if(dev->busy_operation != MX25Series_Operation_None || dev->suspend.active || !MX25Series_async_is_idle(dev))
+    {
+        power->last_active = now;
+        return MX25Series_status_ok;
+    }
+
+    switch(power->policy)
+    {
+        case MX25Series_Power_Policy_Low_Power:
+            return MX25Series_power_set_mode(power, false);
+        case MX25Series_Power_Policy_High_Performance:
+            return MX25Series_power_set_mode(power, true);
+        case MX25Series_Power_Policy_Bulk:
+            if(power->high && now - power->last_active >= power->idle_time)
+            {
+                return MX25Series_power_set_mode(power, false);
+            }
+            return MX25Series_status_ok;
+        default:
+            return MX25Series_status_error_invalid_argument;
+    }
+}
+
+void MX25Series_power_sync(MX25Series_Power_t *power, uint16_t configuration_register)
+{
+    bool high = (configuration_register & MX25Series_CR_LH_MASK) != 0;
+    uint32_t observed;
+    size_t i;
+
+    if(power == NULL || power->high == high)
+    {
+        return;
+    }
+
+    //Completion times learnt in one mode would throw off polling in the other.
+    for(i = 0; i < MX25Series_Operation_Count; i++)
+    {
+        observed = power->dev->observed_time[i];
+        power->dev->observed_time[i] = power->observed_time[i];
+        power->observed_time[i] = observed;
+    }
+
+    power->high = high;
+    power->dev->chip_def = high ? power->high_performance : power->low_power;
+}
@@ -0,0 +1,132 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#ifndef FLASH_MX25Series_Power_H
+#define FLASH_MX25Series_Power_H
+
+#include "MX25Series.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#ifndef MX25Series_POWER_BULK_THRESHOLD
+    #define MX25Series_POWER_BULK_THRESHOLD MX25Series_BLOCK_32K_SIZE /**! Default bytes an erase or program must cover to switch to high performance */
+#endif
+
+#ifndef MX25Series_POWER_IDLE_TIME
+    #define MX25Series_POWER_IDLE_TIME 100000 /**! Default micro-seconds idle in high performance before dropping back to low power */
+#endif
+
+typedef enum {
+    MX25Series_Power_Policy_Low_Power = 0,          /**< Stay in ultra low power mode */
+    MX25Series_Power_Policy_High_Performance = 1,   /**< Stay in high performance mode */
+    MX25Series_Power_Policy_Bulk = 2,               /**< High performance for bulk erases and programs that it makes faster, low power once idle */
+} MX25Series_Power_Policy_enum_t;
+
+/**
+ * @brief Governs the CR L/H bit and keeps dev->chip_def pointing at the timing table of the current mode. Each
+ * mode keeps its own observed completion times.
+ */
+typedef struct MX25Series_Power_t
+{
+    MX25Series_t *dev;
+    MX25Series_Chip_Info_t *low_power;          /**! Chip definition while L/H is clear */
+    MX25Series_Chip_Info_t *high_performance;   /**! Chip definition while L/H is set */
+    MX25Series_Power_Policy_enum_t policy;
+    uint32_t bulk_threshold;                    /**! Bytes an erase or program must cover to switch to high performance */
+    uint32_t idle_time;                         /**! Micro-seconds idle before dropping back to low power, the hysteresis */
+    bool high;                                  /**! L/H is set */
+    uint32_t last_active;                       /**! MX25Series___get_micro_seconds() when the chip was last seen busy, or finished an operation */
+    uint32_t observed_time[MX25Series_Operation_Count]; /**! dev->observed_time of the mode not in use */
+    uint32_t switches;                          /**! Number of L/H changes made */
+} MX25Series_Power_t;
+
+/**
+ * MX25Series_power_init reads the L/H bit, points dev->chip_def at the matching definition and attaches the
+ * governor to dev. From then on every change of L/H through MX25Series_configure_chip swaps dev->chip_def.
+ * @param power the governor structure to initialise.
+ * @param dev the device structure for the MX25Series chip.
+ * @param low_power the chip definition for low power mode, such as MX25R6435F_Chip_Def_Low_Power.
+ * @param high_performance the chip definition for high performance mode, such as
+ * MX25R6435F_Chip_Def_High_Performance.
+ * @param policy the MX25Series_Power_Policy_enum_t to apply.
+ * @return MX25Series_status_error_invalid_argument if a chip definition is missing.
+ */
+MX25Series_status_enum_t MX25Series_power_init(
+        MX25Series_Power_t *power,
+        MX25Series_t *dev,
+        MX25Series_Chip_Info_t *low_power,
+        MX25Series_Chip_Info_t *high_performance,
+        MX25Series_Power_Policy_enum_t policy);
+
+/**
+ * MX25Series_power_deinit detaches the governor from its device, leaving the chip in its current mode.
+ * @param power the governor structure.
+ */
+void MX25Series_power_deinit(MX25Series_Power_t *power);
+
+/**
+ * MX25Series_power_set_mode sets or clears L/H with WRSR and waits for it to complete, which takes up to tW.
+ * @param power the governor structure.
+ * @param high true for high performance mode, false for ultra low power mode.
+ * @return MX25Series_status_error_busy if an operation is in progress, MX25Series_status_error_verify if L/H does
+ * not read back as requested.
+ */
+MX25Series_status_enum_t MX25Series_power_set_mode(MX25Series_Power_t *power, bool high);
+
+/**
+ * MX25Series_power_request tells the governor that an erase or program of length bytes is about to be issued, so
+ * it can switch to high performance first. Called by MX25Series_erase_range and MX25Series_write_stored_data_paged,
+ * and by callers issuing their own sequences of MX25Series_erase. Does nothing while an operation is in progress.
+ * @param power the governor, may be NULL.
+ * @param operation the largest operation about to be issued.
+ * @param length the number of bytes about to be erased or programmed.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_power_request(MX25Series_Power_t *power, MX25Series_Operation_enum_t operation, uint32_t length);
+
+/**
+ * MX25Series_power_tick drops back to low power once the chip has been idle for power->idle_time, and applies a
+ * changed policy. Call it from the main loop.
+ * @param power the governor structure.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_power_tick(MX25Series_Power_t *power);
+
+/**
+ * MX25Series_power_sync brings dev->chip_def and the observed completion times in line with a Configuration
+ * Register value written to the chip. Called by MX25Series_configure_chip.
+ * @param power the governor, may be NULL.
+ * @param configuration_register the value written.
+ */
+void MX25Series_power_sync(MX25Series_Power_t *power, uint16_t configuration_register);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_Power_H
@@ -0,0 +1,325 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+#include "MX25Series_SFDP.h"
+
+//BFPT DWORDs are numbered from 1 in JESD216.
+#define MX25Series_SFDP_DW(n) (dwords[(n) - 1])
+#define MX25Series_SFDP_BITS(value, high, low) (((value) >> (low)) & ((1ul << ((high) - (low) + 1)) - 1))
+
+typedef struct {
+    const uint8_t *sfdp;
+    size_t length;
+} MX25Series_SFDP_Buffer_t;
+
+static uint32_t MX25Series__sfdp_le32(const uint8_t *bytes)
+{
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+/**
+ * MX25Series__sfdp_max_time scales a typical time by the 2 * (multiplier + 1) factor of DW10/DW11.
+ */
+static uint32_t MX25Series__sfdp_max_time(uint32_t typical, uint32_t multiplier)
+{
+    uint64_t max = (uint64_t)typical * 2 * (multiplier + 1);
+    return max > 0xFFFFFFFFull ? 0xFFFFFFFFul : (uint32_t)max;
+}
+
+static uint32_t MX25Series__sfdp_erase_typical(uint32_t dw10, uint8_t erase_type)
+{
+    static const uint32_t units[4] = {1000, 16000, 128000, 1000000};
+    uint32_t field = MX25Series_SFDP_BITS(dw10, 4 + 7 * erase_type + 6, 4 + 7 * erase_type);
+
+    return (MX25Series_SFDP_BITS(field, 4, 0) + 1) * units[MX25Series_SFDP_BITS(field, 6, 5)];
+}
+
+static MX25Series_status_enum_t MX25Series__sfdp_read_buffer(void *ctx, uint32_t address, size_t length, uint8_t *buffer)
+{
+    MX25Series_SFDP_Buffer_t *image = (MX25Series_SFDP_Buffer_t *)ctx;
+
+    if(address > image->length || length > image->length - address)
+    {
+        return MX25Series_status_error_unsupported;
+    }
+    memcpy(buffer, image->sfdp + address, length);
+    return MX25Series_status_ok;
+}
+
+static MX25Series_status_enum_t MX25Series__sfdp_read_chip(void *ctx, uint32_t address, size_t length, uint8_t *buffer)
+{
+    return MX25Series_read_sfdp((MX25Series_t *)ctx, address, length, buffer);
+}
+
+static void MX25Series__sfdp_parse_bfpt(const uint32_t *dwords, size_t count, MX25Series_Chip_Info_t *chip_def)
+{
+    uint32_t dw1 = MX25Series_SFDP_DW(1);
+    uint32_t density = MX25Series_SFDP_DW(2);
+
+    if((density & 0x80000000ul) == 0)
+    {
+        chip_def->memory_size = (density + 1) / 8;
+    }
+    else if((density & 0x7FFFFFFFul) >= 3 && (density & 0x7FFFFFFFul) < 35)
+    {
+        chip_def->memory_size = 1ul << ((density & 0x7FFFFFFFul) - 3);
+    }
+
+    //Read modes, the dummy cycles are the wait states plus the mode bit clocks.
+    chip_def->dummy_cycles.fast_read = 8;
+    chip_def->dummy_cycles.dread = MX25Series_SFDP_BITS(dw1, 16, 16) ?
+            MX25Series_SFDP_BITS(MX25Series_SFDP_DW(4), 4, 0) + MX25Series_SFDP_BITS(MX25Series_SFDP_DW(4), 7, 5) : 0;
+    chip_def->dummy_cycles.dual_io = MX25Series_SFDP_BITS(dw1, 20, 20) ?
+            MX25Series_SFDP_BITS(MX25Series_SFDP_DW(4), 20, 16) + MX25Series_SFDP_BITS(MX25Series_SFDP_DW(4), 23, 21) : 0;
+    chip_def->dummy_cycles.quad_io = MX25Series_SFDP_BITS(dw1, 21, 21) ?
+            MX25Series_SFDP_BITS(MX25Series_SFDP_DW(3), 4, 0) + MX25Series_SFDP_BITS(MX25Series_SFDP_DW(3), 7, 5) : 0;
+    chip_def->dummy_cycles.qread = MX25Series_SFDP_BITS(dw1, 22, 22) ?
+            MX25Series_SFDP_BITS(MX25Series_SFDP_DW(3), 20, 16) + MX25Series_SFDP_BITS(MX25Series_SFDP_DW(3), 23, 21) : 0;
+
+    //Erase types 1 to 4, matched to the commands this library issues.
+    chip_def->erase_types = 0;
+    for(uint8_t erase_type = 0; erase_type < 4; erase_type++)
+    {
+        uint32_t dword = MX25Series_SFDP_DW(8 + erase_type / 2);
+        uint8_t size = MX25Series_SFDP_BITS(dword, 16 * (erase_type % 2) + 7, 16 * (erase_type % 2));
+        uint8_t opcode = MX25Series_SFDP_BITS(dword, 16 * (erase_type % 2) + 15, 16 * (erase_type % 2) + 8);
+        uint32_t *typical = NULL;
+        uint32_t *max = NULL;
+
+        if(size == 12 && opcode == MX25Series_Command_SE)
+        {
+            chip_def->erase_types |= MX25Series_ERASE_TYPE_4K;
+            typical = &chip_def->typical.tSE;
+            max = &chip_def->timing.tSE;
+        }
+        else if(size == 15 && opcode == MX25Series_Command_BE32K)
+        {
+            chip_def->erase_types |= MX25Series_ERASE_TYPE_32K;
+            typical = &chip_def->typical.tBE32K;
+            max = &chip_def->timing.tBE32K;
+        }
+        else if(size == 16 && opcode == MX25Series_Command_BE64K)
+        {
+            chip_def->erase_types |= MX25Series_ERASE_TYPE_64K;
+            typical = &chip_def->typical.tBE64K;
+            max = &chip_def->timing.tBE64K;
+        }
+
+        if(typical != NULL && count >= 10)
+        {
+            uint32_t dw10 = MX25Series_SFDP_DW(10);
+            *typical = MX25Series__sfdp_erase_typical(dw10, erase_type);
+            *max = MX25Series__sfdp_max_time(*typical, MX25Series_SFDP_BITS(dw10, 3, 0));
+        }
+    }
+
+    //JESD216 before revision A only describes 4 KB erase in DW1.
+    if(chip_def->erase_types == 0 && MX25Series_SFDP_BITS(dw1, 1, 0) == 1 && MX25Series_SFDP_BITS(dw1, 15, 8) == MX25Series_Command_SE)
+    {
+        chip_def->erase_types = MX25Series_ERASE_TYPE_4K;
+    }
+
+    if(count >= 11)
+    {
+        static const uint32_t chip_erase_units[4] = {16000, 256000, 4000000, 64000000};
+        uint32_t dw11 = MX25Series_SFDP_DW(11);
+        uint32_t multiplier = MX25Series_SFDP_BITS(dw11, 3, 0);
+        uint32_t byte_program;
+
+        chip_def->page_size = 1ul << MX25Series_SFDP_BITS(dw11, 7, 4);
+        chip_def->typical.tPP = (MX25Series_SFDP_BITS(dw11, 12, 8) + 1) * (MX25Series_SFDP_BITS(dw11, 13, 13) ? 64 : 8);
+        chip_def->timing.tPP = MX25Series__sfdp_max_time(chip_def->typical.tPP, multiplier);
+        byte_program = (MX25Series_SFDP_BITS(dw11, 17, 14) + 1) * (MX25Series_SFDP_BITS(dw11, 18, 18) ? 8 : 1);
+        chip_def->timing.tBP = MX25Series__sfdp_max_time(byte_program, multiplier);
+        chip_def->typical.tCE = (MX25Series_SFDP_BITS(dw11, 28, 24) + 1) * chip_erase_units[MX25Series_SFDP_BITS(dw11, 30, 29)];
+        chip_def->timing.tCE = MX25Series__sfdp_max_time(chip_def->typical.tCE, MX25Series_SFDP_BITS(MX25Series_SFDP_DW(10), 3, 0));
+    }
+
+    //DW12 bit 31 clear means program/erase suspend is supported.
+    if(count >= 12 && MX25Series_SFDP_BITS(MX25Series_SFDP_DW(12), 31, 31) == 0)
+    {
+        static const uint32_t latency_units_ns[4] = {128, 1000, 8000, 64000};
+        uint32_t dw12 = MX25Series_SFDP_DW(12);
+        uint32_t program_ns = (MX25Series_SFDP_BITS(dw12, 17, 13) + 1) * latency_units_ns[MX25Series_SFDP_BITS(dw12, 19, 18)];
+        uint32_t erase_ns = (MX25Series_SFDP_BITS(dw12, 28, 24) + 1) * latency_units_ns[MX25Series_SFDP_BITS(dw12, 30, 29)];
+        uint32_t program_interval = (MX25Series_SFDP_BITS(dw12, 12, 9) + 1) * 64;
+        uint32_t erase_interval = (MX25Series_SFDP_BITS(dw12, 23, 20) + 1) * 64;
+
+        chip_def->timing.tSUS = ((program_ns > erase_ns ? program_ns : erase_ns) + 999) / 1000;
+        chip_def->timing.tRS = program_interval > erase_interval ? program_interval : erase_interval;
+    }
+
+    //DW14 bit 31 clear means deep power-down is supported.
+    if(count >= 14 && MX25Series_SFDP_BITS(MX25Series_SFDP_DW(14), 31, 31) == 0)
+    {
+        static const uint32_t delay_units_ns[4] = {128, 1000, 8000, 64000};
+        uint32_t dw14 = MX25Series_SFDP_DW(14);
+
+        chip_def->timing.tRES1 = ((MX25Series_SFDP_BITS(dw14, 12, 8) + 1) * delay_units_ns[MX25Series_SFDP_BITS(dw14, 14, 13)] + 999) / 1000;
+    }
+}
+
+MX25Series_status_enum_t MX25Series_sfdp_parse(MX25Series_SFDP_Reader_t reader, void *ctx, MX25Series_Chip_Info_t *chip_def)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t header[8];
+    uint32_t dwords[MX25Series_SFDP_BFPT_DWORDS];
+    uint8_t bytes[MX25Series_SFDP_BFPT_DWORDS * 4];
+    uint8_t headers;
+    uint32_t bfpt_address = 0;
+    size_t bfpt_dwords = 0;
+
+    result = reader(ctx, 0, sizeof(header), header);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    if(MX25Series__sfdp_le32(header) != MX25Series_SFDP_SIGNATURE || header[5] != 1)
+    {
+        return MX25Series_status_error_unsupported;
+    }
+
+    //NPH is zero based, the BFPT with the highest revision wins.
+    headers = header[6] + 1;
+    if(headers > MX25Series_SFDP_MAX_HEADERS)
+    {
+        headers = MX25Series_SFDP_MAX_HEADERS;
+    }
+    for(uint8_t i = 0, best_minor = 0; i < headers; i++)
+    {
+        uint8_t parameter[8];
+
+        result = reader(ctx, 8 + 8 * i, sizeof(parameter), parameter);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        if(((parameter[7] << 8) | parameter[0]) == MX25Series_SFDP_BFPT_ID && parameter[2] == 1 &&
+           (bfpt_dwords == 0 || parameter[1] >= best_minor))
+        {
+            best_minor = parameter[1];
+            bfpt_dwords = parameter[3];
+            bfpt_address = parameter[4] | (parameter[5] << 8) | ((uint32_t)parameter[6] << 16);
+        }
+    }
+
+    //JESD216 defines nine DWORDs, later revisions add to them.
+    if(bfpt_dwords < 9)
+    {
+        return MX25Series_status_error_unsupported;
+    }
+    if(bfpt_dwords > MX25Series_SFDP_BFPT_DWORDS)
+    {
+        bfpt_dwords = MX25Series_SFDP_BFPT_DWORDS;
+    }
+
+    result = reader(ctx, bfpt_address, bfpt_dwords * 4, bytes);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    memset(dwords, 0xFF, sizeof(dwords));
+    for(size_t i = 0; i < bfpt_dwords; i++)
+    {
+        dwords[i] = MX25Series__sfdp_le32(bytes + 4 * i);
+    }
+
+    MX25Series__sfdp_parse_bfpt(dwords, bfpt_dwords, chip_def);
+
+    //SFDP has no Write Status Register time, fall back to the unknown budget rather than never waiting.
+    if(chip_def->timing.tUNKNOWN == 0)
+    {
+        chip_def->timing.tUNKNOWN = MX25Series_tUNKNOWN_TIMING;
+    }
+    if(chip_def->timing.tWSR == 0)
+    {
+        chip_def->timing.tWSR = chip_def->timing.tUNKNOWN;
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_sfdp_parse_buffer(const uint8_t *sfdp, size_t length, MX25Series_Chip_Info_t *chip_def)
+{
+    MX25Series_SFDP_Buffer_t image = {.sfdp = sfdp, .length = length};
+
+    return MX25Series_sfdp_parse(MX25Series__sfdp_read_buffer, &image, chip_def);
+}
+
+/**
+ * MX25Series__sfdp_select_read_mode makes the fastest read mode the chip definition describes the read mode of dev.
+ * MX25Series_set_read_mode turns down the modes without dummy cycles, the quad modes while QE is clear and every
+ * multi lane mode without MX25Series_ENABLE_MULTI_IO.
+ */
+static MX25Series_status_enum_t MX25Series__sfdp_select_read_mode(MX25Series_t *dev)
+{
+    static const MX25Series_Read_Mode_enum_t modes[] = {
+            MX25Series_Read_Mode_4READ,
+            MX25Series_Read_Mode_QREAD,
+            MX25Series_Read_Mode_2READ,
+            MX25Series_Read_Mode_DREAD,
+            MX25Series_Read_Mode_FAST_READ,
+    };
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    for(size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+    {
+        result = MX25Series_set_read_mode(dev, modes[i]);
+        if(result != MX25Series_status_error_unsupported)
+        {
+            return result;
+        }
+    }
+    return MX25Series_set_read_mode(dev, MX25Series_Read_Mode_READ);
+}
+
+MX25Series_status_enum_t MX25Series_sfdp_discover(MX25Series_t *dev, MX25Series_Chip_Info_t *chip_def)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    int manufacturer_id = 0;
+    int memory_type = 0;
+    int memory_density = 0;
+
+    result = MX25Series_sfdp_parse(MX25Series__sfdp_read_chip, dev, chip_def);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+
+    //MX25Series_read_identification compares against dev->chip_def, which is being replaced.
+    dev->chip_def = chip_def;
+    result = MX25Series_read_identification(dev, &manufacturer_id, &memory_type, &memory_density);
+    if(MX25Series_HAS_ERROR(result) && result != MX25Series_status_error_incorrect_ids)
+    {
+        return result;
+    }
+    chip_def->manufacturer_id = manufacturer_id;
+    chip_def->memory_type = memory_type;
+    chip_def->memory_density = memory_density;
+
+    //Timings learnt against the previous definition no longer apply.
+    memset(dev->observed_time, 0, sizeof(dev->observed_time));
+    return MX25Series__sfdp_select_read_mode(dev);
+}
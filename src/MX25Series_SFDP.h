@@ -0,0 +1,84 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+#ifndef FLASH_MX25Series_SFDP_H
+#define FLASH_MX25Series_SFDP_H
+
+#include "MX25Series.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define MX25Series_SFDP_SIGNATURE     0x50444653ul /**! "SFDP" read little endian */
+#define MX25Series_SFDP_BFPT_ID       0xFF00       /**! Parameter ID of the JEDEC Basic Flash Parameter Table */
+#define MX25Series_SFDP_BFPT_DWORDS   16           /**! DWORDs of the BFPT used, JESD216B */
+
+#ifndef MX25Series_SFDP_MAX_HEADERS
+    #define MX25Series_SFDP_MAX_HEADERS 8 /**! Parameter headers searched for the BFPT */
+#endif
+
+/**
+ * Reads length bytes at address of an SFDP area, either from the chip or from a buffer.
+ */
+typedef MX25Series_status_enum_t (*MX25Series_SFDP_Reader_t)(void *ctx, uint32_t address, size_t length, uint8_t *buffer);
+
+/**
+ * MX25Series_sfdp_parse fills chip_def from an SFDP area: memory_size, page_size, erase_types, the FAST_READ,
+ * DREAD, QREAD, 2READ and 4READ dummy cycles (0 for modes the chip does not have), and the typical and maximum
+ * program, erase and suspend times, and tRES1. Fields the table does not describe, such as the identification bytes,
+ * tWSR, tDP and the DC=1 dummy cycles, are left as they are, so start from a template such as MX25R6435F_Chip_Def_Low_Power.
+ * @param reader reads from the SFDP area.
+ * @param ctx passed to reader.
+ * @param chip_def the chip definition to fill in.
+ * @return MX25Series_status_error_unsupported if there is no SFDP area or Basic Flash Parameter Table.
+ */
+MX25Series_status_enum_t MX25Series_sfdp_parse(MX25Series_SFDP_Reader_t reader, void *ctx, MX25Series_Chip_Info_t *chip_def);
+
+/**
+ * MX25Series_sfdp_parse_buffer is MX25Series_sfdp_parse for an SFDP image held in memory.
+ * @param sfdp the SFDP image, starting at SFDP address 0.
+ * @param length the number of bytes in sfdp.
+ * @param chip_def the chip definition to fill in.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_sfdp_parse_buffer(const uint8_t *sfdp, size_t length, MX25Series_Chip_Info_t *chip_def);
+
+/**
+ * MX25Series_sfdp_discover reads the JEDEC ID and the SFDP area of the chip into chip_def and makes it the chip
+ * definition of dev. It then sets dev->read_mode to the fastest mode the chip has, in the order 4READ, QREAD, 2READ,
+ * DREAD and FAST_READ, skipping the quad modes while QE is clear and the multi lane modes without
+ * MX25Series_ENABLE_MULTI_IO. Call it after MX25Series_init, chip_def must outlive dev.
+ * @param dev the device structure for the MX25Series chip.
+ * @param chip_def the chip definition to fill in, pre-filled with a template for the fields SFDP does not cover.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_sfdp_discover(MX25Series_t *dev, MX25Series_Chip_Info_t *chip_def);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_SFDP_H
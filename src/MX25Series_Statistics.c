@@ -0,0 +1,242 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+#include "MX25Series_Statistics.h"
+
+MX25Series_status_enum_t MX25Series_statistics_init(
+        MX25Series_Statistics_t *statistics,
+        MX25Series_t *dev,
+        uint16_t *sector_erase_counts,
+        size_t sector_count)
+{
+    memset(statistics, 0, sizeof(MX25Series_Statistics_t));
+    statistics->dev = dev;
+    statistics->sector_erase_counts = sector_erase_counts;
+    statistics->sector_count = sector_erase_counts != NULL ? sector_count : 0;
+    MX25Series_statistics_reset(statistics, true);
+
+#if defined(MX25Series_ENABLE_STATISTICS)
+    dev->statistics = statistics;
+    return MX25Series_status_ok;
+#else
+    return MX25Series_status_error_unsupported;
+#endif
+}
+
+void MX25Series_statistics_deinit(MX25Series_Statistics_t *statistics)
+{
+#if defined(MX25Series_ENABLE_STATISTICS)
+    if(statistics->dev != NULL && statistics->dev->statistics == statistics)
+    {
+        statistics->dev->statistics = NULL;
+    }
+#endif
+    statistics->dev = NULL;
+}
+
+MX25Series_status_enum_t MX25Series_statistics_snapshot(
+        MX25Series_Statistics_t *statistics,
+        MX25Series_Statistics_Counters_t *counters,
+        uint16_t *sector_erase_counts,
+        size_t sector_count)
+{
+    memcpy(counters, &statistics->counters, sizeof(MX25Series_Statistics_Counters_t));
+    if(sector_erase_counts != NULL)
+    {
+        size_t count = sector_count < statistics->sector_count ? sector_count : statistics->sector_count;
+        memcpy(sector_erase_counts, statistics->sector_erase_counts, count * sizeof(uint16_t));
+        memset(sector_erase_counts + count, 0, (sector_count - count) * sizeof(uint16_t));
+    }
+    return MX25Series_status_ok;
+}
+
+void MX25Series_statistics_reset(MX25Series_Statistics_t *statistics, bool sector_erase_counts)
+{
+    memset(&statistics->counters, 0, sizeof(MX25Series_Statistics_Counters_t));
+    statistics->current = NULL;
+    if(sector_erase_counts && statistics->sector_erase_counts != NULL)
+    {
+        memset(statistics->sector_erase_counts, 0, statistics->sector_count * sizeof(uint16_t));
+    }
+}
+
+MX25Series_Statistics_Command_t* MX25Series_statistics_get_command(MX25Series_Statistics_t *statistics, uint8_t command)
+{
+    for(size_t i = 0; i < MX25Series_STATISTICS_COMMANDS && statistics->counters.commands[i].count != 0; i++)
+    {
+        if(statistics->counters.commands[i].command == command)
+        {
+            return &statistics->counters.commands[i];
+        }
+    }
+    return NULL;
+}
+
+uint32_t MX25Series_statistics_get_percentile(MX25Series_Statistics_Histogram_t *histogram, uint8_t percentile)
+{
+    uint64_t target = ((uint64_t)histogram->count * percentile + 99) / 100;
+    uint64_t seen = 0;
+
+    if(histogram->count == 0)
+    {
+        return 0;
+    }
+
+    for(uint8_t bucket = 0; bucket < MX25Series_STATISTICS_BUCKETS; bucket++)
+    {
+        seen += histogram->buckets[bucket];
+        if(seen >= target && seen > 0)
+        {
+            uint32_t upper = (bucket + 1 < 32) ? (2ul << bucket) - 1 : 0xFFFFFFFFul;
+            return upper < histogram->max ? upper : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+#if defined(MX25Series_ENABLE_STATISTICS)
+
+static void MX25Series__statistics_record_latency(MX25Series_Statistics_Histogram_t *histogram, uint32_t elapsed)
+{
+    uint8_t bucket = 0;
+
+    while(bucket < MX25Series_STATISTICS_BUCKETS - 1 && (elapsed >> (bucket + 1)) != 0)
+    {
+        bucket++;
+    }
+
+    if(histogram->count == 0 || elapsed < histogram->min)
+    {
+        histogram->min = elapsed;
+    }
+    if(elapsed > histogram->max)
+    {
+        histogram->max = elapsed;
+    }
+    histogram->count++;
+    histogram->total += elapsed;
+    histogram->buckets[bucket]++;
+}
+
+void MX25Series_statistics_record_command(MX25Series_t *dev, uint8_t command)
+{
+    MX25Series_Statistics_t *statistics = dev->statistics;
+    size_t i;
+
+    if(statistics == NULL)
+    {
+        return;
+    }
+
+    for(i = 0; i < MX25Series_STATISTICS_COMMANDS; i++)
+    {
+        MX25Series_Statistics_Command_t *entry = &statistics->counters.commands[i];
+        if(entry->count == 0 || entry->command == command)
+        {
+            entry->command = command;
+            entry->count++;
+            statistics->current = entry;
+            return;
+        }
+    }
+    statistics->counters.untracked_commands++;
+    statistics->current = NULL;
+}
+
+void MX25Series_statistics_record_bytes(MX25Series_t *dev, size_t length)
+{
+    if(dev->statistics != NULL && dev->statistics->current != NULL)
+    {
+        dev->statistics->current->bytes += length;
+    }
+}
+
+void MX25Series_statistics_record_completion(MX25Series_t *dev, MX25Series_Operation_enum_t operation, uint32_t elapsed)
+{
+    MX25Series_Statistics_t *statistics = dev->statistics;
+
+    if(statistics == NULL)
+    {
+        return;
+    }
+
+    switch(operation)
+    {
+        case MX25Series_Operation_Program:
+            MX25Series__statistics_record_latency(&statistics->counters.program, elapsed);
+            break;
+        case MX25Series_Operation_Erase_4K:
+        case MX25Series_Operation_Erase_32K:
+        case MX25Series_Operation_Erase_64K:
+        case MX25Series_Operation_Erase_Chip:
+            MX25Series__statistics_record_latency(&statistics->counters.erase, elapsed);
+            break;
+        default:
+            break;
+    }
+}
+
+void MX25Series_statistics_record_wait(MX25Series_t *dev, uint32_t elapsed)
+{
+    if(dev->statistics != NULL)
+    {
+        MX25Series__statistics_record_latency(&dev->statistics->counters.polling, elapsed);
+    }
+}
+
+void MX25Series_statistics_record_poll(MX25Series_t *dev)
+{
+    if(dev->statistics != NULL)
+    {
+        dev->statistics->counters.wip_polls++;
+    }
+}
+
+void MX25Series_statistics_record_erase(MX25Series_t *dev, uint32_t memory_address, uint32_t length)
+{
+    MX25Series_Statistics_t *statistics = dev->statistics;
+    size_t sector;
+    size_t end;
+
+    if(statistics == NULL || statistics->sector_erase_counts == NULL)
+    {
+        return;
+    }
+
+    end = ((size_t)memory_address + length) / MX25Series_SECTOR_SIZE;
+    if(end > statistics->sector_count)
+    {
+        end = statistics->sector_count;
+    }
+
+    for(sector = memory_address / MX25Series_SECTOR_SIZE; sector < end; sector++)
+    {
+        if(statistics->sector_erase_counts[sector] != 0xFFFF)
+        {
+            statistics->sector_erase_counts[sector]++;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+#ifndef FLASH_MX25Series_Statistics_H
+#define FLASH_MX25Series_Statistics_H
+
+#include "MX25Series.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#ifndef MX25Series_STATISTICS_COMMANDS
+#define MX25Series_STATISTICS_COMMANDS 24 /**! Number of distinct commands counted */
+#endif
+
+#define MX25Series_STATISTICS_BUCKETS 24  /**! Bucket i counts latencies in [2^i, 2^(i+1)) micro-seconds, bucket 0 includes 0 */
+
+/**
+ * @brief Issue count and bytes transferred, not counting the command byte, for one command.
+ */
+typedef struct {
+    uint8_t command;
+    uint32_t count;
+    uint32_t bytes;
+} MX25Series_Statistics_Command_t;
+
+/**
+ * @brief A log2 bucketed latency histogram in micro-seconds.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t buckets[MX25Series_STATISTICS_BUCKETS];
+} MX25Series_Statistics_Histogram_t;
+
+typedef struct {
+    MX25Series_Statistics_Command_t commands[MX25Series_STATISTICS_COMMANDS]; /**! In order of first use, unused entries have a count of 0 */
+    uint32_t untracked_commands;                  /**! Commands issued once commands[] was full */
+    MX25Series_Statistics_Histogram_t program;    /**! Page Program completion time */
+    MX25Series_Statistics_Histogram_t erase;      /**! Sector, block and chip erase completion time */
+    MX25Series_Statistics_Histogram_t polling;    /**! Time spent in MX25Series_wait_for_completion */
+    uint32_t wip_polls;                           /**! Status Register reads made waiting for WIP to clear */
+} MX25Series_Statistics_Counters_t;
+
+typedef struct MX25Series_Statistics_t
+{
+    MX25Series_t *dev;
+    MX25Series_Statistics_Counters_t counters;
+    MX25Series_Statistics_Command_t *current;     /**! Entry of the command of the frame in progress */
+    uint16_t *sector_erase_counts;                /**! Erases per 4 KB sector that finished without E_FAIL, saturating at 0xFFFF */
+    size_t sector_count;
+} MX25Series_Statistics_t;
+
+/**
+ * MX25Series_statistics_init clears the statistics block and attaches it to dev.
+ * Requires MX25Series_ENABLE_STATISTICS to be defined for every source file of the library, without it the
+ * statistics hooks compile to nothing.
+ * @param statistics the statistics structure to initialise.
+ * @param dev the device structure for the MX25Series chip.
+ * @param sector_erase_counts sector_count counters, one per 4 KB sector from address 0, or NULL.
+ * @param sector_count the number of sector counters, sectors past the end are not counted.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_statistics_init(
+        MX25Series_Statistics_t *statistics,
+        MX25Series_t *dev,
+        uint16_t *sector_erase_counts,
+        size_t sector_count);
+
+/**
+ * MX25Series_statistics_deinit detaches the statistics block from its device.
+ * @param statistics the statistics structure.
+ */
+void MX25Series_statistics_deinit(MX25Series_Statistics_t *statistics);
+
+/**
+ * MX25Series_statistics_snapshot copies the counters, and optionally the sector erase counts, in one go.
+ * @param statistics the statistics structure.
+ * @param counters where to copy the counters to.
+ * @param sector_erase_counts where to copy the sector erase counts to, or NULL.
+ * @param sector_count the number of entries in sector_erase_counts.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_statistics_snapshot(
+        MX25Series_Statistics_t *statistics,
+        MX25Series_Statistics_Counters_t *counters,
+        uint16_t *sector_erase_counts,
+        size_t sector_count);
+
+/**
+ * MX25Series_statistics_reset clears the counters.
+ * @param statistics the statistics structure.
+ * @param sector_erase_counts true to also clear the sector erase counts, which usually outlive a reporting period.
+ */
+void MX25Series_statistics_reset(MX25Series_Statistics_t *statistics, bool sector_erase_counts);
+
+/**
+ * MX25Series_statistics_get_command finds the counters of a command.
+ * @param statistics the statistics structure.
+ * @param command the command to look up.
+ * @return the command's counters, NULL if it has not been issued.
+ */
+MX25Series_Statistics_Command_t* MX25Series_statistics_get_command(MX25Series_Statistics_t *statistics, uint8_t command);
+
+/**
+ * MX25Series_statistics_get_percentile estimates a latency percentile from a histogram as the upper bound of the
+ * bucket it falls in.
+ * @param histogram the histogram.
+ * @param percentile 0 to 100.
+ * @return the latency in micro-seconds, 0 if the histogram is empty.
+ */
+uint32_t MX25Series_statistics_get_percentile(MX25Series_Statistics_Histogram_t *histogram, uint8_t percentile);
+
+#if defined(MX25Series_ENABLE_STATISTICS)
+
+//Recording functions used by the library, dev->statistics may be NULL.
+void MX25Series_statistics_record_command(MX25Series_t *dev, uint8_t command);
+void MX25Series_statistics_record_bytes(MX25Series_t *dev, size_t length);
+void MX25Series_statistics_record_completion(MX25Series_t *dev, MX25Series_Operation_enum_t operation, uint32_t elapsed);
+void MX25Series_statistics_record_wait(MX25Series_t *dev, uint32_t elapsed);
+void MX25Series_statistics_record_poll(MX25Series_t *dev);
+void MX25Series_statistics_record_erase(MX25Series_t *dev, uint32_t memory_address, uint32_t length);
+
+#define MX25Series_STATISTICS_COMMAND(dev, command) MX25Series_statistics_record_command(dev, command)
+#define MX25Series_STATISTICS_BYTES(dev, length) MX25Series_statistics_record_bytes(dev, length)
+#define MX25Series_STATISTICS_COMPLETION(dev, operation, elapsed) MX25Series_statistics_record_completion(dev, operation, elapsed)
+#define MX25Series_STATISTICS_WAIT(dev, elapsed) MX25Series_statistics_record_wait(dev, elapsed)
+#define MX25Series_STATISTICS_POLL(dev) MX25Series_statistics_record_poll(dev)
+#define MX25Series_STATISTICS_ERASE(dev, memory_address, length) MX25Series_statistics_record_erase(dev, memory_address, length)
+
+#else
+
+#define MX25Series_STATISTICS_COMMAND(dev, command)
+#define MX25Series_STATISTICS_BYTES(dev, length)
+#define MX25Series_STATISTICS_COMPLETION(dev, operation, elapsed)
+#define MX25Series_STATISTICS_WAIT(dev, elapsed)
+#define MX25Series_STATISTICS_POLL(dev)
+#define MX25Series_STATISTICS_ERASE(dev, memory_address, length)
+
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_Statistics_H
@@ -0,0 +1,302 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#include "MX25Series_Stripe.h"
+#include "MX25Series_Bus.h"
+
+/**
+ * MX25Series__stripe_locate maps a volume address to its member, the member address, and the bytes left in the
+ * stripe unit.
+ */
+static MX25Series_t* MX25Series__stripe_locate(
+        MX25Series_Stripe_t *stripe,
+        uint32_t memory_address,
+        uint32_t *member_address,
+        size_t *unit_remaining)
+{
+    uint32_t unit = memory_address / stripe->stripe_size;
+    uint32_t offset = memory_address % stripe->stripe_size;
+
+    *member_address = (unit / stripe->member_count) * stripe->stripe_size + offset;
+    *unit_remaining = stripe->stripe_size - offset;
+    return stripe->members[unit % stripe->member_count];
+}
+
+static MX25Series_status_enum_t MX25Series__stripe_wait_member(MX25Series_t *member)
+{
+    if(member->busy_operation == MX25Series_Operation_None)
+    {
+        return MX25Series_status_ok;
+    }
+    return MX25Series_wait_for_operation(member);
+}
+
+MX25Series_status_enum_t MX25Series_stripe_init(MX25Series_Stripe_t *stripe, MX25Series_t **members, uint8_t member_count)
+{
+    uint32_t member_size = 0;
+    uint8_t index;
+
+    memset(stripe, 0, sizeof(MX25Series_Stripe_t));
+
+    if(members == NULL || member_count == 0 || member_count > MX25Series_STRIPE_MAX_MEMBERS)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    for(index = 0; index < member_count; index++)
+    {
+        MX25Series_Chip_Info_t *chip_def;
+
+        if(members[index] == NULL)
+        {
+            return MX25Series_status_error_invalid_argument;
+        }
+
+        chip_def = members[index]->chip_def;
+        if(chip_def == NULL || chip_def->page_size == 0 || (MX25Series_SECTOR_SIZE % chip_def->page_size) != 0 ||
+           (index > 0 && chip_def->page_size != stripe->stripe_size))
+        {
+            return MX25Series_status_error_invalid_chip_def;
+        }
+
+        stripe->members[index] = members[index];
+        stripe->stripe_size = chip_def->page_size;
+        if(index == 0 || chip_def->memory_size < member_size)
+        {
+            member_size = chip_def->memory_size;
+        }
+    }
+
+    //Whole sectors only, so a volume sector is the same sector on every member.
+    member_size -= member_size % MX25Series_SECTOR_SIZE;
+
+    stripe->member_count = member_count;
+    stripe->sector_size = MX25Series_SECTOR_SIZE * member_count;
+    stripe->memory_size = member_size * member_count;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_stripe_read(
+        MX25Series_Stripe_t *stripe,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    if(memory_address > stripe->memory_size || length > stripe->memory_size - memory_address)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    while(length > 0)
+    {
+        uint32_t member_address;
+        size_t chunk;
+        MX25Series_t *member = MX25Series__stripe_locate(stripe, memory_address, &member_address, &chunk);
+
+        if(chunk > length)
+        {
+            chunk = length;
+        }
+
+        result = MX25Series__stripe_wait_member(member);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        result = MX25Series_read_stored_data_mode(member, member->read_mode, member_address, chunk, buffer);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        memory_address += chunk;
+        buffer += chunk;
+        length -= chunk;
+    }
+
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_stripe_write(
+        MX25Series_Stripe_t *stripe,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+
+    if(memory_address > stripe->memory_size || length > stripe->memory_size - memory_address)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    while(length > 0)
+    {
+        uint32_t member_address;
+        size_t chunk;
+        MX25Series_t *member = MX25Series__stripe_locate(stripe, memory_address, &member_address, &chunk);
+
+        if(chunk > length)
+        {
+            chunk = length;
+        }
+
+        //Only this member has to be idle, the others keep programming while it is loaded.
+        result = MX25Series__stripe_wait_member(member);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        result = MX25Series_set_write_enable(member, true);
+        result |= MX25Series_write_stored_data(member, member_address, chunk, buffer);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+
+        memory_address += chunk;
+        buffer += chunk;
+        length -= chunk;
+    }
+
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_stripe_erase_range(
+        MX25Series_Stripe_t *stripe,
+        uint32_t memory_address,
+        uint32_t length)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t address[MX25Series_STRIPE_MAX_MEMBERS];
+    uint32_t remaining[MX25Series_STRIPE_MAX_MEMBERS];
+    uint8_t index;
+
+    if(stripe->member_count == 0 || (memory_address % stripe->sector_size) != 0 || (length % stripe->sector_size) != 0 ||
+       memory_address > stripe->memory_size || length > stripe->memory_size - memory_address)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    for(index = 0; index < stripe->member_count; index++)
+    {
+        address[index] = memory_address / stripe->member_count;
+        remaining[index] = length / stripe->member_count;
+
+        //Refuse before erasing anything if a member has no erase that fits.
+        result = MX25Series_plan_erase_range(stripe->members[index], address[index], remaining[index], NULL, 0, NULL, NULL);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+
+    for(;;)
+    {
+        bool pending = false;
+        bool issued = false;
+
+        for(index = 0; index < stripe->member_count; index++)
+        {
+            MX25Series_t *member = stripe->members[index];
+            MX25Series_Erase_enum_t erase_type;
+
+            if(member->busy_operation != MX25Series_Operation_None)
+            {
+                uint32_t estimate = MX25Series_get_operation_typical_time(member, member->busy_operation);
+                bool busy = true;
+
+                //Leave the bus to the other members for most of the typical time.
+                if(MX25Series___get_micro_seconds(member) - member->busy_start < estimate - estimate / 8)
+                {
+                    pending = true;
+                    continue;
+                }
+
+                result = MX25Series_check_completion(member, &busy);
+                if(MX25Series_HAS_ERROR(result))
+                {
+                    return result;
+                }
+                if(busy)
+                {
+                    pending = true;
+                    continue;
+                }
+            }
+
+            if(remaining[index] == 0)
+            {
+                continue;
+            }
+
+            erase_type = MX25Series_next_erase_step(member, address[index], remaining[index]);
+            result = MX25Series_set_write_enable(member, true);
+            result |= MX25Series_erase(member, erase_type, address[index]);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+
+            address[index] += MX25Series_get_erasure_size(member, erase_type);
+            remaining[index] -= MX25Series_get_erasure_size(member, erase_type);
+            pending = true;
+            issued = true;
+        }
+
+        if(!pending)
+        {
+            break;
+        }
+        if(!issued)
+        {
+            MX25Series_bus_delay(stripe->members[0], MX25Series_WIP_POLL_INTERVAL);
+        }
+    }
+
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_stripe_wait(MX25Series_Stripe_t *stripe)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint8_t index;
+
+    for(index = 0; index < stripe->member_count; index++)
+    {
+        MX25Series_status_enum_t member_result = MX25Series__stripe_wait_member(stripe->members[index]);
+
+        if(MX25Series_HAS_ERROR(member_result))
+        {
+            result = member_result;
+        }
+    }
+
+    return result;
+}
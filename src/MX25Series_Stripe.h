@@ -0,0 +1,123 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#ifndef FLASH_MX25Series_Stripe_H
+#define FLASH_MX25Series_Stripe_H
+
+#include "MX25Series.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#ifndef MX25Series_STRIPE_MAX_MEMBERS
+    #define MX25Series_STRIPE_MAX_MEMBERS 4 /**! Most chips a stripe can span */
+#endif
+
+/**
+ * @brief A volume striped page by page across several chips, each on its own CS line.
+ * Logical page n lives on member n % member_count at page n / member_count of that member, so a sequential write
+ * loads the next chip while the previous ones are still programming.
+ */
+typedef struct
+{
+    MX25Series_t *members[MX25Series_STRIPE_MAX_MEMBERS];
+    uint8_t member_count;
+    uint32_t stripe_size;       /**! Bytes placed on one member before moving to the next, the members' page size */
+    uint32_t sector_size;       /**! Smallest erasable unit, one 4 KB sector on every member */
+    uint32_t memory_size;       /**! Size of the linear address space */
+} MX25Series_Stripe_t;
+
+/**
+ * MX25Series_stripe_init builds a striped volume from initialised devices, the volume is as large as member_count
+ * times the smallest member.
+ * @param stripe the stripe structure to initialise.
+ * @param members member_count initialised devices, the order sets the data layout.
+ * @param member_count between 1 and MX25Series_STRIPE_MAX_MEMBERS.
+ * @return MX25Series_status_error_invalid_chip_def if the members do not share a page size,
+ * MX25Series_status_error_invalid_argument for a bad member list.
+ */
+MX25Series_status_enum_t MX25Series_stripe_init(MX25Series_Stripe_t *stripe, MX25Series_t **members, uint8_t member_count);
+
+/**
+ * MX25Series_stripe_read reads from the volume with each member's dev->read_mode, waiting for a member's
+ * operation in flight before reading from it.
+ * @param stripe the stripe structure.
+ * @param memory_address the volume address to read from.
+ * @param length the number of bytes to read.
+ * @param buffer where to store the data.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_stripe_read(
+        MX25Series_Stripe_t *stripe,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer);
+
+/**
+ * MX25Series_stripe_write programs the volume page by page, only waiting for a member when the next page is its
+ * own, so up to member_count programs are in flight at once. The last programs are still in flight on return,
+ * use MX25Series_stripe_wait before powering down or relying on the data being stored.
+ * @param stripe the stripe structure.
+ * @param memory_address the volume address to write to.
+ * @param length the number of bytes to write.
+ * @param buffer the data to write.
+ * @return a MX25Series_status_enum_t indication success or error codes, including those of earlier programs
+ * that finished while waiting.
+ */
+MX25Series_status_enum_t MX25Series_stripe_write(
+        MX25Series_Stripe_t *stripe,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer);
+
+/**
+ * MX25Series_stripe_erase_range erases a stripe->sector_size aligned range, every member erases its share with
+ * the steps of MX25Series_next_erase_step at the same time, each member starting its next step as soon as its
+ * last one is seen complete.
+ * @param stripe the stripe structure.
+ * @param memory_address the stripe->sector_size aligned volume address of the range.
+ * @param length the number of bytes to erase, a multiple of stripe->sector_size.
+ * @return MX25Series_status_error_invalid_argument if the range is not aligned, MX25Series_status_error_unsupported
+ * if the members have no erase that fits.
+ */
+MX25Series_status_enum_t MX25Series_stripe_erase_range(
+        MX25Series_Stripe_t *stripe,
+        uint32_t memory_address,
+        uint32_t length);
+
+/**
+ * MX25Series_stripe_wait waits for the operations in flight on every member.
+ * @param stripe the stripe structure.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_stripe_wait(MX25Series_Stripe_t *stripe);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_Stripe_H
@@ -0,0 +1,149 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#include "MX25Series_Verify.h"
+
+typedef struct
+{
+    MX25Series_CRC_enum_t type;
+    uint32_t crc;
+} MX25Series_Verify_Context_t;
+
+static void MX25Series__verify_chunk(void *context, const uint8_t *data, size_t length)
+{
+    MX25Series_Verify_Context_t *verify = (MX25Series_Verify_Context_t*)context;
+    verify->crc = MX25Series_crc(verify->type, verify->crc, data, length);
+}
+
+static MX25Series_status_enum_t MX25Series__verify_trailer(
+        MX25Series_t *dev,
+        uint32_t memory_address,
+        uint32_t crc)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t trailer[MX25Series_VERIFY_TRAILER_SIZE];
+
+    result = MX25Series_read_stored_data_mode(dev, dev->read_mode, memory_address, sizeof(trailer), trailer);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    if((trailer[0] | (trailer[1] << 8) | ((uint32_t)trailer[2] << 16) | ((uint32_t)trailer[3] << 24)) != crc)
+    {
+        return MX25Series_status_error_verify;
+    }
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_read_crc(
+        MX25Series_t *dev,
+        MX25Series_CRC_enum_t type,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer,
+        uint32_t *crc)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    MX25Series_Verify_Context_t verify;
+
+    verify.type = type;
+    verify.crc = *crc;
+    result = MX25Series_read_stored_data_stream(dev, dev->read_mode, memory_address, length, buffer,
+                                                MX25Series_VERIFY_CHUNK, MX25Series__verify_chunk, &verify);
+    *crc = verify.crc;
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_read_checked(
+        MX25Series_t *dev,
+        MX25Series_CRC_enum_t type,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t crc = 0;
+
+    result = MX25Series_read_crc(dev, type, memory_address, length, buffer, &crc);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    return MX25Series__verify_trailer(dev, memory_address + length, crc);
+}
+
+MX25Series_status_enum_t MX25Series_write_checked(
+        MX25Series_t *dev,
+        MX25Series_CRC_enum_t type,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint8_t trailer[MX25Series_VERIFY_TRAILER_SIZE];
+    uint32_t crc = MX25Series_crc(type, 0, buffer, length);
+
+    trailer[0] = crc & 0xFF;
+    trailer[1] = (crc >> 8) & 0xFF;
+    trailer[2] = (crc >> 16) & 0xFF;
+    trailer[3] = (crc >> 24) & 0xFF;
+
+    result = MX25Series_write_stored_data_paged(dev, memory_address, length, buffer);
+    if(MX25Series_HAS_ERROR(result))
+    {
+        return result;
+    }
+    return MX25Series_write_stored_data_paged(dev, memory_address + length, sizeof(trailer), trailer);
+}
+
+MX25Series_status_enum_t MX25Series_verify_checked(
+        MX25Series_t *dev,
+        MX25Series_CRC_enum_t type,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *scratch,
+        size_t scratch_length)
+{
+    MX25Series_status_enum_t result = MX25Series_status_init;
+    uint32_t crc = 0;
+    size_t offset;
+
+    if(scratch == NULL || scratch_length == 0)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    for(offset = 0; offset < length; offset += scratch_length)
+    {
+        size_t step = length - offset < scratch_length ? length - offset : scratch_length;
+
+        result = MX25Series_read_crc(dev, type, memory_address + offset, step, scratch, &crc);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+    return MX25Series__verify_trailer(dev, memory_address + length, crc);
+}
@@ -0,0 +1,118 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+
+
+#ifndef FLASH_MX25Series_Verify_H
+#define FLASH_MX25Series_Verify_H
+
+#include "MX25Series.h"
+#include "MX25Series_CRC.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define MX25Series_VERIFY_TRAILER_SIZE 4        /**! Little endian CRC stored straight after the data */
+
+#ifndef MX25Series_VERIFY_CHUNK
+    #define MX25Series_VERIFY_CHUNK 256         /**! Bytes read between CRC updates, small enough to still be in cache */
+#endif
+
+/**
+ * MX25Series_read_crc reads data with dev->read_mode and computes its CRC in the same pass, a chunk at a time as
+ * it arrives from the chip.
+ * @param dev the device structure for the MX25Series chip.
+ * @param type the CRC to compute.
+ * @param memory_address the 24-bit memory address to read from.
+ * @param length the number of bytes to read.
+ * @param buffer the buffer in which to store the read data.
+ * @param crc 0 or the CRC to continue on entry, the CRC including the data read on return.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_read_crc(
+        MX25Series_t *dev,
+        MX25Series_CRC_enum_t type,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer,
+        uint32_t *crc);
+
+/**
+ * MX25Series_read_checked reads data written by MX25Series_write_checked and checks it against its trailer.
+ * @param dev the device structure for the MX25Series chip.
+ * @param type the CRC the data was written with.
+ * @param memory_address the 24-bit memory address to read from.
+ * @param length the number of bytes to read, not counting the trailer.
+ * @param buffer the buffer in which to store the read data.
+ * @return MX25Series_status_error_verify if the CRC does not match the trailer.
+ */
+MX25Series_status_enum_t MX25Series_read_checked(
+        MX25Series_t *dev,
+        MX25Series_CRC_enum_t type,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer);
+
+/**
+ * MX25Series_write_checked programs data followed by a MX25Series_VERIFY_TRAILER_SIZE byte trailer holding its CRC,
+ * page by page like MX25Series_write_stored_data_paged.
+ * @param dev the device structure for the MX25Series chip.
+ * @param type the CRC to append.
+ * @param memory_address the 24-bit memory address to start writing at.
+ * @param length the number of bytes to write, not counting the trailer.
+ * @param buffer the data to write.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_write_checked(
+        MX25Series_t *dev,
+        MX25Series_CRC_enum_t type,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *buffer);
+
+/**
+ * MX25Series_verify_checked checks data written by MX25Series_write_checked against its trailer without keeping it,
+ * reading it through a caller supplied buffer of any size, such as after writing it.
+ * @param dev the device structure for the MX25Series chip.
+ * @param type the CRC the data was written with.
+ * @param memory_address the 24-bit memory address of the data.
+ * @param length the number of bytes of data, not counting the trailer.
+ * @param scratch scratch_length bytes to read into.
+ * @param scratch_length the size of scratch.
+ * @return MX25Series_status_error_verify if the CRC does not match the trailer.
+ */
+MX25Series_status_enum_t MX25Series_verify_checked(
+        MX25Series_t *dev,
+        MX25Series_CRC_enum_t type,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t *scratch,
+        size_t scratch_length);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_Verify_H
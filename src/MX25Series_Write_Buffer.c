@@ -0,0 +1,282 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+#include "MX25Series_Write_Buffer.h"
+#include "MX25Series_Cache.h"
+
+static MX25Series_status_enum_t MX25Series__write_buffer_flush_page(MX25Series_Write_Buffer_t *buffer, MX25Series_Write_Buffer_Page_t *page)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+
+    if(page->page == MX25Series_WRITE_BUFFER_EMPTY)
+    {
+        return result;
+    }
+
+    result = MX25Series_write_stored_data_paged(buffer->dev, page->page + page->first, page->end - page->first, page->data + page->first);
+    buffer->stats.flushes++;
+
+    //Keep the data buffered if it did not make it to the chip.
+    if(!MX25Series_HAS_ERROR(result))
+    {
+        page->page = MX25Series_WRITE_BUFFER_EMPTY;
+    }
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_write_buffer_init(
+        MX25Series_Write_Buffer_t *buffer,
+        MX25Series_t *dev,
+        MX25Series_Write_Buffer_Page_t *pages,
+        size_t page_count,
+        uint8_t *data,
+        uint32_t deadline)
+{
+    memset(buffer, 0, sizeof(MX25Series_Write_Buffer_t));
+
+    if(dev->chip_def == NULL || dev->chip_def->page_size == 0)
+    {
+        return MX25Series_status_error_invalid_chip_def;
+    }
+
+    if(pages == NULL || page_count == 0 || data == NULL)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    buffer->dev = dev;
+    buffer->pages = pages;
+    buffer->page_count = page_count;
+    buffer->deadline = deadline;
+
+    for(size_t i = 0; i < page_count; i++)
+    {
+        pages[i].page = MX25Series_WRITE_BUFFER_EMPTY;
+        pages[i].data = data + i * dev->chip_def->page_size;
+    }
+
+    dev->write_buffer = buffer;
+    return MX25Series_status_ok;
+}
+
+MX25Series_status_enum_t MX25Series_write_buffer_deinit(MX25Series_Write_Buffer_t *buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_write_buffer_flush(buffer);
+
+    if(buffer->dev->write_buffer == buffer)
+    {
+        buffer->dev->write_buffer = NULL;
+    }
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_write_buffer_write(
+        MX25Series_Write_Buffer_t *buffer,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* data)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint32_t page_size = buffer->dev->chip_def->page_size;
+
+    if(memory_address > buffer->dev->chip_def->memory_size || length > buffer->dev->chip_def->memory_size - memory_address)
+    {
+        return MX25Series_status_error_invalid_argument;
+    }
+
+    buffer->stats.writes++;
+    MX25Series_cache_invalidate(buffer->dev->cache, memory_address, length);
+
+    while(length > 0)
+    {
+        uint32_t page_address = memory_address - (memory_address % page_size);
+        uint32_t offset = memory_address - page_address;
+        size_t chunk = page_size - offset;
+        MX25Series_Write_Buffer_Page_t *page = NULL;
+        MX25Series_Write_Buffer_Page_t *oldest = NULL;
+
+        if(chunk > length)
+        {
+            chunk = length;
+        }
+
+        for(size_t i = 0; i < buffer->page_count && page == NULL; i++)
+        {
+            if(buffer->pages[i].page == page_address)
+            {
+                page = &buffer->pages[i];
+            }
+        }
+
+        if(page == NULL)
+        {
+            for(size_t i = 0; i < buffer->page_count && page == NULL; i++)
+            {
+                if(buffer->pages[i].page == MX25Series_WRITE_BUFFER_EMPTY)
+                {
+                    page = &buffer->pages[i];
+                }
+                else if(oldest == NULL || (int32_t)(buffer->pages[i].since - oldest->since) < 0)
+                {
+                    oldest = &buffer->pages[i];
+                }
+            }
+
+            //Every buffer is in use, make room by programming the page that has waited the longest.
+            if(page == NULL)
+            {
+                page = oldest;
+                result = MX25Series__write_buffer_flush_page(buffer, page);
+                if(MX25Series_HAS_ERROR(result))
+                {
+                    return result;
+                }
+            }
+
+            memset(page->data, 0xFF, page_size);
+            page->page = page_address;
+            page->first = offset;
+            page->end = offset + chunk;
+            page->since = MX25Series___get_micro_seconds(buffer->dev);
+        }
+
+        //Programming only clears bits, so a second write to a byte is the AND of both.
+        for(size_t i = 0; i < chunk; i++)
+        {
+            page->data[offset + i] &= data[i];
+        }
+        page->first = offset < page->first ? offset : page->first;
+        page->end = offset + chunk > page->end ? offset + chunk : page->end;
+
+        if(page->first == 0 && page->end == page_size)
+        {
+            result = MX25Series__write_buffer_flush_page(buffer, page);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+        }
+
+        memory_address += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+
+    return MX25Series_write_buffer_poll(buffer);
+}
+
+MX25Series_status_enum_t MX25Series_write_buffer_flush(MX25Series_Write_Buffer_t *buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+
+    for(size_t i = 0; i < buffer->page_count; i++)
+    {
+        result = MX25Series__write_buffer_flush_page(buffer, &buffer->pages[i]);
+        if(MX25Series_HAS_ERROR(result))
+        {
+            return result;
+        }
+    }
+    return result;
+}
+
+MX25Series_status_enum_t MX25Series_write_buffer_poll(MX25Series_Write_Buffer_t *buffer)
+{
+    MX25Series_status_enum_t result = MX25Series_status_ok;
+    uint32_t now;
+
+    if(buffer->deadline == 0)
+    {
+        return result;
+    }
+
+    now = MX25Series___get_micro_seconds(buffer->dev);
+    for(size_t i = 0; i < buffer->page_count; i++)
+    {
+        MX25Series_Write_Buffer_Page_t *page = &buffer->pages[i];
+        if(page->page != MX25Series_WRITE_BUFFER_EMPTY && now - page->since >= buffer->deadline)
+        {
+            result = MX25Series__write_buffer_flush_page(buffer, page);
+            if(MX25Series_HAS_ERROR(result))
+            {
+                return result;
+            }
+        }
+    }
+    return result;
+}
+
+void MX25Series_write_buffer_overlay(MX25Series_Write_Buffer_t *buffer, uint32_t memory_address, size_t length, uint8_t* data)
+{
+    if(buffer == NULL)
+    {
+        return;
+    }
+
+    for(size_t i = 0; i < buffer->page_count; i++)
+    {
+        MX25Series_Write_Buffer_Page_t *page = &buffer->pages[i];
+        uint32_t start;
+        uint32_t end;
+
+        if(page->page == MX25Series_WRITE_BUFFER_EMPTY)
+        {
+            continue;
+        }
+
+        start = page->page + page->first;
+        end = page->page + page->end;
+        if(start < memory_address)
+        {
+            start = memory_address;
+        }
+        if(end > memory_address + length)
+        {
+            end = memory_address + length;
+        }
+
+        //The chip will hold the AND of what is there and what is buffered.
+        for(uint32_t address = start; address < end; address++)
+        {
+            data[address - memory_address] &= page->data[address - page->page];
+        }
+    }
+}
+
+void MX25Series_write_buffer_discard(MX25Series_Write_Buffer_t *buffer, uint32_t memory_address, uint32_t length)
+{
+    if(buffer == NULL)
+    {
+        return;
+    }
+
+    for(size_t i = 0; i < buffer->page_count; i++)
+    {
+        MX25Series_Write_Buffer_Page_t *page = &buffer->pages[i];
+        if(page->page != MX25Series_WRITE_BUFFER_EMPTY &&
+           page->page < memory_address + length && memory_address < page->page + buffer->dev->chip_def->page_size)
+        {
+            page->page = MX25Series_WRITE_BUFFER_EMPTY;
+        }
+    }
+}
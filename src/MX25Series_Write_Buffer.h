@@ -0,0 +1,136 @@
+/*
+ * c-MX25Series is an C Library for the Macronix MX25-Series flash chips.
+ * Copyright (C) 2021 eResearch, James Cook University
+ * Author: NigelB
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Repository: https://github.com/jcu-eresearch/c-MX25-Series
+ *
+ */
+
+
+#ifndef FLASH_MX25Series_Write_Buffer_H
+#define FLASH_MX25Series_Write_Buffer_H
+
+#include "MX25Series.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define MX25Series_WRITE_BUFFER_EMPTY 0xFFFFFFFFul
+
+/**
+ * @brief A page of unflushed data, bytes that have not been written hold 0xFF so they program nothing.
+ */
+typedef struct {
+    uint32_t page;  /**! Address of the first byte of the page, MX25Series_WRITE_BUFFER_EMPTY when unused */
+    uint32_t first; /**! Offset of the first written byte */
+    uint32_t end;   /**! Offset after the last written byte */
+    uint32_t since; /**! MX25Series___get_micro_seconds() of the first unflushed write */
+    uint8_t *data;  /**! chip_def->page_size bytes */
+} MX25Series_Write_Buffer_Page_t;
+
+typedef struct MX25Series_Write_Buffer_t
+{
+    MX25Series_t *dev;
+    MX25Series_Write_Buffer_Page_t *pages;
+    size_t page_count;
+    uint32_t deadline;  /**! Micro-seconds a page may stay unflushed, 0 to only flush when full or asked */
+    struct{
+        uint32_t writes;  /**! Calls to MX25Series_write_buffer_write */
+        uint32_t flushes; /**! Page Programs issued */
+    }stats;
+} MX25Series_Write_Buffer_t;
+
+/**
+ * MX25Series_write_buffer_init sets up a write-back page buffer in front of MX25Series_write_stored_data_paged and
+ * attaches it to dev, so that MX25Series_read_stored_data serves unflushed bytes and MX25Series_erase drops them.
+ * @param buffer the write buffer structure to initialise.
+ * @param dev the device structure for the MX25Series chip.
+ * @param pages page_count entries of page book keeping.
+ * @param page_count the number of pages that can be buffered at once.
+ * @param data page_count * chip_def->page_size bytes of page storage.
+ * @param deadline micro-seconds a page may stay unflushed, 0 to disable.
+ * @return MX25Series_status_error_invalid_argument if the buffers are invalid.
+ */
+MX25Series_status_enum_t MX25Series_write_buffer_init(
+        MX25Series_Write_Buffer_t *buffer,
+        MX25Series_t *dev,
+        MX25Series_Write_Buffer_Page_t *pages,
+        size_t page_count,
+        uint8_t *data,
+        uint32_t deadline);
+
+/**
+ * MX25Series_write_buffer_deinit flushes and detaches the write buffer from its device.
+ * @param buffer the write buffer structure.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_write_buffer_deinit(MX25Series_Write_Buffer_t *buffer);
+
+/**
+ * MX25Series_write_buffer_write accumulates data in page buffers. A page is programmed when it has been completely
+ * written, when a buffer is needed for another page, or once it is older than the deadline.
+ * Like a Page Program, bytes written twice before a flush end up as the bitwise AND of both values.
+ * @param buffer the write buffer structure.
+ * @param memory_address the 24-bit memory address to write to.
+ * @param length the number of bytes to write.
+ * @param data the data to write.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_write_buffer_write(
+        MX25Series_Write_Buffer_t *buffer,
+        uint32_t memory_address,
+        size_t length,
+        uint8_t* data);
+
+/**
+ * MX25Series_write_buffer_flush programs every buffered page.
+ * @param buffer the write buffer structure.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_write_buffer_flush(MX25Series_Write_Buffer_t *buffer);
+
+/**
+ * MX25Series_write_buffer_poll programs the buffered pages that are older than the deadline, call it periodically.
+ * @param buffer the write buffer structure.
+ * @return a MX25Series_status_enum_t indication success or error codes.
+ */
+MX25Series_status_enum_t MX25Series_write_buffer_poll(MX25Series_Write_Buffer_t *buffer);
+
+/**
+ * MX25Series_write_buffer_overlay applies unflushed bytes to data read from the chip.
+ * @param buffer the write buffer structure, may be NULL.
+ * @param memory_address the address data was read from.
+ * @param length the number of bytes read.
+ * @param data the data read from the chip.
+ */
+void MX25Series_write_buffer_overlay(MX25Series_Write_Buffer_t *buffer, uint32_t memory_address, size_t length, uint8_t* data);
+
+/**
+ * MX25Series_write_buffer_discard drops the buffered pages overlapping an erased range.
+ * @param buffer the write buffer structure, may be NULL.
+ * @param memory_address the first address of the range.
+ * @param length the number of bytes in the range.
+ */
+void MX25Series_write_buffer_discard(MX25Series_Write_Buffer_t *buffer, uint32_t memory_address, uint32_t length);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLASH_MX25Series_Write_Buffer_H